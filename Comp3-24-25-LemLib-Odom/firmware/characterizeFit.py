@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Fits drive feedforward constants to a drive characterization log.
+
+usage: telemetryDecode.py --csv --match "Drive characterization" FILE | characterizeFit.py
+       characterizeFit.py [--window N] [LOG...]
+
+Reads CSV from the files given, or stdin. Two kinds of row are used, the rest
+are skipped, so a whole terminal log can be given:
+
+    time,INFO,Drive characterization: ...,test,leftV,rightV,leftIn,rightIn,heading
+        lemlib::Chassis::characterize() through telemetryDecode.py --csv
+    characterize,time,test,leftV,rightV,leftIn,rightIn,heading
+        characterize() in EZ-Code, printed straight to the terminal
+
+time is ms, the voltages are what each side was given from then on, leftIn
+and rightIn how far each side has gone in the test and heading the IMU in
+degrees. Tests 0-3 drive straight and 4-7 turn in place, each a slow voltage
+ramp or a sudden step.
+
+Speed and acceleration come from differences across WINDOW samples either
+side, then V = kS sgn(v) + kV v + kA a is fitted by least squares to each side
+over the straight tests, and to the turn rate in degrees per second over the
+turning tests. Samples where the drive is barely moving are left out, nothing
+can be told about kV from them and the wheels may not have broken free yet.
+
+Prints each fit with its R^2, then the constants ready to paste into
+lemlib::setDriveFeedforward() and ProfiledDrive::Settings.
+"""
+
+import argparse
+import csv
+import sys
+
+STRAIGHT_TESTS = range(0, 4)
+TURN_TESTS = range(4, 8)
+MIN_SPEED = 1.0  # in/s
+MIN_TURN_RATE = 10.0  # deg/s
+
+
+def samples(paths):
+    """Yields (time, test, leftV, rightV, leftIn, rightIn, heading) for each usable row."""
+    files = [open(path, newline="") for path in paths] if paths else [sys.stdin]
+    for file in files:
+        for row in csv.reader(file):
+            if len(row) >= 9 and row[2].startswith("Drive characterization"):
+                fields = [row[0]] + row[3:9]
+            elif len(row) >= 8 and row[0] == "characterize":
+                fields = row[1:8]
+            else:
+                continue
+            try:
+                values = [float(value) for value in fields]
+            except ValueError:
+                continue
+            values[1] = int(values[1])
+            yield tuple(values)
+
+
+def tests(rows):
+    """Splits the rows into runs of the same test, in order."""
+    runs = []
+    for row in rows:
+        if not runs or runs[-1][0][1] != row[1] or row[0] < runs[-1][-1][0]:
+            runs.append([])
+        runs[-1].append(row)
+    return runs
+
+
+def derivative(times, values, window):
+    """Central differences across window samples either side, None where the window runs off the end."""
+    result = [None] * len(values)
+    for i in range(window, len(values) - window):
+        dt = (times[i + window] - times[i - window]) / 1000
+        if dt > 0:
+            result[i] = (values[i + window] - values[i - window]) / dt
+    return result
+
+
+def solve(matrix, vector):
+    """Gaussian elimination with partial pivoting on a small square system."""
+    n = len(vector)
+    a = [row[:] + [vector[i]] for i, row in enumerate(matrix)]
+    for column in range(n):
+        pivot = max(range(column, n), key=lambda r: abs(a[r][column]))
+        if abs(a[pivot][column]) < 1e-12:
+            return None
+        a[column], a[pivot] = a[pivot], a[column]
+        for r in range(column + 1, n):
+            scale = a[r][column] / a[column][column]
+            for c in range(column, n + 1):
+                a[r][c] -= scale * a[column][c]
+    x = [0.0] * n
+    for r in reversed(range(n)):
+        x[r] = (a[r][n] - sum(a[r][c] * x[c] for c in range(r + 1, n))) / a[r][r]
+    return x
+
+
+def fit(points):
+    """Least squares kS, kV, kA over (volts, velocity, acceleration) points, and R^2."""
+    rows = [((1 if v > 0 else -1), v, a) for _, v, a in points]
+    volts = [p[0] for p in points]
+    normal = [[sum(r[i] * r[j] for r in rows) for j in range(3)] for i in range(3)]
+    right = [sum(r[i] * y for r, y in zip(rows, volts)) for i in range(3)]
+    constants = solve(normal, right)
+    if constants is None:
+        return None, 0
+    mean = sum(volts) / len(volts)
+    total = sum((y - mean) ** 2 for y in volts)
+    residual = sum((y - sum(k * x for k, x in zip(constants, r))) ** 2 for r, y in zip(rows, volts))
+    return constants, 1 - residual / total if total > 0 else 0
+
+
+def points(runs, volts_column, position_column, wanted, window, min_speed):
+    """(volts, velocity, acceleration) for every moving sample of the wanted tests."""
+    result = []
+    for run in runs:
+        if run[0][1] not in wanted:
+            continue
+        times = [row[0] for row in run]
+        velocity = derivative(times, [row[position_column] for row in run], window)
+        acceleration = derivative(times, [v if v is not None else 0 for v in velocity], window)
+        for i, row in enumerate(run):
+            v = velocity[i]
+            a = acceleration[i]
+            if v is None or a is None or velocity[i - window] is None or velocity[i + window] is None:
+                continue
+            if abs(v) < min_speed:
+                continue
+            result.append((row[volts_column], v, a))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fit drive feedforward constants to a characterization log.")
+    parser.add_argument("--window", type=int, default=2, help="samples either side for speed and acceleration")
+    parser.add_argument("logs", nargs="*", help="CSV logs, stdin when none are given")
+    options = parser.parse_args()
+
+    runs = tests(samples(options.logs))
+    if not runs:
+        sys.exit("no drive characterization rows found")
+
+    fits = {}
+    for name, volts, position, wanted, min_speed in (
+        ("left", 2, 4, STRAIGHT_TESTS, MIN_SPEED),
+        ("right", 3, 5, STRAIGHT_TESTS, MIN_SPEED),
+        ("angular", 2, 6, TURN_TESTS, MIN_TURN_RATE),
+    ):
+        data = points(runs, volts, position, wanted, options.window, min_speed)
+        if len(data) < 3:
+            sys.exit("not enough moving samples for the %s fit" % name)
+        constants, r2 = fit(data)
+        if constants is None:
+            sys.exit("the %s fit has no unique answer, were both the ramp and step tests run?" % name)
+        fits[name] = constants
+        print("%-8s kS %.4f  kV %.5f  kA %.5f   R^2 %.4f  %d samples" % ((name,) + tuple(constants) + (r2, len(data))))
+
+    def braces(constants):
+        return "{%.4g, %.4g, %.4g}" % tuple(constants)
+
+    print("lemlib::setDriveFeedforward({.left = %s, .right = %s, .angular = %s});"
+          % (braces(fits["left"]), braces(fits["right"]), braces(fits["angular"])))
+    print(".feedforward = {.left = %s, .right = %s, .angular = %s}"
+          % (braces(fits["left"]), braces(fits["right"]), braces(fits["angular"])))
+
+
+if __name__ == "__main__":
+    main()
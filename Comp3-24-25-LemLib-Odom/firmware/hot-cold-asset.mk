@@ -9,11 +9,28 @@ TEMPLATE_FILES+=$(wildcard static/*) $(wildcard firmware/hot-cold-asset.mk)
 
 ASSET_OBJ=$(addprefix $(BINDIR)/, $(addsuffix .o, $(ASSET_FILES)) )
 
-GETALLOBJ=$(sort $(call ASMOBJ,$1) $(call COBJ,$1) $(call CXXOBJ,$1)) $(ASSET_OBJ)
+# paths in static/ are also packed into binary path assets that follow() reads in
+# place, static/foo.txt becomes ASSET(foo_path). See lemlib/pathAsset.hpp
+PYTHON?=python3
+PATH_FILES=$(wildcard static/*.txt)
+PATH_OBJ=$(addprefix $(BINDIR)/, $(addsuffix .o, $(PATH_FILES:.txt=.path)) )
+
+TEMPLATE_FILES+=$(wildcard firmware/pathAsset.py)
+
+GETALLOBJ=$(sort $(call ASMOBJ,$1) $(call COBJ,$1) $(call CXXOBJ,$1)) $(ASSET_OBJ) $(PATH_OBJ)
 
 .SECONDEXPANSION:
 $(ASSET_OBJ): $$(patsubst bin/%,%,$$(basename $$@))
 	$(VV)mkdir -p $(BINDIR)/static
 	$(VV)mkdir -p $(BINDIR)/static.lib
 	@echo "ASSET $@"
-	$(VV)$(OBJCOPY) -I binary -O elf32-littlearm -B arm $^ $@
\ No newline at end of file
+	$(VV)$(OBJCOPY) -I binary -O elf32-littlearm -B arm $^ $@
+
+# read only and 4 byte aligned so the floats can be read straight out of the image
+$(BINDIR)/static/%.path.o: static/%.txt firmware/pathAsset.py
+	$(VV)mkdir -p $(BINDIR)/static
+	@echo "PATH $@"
+	$(VV)$(PYTHON) firmware/pathAsset.py $< $(BINDIR)/static/$*.path
+	$(VV)cd $(BINDIR) && $(OBJCOPY) -I binary -O elf32-littlearm -B arm \
+		--rename-section .data=.rodata,alloc,load,readonly,data,contents --set-section-alignment .data=4 \
+		static/$*.path static/$*.path.o
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Sums up loop timing from LoopTimer::recordAll() telemetry.
+
+usage: telemetryDecode.py --csv --match "Loop timing" FILE | loopReport.py
+       loopReport.py [--csv] [LOG...]
+
+Reads CSV from the files given, or stdin. Rows from telemetryDecode.py --csv
+look like
+
+    time,INFO,Loop timing: ...,name,period,runs,mean,max,latency,misses,cpu,j0,...,j7
+
+with the times in microseconds, cpu a fraction and j0-j7 how many runs started
+within each jitter bin of the period, see LoopStats::JITTER_EDGES. The stats
+add up from the last LoopTimer::resetAll(), so the last row for each loop
+covers the whole auton or match up to when it was logged.
+
+Prints one line per loop with its histogram as percentages, or with --csv the
+same as CSV with one row per loop, ready for a spreadsheet.
+"""
+
+import argparse
+import csv
+import sys
+
+JITTER_LABELS = ["50us", "100us", "250us", "500us", "1ms", "2ms", "5ms", ">5ms"]
+COLUMNS = ["loop", "period ms", "runs", "mean us", "max us", "latency us", "missed", "cpu %"] + JITTER_LABELS
+
+
+def rows(paths):
+    """Yields (time, name, numbers) for each loop timing row, numbers from period to the last jitter bin."""
+    files = [open(path, newline="") for path in paths] if paths else [sys.stdin]
+    for file in files:
+        for row in csv.reader(file):
+            if len(row) < 3 + 1 + 7 + len(JITTER_LABELS) or not row[2].startswith("Loop timing"):
+                continue
+            try:
+                yield int(row[0]), row[3], [float(value) for value in row[4:]]
+            except ValueError:
+                continue
+
+
+def latest(all_rows):
+    """The last row for each loop, in the order the loops first showed up."""
+    loops = {}
+    for time, name, numbers in all_rows:
+        loops[name] = (time, numbers)
+    return loops
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sum up loop timing telemetry.")
+    parser.add_argument("--csv", action="store_true", help="write CSV instead of a table")
+    parser.add_argument("logs", nargs="*", help="CSV logs, stdin when none are given")
+    options = parser.parse_args()
+
+    loops = latest(rows(options.logs))
+    if not loops:
+        sys.exit("no loop timing rows found")
+
+    writer = csv.writer(sys.stdout, lineterminator="\n") if options.csv else None
+    if writer:
+        writer.writerow(COLUMNS)
+    else:
+        print("%-12s %9s %7s %7s %7s %10s %6s %6s   jitter %s" % (tuple(COLUMNS[:8]) + (" ".join(JITTER_LABELS),)))
+    for name, (time, numbers) in loops.items():
+        period, runs, mean, longest, latency, misses, cpu = numbers[:7]
+        jitter = numbers[7 : 7 + len(JITTER_LABELS)]
+        starts = sum(jitter)
+        shares = [100 * count / starts if starts else 0 for count in jitter]
+        if writer:
+            writer.writerow([name, int(period), int(runs), int(mean), int(longest), int(latency), int(misses),
+                             "%.2f" % (100 * cpu)] + ["%.1f" % share for share in shares])
+        else:
+            print("%-12s %9d %7d %7d %7d %10d %6d %5.1f%%          %s" % (
+                name, period, runs, mean, longest, latency, misses, 100 * cpu,
+                " ".join("%*.0f%%" % (len(label) - 1, share) for label, share in zip(JITTER_LABELS, shares))))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Packs a LemLib path.jerryio text path into a binary path asset.
+
+usage: pathAsset.py static/path.txt bin/static/path.path
+
+The text format is one "x, y, speed" point per line, ending at "endData". The
+binary format is read in place by lemlib::PathAsset (include/lemlib/pathAsset.hpp),
+so the two have to be changed together:
+
+    header, 24 bytes
+        char[4]  magic      "LLPB"
+        uint16   version    2
+        uint16   pointSize  16
+        uint32   count      number of points
+        float32  length     total arc length, inches
+        uint16   boxPoints  points covered by each box, 16
+        uint16   boxSize    16
+        uint32   boxCount   ceil((count - 1) / (boxPoints - 1))
+    count points, 16 bytes each
+        float32  x, y       inches
+        float32  speed      0-127
+        float32  distance   arc length from the start, inches
+    boxCount boxes, 16 bytes each
+        float32  minX, minY, maxX, maxY
+        box i covers points i * (boxPoints - 1) to (i + 1) * (boxPoints - 1),
+        so every segment is inside one box
+
+Everything is little endian, like the V5 brain.
+"""
+
+import math
+import struct
+import sys
+
+MAGIC = b"LLPB"
+VERSION = 2
+BOX_POINTS = 16
+HEADER = struct.Struct("<4sHHIfHHI")
+POINT = struct.Struct("<ffff")
+BOX = struct.Struct("<ffff")
+
+
+def read_points(text):
+    points = []
+    for number, line in enumerate(text.splitlines(), 1):
+        line = line.strip()
+        if line == "endData":
+            break
+        if not line:
+            continue
+        fields = line.split(",")
+        if len(fields) != 3:
+            raise ValueError(f"line {number}: expected 'x, y, speed', got '{line}'")
+        points.append(tuple(float(f) for f in fields))
+    return points
+
+
+def pack(points):
+    distances = [0.0]
+    for a, b in zip(points, points[1:]):
+        distances.append(distances[-1] + math.dist(a[:2], b[:2]))
+
+    step = BOX_POINTS - 1
+    boxes = []
+    for first in range(0, max(len(points) - 1, 0), step):
+        covered = points[first:first + BOX_POINTS]
+        xs = [p[0] for p in covered]
+        ys = [p[1] for p in covered]
+        boxes.append((min(xs), min(ys), max(xs), max(ys)))
+
+    length = distances[-1] if points else 0.0
+    out = bytearray(HEADER.pack(MAGIC, VERSION, POINT.size, len(points), length, BOX_POINTS, BOX.size, len(boxes)))
+    for point, distance in zip(points, distances):
+        out += POINT.pack(*point, distance)
+    for box in boxes:
+        out += BOX.pack(*box)
+    return bytes(out)
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.exit(__doc__.split("\n\n")[1])
+    with open(argv[1]) as f:
+        try:
+            points = read_points(f.read())
+        except ValueError as e:
+            sys.exit(f"{argv[1]}: {e}")
+    with open(argv[2], "wb") as f:
+        f.write(pack(points))
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""Turns binary telemetry from lemlib::TelemetrySink back into text or CSV.
+
+usage: telemetryDecode.py [--csv] [--match TEXT] FILE...
+
+FILE is either a telemetry file from the SD card (/usd/telemetry.bin by
+default) or a saved terminal log, where the records are printed in hex between
+BTEL_START and BTEL_END. Files are read in order and share the formats, so a
+terminal log that started after the robot booted can be decoded by giving an
+earlier log or file from the same program first.
+
+Text output is one "time level message" line per message, formatted the way
+fmt would have on the brain. --csv writes "time,level,format,arguments..."
+instead, with a Pose as three columns, ready for a spreadsheet. --match only
+keeps messages whose format contains TEXT.
+
+The record layout is in include/lemlib/logger/telemetryRecord.hpp, the two have
+to be changed together:
+
+    file        uint16 length, then a record, repeated
+    FORMAT      uint8 kind 0, uint32 id, argument codes, '\\0', format string
+    MESSAGE     uint8 kind 1, uint32 id, uint32 time ms, uint8 level, arguments
+
+Argument codes are struct codes (? c b B h H i I q Q f d), plus L for a level
+(uint8), P for a Pose (three float32) and s for a string (uint8 length, then
+the characters). Everything is little endian, like the V5 brain.
+"""
+
+import argparse
+import csv
+import math
+import re
+import struct
+import sys
+
+FORMAT = 0
+MESSAGE = 1
+LEVELS = ["INFO", "DEBUG", "WARN", "ERROR", "FATAL"]
+HEX_RECORD = re.compile(rb"BTEL_START([0-9a-f]*)BTEL_END")
+MESSAGE_HEADER = struct.Struct("<BIIB")
+
+
+def shortest(value, single):
+    """Formats a float like fmt's "{}": the fewest digits that read back the same."""
+    if math.isnan(value):
+        return "nan"
+    if math.isinf(value):
+        return "inf" if value > 0 else "-inf"
+    if value == 0:
+        return "-0" if math.copysign(1, value) < 0 else "0"
+    for precision in range(1, 18):
+        text = "%.*e" % (precision - 1, value)
+        back = float(text)
+        if single:
+            back = struct.unpack("<f", struct.pack("<f", back))[0]
+        if back == value:
+            break
+    mantissa, exponent = text.split("e")
+    sign = "-" if mantissa.startswith("-") else ""
+    digits = mantissa.lstrip("-").replace(".", "").rstrip("0") or "0"
+    exponent = int(exponent)
+    if -4 <= exponent < 16:
+        if exponent >= 0:
+            whole = digits[: exponent + 1].ljust(exponent + 1, "0")
+            fraction = digits[exponent + 1 :]
+        else:
+            whole = "0"
+            fraction = "0" * (-exponent - 1) + digits
+        return sign + whole + ("." + fraction if fraction else "")
+    fraction = digits[1:]
+    return "%s%s%se%s%02d" % (sign, digits[0], "." + fraction if fraction else "",
+                              "-" if exponent < 0 else "+", abs(exponent))
+
+
+class Arg:
+    """One decoded argument, formats itself the way fmt would for its type."""
+
+    def __init__(self, code, value):
+        self.code = code
+        self.value = value
+
+    def text(self):
+        if self.code == "?":
+            return "true" if self.value else "false"
+        if self.code in "fd":
+            return shortest(self.value, self.code == "f")
+        if self.code == "L":
+            return LEVELS[self.value] if self.value < len(LEVELS) else "UNKNOWN"
+        if self.code == "P":
+            x, y, theta = (shortest(v, True) for v in self.value)
+            return "lemlib::Pose { x: %s, y: %s, theta: %s }" % (x, y, theta)
+        return str(self.value)
+
+    def columns(self):
+        if self.code == "P":
+            return [shortest(v, True) for v in self.value]
+        return [self.text()]
+
+    def __format__(self, spec):
+        if not spec:
+            return self.text()
+        if self.code in "bBhHiIqQ" or (self.code == "?" and spec[-1] in "bBdoxX"):
+            return format(int(self.value), spec)
+        if self.code in "fd":
+            return format(self.value, spec)
+        return format(self.text(), spec)
+
+
+def decode_args(codes, data):
+    args = []
+    offset = 0
+    for code in codes:
+        if code == "s":
+            size = data[offset]
+            args.append(Arg(code, data[offset + 1 : offset + 1 + size].decode("utf-8", "replace")))
+            offset += 1 + size
+        elif code == "P":
+            args.append(Arg(code, struct.unpack_from("<fff", data, offset)))
+            offset += 12
+        elif code == "L":
+            args.append(Arg(code, data[offset]))
+            offset += 1
+        elif code == "c":
+            args.append(Arg(code, chr(data[offset])))
+            offset += 1
+        else:
+            args.append(Arg(code, struct.unpack_from("<" + code, data, offset)[0]))
+            offset += struct.calcsize(code)
+    return args
+
+
+def records(path):
+    with open(path, "rb") as file:
+        data = file.read()
+    found = HEX_RECORD.findall(data)
+    if found or b"BTEL_START" in data:
+        for text in found:
+            yield bytes.fromhex(text.decode())
+        return
+    offset = 0
+    while offset + 2 <= len(data):
+        (size,) = struct.unpack_from("<H", data, offset)
+        yield data[offset + 2 : offset + 2 + size]
+        offset += 2 + size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("files", nargs="+", metavar="FILE")
+    parser.add_argument("--csv", action="store_true", help="write CSV instead of text")
+    parser.add_argument("--match", default="", metavar="TEXT", help="only messages whose format contains TEXT")
+    options = parser.parse_args()
+
+    formats = {}
+    unknown = 0
+    writer = csv.writer(sys.stdout, lineterminator="\n") if options.csv else None
+    for path in options.files:
+        for record in records(path):
+            if len(record) < 5:
+                continue
+            if record[0] == FORMAT:
+                (id,) = struct.unpack_from("<I", record, 1)
+                codes, _, format = record[5:].partition(b"\0")
+                formats[id] = (codes.decode(), format.decode("utf-8", "replace"))
+                continue
+            if record[0] != MESSAGE or len(record) < MESSAGE_HEADER.size:
+                continue
+            _, id, time, level = MESSAGE_HEADER.unpack_from(record)
+            level = LEVELS[level] if level < len(LEVELS) else "UNKNOWN"
+            if id not in formats:
+                unknown += 1
+                continue
+            codes, format = formats[id]
+            if options.match not in format:
+                continue
+            args = decode_args(codes, record[MESSAGE_HEADER.size :])
+            if writer:
+                writer.writerow([time, level, format] + [column for arg in args for column in arg.columns()])
+            else:
+                print(time, level, format.format(*args))
+    if unknown:
+        print("%d messages with no format, decode an earlier file from the same program first" % unknown,
+              file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "loopTimer.hpp"
+#include "pros/rtos.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Where in a tick a job runs. Every job due on a tick runs stage by stage, so
+ * the controllers always work from readings taken on that tick and their
+ * outputs go out before anything slow like the screen gets a turn.
+ */
+enum class Stage : std::uint8_t {
+    SENSE,   // reading sensors, e.g. odometry
+    COMPUTE, // deciding what to do with them
+    ACTUATE, // driving motors and pistons
+    DISPLAY  // screen and logging
+};
+
+/**
+ * Runs the robot's periodic jobs from one task on one shared tick.
+ *
+ * Separate tasks each with their own delay loop drift in and out of phase
+ * with each other, so whether the sort or a macro sees this update's pose or
+ * the last one's changes from run to run. Here every job has a period that is
+ * a multiple of the tick, every job due on a tick runs in the same order, and
+ * every tick starts on time from the same clock.
+ *
+ * Jobs run by stage, then shortest period first (rate monotonic), then in the
+ * order they were added. A job must never block or delay: the next job waits
+ * for it, and a job that runs long makes the ones after it late. Each job, and
+ * the tick as a whole, has a LoopTimer, so how long they take, how late they
+ * start and how often they finish after they were due again show up with
+ * every other timed loop, see getStats() and printReport().
+ *
+ * @b Example
+ * @code {.cpp}
+ * ControlScheduler scheduler;
+ *
+ * // in initialize()
+ * lemlib::setUpdateTask(false); // before chassis.calibrateOdom()
+ * scheduler.add("odometry", Stage::SENSE, 5, [](std::uint32_t) { lemlib::update(); });
+ * scheduler.add("macros", Stage::ACTUATE, 10, [](std::uint32_t now) { macros.update(now); });
+ * pros::Task schedulerTask([] { scheduler.run(); }, TASK_PRIORITY_DEFAULT + 2);
+ * @endcode
+ */
+class ControlScheduler {
+    public:
+        /**
+         * @param tick ms between ticks, every job's period is a multiple of it
+         */
+        ControlScheduler(std::uint32_t tick = 5);
+
+        /**
+         * Adds a job. Add every job before run() starts.
+         *
+         * @param name shown in reports, a string literal or something else that lives as long
+         * @param stage where in the tick it runs
+         * @param period ms between runs, rounded up to a multiple of the tick
+         * @param job gets the time the tick was due, in ms
+         * @return the job's index for getStats()
+         */
+        int add(const char* name, Stage stage, std::uint32_t period, std::function<void(std::uint32_t now)> job);
+
+        /**
+         * Runs the jobs. Never returns, start it in its own task, above the
+         * priority of anything that could hold it up.
+         */
+        void run();
+
+        /**
+         * Runs every job due on one tick. run() calls this every tick.
+         *
+         * @param now the time the tick was due, ms
+         */
+        void update(std::uint32_t now);
+
+        int getJobCount() const;
+
+        /**
+         * @param job index from add(), in the order they were added
+         */
+        LoopStats getStats(int job);
+
+        /**
+         * @return stats for whole ticks, every job due on them together
+         */
+        LoopStats getTickStats();
+
+        /**
+         * Starts every job's stats again, e.g. at the start of a match.
+         */
+        void resetStats();
+
+        /**
+         * Prints every job's stats to the terminal, one line each.
+         */
+        void printReport();
+    private:
+        struct Job {
+                Stage stage;
+                std::uint32_t period; // ms
+                std::function<void(std::uint32_t)> run;
+                std::unique_ptr<LoopTimer> timer;
+                int index; // add() order
+        };
+
+        const std::uint32_t tick; // ms
+        std::uint32_t ticks = 0; // since run() started
+        LoopTimer tickTimer;
+        std::vector<Job> jobs; // in the order they run
+};
@@ -5,6 +5,7 @@
 #include "lemlib/util.hpp" // IWYU pragma: keep
 #include "lemlib/chassis/chassis.hpp"
 #include "lemlib/chassis/trackingWheel.hpp" // IWYU pragma: keep
+#include "lemlib/motionQueue.hpp" // IWYU pragma: keep
 #include "lemlib/logger/logger.hpp" // IWYU pragma: keep
 
 // using to shorten lemlib::AngularDirection to just AngularDirection
@@ -3,6 +3,8 @@
 #include "pros/rtos.hpp"
 #include "pros/imu.hpp"
 #include "lemlib/asset.hpp"
+#include "lemlib/pathAsset.hpp"
+#include "lemlib/trajectoryTracker.hpp"
 #include "lemlib/chassis/trackingWheel.hpp"
 #include "lemlib/pose.hpp"
 #include "lemlib/pid.hpp"
@@ -323,6 +325,87 @@ struct MoveToPointParams {
         float earlyExitRange = 0;
 };
 
+/**
+ * @brief Parameters for Chassis::moveToPointProfiled
+ *
+ * The defaults suit a 450 rpm drive on 2.75" wheels, see MotionProfile. Once setDriveFeedforward() is called its
+ * constants replace kA and the estimate from the drivetrain's free speed
+ */
+struct MoveToPointProfiledParams {
+        /** whether the robot should move forwards or backwards. True by default */
+        bool forwards = true;
+        /** top speed in inches per second. 0 means 90% of the drivetrain's free speed. 0 by default */
+        float maxVelocity = 0;
+        /** in/s^2, how hard the robot speeds up and slows down. 300 by default */
+        float maxAcceleration = 300;
+        /** in/s^3, how fast the acceleration may change. 0 for a trapezoid profile. 6000 by default */
+        float maxJerk = 6000;
+        /** power per in/s^2 of planned acceleration, on top of the power for the planned speed. 0.25 by default */
+        float kA = 0.25;
+        /** distance from the target point where the movement exits once the profile is done. 1 by default */
+        float exitRange = 1;
+        /** longest the robot can spend settling in exitRange after the profile is done, in ms. 250 by default */
+        int settleTime = 250;
+};
+
+/**
+ * @brief Parameters for Chassis::turnToHeadingProfiled
+ *
+ * Once setDriveFeedforward() is called its angular constants replace kA and the estimate from the free speed
+ */
+struct TurnToHeadingProfiledParams {
+        /** the direction the robot should turn in. AUTO by default */
+        AngularDirection direction = AngularDirection::AUTO;
+        /** top turning speed in degrees per second. 0 means 90% of what the drivetrain can do. 0 by default */
+        float maxVelocity = 0;
+        /** deg/s^2. 2400 by default */
+        float maxAcceleration = 2400;
+        /** deg/s^3. 0 for a trapezoid profile. 48000 by default */
+        float maxJerk = 48000;
+        /** motor power per deg/s^2 of planned acceleration. 0.015 by default */
+        float kA = 0.015;
+        /** angle from the target heading where the movement exits once the profile is done. 1 by default */
+        float exitRange = 1;
+        /** longest the robot can spend settling in exitRange after the profile is done, in ms. 250 by default */
+        int settleTime = 250;
+};
+
+/**
+ * @brief Parameters for Chassis::characterize
+ *
+ * The straight tests drive forwards then back, so the robot needs maxDistance of clear field in front of it
+ */
+struct CharacterizeParams {
+        /** volts per second the slow ramps speed up by. 1.5 by default */
+        float rampRate = 1.5;
+        /** volts the sudden steps jump to. 7 by default */
+        float stepVoltage = 7;
+        /** inches a straight test may cover before it stops. 36 by default */
+        float maxDistance = 36;
+        /** longest a turning test may run, in ms. 4000 by default */
+        int turnTime = 4000;
+        /** time the robot is given to coast to a stop between tests, in ms. 1000 by default */
+        int restTime = 1000;
+};
+
+/**
+ * @brief Parameters for Chassis::runQueue
+ */
+struct MotionQueueParams {
+        /** distance from a point where the next motion takes over, when there is one. 6 by default */
+        float blendDistance = 6;
+        /** how far ahead along the line to each point the robot steers at. 12 by default */
+        float lookahead = 12;
+        /** angle from a heading where the next motion takes over, when there is one. 10 by default */
+        float blendAngle = 10;
+        /** time the output fades from the last motion's to the next one's over, in ms. 150 by default */
+        int blendTime = 150;
+        /** slowest the robot goes through a point it turns right around at. Value between 0-127. 30 by default */
+        float minExitSpeed = 30;
+};
+
+class MotionQueue;
+
 // default drive curve
 extern ExpoDriveCurve defaultDriveCurve;
 
@@ -368,6 +451,25 @@ class Chassis {
          * @endcode
          */
         void calibrate(bool calibrateIMU = true);
+        /**
+         * @brief Calibrate the chassis sensors and start the odometry in src/lemlib/chassis/odom.cpp, in place of
+         * calibrate()
+         *
+         * calibrate() starts the odometry in LemLib's archive, which updates every 10 ms. This starts the one in
+         * odom.hpp instead, and after each update sets the archive's pose to match, so getPose() and every motion
+         * read the same pose. setPose() still works: a pose set on the chassis is picked up at the next update. Call
+         * one or the other, not both
+         *
+         * @param calibrateIMU whether the IMU should be calibrated. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     chassis.calibrateOdom();
+         * }
+         * @endcode
+         */
+        void calibrateOdom(bool calibrateIMU = true);
         /**
          * @brief Set the pose of the chassis
          *
@@ -680,6 +782,90 @@ class Chassis {
          * @endcode
          */
         void moveToPoint(float x, float y, int timeout, MoveToPointParams params = {}, bool async = true);
+        /**
+         * @brief Move the chassis towards a point along a planned motion profile
+         *
+         * Plans the quickest speed profile along the straight line to the point that keeps to the speed, acceleration
+         * and jerk limits, then drives it: the power for the planned speed and acceleration, plus the lateral PID on
+         * how far the robot is behind or ahead of the plan. The angular PID keeps it pointed at the point. It speeds
+         * up harder than the slew in moveToPoint() lets it and slows down before the point instead of settling onto
+         * it, and exits when the profile is done instead of on the exit conditions' timeouts.
+         *
+         * @param x x location
+         * @param y y location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // move the robot to x = 20, y = 15 with a timeout of 4000ms
+         * chassis.moveToPointProfiled(20, 15, 4000);
+         * // the same backwards, speeding up no harder than 100 in/s^2
+         * chassis.moveToPointProfiled(20, 15, 4000, {.forwards = false, .maxAcceleration = 100});
+         * @endcode
+         */
+        void moveToPointProfiled(float x, float y, int timeout, MoveToPointProfiledParams params = {},
+                                 bool async = true);
+        /**
+         * @brief Turn the chassis to face a heading along a planned motion profile
+         *
+         * The turning counterpart of moveToPointProfiled(), with the angular PID on how far the turn is behind or
+         * ahead of the plan
+         *
+         * @param theta heading location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // turn the robot to face heading 135, with a timeout of 1000ms
+         * chassis.turnToHeadingProfiled(135, 1000);
+         * @endcode
+         */
+        void turnToHeadingProfiled(float theta, int timeout, TurnToHeadingProfiledParams params = {},
+                                   bool async = true);
+        /**
+         * @brief Drive each side at a speed, with the drive feedforward from setDriveFeedforward()
+         *
+         * Voltage control: the feedforward for the speed and acceleration, plus DriveFeedforward::kP on how far each
+         * side is off its speed. Call it every loop, like tank()
+         *
+         * @param leftVelocity inches per second of the left wheels
+         * @param rightVelocity inches per second of the right wheels
+         * @param leftAcceleration in/s^2 the left side should be speeding up by. 0 by default
+         * @param rightAcceleration in/s^2 the right side should be speeding up by. 0 by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // arc to the right at 40 in/s
+         * chassis.tankVelocity(45, 35);
+         * @endcode
+         */
+        void tankVelocity(float leftVelocity, float rightVelocity, float leftAcceleration = 0,
+                          float rightAcceleration = 0);
+        /**
+         * @brief Run the drive characterization tests and log what the drive did through lemlib::telemetrySink()
+         *
+         * Slow voltage ramps (quasistatic) and sudden voltage steps (dynamic), driving forwards, backwards and
+         * turning both ways, coasting to a stop between each. Every 10 ms it records the voltage on each side, how far
+         * each side has gone by the motor encoders and the IMU heading as "Drive characterization" telemetry. Fit the
+         * log with firmware/characterizeFit.py to get the constants for setDriveFeedforward(). Blocks until done,
+         * about 30 seconds
+         *
+         * @param params struct to simulate named parameters
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::telemetrySink()->setLowestLevel(lemlib::Level::INFO);
+         * lemlib::telemetrySink()->setMode(lemlib::TelemetrySink::Mode::BINARY);
+         * chassis.characterize();
+         * // then on the laptop:
+         * // telemetryDecode.py --csv --match "Drive characterization" telemetry.bin | characterizeFit.py
+         * @endcode
+         */
+        void characterize(CharacterizeParams params = {});
         /**
          * @brief Move the chassis along a path
          *
@@ -708,6 +894,94 @@ class Chassis {
          * @endcode
          */
         void follow(const asset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+        /**
+         * @brief Move the chassis along a binary path asset
+         *
+         * Same as following the text path, but the points are read in place instead of being parsed when the motion
+         * starts, so the first control cycles aren't spent parsing
+         *
+         * @param path the binary path asset to follow
+         * @param lookahead the lookahead distance. Units in inches. Larger values will make the robot move
+         * faster but will follow the path less accurately
+         * @param timeout the maximum time the robot can spend moving
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // static/myPath.txt is also packed into myPath.path at build time
+         * ASSET(myPath_path);
+         *
+         * void autonomous() {
+         *     // follow the path in "myPath.txt" with a lookahead of 10 inches and a timeout of 4000ms
+         *     chassis.follow(lemlib::PathAsset(myPath_path), 10, 4000);
+         * }
+         * @endcode
+         */
+        void follow(const PathAsset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+        /**
+         * @brief Move the chassis along a trajectory, tracking where it should be each moment
+         *
+         * Pure pursuit steers at a point a lookahead ahead, so it cuts corners. A trajectory also says when the robot
+         * should be at each point and how fast it should be going and turning there, and the tracker corrects being
+         * off to the side, behind or ahead, and off the heading. The wheels are driven with tankVelocity() when
+         * setDriveFeedforward() has been called, and scaled off the drivetrain's free speed when not
+         *
+         * @param trajectory the trajectory to follow. Not copied, it has to outlive the motion
+         * @param timeout the maximum time the robot can spend moving
+         * @param params which tracker to use, RAMSETE or LTV, and its tuning
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * ASSET(myPath_path);
+         * lemlib::Trajectory myTrajectory;
+         *
+         * void initialize() {
+         *     // 60 in/s, 200 in/s^2, 13.5 in track width
+         *     myTrajectory = lemlib::Trajectory(lemlib::PathAsset(myPath_path), {60, 200, 13.5});
+         * }
+         *
+         * void autonomous() {
+         *     // follow it with RAMSETE
+         *     chassis.follow(myTrajectory, 5000);
+         *     // or with LTV
+         *     chassis.follow(myTrajectory, 5000, {.type = lemlib::TrajectoryTrackerType::LTV});
+         * }
+         * @endcode
+         */
+        void follow(const Trajectory& trajectory, int timeout, TrajectoryTrackerParams params = {},
+                    bool async = true);
+        /**
+         * @brief Run the motions in a queue back to back, keeping speed between them
+         *
+         * Runs as one motion, so nothing waits on the mutex between the moves. Moves steer at a point lookahead
+         * ahead along the line from the last point, so a corner cut short comes back onto the line. A move with
+         * another motion after it exits once it is within blendDistance of its point or drives past it, and slows
+         * only to the speed the corner there allows instead of stopping: full speed if the next move goes straight
+         * on, minExitSpeed if it turns right around. A turn with another motion after it exits within blendAngle.
+         * The next motion starts from the speed the robot already has, and its output fades in from the last one's
+         * over blendTime, so the handoff doesn't jerk. The last motion settles on the usual exit conditions.
+         *
+         * Motions added while it runs are picked up, as long as they are queued before it reaches the last one.
+         * cancelMotion() stops it and drops whatever is left in the queue
+         *
+         * @param queue the motions to run, taken off as they start. Not copied, it has to outlive the motion
+         * @param params how the motions blend together
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::MotionQueue queue;
+         * queue.moveToPoint(0, 24, 2000);
+         * queue.moveToPoint(24, 48, 2000);
+         * queue.turnToHeading(180, 1000);
+         * // the robot goes through (0, 24) without stopping
+         * chassis.runQueue(queue);
+         * chassis.waitUntilDone();
+         * @endcode
+         */
+        void runQueue(MotionQueue& queue, MotionQueueParams params = {}, bool async = true);
         /**
          * @brief Control the robot during the driver using the arcade drive control scheme. In this control scheme one
          * joystick axis controls the forwards and backwards movement of the robot, while the other joystick axis
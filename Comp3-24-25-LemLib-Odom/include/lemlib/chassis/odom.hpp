@@ -1,9 +1,55 @@
 #pragma once
 
+#include "pros/gps.hpp"
 #include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/poseFilter.hpp"
 #include "lemlib/pose.hpp"
 
+// LemLib's own odometry is in its prebuilt archive, which the rest of LemLib keeps calling. This one is built from
+// src/lemlib/chassis/odom.cpp and declared in an inline namespace, so it is called as lemlib::getPose() and so on
+// but none of its symbols share a name with the archive's, whatever order they are linked in.
+// Chassis::calibrateOdom() starts it and keeps the archive's pose in step with it
+
 namespace lemlib {
+inline namespace rebuilt {
+/**
+ * @brief Everything one odometry update worked out
+ */
+struct OdomState {
+        /** position in inches, heading in degrees or radians */
+        Pose pose {0, 0, 0};
+        /** field relative speed, per second */
+        Pose speed {0, 0, 0};
+        /** speed relative to the robot, per second */
+        Pose localSpeed {0, 0, 0};
+        /** when the sensors were read, in microseconds. 0 before the first update */
+        uint64_t time = 0;
+};
+
+/**
+ * @brief How far to trust the GPS against odometry, see useGps()
+ */
+struct GpsSettings {
+        /** ms from the GPS taking a reading to the brain having it */
+        float latency = 50;
+        /** inches, the least a reading is ever taken to be off by, whatever get_error() says */
+        float minError = 0.5;
+        /** inches odometry drifts by, per square root inch driven */
+        float odomNoise = 0.1;
+        /** 0 to 1, how much of the difference in heading one reading corrects */
+        float headingWeight = 0.05;
+        /**
+         * A reading whose difference from odometry, squared, is more than this many times what is expected is
+         * thrown out. 9 is 3 standard deviations
+         */
+        float gate = 9;
+        /**
+         * After this many readings in a row are thrown out it is odometry that is off, a bumped tracking wheel say,
+         * and the next one is taken whatever it says
+         */
+        uint32_t trustAfter = 5;
+};
+
 /**
  * @brief Set the sensors to be used for odometry
  *
@@ -18,6 +64,16 @@ void setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain);
  * @return Pose
  */
 Pose getPose(bool radians = false);
+/**
+ * @brief Get the pose, speeds and time from the same odometry update
+ *
+ * Published once per update, reading it never waits on the odometry task and the odometry task never waits on it.
+ * getPose(), getSpeed() and the rest each read it too, so take it once when more than one of them is needed
+ *
+ * @param radians true for theta in radians, false for degrees. False by default
+ * @return OdomState
+ */
+OdomState getOdomState(bool radians = false);
 /**
  * @brief Set the Pose of the robot
  *
@@ -42,11 +98,20 @@ Pose getLocalSpeed(bool radians = false);
 /**
  * @brief Estimate the pose of the robot after a certain amount of time
  *
+ * The time is counted from when the sensors behind getPose() were read, so the pose comes out as of now plus time
+ * even though odometry last updated up to a period ago
+ *
  * @param time time in seconds
  * @param radians False for degrees, true for radians. False by default
  * @return lemlib::Pose
  */
 Pose estimatePose(float time, bool radians = false);
+/**
+ * @brief Get when the sensors behind the current pose were read
+ *
+ * @return time in microseconds, see pros::micros(). 0 before the first update
+ */
+uint64_t getPoseTime();
 /**
  * @brief Update the pose of the robot
  *
@@ -57,4 +122,80 @@ void update();
  *
  */
 void init();
+/**
+ * @brief Set how often odometry updates. 5 ms by default
+ *
+ * Call before Chassis::calibrateOdom(). The tracking wheels and IMU are set to send readings just as often, they
+ * go no faster than every 5 ms
+ *
+ * @param ms time between updates in milliseconds
+ */
+void setUpdatePeriod(uint32_t ms);
+/**
+ * @brief Set whether odometry runs its own task. On by default
+ *
+ * Turn it off before Chassis::calibrateOdom() to call update() from somewhere else instead, like a
+ * ControlScheduler job, once every update period
+ *
+ * @param enabled true to have init() start the task that calls update()
+ */
+void setUpdateTask(bool enabled);
+/**
+ * @brief Work the pose out with an extended Kalman filter instead of dead reckoning from one sensor per axis
+ *
+ * Every tracking wheel, both sides of the drivetrain and the IMU go into each update. Readings that disagree the way
+ * a slipping or bumped wheel does are left out, see PoseFilter. Can be called at any time, the filter starts from
+ * the current pose
+ *
+ * @param settings how much to trust each sensor
+ *
+ * @b Example
+ * @code {.cpp}
+ * void initialize() {
+ *     lemlib::usePoseFilter();
+ *     chassis.calibrateOdom();
+ * }
+ * @endcode
+ */
+void usePoseFilter(PoseFilterSettings settings = {});
+/**
+ * @brief Get how many readings the pose filter has left out as slip
+ *
+ * @return 0 if the pose filter isn't being used
+ */
+uint32_t getRejectedReadings();
+/**
+ * @brief Pull odometry towards a GPS sensor as its readings come in
+ *
+ * A GPS reading is already old when it arrives, so it is compared with where odometry had the robot when the reading
+ * was taken, not with where it has the robot now. The pose then is corrected, and everything odometry measured since
+ * is replayed on top of it. How much each reading moves the pose depends on how far odometry has driven since the
+ * last one and on the GPS's own error, so a robot that has barely moved doesn't jump around with the GPS's noise.
+ * Readings that disagree with odometry by far more than they should, like one off a robot blocking the field strip,
+ * are left out, unless they keep disagreeing the same way.
+ *
+ * The GPS works in field coordinates, so odometry has to as well: set the pose with inches from the center of the
+ * field and heading clockwise from the GPS's 0. Works with and without usePoseFilter()
+ *
+ * @param gps the sensor, set up with its offset on the robot. nullptr to stop using it
+ * @param settings how much to trust it
+ *
+ * @b Example
+ * @code {.cpp}
+ * pros::Gps gps(12, 0, -4.5 * 0.0254);
+ *
+ * void initialize() {
+ *     chassis.calibrateOdom();
+ *     lemlib::useGps(&gps);
+ * }
+ * @endcode
+ */
+void useGps(pros::Gps* gps, GpsSettings settings = {});
+/**
+ * @brief Get how many GPS readings have been left out for disagreeing with odometry
+ *
+ * @return uint32_t
+ */
+uint32_t getRejectedGpsReadings();
+} // namespace rebuilt
 } // namespace lemlib
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+
+#include "lemlib/matrix.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief How much to trust each sensor the pose filter reads, as standard deviations
+ */
+struct PoseFilterSettings {
+        /** in/s, a tracking wheel's speed */
+        float trackerNoise = 0.5;
+        /** in/s, a drive side's speed from the motor encoders. Looser, the drive wheels slip */
+        float driveNoise = 4;
+        /** radians, the IMU heading */
+        float headingNoise = 0.005;
+        /** rad/s, the change in IMU heading over an update */
+        float turnRateNoise = 0.1;
+        /** in/s, how fast the robot might slide sideways when there is no horizontal tracking wheel to tell */
+        float sidewaysNoise = 3;
+        /** in/s^2, how hard the robot can speed up or slow down */
+        float acceleration = 200;
+        /** rad/s^2, how hard the robot can start or stop turning */
+        float angularAcceleration = 40;
+        /**
+         * A reading whose difference from the prediction, squared, is more than this many times what is expected is
+         * thrown out as slip. 9 is 3 standard deviations
+         */
+        float gate = 9;
+};
+
+/**
+ * @brief Extended Kalman filter for the robot's pose on the field
+ *
+ * Estimates x, y and heading along with the robot's forward, sideways and turning speeds. Each update predicts
+ * where the robot went from the speeds it had, then corrects the speeds with every wheel and the IMU, weighted by
+ * how much they are trusted. A wheel that disagrees far more than it should, because it slipped or was bumped off
+ * the ground, is left out of that update instead of bending the pose for good.
+ *
+ * Units and directions are the same as the rest of LemLib odometry: inches, heading in radians clockwise from +y,
+ * local x positive to the left. Everything is fixed size, an update allocates nothing.
+ *
+ * Readings are applied one at a time, so nothing bigger than a number needs inverting.
+ */
+class PoseFilter {
+    public:
+        /** x, y, theta, forward speed, sideways speed, turn rate */
+        static constexpr size_t STATES = 6;
+
+        /**
+         * @brief Construct a new Pose Filter, stopped at 0, 0, 0
+         *
+         * @param settings how much to trust each sensor
+         */
+        PoseFilter(PoseFilterSettings settings = {});
+
+        /**
+         * @brief Start again from a known pose, stopped
+         *
+         * @param pose theta in radians
+         */
+        void reset(Pose pose);
+
+        /**
+         * @brief Move the pose, keeping the speeds and how sure of everything it is. For corrections from outside
+         * the filter, like the GPS
+         *
+         * @param pose theta in radians
+         */
+        void setPose(Pose pose);
+
+        /**
+         * @brief Move the estimate forward in time with the speeds it has
+         *
+         * @param dt seconds since the last prediction
+         */
+        void predict(float dt);
+
+        /**
+         * @brief Correct with a wheel's speed along the robot
+         *
+         * @param speed in/s, forwards positive
+         * @param offset inches to the right of the tracking center, negative to the left
+         * @param noise in/s, its standard deviation
+         * @return false if it was thrown out
+         */
+        bool measureVertical(float speed, float offset, float noise);
+
+        /**
+         * @brief Correct with a wheel's speed across the robot
+         *
+         * @param speed in/s, left positive
+         * @param offset inches in front of the tracking center, negative behind
+         * @param noise in/s, its standard deviation
+         * @return false if it was thrown out
+         */
+        bool measureHorizontal(float speed, float offset, float noise);
+
+        /**
+         * @brief Correct with the IMU heading. Never thrown out
+         *
+         * @param theta radians, lined up with the pose
+         */
+        void measureHeading(float theta);
+
+        /**
+         * @brief Correct with how fast the IMU says the robot is turning
+         *
+         * @param rate rad/s clockwise
+         * @return false if it was thrown out
+         */
+        bool measureTurnRate(float rate);
+
+        /**
+         * @brief Correct with the robot not sliding sideways, for when there is no horizontal tracking wheel
+         */
+        void measureNoSideways();
+
+        /**
+         * @return the pose, theta in radians
+         */
+        Pose getPose() const;
+
+        /**
+         * @return sideways, forward and turning speed, in/s and rad/s
+         */
+        Pose getLocalSpeed() const;
+
+        /**
+         * @return the settings it was made with
+         */
+        const PoseFilterSettings& getSettings() const;
+
+        /**
+         * @return how many readings have been thrown out
+         */
+        uint32_t getRejected() const;
+    private:
+        bool measure(size_t stateIndex, float turnRateWeight, float reading, float variance, bool gated);
+
+        PoseFilterSettings settings;
+        Vector<STATES> state;
+        Matrix<STATES, STATES> covariance;
+        uint32_t rejected = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief The last few hundred milliseconds of odometry poses, and when each was measured
+ *
+ * A sensor that reports late, like the GPS, describes where the robot was when it took its reading, not where it is
+ * now. The history says where odometry had the robot at that time, so the two can be compared, and once the old pose
+ * is corrected every pose since is moved along with it.
+ *
+ * Units are the same as the rest of LemLib odometry: inches, heading in radians clockwise from +y. Fixed size, the
+ * oldest pose is dropped to make room.
+ */
+class PoseHistory {
+    public:
+        /** poses kept, 640 ms of 5 ms updates */
+        static constexpr size_t CAPACITY = 128;
+
+        /**
+         * @brief Add a pose, newer than every pose already in it
+         *
+         * @param time when the sensors behind it were read, in microseconds
+         * @param pose theta in radians
+         */
+        void push(uint64_t time, Pose pose);
+
+        /**
+         * @brief Forget every pose
+         */
+        void clear();
+
+        /**
+         * @brief Find where odometry had the robot at a time, between the two poses either side of it
+         *
+         * @param time in microseconds
+         * @param pose set to the pose at that time, or the newest pose if the time is newer than all of them
+         * @return false if it is empty or the time is older than every pose kept
+         */
+        bool at(uint64_t time, Pose& pose) const;
+
+        /**
+         * @brief Correct the pose at a time and move every later pose the same way
+         *
+         * Each later pose keeps where it is relative to the one corrected, so the path since then is turned and slid
+         * to start from the correction. The pose at the time is added to the history if it isn't in it
+         *
+         * @param time in microseconds, a time at() found a pose for
+         * @param corrected the pose the robot actually had then
+         * @return the newest pose, corrected
+         */
+        Pose correct(uint64_t time, Pose corrected);
+    private:
+        struct Entry {
+                uint64_t time = 0;
+                Pose pose {0, 0, 0};
+        };
+
+        // the index count entries after the oldest
+        size_t index(size_t count) const { return (oldest + count) % CAPACITY; }
+
+        std::array<Entry, CAPACITY> entries;
+        size_t oldest = 0;
+        size_t size = 0;
+};
+} // namespace lemlib
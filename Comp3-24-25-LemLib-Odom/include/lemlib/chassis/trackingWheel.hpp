@@ -184,6 +184,23 @@ class TrackingWheel {
          * @endcode
          */
         int getType();
+        /**
+         * @brief Set how often a rotation sensor sends its position to the brain
+         *
+         * Does nothing for encoders and motor groups. If you are using odometry provided by LemLib, this is called with
+         * the odometry period when it starts, see setUpdatePeriod()
+         *
+         * @param rate in ms, rounded down to a multiple of 5 ms, the fastest the sensor goes
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     // the sensor sends a new position every 5 ms instead of every 10 ms
+         *     exampleTrackingWheel.setDataRate(5);
+         * }
+         * @endcode
+         */
+        void setDataRate(uint32_t rate);
     private:
         float diameter;
         float distance;
@@ -0,0 +1,64 @@
+#pragma once
+
+namespace lemlib {
+/**
+ * @brief Motor voltage for a speed and an acceleration, kS sgn(v) + kV v + kA a
+ *
+ * kS is what it takes to get moving against friction, kV what it takes to hold each unit of speed against the
+ * motors' back EMF, and kA what it takes to speed the robot up. Unlike a PID gain they are properties of the robot,
+ * so the same constants hold at any speed. Measure them with Chassis::characterize() and firmware/characterizeFit.py
+ */
+struct Feedforward {
+        /** volts */
+        float kS = 0;
+        /** volts per unit per second */
+        float kV = 0;
+        /** volts per unit per second squared */
+        float kA = 0;
+
+        /**
+         * @param velocity units per second
+         * @param acceleration units per second squared
+         * @return volts. Stopped and not speeding up is 0
+         */
+        float calculate(float velocity, float acceleration = 0) const;
+};
+
+/**
+ * @brief The feedforward of a differential drive
+ */
+struct DriveFeedforward {
+        /** left side, inches per second of the left wheels */
+        Feedforward left;
+        /** right side, inches per second of the right wheels */
+        Feedforward right;
+        /** turning in place, degrees per second of the robot. Volts on each side, opposite ways */
+        Feedforward angular;
+        /** volts per in/s a side is behind or ahead of its target speed, for Chassis::tankVelocity() */
+        float kP = 0;
+};
+
+/**
+ * @brief Set the drive's feedforward, usually what firmware/characterizeFit.py printed
+ *
+ * Chassis::tankVelocity() needs it, and the profiled motions use it in place of their estimate from the
+ * drivetrain's free speed. Call before any motion, in initialize()
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::setDriveFeedforward({.left = {0.9, 0.17, 0.03}, .right = {0.9, 0.17, 0.03}, .angular = {1.1, 0.02, 0.002},
+ *                              .kP = 0.05});
+ * @endcode
+ */
+void setDriveFeedforward(const DriveFeedforward& feedforward);
+
+/**
+ * @return the feedforward from setDriveFeedforward(). All 0 until it is called
+ */
+const DriveFeedforward& getDriveFeedforward();
+
+/**
+ * @return whether setDriveFeedforward() was given a drive feedforward
+ */
+bool hasDriveFeedforward();
+} // namespace lemlib
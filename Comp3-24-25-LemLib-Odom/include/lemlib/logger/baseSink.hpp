@@ -9,7 +9,34 @@
 
 #include "lemlib/logger/message.hpp"
 
+#ifndef LEMLIB_LOG_LEVEL
+#define LEMLIB_LOG_LEVEL INFO
+#endif
+
 namespace lemlib {
+inline namespace rebuilt {
+/**
+ * @brief The lowest level that is compiled in
+ *
+ * Messages below it compile to nothing, whatever the sink's lowest level is. Set it with -DLEMLIB_LOG_LEVEL=WARN,
+ * the project Makefile does this from LOG_LEVEL. The arguments of a call are still worked out before the call, so on
+ * a hot path check logCompiled() first if working them out costs anything. Getting a sink, like infoSink(), copies a
+ * shared_ptr, so a loop should get it once before it starts.
+ */
+constexpr Level COMPILED_LEVEL = Level::LEMLIB_LOG_LEVEL;
+
+/**
+ * @brief Whether messages at the given level are compiled in
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * if constexpr (lemlib::logCompiled(lemlib::Level::DEBUG)) {
+ *     lemlib::infoSink()->debug("motor temperatures: {}", motors.get_temperature_all());
+ * }
+ * @endcode
+ */
+constexpr bool logCompiled(Level level) { return level >= COMPILED_LEVEL; }
+
 /**
  * @brief A base for any sink in LemLib to implement.
  *
@@ -55,6 +82,9 @@ class BaseSink {
          * If this is a combined sink, this operation will
          * apply for all the parent sinks.
          *
+         * debug(), info() and the rest drop messages below COMPILED_LEVEL at compile time. Here that takes the level
+         * being a constant the compiler can see.
+         *
          * @tparam T
          * @param level The level at which to send the message.
          * @param format The format that the message will use. Use "{}" as placeholders.
@@ -67,8 +97,12 @@ class BaseSink {
 
          */
         template <typename... T> void log(Level level, fmt::format_string<T...> format, T&&... args) {
+            if (!logCompiled(level)) { return; }
+
             if (!sinks.empty()) {
-                for (std::shared_ptr<BaseSink> sink : sinks) { sink->log(level, format, std::forward<T>(args)...); }
+                for (const std::shared_ptr<BaseSink>& sink : sinks) {
+                    sink->log(level, format, std::forward<T>(args)...);
+                }
                 return;
             }
 
@@ -100,7 +134,7 @@ class BaseSink {
          * @param args
          */
         template <typename... T> void debug(fmt::format_string<T...> format, T&&... args) {
-            log(Level::DEBUG, format, std::forward<T>(args)...);
+            if constexpr (logCompiled(Level::DEBUG)) { log(Level::DEBUG, format, std::forward<T>(args)...); }
         }
 
         /**
@@ -112,7 +146,7 @@ class BaseSink {
          * @param args
          */
         template <typename... T> void info(fmt::format_string<T...> format, T&&... args) {
-            log(Level::INFO, format, std::forward<T>(args)...);
+            if constexpr (logCompiled(Level::INFO)) { log(Level::INFO, format, std::forward<T>(args)...); }
         }
 
         /**
@@ -124,7 +158,7 @@ class BaseSink {
          * @param args
          */
         template <typename... T> void warn(fmt::format_string<T...> format, T&&... args) {
-            log(Level::WARN, format, std::forward<T>(args)...);
+            if constexpr (logCompiled(Level::WARN)) { log(Level::WARN, format, std::forward<T>(args)...); }
         }
 
         /**
@@ -136,7 +170,7 @@ class BaseSink {
          * @param args
          */
         template <typename... T> void error(fmt::format_string<T...> format, T&&... args) {
-            log(Level::ERROR, format, std::forward<T>(args)...);
+            if constexpr (logCompiled(Level::ERROR)) { log(Level::ERROR, format, std::forward<T>(args)...); }
         }
 
         /**
@@ -148,9 +182,14 @@ class BaseSink {
          * @param args
          */
         template <typename... T> void fatal(fmt::format_string<T...> format, T&&... args) {
-            log(Level::FATAL, format, std::forward<T>(args)...);
+            if constexpr (logCompiled(Level::FATAL)) { log(Level::FATAL, format, std::forward<T>(args)...); }
         }
     protected:
+        /**
+         * @brief Get the lowest level this sink sends. Not meaningful for a combined sink
+         */
+        Level getLowestLevel() const;
+
         /**
          * @brief Log the given message
          *
@@ -206,4 +245,5 @@ class BaseSink {
 
         std::vector<std::shared_ptr<BaseSink>> sinks {};
 };
+} // namespace rebuilt
 } // namespace lemlib
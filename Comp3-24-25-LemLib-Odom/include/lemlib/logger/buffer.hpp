@@ -1,25 +1,42 @@
 #pragma once
 
-#include <deque>
+#include <atomic>
 #include <functional>
 #include <string>
+#include <string_view>
 
 #include "pros/rtos.hpp"
+#include "lemlib/logger/recordRing.hpp"
 
 namespace lemlib {
+inline namespace rebuilt {
+/**
+ * @brief What a full buffer does with a new string
+ */
+enum class OverflowPolicy {
+    DROP, /** drop the new string and count it. Pushing never waits */
+    WAIT /** wait for the buffer's task to make room. Never use this from a control loop */
+};
+
 /**
  * @brief A buffer implementation
  *
- * Asynchronously processes a backlog of strings at a given rate. The strings are processed in a first in last out
- * order.
+ * Asynchronously processes a backlog of strings at a given rate. The strings are processed in the order they were
+ * pushed.
+ *
+ * The backlog is a RecordRing allocated up front, so pushing a string never allocates or takes a lock, and a task
+ * logging can't be held up by the buffer's own task or the odometry task logging at the same time. If the buffer
+ * fills up new strings are dropped and counted, see setOverflowPolicy().
  */
 class Buffer {
     public:
         /**
          * @brief Construct a new Buffer object
          *
+         * @param bufferFunc applied to each string as it is taken out of the buffer, on the buffer's task
+         * @param capacity bytes of backlog, see RecordRing
          */
-        Buffer(std::function<void(const std::string&)> bufferFunc);
+        Buffer(std::function<void(std::string_view)> bufferFunc, size_t capacity = 8192);
 
         /**
          * @brief Destroy the Buffer object
@@ -34,8 +51,18 @@ class Buffer {
          * @brief Push to the buffer
          *
          * @param bufferData
+         * @return false if it was dropped
+         */
+        bool pushToBuffer(const std::string& bufferData);
+
+        /**
+         * @brief Push to the buffer. Strings longer than RecordRing::MAX_RECORD are cut short
+         *
+         * @param data
+         * @param size
+         * @return false if it was dropped
          */
-        void pushToBuffer(const std::string& bufferData);
+        bool pushToBuffer(const char* data, size_t size);
 
         /**
          * @brief Set the rate of the sink
@@ -44,11 +71,33 @@ class Buffer {
          */
         void setRate(uint32_t rate);
 
+        /**
+         * @brief Set what happens to strings pushed while the buffer is full. DROP by default
+         *
+         * @param policy
+         */
+        void setOverflowPolicy(OverflowPolicy policy);
+
         /**
          * @brief Check to see if the internal buffer is empty
          *
          */
         bool buffersEmpty();
+
+        /**
+         * @return strings dropped because the buffer was full
+         */
+        uint32_t getDropped() const;
+
+        /**
+         * @return strings cut short because they were longer than RecordRing::MAX_RECORD
+         */
+        uint32_t getTruncated() const;
+
+        /**
+         * @return the most bytes that have been waiting at once, to size the buffer
+         */
+        size_t getHighWater() const;
     private:
         /**
          * @brief The function that will be run inside of the buffer's task.
@@ -60,13 +109,17 @@ class Buffer {
          * @brief The function that will be applied to each string in the buffer when it is removed.
          *
          */
-        std::function<void(std::string)> bufferFunc;
+        std::function<void(std::string_view)> bufferFunc;
 
-        std::deque<std::string> buffer = {};
+        RecordRing ring;
 
-        pros::Mutex mutex;
-        pros::Task task;
+        std::atomic<OverflowPolicy> policy = OverflowPolicy::DROP;
+        std::atomic<uint32_t> dropped = 0;
+        std::atomic<uint32_t> truncated = 0;
+        std::atomic<uint32_t> rate = 50;
 
-        uint32_t rate;
+        // last, so everything the task uses exists before it starts
+        pros::Task task;
 };
+} // namespace rebuilt
 } // namespace lemlib
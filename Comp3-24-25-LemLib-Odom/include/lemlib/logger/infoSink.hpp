@@ -4,6 +4,7 @@
 #include "lemlib/logger/baseSink.hpp"
 
 namespace lemlib {
+inline namespace rebuilt {
 /**
  * @brief Sink for sending messages to the terminal.
  *
@@ -33,4 +34,5 @@ class InfoSink : public BaseSink {
          */
         void sendMessage(const Message& message) override;
 };
+} // namespace rebuilt
 } // namespace lemlib
@@ -10,7 +10,12 @@
 #include "lemlib/logger/infoSink.hpp"
 #include "lemlib/logger/telemetrySink.hpp"
 
+// LemLib's own logger is in its prebuilt archive, which the rest of LemLib keeps calling. This one is built from
+// src/lemlib/logger/ and declared in an inline namespace like odom.hpp, so it is used as lemlib::infoSink() and so on
+// but none of its symbols share a name with the archive's, and its Buffer can be laid out differently
+
 namespace lemlib {
+inline namespace rebuilt {
 
 /**
  * @brief Get the info sink.
@@ -23,4 +28,5 @@ std::shared_ptr<InfoSink> infoSink();
  * @return std::shared_ptr<TelemetrySink>
  */
 std::shared_ptr<TelemetrySink> telemetrySink();
+} // namespace rebuilt
 } // namespace lemlib
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 namespace lemlib {
+inline namespace rebuilt {
 /**
  * @brief Level of the message
  *
@@ -32,4 +33,5 @@ struct Message {
  * @return std::string
  */
 std::string format_as(Level level);
+} // namespace rebuilt
 } // namespace lemlib
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace lemlib {
+inline namespace rebuilt {
+/**
+ * @brief A fixed size queue of byte records that never locks
+ *
+ * All of its memory is allocated when it is made, pushing a record only copies it in. Any number of tasks can push
+ * and one task pops, and records come out in the order they claimed their space.
+ *
+ * A push claims space with a single compare and swap, copies the record in and then marks it written. The reader
+ * stops at the first record that isn't marked yet, so a task preempted in the middle of a push holds up the records
+ * behind its own until it runs again, but never the tasks pushing them.
+ */
+class RecordRing {
+    public:
+        /** the most bytes one record can hold */
+        static constexpr size_t MAX_RECORD = 1020;
+
+        /**
+         * @brief Construct a new Record Ring
+         *
+         * @param capacity bytes of storage, rounded up to a power of two. A record takes its size rounded up to a
+         * multiple of 4, plus 4
+         */
+        RecordRing(size_t capacity);
+
+        RecordRing(const RecordRing&) = delete;
+        RecordRing& operator=(const RecordRing&) = delete;
+
+        /**
+         * @brief Copy a record in. Safe from any task
+         *
+         * @return false if there wasn't room or it is bigger than MAX_RECORD, nothing is copied
+         */
+        bool push(const void* data, size_t size);
+
+        /**
+         * @brief Copy the oldest record out. Only one task may pop
+         *
+         * @param out at least MAX_RECORD bytes
+         * @return the size of the record, -1 if there is no record ready
+         */
+        int pop(void* out);
+
+        /**
+         * @return whether every pushed record has been popped
+         */
+        bool empty() const;
+
+        /**
+         * @return bytes of storage
+         */
+        size_t capacity() const;
+
+        /**
+         * @return the most bytes that have been waiting to be popped at once
+         */
+        size_t getHighWater() const;
+    private:
+        static constexpr uint32_t WRITTEN = 0x80000000;
+
+        uint8_t* bytes() const;
+        void copyIn(uint32_t position, const void* data, size_t size);
+        void copyOut(uint32_t position, void* out, size_t size) const;
+        void clear(uint32_t position, size_t size);
+
+        const uint32_t size;
+        std::unique_ptr<uint32_t[]> words;
+
+        // bytes ever claimed and ever popped. They wrap, only their difference matters
+        std::atomic<uint32_t> head = 0;
+        std::atomic<uint32_t> tail = 0;
+        std::atomic<uint32_t> highWater = 0;
+};
+} // namespace rebuilt
+} // namespace lemlib
@@ -6,6 +6,7 @@
 #include "lemlib/logger/buffer.hpp"
 
 namespace lemlib {
+inline namespace rebuilt {
 /**
  * @brief Buffered printing to Stout.
  *
@@ -20,9 +21,13 @@ class BufferedStdout : public Buffer {
         /**
          * @brief Print a string (thread-safe).
          *
+         * Formatted on the stack, so printing doesn't allocate.
          */
         template <typename... T> void print(fmt::format_string<T...> format, T&&... args) {
-            pushToBuffer(fmt::format(format, std::forward<T>(args)...));
+            char text[RecordRing::MAX_RECORD];
+            const auto result = fmt::format_to_n(text, sizeof(text), format, std::forward<T>(args)...);
+            // a longer string is cut short, pushToBuffer() counts it
+            pushToBuffer(text, result.size);
         }
 };
 
@@ -31,4 +36,5 @@ class BufferedStdout : public Buffer {
  *
  */
 BufferedStdout& bufferedStdout();
+} // namespace rebuilt
 } // namespace lemlib
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "lemlib/logger/message.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+/**
+ * @brief A format string as a template parameter, so its id is worked out at compile time
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * lemlib::telemetrySink()->record<lemlib::Level::INFO, "left: {}, right: {}">(left, right);
+ * @endcode
+ */
+template <size_t N> struct FormatLiteral {
+        consteval FormatLiteral(const char (&text)[N]) { std::copy_n(text, N, this->text); }
+
+        constexpr std::string_view view() const { return {text, N - 1}; }
+
+        char text[N] {};
+};
+
+/**
+ * @brief Layout of the binary telemetry stream
+ *
+ * Each record is one of
+ * - FORMAT: kind, uint32 id, the argument codes, '\0', the format string. Sent the first time a call site logs
+ * - MESSAGE: kind, uint32 id, uint32 time in ms, uint8 level, the arguments
+ *
+ * Arguments are copied as they are in memory, little endian like the brain. Each has a one character code, the same
+ * as Python's struct module where there is one:
+ * - ? bool, c char, b/B h/H i/I q/Q signed/unsigned 8/16/32/64 bit integers, f float, d double
+ * - L Level, uint8
+ * - P Pose, three floats
+ * - s string, uint8 length then the characters
+ *
+ * firmware/telemetryDecode.py reads it back and does the formatting.
+ */
+namespace telemetry {
+enum class RecordKind : uint8_t { FORMAT, MESSAGE };
+
+/** largest record, longer strings are cut short */
+constexpr size_t MAX_RECORD = 256;
+constexpr size_t MESSAGE_HEADER = 1 + 4 + 4 + 1;
+
+template <typename T> constexpr char argCode() {
+    if constexpr (std::is_same_v<T, bool>) return '?';
+    else if constexpr (std::is_same_v<T, char>) return 'c';
+    else if constexpr (std::is_same_v<T, Level>) return 'L';
+    else if constexpr (std::is_enum_v<T>) return argCode<std::underlying_type_t<T>>();
+    else if constexpr (std::is_integral_v<T>) {
+        constexpr std::string_view codes = std::is_signed_v<T> ? "bhiq" : "BHIQ";
+        return codes[sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3];
+    } else if constexpr (std::is_same_v<T, float>) return 'f';
+    else if constexpr (std::is_same_v<T, double>) return 'd';
+    else if constexpr (std::is_same_v<T, Pose>) return 'P';
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) return 's';
+    else static_assert(!sizeof(T), "this type can't be sent as binary telemetry");
+}
+
+/**
+ * @brief Bytes an argument takes, not counting a string's characters
+ */
+template <typename T> constexpr size_t argSize() {
+    constexpr char code = argCode<T>();
+    if constexpr (code == 's') return 1;
+    else if constexpr (code == 'P') return 3 * sizeof(float);
+    else if constexpr (code == 'L') return 1;
+    else return sizeof(T);
+}
+
+template <typename... T> constexpr std::array<char, sizeof...(T) + 1> signature = {argCode<T>()..., '\0'};
+
+/**
+ * @brief FNV-1a of the format and the argument codes, so the same format logged with different types is told apart
+ */
+constexpr uint32_t formatId(std::string_view format, std::string_view codes) {
+    uint32_t hash = 2166136261u;
+    for (std::string_view part : {codes, std::string_view("\0", 1), format}) {
+        for (char c : part) hash = (hash ^ uint8_t(c)) * 16777619u;
+    }
+    return hash;
+}
+
+inline void write(char*& out, const void* data, size_t size) {
+    std::memcpy(out, data, size);
+    out += size;
+}
+
+/**
+ * @brief Copy one argument to out, leaving out past it. Strings are cut short at end
+ */
+template <typename T> void writeArg(char*& out, const char* end, const T& value) {
+    constexpr char code = argCode<T>();
+    if constexpr (code == 's') {
+        const std::string_view text(value);
+        const ptrdiff_t room = std::max<ptrdiff_t>(end - out - 1, 0);
+        const uint8_t size = std::min<size_t>({text.size(), 255, size_t(room)});
+        write(out, &size, 1);
+        write(out, text.data(), size);
+    } else if constexpr (code == 'P') {
+        const float xyTheta[3] = {value.x, value.y, value.theta};
+        write(out, xyTheta, sizeof(xyTheta));
+    } else if constexpr (code == 'L') {
+        const uint8_t level = uint8_t(value);
+        write(out, &level, 1);
+    } else {
+        write(out, &value, sizeof(T));
+    }
+}
+/**
+ * @brief Copy every argument to out, leaving out past them. Each string is cut short so the arguments after it
+ * still fit before end
+ */
+template <typename T, typename... Rest> void writeArgs(char*& out, const char* end, const T& value,
+                                                       const Rest&... rest) {
+    writeArg(out, end - (argSize<Rest>() + ... + 0), value);
+    if constexpr (sizeof...(Rest) > 0) writeArgs(out, end, rest...);
+}
+
+inline void writeArgs(char*&, const char*) {}
+} // namespace telemetry
+} // namespace rebuilt
+} // namespace lemlib
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <cstdio>
+
 #include "lemlib/logger/baseSink.hpp"
+#include "lemlib/logger/buffer.hpp"
+#include "lemlib/logger/telemetryRecord.hpp"
 
 namespace lemlib {
+inline namespace rebuilt {
 /**
  * @brief Sink for sending telemetry data.
  *
@@ -16,19 +22,139 @@ namespace lemlib {
  * lemlib::telemetrySink()->setLowestLevel(lemlib::Level::INFO);
  * lemlib::telemetrySink()->info("{},{}", motor1.get_temperature(), motor2.get_temperature());
  * @endcode
+ *
+ * Telemetry logged many times a second should go through record() instead. In BINARY mode it only copies an id for
+ * the format and the raw arguments, and formatting is left to firmware/telemetryDecode.py on a computer.
  */
 class TelemetrySink : public BaseSink {
     public:
+        /**
+         * @brief How record() sends messages
+         */
+        enum class Mode {
+            TEXT, /** formatted like any other message */
+            BINARY /** format id and raw arguments, see telemetry::RecordKind */
+        };
+
+        /** where BINARY records go when there is an SD card and setFile() wasn't called */
+        static constexpr const char* DEFAULT_FILE = "/usd/telemetry.bin";
+
         /**
          * @brief Construct a new Telemetry Sink object
          */
         TelemetrySink();
+
+        /**
+         * @brief Destroy the Telemetry Sink object, closing the file
+         */
+        ~TelemetrySink();
+
+        /**
+         * @brief Set how record() sends messages. TEXT by default
+         *
+         * @param mode
+         */
+        void setMode(Mode mode);
+
+        /**
+         * @brief Send BINARY records to a file instead of DEFAULT_FILE
+         *
+         * Each record is written as a uint16 length and then the record. With no file (nullptr, or it can't be
+         * opened) records are printed to the terminal in hex between BTEL_START and BTEL_END, hidden like every other
+         * telemetry message. The file is appended to, so earlier runs are kept.
+         *
+         * @param path the file, or nullptr to close it and use the terminal
+         */
+        void setFile(const char* path);
+
+        /**
+         * @return BINARY records dropped because the buffer was full
+         */
+        uint32_t getDropped() const;
+
+        /**
+         * @brief Log a message with a format known at compile time
+         *
+         * In TEXT mode this is the same as log(). In BINARY mode nothing is formatted or allocated: the format's id,
+         * the time, the level and the arguments are copied into a record and the call returns. The format itself is
+         * sent once, the first time each call site logs to a file.
+         *
+         * Arguments can be numbers, bools, chars, enums, strings and Poses, see telemetry::argCode().
+         *
+         * <h3> Example Usage </h3>
+         * @code
+         * lemlib::telemetrySink()->setMode(lemlib::TelemetrySink::Mode::BINARY);
+         * lemlib::telemetrySink()->record<lemlib::Level::INFO, "Chassis pose: {}">(chassis.getPose());
+         * @endcode
+         *
+         * @tparam level compiled out below COMPILED_LEVEL
+         * @tparam Format
+         * @tparam T
+         * @param args
+         */
+        template <Level level, FormatLiteral Format, typename... T> void record(const T&... args) {
+            if constexpr (logCompiled(level)) {
+                if (level < getLowestLevel()) { return; }
+                if (mode.load(std::memory_order_relaxed) == Mode::TEXT) {
+                    log<const T&...>(level, Format.view(), args...);
+                    return;
+                }
+
+                static constexpr std::array codes = telemetry::signature<T...>;
+                static constexpr uint32_t id = telemetry::formatId(Format.view(), codes.data());
+                static constexpr size_t fixedSize = telemetry::MESSAGE_HEADER + (telemetry::argSize<T>() + ... + 0);
+                static_assert(fixedSize <= telemetry::MAX_RECORD, "too many arguments for one telemetry record");
+
+                // the format goes into each file once, first time round for this call site
+                static std::atomic<uint32_t> described = 0;
+                const uint32_t current = generation.load(std::memory_order_relaxed);
+                if (described.load(std::memory_order_relaxed) != current &&
+                    describe(id, codes.data(), Format.view())) {
+                    described.store(current, std::memory_order_relaxed);
+                }
+
+                char data[telemetry::MAX_RECORD];
+                char* out = data;
+                const uint8_t kind = uint8_t(telemetry::RecordKind::MESSAGE);
+                const uint32_t time = pros::millis();
+                const uint8_t levelByte = uint8_t(level);
+                telemetry::write(out, &kind, 1);
+                telemetry::write(out, &id, sizeof(id));
+                telemetry::write(out, &time, sizeof(time));
+                telemetry::write(out, &levelByte, 1);
+                telemetry::writeArgs(out, data + sizeof(data), args...);
+                binary.pushToBuffer(data, out - data);
+            }
+        }
     private:
+        /**
+         * @brief Send the FORMAT record for a call site
+         *
+         * @return false if it was dropped
+         */
+        bool describe(uint32_t id, std::string_view codes, std::string_view format);
+
+        /**
+         * @brief Write one BINARY record out, on the buffer's task
+         */
+        void sendRecord(std::string_view record);
+
         /**
          * @brief Log the given message
          *
          * @param message
          */
         void sendMessage(const Message& message) override;
+
+        std::atomic<Mode> mode = Mode::TEXT;
+        // bumped by setFile(), so every call site sends its format to the new file
+        std::atomic<uint32_t> generation = 1;
+
+        pros::Mutex fileMutex;
+        FILE* file = nullptr;
+        bool fileChosen = false;
+
+        Buffer binary;
 };
+} // namespace rebuilt
 } // namespace lemlib
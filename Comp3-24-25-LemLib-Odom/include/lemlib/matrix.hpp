@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace lemlib {
+/**
+ * @brief A fixed size matrix of floats
+ *
+ * The size is part of the type, so everything lives on the stack or inside the object holding it and nothing is ever
+ * allocated. Sizes that don't fit together don't compile.
+ *
+ * @tparam R rows
+ * @tparam C columns
+ */
+template <size_t R, size_t C> class Matrix {
+    public:
+        /**
+         * @brief Construct a matrix of zeros
+         */
+        constexpr Matrix() = default;
+
+        /**
+         * @brief Construct a matrix with 1 down the diagonal and 0 everywhere else
+         */
+        static constexpr Matrix identity() {
+            Matrix result;
+            for (size_t i = 0; i < R && i < C; i++) result(i, i) = 1;
+            return result;
+        }
+
+        constexpr float& operator()(size_t row, size_t col) { return values[row * C + col]; }
+
+        constexpr float operator()(size_t row, size_t col) const { return values[row * C + col]; }
+
+        constexpr Matrix operator+(const Matrix& other) const {
+            Matrix result;
+            for (size_t i = 0; i < R * C; i++) result.values[i] = values[i] + other.values[i];
+            return result;
+        }
+
+        constexpr Matrix operator-(const Matrix& other) const {
+            Matrix result;
+            for (size_t i = 0; i < R * C; i++) result.values[i] = values[i] - other.values[i];
+            return result;
+        }
+
+        constexpr Matrix operator*(float scale) const {
+            Matrix result;
+            for (size_t i = 0; i < R * C; i++) result.values[i] = values[i] * scale;
+            return result;
+        }
+
+        template <size_t N> constexpr Matrix<R, N> operator*(const Matrix<C, N>& other) const {
+            Matrix<R, N> result;
+            for (size_t row = 0; row < R; row++) {
+                for (size_t k = 0; k < C; k++) {
+                    const float value = (*this)(row, k);
+                    if (value == 0) continue; // the filter's matrices are mostly zeros
+                    for (size_t col = 0; col < N; col++) result(row, col) += value * other(k, col);
+                }
+            }
+            return result;
+        }
+
+        constexpr Matrix<C, R> transpose() const {
+            Matrix<C, R> result;
+            for (size_t row = 0; row < R; row++) {
+                for (size_t col = 0; col < C; col++) result(col, row) = (*this)(row, col);
+            }
+            return result;
+        }
+    private:
+        std::array<float, R * C> values {};
+};
+
+/** a column vector */
+template <size_t N> using Vector = Matrix<N, 1>;
+} // namespace lemlib
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace lemlib {
+/**
+ * @brief How hard a motion profile may drive, in the units of the distance it covers
+ */
+struct ProfileLimits {
+        /** per second */
+        float velocity;
+        /** per second squared */
+        float acceleration;
+        /** per second cubed. 0 for no limit, which makes the profile a trapezoid */
+        float jerk = 0;
+};
+
+/**
+ * @brief Where a motion profile is at one moment
+ */
+struct ProfileState {
+        float position;
+        float velocity;
+        float acceleration;
+};
+
+/**
+ * @brief The quickest way over a distance that keeps to limits on speed, acceleration and jerk
+ *
+ * Speeds up as hard as it may, cruises, then slows down as hard as it may so it arrives at the end speed exactly at
+ * the end. With a jerk limit the acceleration ramps up and down instead of switching on and off, an S-curve, which is
+ * kinder to the drive and keeps the wheels from breaking loose. When the distance is too short to reach the top speed
+ * it peaks at whatever speed it can.
+ *
+ * Planned once up front, then sampled every control cycle. Made of at most 7 pieces of constant jerk, so sampling is
+ * a handful of multiplies, and nothing is allocated.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::MotionProfile profile(24, {60, 150, 1500});
+ * // every control cycle
+ * const lemlib::ProfileState target = profile.sample(elapsedSeconds);
+ * @endcode
+ */
+class MotionProfile {
+    public:
+        /**
+         * @param distance how far to go, positive. Negative is taken as its size
+         * @param limits how hard it may drive
+         * @param startVelocity speed it starts at, at most limits.velocity. If it is too fast to stop in the distance
+         * the profile slows down as hard as it may and goes past the end
+         * @param endVelocity speed it should arrive at. Lowered if there isn't room to reach it
+         */
+        MotionProfile(float distance, ProfileLimits limits, float startVelocity = 0, float endVelocity = 0);
+
+        /**
+         * @param time seconds since the start. Before 0 is the start, after getDuration() is the end
+         * @return where the profile is then
+         */
+        ProfileState sample(float time) const;
+
+        /**
+         * @return seconds from start to end
+         */
+        float getDuration() const;
+
+        /**
+         * @return how far it goes
+         */
+        float getDistance() const;
+
+        /**
+         * @return the speed it arrives at
+         */
+        float getEndVelocity() const;
+    private:
+        struct Piece {
+                float duration;
+                float jerk;
+                // where the piece starts
+                float position;
+                float velocity;
+                float acceleration;
+
+                ProfileState at(float time) const;
+        };
+
+        void addPiece(float duration, float jerk, float acceleration);
+        void addChange(float from, float to);
+
+        ProfileLimits limits;
+        float distance;
+        float startVelocity;
+        float endVelocity;
+        std::array<Piece, 7> pieces {};
+        size_t count = 0;
+        float duration = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "lemlib/chassis/chassis.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief The kind of a queued motion
+ */
+enum class QueuedMotionType {
+    POINT,
+    HEADING
+};
+
+/**
+ * @brief A motion waiting in a MotionQueue
+ */
+struct QueuedMotion {
+        QueuedMotionType type;
+        /** the point to drive to, for POINT */
+        float x;
+        float y;
+        /** the heading to turn to in degrees, for HEADING */
+        float theta;
+        /** longest time the motion can take, in ms */
+        int timeout;
+        /** whether to drive to the point forwards, for POINT */
+        bool forwards;
+        /** Value between 0-127 */
+        float maxSpeed;
+        /** which way to turn, for HEADING */
+        AngularDirection direction;
+};
+
+/**
+ * @brief Motions for Chassis::runQueue() to run back to back
+ *
+ * Chained with moveToPoint() and turnToHeading(), each motion waits for the one before it to end, and the one before
+ * it slows to a stop first unless it is given a minSpeed. The queue hands over from one motion to the next while the
+ * robot is still moving, so speed is kept through the points in between.
+ *
+ * Holds up to CAPACITY motions in a ring with no allocation. Motions can be added while the queue runs, from any task.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::MotionQueue queue;
+ *
+ * void autonomous() {
+ *     queue.moveToPoint(0, 24, 2000);
+ *     queue.moveToPoint(24, 48, 2000);
+ *     queue.turnToHeading(180, 1000);
+ *     chassis.runQueue(queue);
+ * }
+ * @endcode
+ */
+class MotionQueue {
+    public:
+        static constexpr int CAPACITY = 16;
+
+        /**
+         * @brief Add a move to a point, like Chassis::moveToPoint()
+         *
+         * @param x x location
+         * @param y y location
+         * @param timeout longest time the robot can spend moving
+         * @param params forwards and maxSpeed are used. minSpeed and earlyExitRange are left to the queue
+         *
+         * @return false if the queue is full
+         */
+        bool moveToPoint(float x, float y, int timeout, MoveToPointParams params = {});
+        /**
+         * @brief Add a turn to a heading, like Chassis::turnToHeading()
+         *
+         * @param theta heading location
+         * @param timeout longest time the robot can spend moving
+         * @param params direction and maxSpeed are used. minSpeed and earlyExitRange are left to the queue
+         *
+         * @return false if the queue is full
+         */
+        bool turnToHeading(float theta, int timeout, TurnToHeadingParams params = {});
+        /**
+         * @return the next motion, taking it off the queue, or nothing if it is empty
+         */
+        std::optional<QueuedMotion> pop();
+        /**
+         * @return the next motion, leaving it on the queue, or nothing if it is empty
+         */
+        std::optional<QueuedMotion> peek();
+        /**
+         * @return how many motions are waiting
+         */
+        int size();
+        /**
+         * @brief Drop every motion waiting
+         */
+        void clear();
+    private:
+        bool push(const QueuedMotion& motion);
+
+        std::array<QueuedMotion, CAPACITY> motions {};
+        int first = 0;
+        int count = 0;
+        pros::Mutex mutex;
+};
+} // namespace lemlib
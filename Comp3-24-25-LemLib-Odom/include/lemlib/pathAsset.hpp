@@ -0,0 +1,119 @@
+#pragma once
+
+#include "lemlib/asset.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief A point on a binary path asset
+ */
+struct PathPoint {
+        float x;
+        float y;
+        /** target speed, 0-127 */
+        float speed;
+        /** arc length from the start of the path, in inches */
+        float distance;
+};
+
+/**
+ * @brief Bounding box of a run of points on a binary path asset
+ */
+struct PathBox {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+};
+
+/**
+ * @brief Header at the start of a binary path asset
+ *
+ * Written by firmware/pathAsset.py, the two have to be changed together
+ */
+struct PathHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t pointSize;
+        uint32_t count;
+        /** total arc length, in inches */
+        float length;
+        /** points covered by each box, neighbouring boxes share their end point */
+        uint16_t boxPoints;
+        uint16_t boxSize;
+        uint32_t boxCount;
+};
+
+static_assert(sizeof(PathPoint) == 16, "PathPoint must match firmware/pathAsset.py");
+static_assert(sizeof(PathBox) == 16, "PathBox must match firmware/pathAsset.py");
+static_assert(sizeof(PathHeader) == 24, "PathHeader must match firmware/pathAsset.py");
+
+/**
+ * @brief A path packed at build time, read in place
+ *
+ * A text path has to be parsed into floats at the start of every follow(). The build also packs every
+ * .txt path in static/ into a .path asset, a header and an array of floats, so follow() can read the points straight
+ * out of the program image without copying or parsing anything. The packer also works out the arc length to each point
+ * and bounding boxes over runs of points, which PathTracker uses to keep each control cycle short on long paths.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // static/myPath.txt is packed into the "myPath_path" asset
+ * ASSET(myPath_path);
+ *
+ * void autonomous() {
+ *     // follow the path with a lookahead of 10 inches and a timeout of 4000ms
+ *     chassis.follow(lemlib::PathAsset(myPath_path), 10, 4000);
+ * }
+ * @endcode
+ */
+class PathAsset {
+    public:
+        static constexpr char MAGIC[4] = {'L', 'L', 'P', 'B'};
+        static constexpr uint16_t VERSION = 2;
+
+        /**
+         * @brief Read the header of a binary path asset
+         *
+         * The asset is not copied and has to outlive the PathAsset, which ASSET() assets always do
+         *
+         * @param path a .path asset. If it is not a binary path asset the path is empty
+         */
+        explicit PathAsset(const asset& path);
+        /**
+         * @return whether the asset was a binary path asset this version understands
+         */
+        bool isValid() const;
+        /**
+         * @return number of points, 0 if the asset was not valid
+         */
+        size_t size() const;
+        /**
+         * @return total arc length of the path, in inches
+         */
+        float length() const;
+        const PathPoint& operator[](size_t index) const;
+        const PathPoint* begin() const;
+        const PathPoint* end() const;
+        /**
+         * @return number of bounding boxes
+         */
+        size_t boxCount() const;
+        /**
+         * @brief Bounding box of the segments starting at points index * (boxPoints() - 1) up to the next box
+         */
+        const PathBox& box(size_t index) const;
+        /**
+         * @return points covered by each box, the last point of one box is the first of the next
+         */
+        size_t boxPoints() const;
+    private:
+        const PathPoint* points = nullptr;
+        size_t count = 0;
+        float totalLength = 0;
+        const PathBox* boxList = nullptr;
+        size_t numBoxes = 0;
+        size_t pointsPerBox = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "lemlib/pathAsset.hpp"
+
+namespace lemlib {
+/**
+ * @brief Finds the closest point and the pure pursuit lookahead point on a binary path asset
+ *
+ * Scanning the whole path for the closest point every control cycle takes longer the longer the path is, which adds
+ * up on a skills path with thousands of points. The tracker only moves forwards instead:
+ * - the closest point is searched for from the last one, up to a lookahead further along the path. The robot can't
+ * get further than that in one cycle
+ * - the lookahead point is searched for from the last one, up to two lookaheads past the closest point, skipping
+ * every box of points that the lookahead circle can't cross. Further than that would be the path coming back past the
+ * robot, not where it should go next
+ *
+ * so each cycle only looks at the few points around the robot, however long the path is
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::PathTracker tracker(lemlib::PathAsset(myPath_path), 10);
+ * // every control cycle
+ * tracker.update(pose.x, pose.y);
+ * const lemlib::PathPoint& target = tracker.getLookahead();
+ * @endcode
+ */
+class PathTracker {
+    public:
+        /**
+         * @param path the path to follow. Not copied, the asset has to outlive the tracker
+         * @param lookahead the lookahead distance, in inches
+         */
+        PathTracker(const PathAsset& path, float lookahead);
+        /**
+         * @brief Move the closest and lookahead points on to where the robot is now
+         *
+         * @param x robot x, in inches
+         * @param y robot y, in inches
+         */
+        void update(float x, float y);
+        /**
+         * @return index of the point closest to the robot
+         */
+        size_t getClosest() const;
+        /**
+         * @brief The lookahead point. If the lookahead circle doesn't cross the path it stays where it was
+         *
+         * @return the point, with the speed and distance interpolated along its segment
+         */
+        const PathPoint& getLookahead() const;
+        /**
+         * @return index of the point at the start of the segment the lookahead point is on
+         */
+        size_t getLookaheadSegment() const;
+    private:
+        const PathAsset path;
+        const float lookahead;
+        size_t closest = 0;
+        size_t lookaheadSegment = 0;
+        PathPoint lookaheadPoint = {0, 0, 0, 0};
+};
+} // namespace lemlib
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace lemlib {
+/**
+ * @brief A value one task publishes and any task can read whole, without either of them locking
+ *
+ * There are two copies. The writer fills the one readers aren't pointed at, then points them at it, so a reader is
+ * never left waiting on a writer that was preempted half way through. Each copy has a count that is odd while it is
+ * being written, and a reader that sees it change under it reads again. That only happens when the writer finished
+ * two whole updates during one read.
+ *
+ * Only one task may store at a time, guard it with a mutex if more than one does.
+ *
+ * @tparam T trivially copyable and default constructible, a multiple of 4 bytes
+ */
+template <typename T> class Snapshot {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % 4 == 0,
+                      "a snapshot is copied 4 bytes at a time");
+        using Words = std::array<uint32_t, sizeof(T) / 4>;
+    public:
+        /**
+         * @brief Construct a new Snapshot
+         *
+         * @param value what load() returns until the first store()
+         */
+        Snapshot(const T& value) { store(value); }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        /**
+         * @brief Publish a new value. Only one task at a time
+         */
+        void store(const T& value) {
+            const uint32_t next = current.load(std::memory_order_relaxed) ^ 1;
+            Copy& copy = copies[next];
+            const uint32_t sequence = copy.sequence.load(std::memory_order_relaxed);
+            copy.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            Words words;
+            std::memcpy(words.data(), &value, sizeof(T));
+            for (size_t i = 0; i < words.size(); i++) copy.words[i].store(words[i], std::memory_order_relaxed);
+            copy.sequence.store(sequence + 2, std::memory_order_release);
+            current.store(next, std::memory_order_release);
+        }
+
+        /**
+         * @brief Get the last value stored. Safe from any task, never waits on the writer
+         */
+        T load() const {
+            Words words;
+            while (true) {
+                const Copy& copy = copies[current.load(std::memory_order_acquire)];
+                const uint32_t sequence = copy.sequence.load(std::memory_order_acquire);
+                for (size_t i = 0; i < words.size(); i++) words[i] = copy.words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence % 2 == 0 && copy.sequence.load(std::memory_order_relaxed) == sequence) break;
+            }
+            T value;
+            // T is trivially copyable, but may have default member initializers that -Wclass-memaccess objects to
+            std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+            return value;
+        }
+    private:
+        struct Copy {
+                std::atomic<uint32_t> sequence = 0;
+                std::array<std::atomic<uint32_t>, sizeof(T) / 4> words {};
+        };
+
+        Copy copies[2];
+        std::atomic<uint32_t> current = 0;
+};
+} // namespace lemlib
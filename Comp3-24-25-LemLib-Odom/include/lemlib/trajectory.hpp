@@ -0,0 +1,108 @@
+#pragma once
+
+#include "lemlib/pathAsset.hpp"
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief How hard a trajectory may drive
+ */
+struct TrajectoryLimits {
+        /** top speed of either side, in inches per second */
+        float velocity;
+        /** how fast the robot may speed up and slow down, in inches per second squared */
+        float acceleration;
+        /** distance between the left and right wheels, in inches. Turning speeds one side up, so corners are slower */
+        float trackWidth;
+};
+
+/**
+ * @brief Where a trajectory wants the robot at one moment
+ *
+ * Headings are the same as the chassis pose: radians, 0 facing +y, clockwise positive
+ */
+struct TrajectoryState {
+        /** seconds from the start */
+        float time;
+        float x;
+        float y;
+        float theta;
+        /** inches per second, negative when the trajectory is driven backwards */
+        float velocity;
+        /** radians per second, clockwise positive */
+        float angularVelocity;
+        /** inches per second squared */
+        float acceleration;
+};
+
+/**
+ * @brief A path with a time for every point, so it can be tracked instead of chased
+ *
+ * Pure pursuit only knows where the path goes. It steers at a point a lookahead ahead, which cuts the corners, and
+ * drives at whatever speed the path says for the closest point. A trajectory also says when the robot should be at
+ * each point, with the heading, speed and turn rate it should have there, so a tracker can correct being behind or
+ * ahead as well as being off to the side.
+ *
+ * The speed at each point is the slowest of
+ * - the path's own speed for the point, as a fraction of limits.velocity
+ * - what keeps the outside wheel at limits.velocity through the curve there
+ * - what can be reached from the start, and stopped from by the end, at limits.acceleration
+ *
+ * The path ends at its first point with a speed of 0, the same as follow().
+ *
+ * Built once, up front, in initialize() rather than at the start of the motion. Sampling is a binary search over the
+ * points, nothing is allocated.
+ *
+ * @b Example
+ * @code {.cpp}
+ * ASSET(myPath_path);
+ * lemlib::Trajectory myTrajectory;
+ *
+ * void initialize() {
+ *     myTrajectory = lemlib::Trajectory(lemlib::PathAsset(myPath_path), {60, 200, 13.5});
+ * }
+ *
+ * void autonomous() {
+ *     chassis.follow(myTrajectory, 5000);
+ * }
+ * @endcode
+ */
+class Trajectory {
+    public:
+        /**
+         * @brief An empty trajectory
+         */
+        Trajectory() = default;
+        /**
+         * @param path the points to go through
+         * @param limits how hard it may drive
+         * @param forwards whether the robot drives it facing forwards. Backwards the headings are turned around and
+         * the speeds are negative
+         */
+        Trajectory(const PathAsset& path, TrajectoryLimits limits, bool forwards = true);
+
+        /**
+         * @param time seconds since the start. Before 0 is the start, after getDuration() is the end
+         * @return where the trajectory is then, interpolated between its points
+         */
+        TrajectoryState sample(float time) const;
+
+        /**
+         * @return seconds from start to end, 0 if empty
+         */
+        float getDuration() const;
+
+        /**
+         * @return the fastest it goes, in inches per second
+         */
+        float getMaxVelocity() const;
+
+        /**
+         * @return the points, with the time to be at each
+         */
+        const std::vector<TrajectoryState>& getStates() const;
+    private:
+        std::vector<TrajectoryState> states;
+        float maxVelocity = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "lemlib/matrix.hpp"
+#include "lemlib/pose.hpp"
+#include "lemlib/trajectory.hpp"
+#include <array>
+
+namespace lemlib {
+/**
+ * @brief The control law a TrajectoryTracker uses
+ */
+enum class TrajectoryTrackerType {
+    /** nonlinear, closed form and cheap. Two gains to tune */
+    RAMSETE,
+    /** linear quadratic regulator relinearized at the target speed. Tuned by how much error is acceptable */
+    LTV
+};
+
+/**
+ * @brief Parameters for TrajectoryTracker and Chassis::follow() on a Trajectory
+ *
+ * Only the fields for the chosen type are used
+ */
+struct TrajectoryTrackerParams {
+        TrajectoryTrackerType type = TrajectoryTrackerType::RAMSETE;
+        /** RAMSETE: how hard to correct, per square inch. The usual 2 per square meter is 0.0013, too soft to correct
+         * much as the robot slows down to stop */
+        float b = 0.006;
+        /** RAMSETE: damping, between 0 and 1 */
+        float zeta = 0.7;
+        /** LTV: inches behind or ahead of the target worth a full correction */
+        float maxErrorX = 2;
+        /** LTV: inches off to the side of the target worth a full correction */
+        float maxErrorY = 2;
+        /** LTV: degrees off the target heading worth a full correction */
+        float maxErrorTheta = 45;
+        /** LTV: in/s of correction to the forward speed the robot can spare */
+        float maxVelocityCorrection = 40;
+        /** LTV: degrees per second of correction to the turn rate the robot can spare */
+        float maxAngularCorrection = 115;
+};
+
+/**
+ * @brief Forward speed and turn rate for a differential drive
+ */
+struct UnicycleCommand {
+        /** inches per second */
+        float velocity;
+        /** radians per second, clockwise positive */
+        float angularVelocity;
+};
+
+/**
+ * @brief Works out the speed and turn rate that bring the robot back onto a trajectory
+ *
+ * Starts from the trajectory's own speed and turn rate, which are all a perfect robot would need, and corrects them
+ * for how far the robot is behind or ahead of the target, off to the side of it and off its heading, all measured
+ * from the robot.
+ *
+ * RAMSETE corrects with a closed form law that is stable for any error. LTV runs a linear quadratic regulator on the
+ * error: the drive is linearized at the target speed, which changes along the trajectory, so the optimal gains are
+ * worked out for a spread of speeds when the tracker is made and looked up each cycle. Either is a handful of
+ * multiplies per cycle.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::TrajectoryTracker tracker({.type = lemlib::TrajectoryTrackerType::LTV}, trajectory.getMaxVelocity());
+ * // every control cycle
+ * const lemlib::UnicycleCommand command = tracker.calculate(chassis.getPose(true), trajectory.sample(elapsed));
+ * @endcode
+ */
+class TrajectoryTracker {
+    public:
+        /**
+         * @param params which control law and how it is tuned
+         * @param maxVelocity fastest the trajectories tracked go, in inches per second. LTV works out gains up to it
+         */
+        TrajectoryTracker(TrajectoryTrackerParams params, float maxVelocity);
+
+        /**
+         * @param pose where the robot is, heading in radians
+         * @param target where the trajectory is now
+         * @return what to drive at this cycle
+         */
+        UnicycleCommand calculate(const Pose& pose, const TrajectoryState& target) const;
+    private:
+        // gains for speeds from -maxVelocity to maxVelocity
+        static constexpr int GAIN_STEPS = 16;
+
+        const TrajectoryTrackerParams params;
+        const float maxVelocity;
+        std::array<Matrix<2, 3>, 2 * GAIN_STEPS + 1> gains {};
+};
+} // namespace lemlib
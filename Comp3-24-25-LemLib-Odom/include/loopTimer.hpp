@@ -0,0 +1,112 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * How one periodic loop has been running since the last reset, see LoopTimer.
+ */
+struct LoopStats {
+        static constexpr int JITTER_BINS = 8;
+        /** us, upper edge of each jitter bin but the last, which has everything further off */
+        static constexpr std::array<std::uint32_t, JITTER_BINS - 1> JITTER_EDGES {50, 100, 250, 500, 1000, 2000, 5000};
+
+        const char* name = "";
+        std::uint32_t period = 0;     // ms
+        std::uint32_t runs = 0;
+        std::uint32_t lastTime = 0;   // us the last run took
+        std::uint32_t maxTime = 0;    // us, the longest run
+        std::uint64_t totalTime = 0;  // us, every run added up
+        std::uint32_t maxLatency = 0; // us, the latest a run has started after it was due
+        std::uint32_t misses = 0;     // runs that hadn't finished by the time the next one was due
+        // runs by how far the time since the run before was off the period, see JITTER_EDGES
+        std::array<std::uint32_t, JITTER_BINS> jitter {};
+
+        /**
+         * @return us a run takes on average
+         */
+        std::uint32_t meanTime() const;
+
+        /**
+         * @return share of the CPU the loop takes, 0 to 1: the mean run time over the period
+         */
+        float utilization() const;
+};
+
+/**
+ * Times a periodic loop: how long each run takes, how far the time between
+ * runs wanders off the period, and how late runs start.
+ *
+ * Every LoopTimer alive is listed by getAll(), so everything timed shows up on
+ * the brain screen page and in recordAll()'s telemetry without being passed
+ * around. Timers are meant to be globals or members of globals.
+ *
+ * @b Example
+ * @code {.cpp}
+ * LoopTimer driverTimer("opcontrol", 10);
+ *
+ * while (true) {
+ *     driverTimer.start();
+ *     // ...
+ *     driverTimer.stop();
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class LoopTimer {
+    public:
+        /**
+         * @param name shown on the screen and in telemetry, a string literal or something else that lives as long
+         * @param period ms the loop is meant to run every
+         */
+        LoopTimer(const char* name, std::uint32_t period);
+        ~LoopTimer();
+
+        LoopTimer(const LoopTimer&) = delete;
+        LoopTimer& operator=(const LoopTimer&) = delete;
+
+        /**
+         * Call as a run starts.
+         *
+         * @param due us the run was due, from pros::micros(). A scheduler knows this, a loop on pros::delay() can
+         *        leave it out: the run is taken to be due a period after the last one started
+         */
+        void start(std::uint64_t due);
+        void start();
+
+        /**
+         * Call as a run finishes.
+         */
+        void stop();
+
+        LoopStats getStats();
+
+        /**
+         * Starts the stats again, e.g. at the start of a match.
+         */
+        void reset();
+
+        /**
+         * @return every LoopTimer alive, oldest first
+         */
+        static std::vector<LoopTimer*> getAll();
+
+        /**
+         * Resets every LoopTimer alive.
+         */
+        static void resetAll();
+
+        /**
+         * Sends every LoopTimer's stats to lemlib::telemetrySink(), one "Loop timing" record each.
+         * firmware/loopReport.py turns them into a table on a computer.
+         */
+        static void recordAll();
+    private:
+        pros::Mutex mutex;
+        LoopStats stats;
+        std::uint64_t started = 0;   // us the current run started
+        std::uint64_t due = 0;       // us the current run was due
+        std::uint64_t lastStart = 0; // us the run before started, 0 before the first
+};
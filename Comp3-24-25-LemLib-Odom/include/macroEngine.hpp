@@ -0,0 +1,142 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * The mechanisms a macro can drive. A macro lists every one it touches, and
+ * starting a macro cancels any running macro that shares one with it.
+ */
+enum Mechanism : std::uint8_t {
+    LADY_BROWN = 1 << 0,
+    HOOKS = 1 << 1,
+    CLAMP = 1 << 2
+};
+
+/**
+ * One step of a macro. The action runs once as the step starts, then the step
+ * waits until done() is true or the timeout runs out, whichever is first, and
+ * the next step starts on the same tick.
+ */
+struct MacroStep {
+        std::function<void()> action; // may be empty
+        std::function<bool()> done;   // empty moves straight on to the next step
+        std::uint32_t timeout = 0;    // ms, 0 to wait for done() for as long as it takes
+};
+
+/**
+ * A fixed list of steps for some mechanisms, e.g. raising the lady brown and
+ * then backing the hooks off the ring it took. Built once, usually as a
+ * global, and started as often as needed with MacroEngine::start().
+ */
+class Macro {
+    public:
+        /**
+         * @param mechanisms the Mechanism flags of everything the steps drive
+         * @param steps run in order
+         * @param finish runs once the last step is done, or when the macro is cancelled, to leave the mechanisms
+         *        in a safe state. May be empty
+         */
+        Macro(std::uint8_t mechanisms, std::initializer_list<MacroStep> steps, std::function<void()> finish = {});
+
+        std::uint8_t getMechanisms() const;
+    private:
+        friend class MacroEngine;
+
+        const std::uint8_t mechanisms;
+        const std::vector<MacroStep> steps;
+        const std::function<void()> finish;
+};
+
+/**
+ * Runs macros without blocking whoever starts them.
+ *
+ * Every running macro is stepped from one task on one tick, so a driver macro
+ * runs alongside driving and each step ends the moment its sensor says so
+ * instead of after a fixed delay. Macros on different mechanisms run side by
+ * side; starting one on a mechanism that is busy cancels the macro already
+ * there, the way pressing another button takes over from the last one.
+ *
+ * Steps run with the engine locked, so they must not start, cancel or wait on
+ * macros themselves.
+ *
+ * @b Example
+ * @code {.cpp}
+ * MacroEngine macros;
+ * const Macro score(LADY_BROWN, {
+ *     {[] { ladybrown.move_absolute(1850, 127); }, [] { return ladybrown.get_position() > 1800; }, 1500},
+ * });
+ *
+ * // in initialize()
+ * pros::Task macroTask([] { macros.run(); });
+ *
+ * // in opcontrol()
+ * if (controller.get_digital_new_press(DIGITAL_UP)) macros.start(score);
+ * @endcode
+ */
+class MacroEngine {
+    public:
+        static constexpr int SLOTS = 4;
+
+        /**
+         * Runs every macro started. Never returns, start it in its own task.
+         */
+        void run();
+
+        /**
+         * Starts a macro, cancelling any running one that shares a mechanism
+         * with it, and returns straight away. The macro is not copied, it has
+         * to outlive the run.
+         *
+         * @return false if every slot is taken by macros on other mechanisms
+         */
+        bool start(const Macro& macro);
+
+        /**
+         * Stops a macro if it is running, running its finish.
+         */
+        void cancel(const Macro& macro);
+
+        /**
+         * Stops every running macro.
+         */
+        void cancelAll();
+
+        bool isRunning(const Macro& macro);
+
+        /**
+         * @return true if a running macro drives any of the given Mechanism
+         *         flags, so other code should leave them alone
+         */
+        bool isUsing(std::uint8_t mechanisms);
+
+        /**
+         * Blocks until the macro is no longer running.
+         *
+         * @param timeout ms to give up after, 0 to wait for as long as it takes
+         */
+        void waitUntilDone(const Macro& macro, std::uint32_t timeout = 0);
+
+        /**
+         * Steps every running macro once. run() calls this every PERIOD.
+         */
+        void update(std::uint32_t now);
+    private:
+        struct Slot {
+                const Macro* macro = nullptr; // nullptr when free
+                std::size_t step = 0;
+                bool started = false; // whether the action of step has run
+                std::uint32_t startedAt = 0;
+        };
+
+        static constexpr std::uint32_t PERIOD = 10; // ms
+
+        void end(Slot& slot);
+
+        pros::Mutex mutex;
+        std::array<Slot, SLOTS> slots {};
+};
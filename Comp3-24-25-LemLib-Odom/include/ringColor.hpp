@@ -0,0 +1,100 @@
+#pragma once
+
+#include "pros/optical.hpp"
+#include <cstdint>
+#include <vector>
+
+enum class RingColor {
+    NONE,
+    RED,
+    BLUE
+};
+
+/**
+ * Tells red and blue rings apart by hue and saturation.
+ *
+ * Hue barely moves with the lighting, unlike raw rgb which scales with how
+ * bright the venue is. Each color is a band of hue around a center, and
+ * anything too washed out (the field, the hooks, an empty sensor) is no ring.
+ *
+ * The bands can be fit at an event: record rings of each color with
+ * startCalibration(), then finishCalibration() fits the bands, saves them and
+ * the samples to the SD card, and they are loaded again on the next boot.
+ */
+class RingClassifier {
+    public:
+        struct Band {
+            double hue;    // center, deg
+            double spread; // standard deviation, deg
+        };
+
+        struct Settings {
+            Band red = {10, 12};
+            Band blue = {215, 12};
+            double minSaturation = 0.35; // 0-1
+            double width = 3;            // spreads from the center that still count as that color
+        };
+
+        struct Sample {
+            RingColor label;
+            double hue;
+            double saturation;
+            std::int32_t proximity;
+            std::uint32_t clear; // raw clear channel, for checking the lighting later
+        };
+
+        static constexpr const char* SETTINGS_FILE = "/usd/ring_color.txt";
+        static constexpr const char* SAMPLES_FILE = "/usd/ring_color_samples.csv";
+        static constexpr int MIN_SAMPLES = 20; // per color to fit
+        static constexpr int MAX_SAMPLES = 500; // per color, recording stops there so a long session can't fill memory
+
+        RingClassifier();
+        RingClassifier(Settings settings);
+
+        /**
+         * Classifies one reading.
+         */
+        RingColor classify(double hue, double saturation) const;
+
+        /**
+         * Starts recording samples of the given color, NONE stops.
+         */
+        void startCalibration(RingColor label);
+        RingColor getCalibration() const;
+
+        /**
+         * Records a sample if calibrating and there are fewer than MAX_SAMPLES
+         * of that color. Call only while a ring is in front of the sensor.
+         */
+        void record(const Sample& sample);
+
+        /**
+         * Fits the bands to the recorded samples and saves them and the samples
+         * to the SD card.
+         *
+         * @return false if either color has fewer than MIN_SAMPLES, the old
+         * bands are kept
+         */
+        bool finishCalibration();
+
+        /**
+         * Fits bands to samples of both colors.
+         */
+        static Settings fit(const std::vector<Sample>& samples, const Settings& defaults);
+
+        /**
+         * Loads bands saved by finishCalibration().
+         *
+         * @return false if there is no SD card or no saved bands
+         */
+        bool load();
+
+        const Settings& getSettings() const;
+        int sampleCount(RingColor label) const;
+    private:
+        bool save() const;
+
+        Settings settings;
+        RingColor calibrating = RingColor::NONE;
+        std::vector<Sample> samples;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "pros/motors.hpp"
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "ringColor.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Color sort that follows each ring up the hooks.
+ *
+ * Ring colors come from a RingClassifier, which can be recalibrated at an
+ * event through startCalibration() / finishCalibration().
+ *
+ * A ring is logged the moment it shows up in front of the optical sensor,
+ * along with where the hook motor was at the time. The hooks carry it a fixed
+ * number of degrees to the top, so the eject is timed off the hook encoder
+ * instead of a fixed delay, and the task keeps watching the sensor while a ring
+ * is being thrown. Back to back rings each get their own eject.
+ *
+ * The sort only takes over the hooks while it is throwing a ring. Everything
+ * else should drive the hooks through setIntake() so the sort can put them
+ * back the way they were asked to run afterwards.
+ */
+class RingSorter {
+    public:
+        static constexpr std::uint32_t PERIOD = 5; // ms
+
+        struct Settings {
+            int proximity;            // 0-255, a ring is in front of the sensor above this
+            double travel;            // hook degrees from the sensor to the top, where the ring is thrown
+            int ejectPower;           // -127 to 127, hook power while throwing
+            std::uint32_t ejectTime;  // ms the eject power is held
+            double minEjectSpeed;     // rpm, slower hooks can't throw a ring so they are stopped instead
+        };
+
+        /**
+         * @param sensor optical sensor at the bottom of the hooks
+         * @param hooks the hook motor, forward carrying rings up
+         * @param settings see Settings
+         * @param classifier red/blue decision, replaced by saved calibration on loadCalibration()
+         */
+        RingSorter(pros::Optical& sensor, pros::Motor& hooks, Settings settings, RingClassifier classifier = {});
+
+        /**
+         * Runs the sort. Never returns, start it in its own task.
+         */
+        void run();
+
+        /**
+         * Runs one pass of the sort, for calling from a ControlScheduler job
+         * instead of starting run(). Call it every PERIOD ms.
+         */
+        void step(std::uint32_t now);
+
+        /**
+         * Turns the sort on or off. When off the sensor LED is turned off and
+         * rings already on the hooks are forgotten.
+         */
+        void setEnabled(bool enabled);
+        bool isEnabled() const;
+
+        /**
+         * Which alliance we are, rings of the other color are thrown.
+         */
+        void setRedTeam(bool red);
+        bool isRedTeam() const;
+
+        /**
+         * Sets the hook power, -127 to 127. Applied straight away unless a ring
+         * is being thrown, in which case it is applied once the throw is done.
+         */
+        void setIntake(int power);
+
+        /**
+         * Number of rings between the sensor and the top.
+         */
+        int ringsOnHooks();
+
+        /**
+         * Loads the classifier calibration saved on the SD card, if any.
+         */
+        bool loadCalibration();
+
+        /**
+         * Records every ring that passes the sensor as the given color until
+         * finishCalibration(). Sorting is paused meanwhile.
+         */
+        void startCalibration(RingColor label);
+        RingColor getCalibration();
+
+        /**
+         * Fits and saves the calibration, see RingClassifier::finishCalibration().
+         */
+        bool finishCalibration();
+    private:
+        struct Ring {
+            std::uint32_t seenAt; // ms
+            double ejectAt;       // hook position where it reaches the top, deg
+            bool wrongColor;
+        };
+
+        static constexpr int MAX_RINGS = 4;
+
+        std::uint32_t update(std::uint32_t now);
+        bool wrongColor(RingColor color) const;
+        void eject(std::uint32_t now);
+
+        pros::Optical& sensor;
+        pros::Motor& hooks;
+        const Settings settings;
+        RingClassifier classifier;
+
+        std::atomic<bool> enabled = true;
+        std::atomic<bool> redTeam = true;
+
+        pros::Mutex mutex;
+        std::array<Ring, MAX_RINGS> rings {};
+        int first = 0; // oldest ring
+        int count = 0;
+        bool ringPresent = false;
+        bool ledOn = false;
+        int requested = 0;
+        bool ejecting = false;
+        std::uint32_t ejectUntil = 0;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "lemlib/pathAsset.hpp"
+#include "lemlib/pose.hpp"
+#include "liblvgl/lvgl.h"
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * Draws the brain screen with LVGL, redrawing only what has changed.
+ *
+ * Reprinting every pros::lcd line on every update formats each line again and
+ * redraws all of it, even when nothing on it moved. Here each readout keeps the
+ * numbers it last drew, and is only formatted and handed to LVGL once one of
+ * them has moved further than its epsilon, e.g. half its last shown digit, so
+ * LVGL only redraws the labels that really changed. Changes are pushed out at
+ * most once every redraw period however often they come in, and only for the
+ * page that is showing; the rest wait until their page is.
+ *
+ * The first page has a map of the field on the left, with the robot, its
+ * heading, the way it has come and the path it has been given. Readouts on it
+ * go in the column to the right of the map, on other pages across the screen.
+ * Tapping the screen steps through the pages.
+ *
+ * Past init() and adding lines, only render() calls LVGL, so call it from
+ * one task. Everything else can be called from any task. This takes the whole
+ * screen, don't initialize pros::lcd as well.
+ *
+ * @b Example
+ * @code {.cpp}
+ * ScreenRenderer screen;
+ *
+ * // in initialize()
+ * screen.init();
+ * const int heading = screen.addReadout(0, 0, 0, "Theta: %.1f", 0.05);
+ *
+ * // every 50 ms
+ * const lemlib::Pose pose = chassis.getPose();
+ * screen.setPose(pose);
+ * screen.set(heading, {pose.theta});
+ * screen.render(pros::millis());
+ * @endcode
+ */
+class ScreenRenderer {
+    public:
+        static constexpr int MAX_VALUES = 6;    // numbers a readout can show
+        static constexpr int TEXT_LENGTH = 48;  // characters a line can hold
+        static constexpr int LINES = 10;        // lines on a page
+        static constexpr int PATH_POINTS = 64;  // points a path is drawn with
+        static constexpr int TRAIL_CHUNKS = 8;  // the trail is drawn in pieces, so a new point only redraws the last
+        static constexpr int CHUNK_POINTS = 16;
+
+        /**
+         * @param pages how many pages there are, the first has the field map
+         * @param redrawPeriod ms, the least time between two redraws
+         */
+        ScreenRenderer(int pages = 2, std::uint32_t redrawPeriod = 100);
+
+        /**
+         * Builds the pages and the map on the active screen. Call once from initialize(), before adding anything.
+         */
+        void init();
+
+        /**
+         * Adds a line of numbers.
+         *
+         * @param page which page it's on
+         * @param line 0 at the top, up to LINES - 1
+         * @param column px from the left of the page's text
+         * @param format printf format for up to MAX_VALUES floats, e.g. "X: %.2f". Must live as long as the renderer
+         * @param epsilon how far a number has to move from what's on the screen before it's redrawn
+         * @return the readout's index for set()
+         */
+        int addReadout(int page, int line, int column, const char* format, float epsilon = 0);
+
+        /**
+         * Adds a line of text.
+         *
+         * @return the text's index for setText()
+         */
+        int addText(int page, int line, int column);
+
+        /**
+         * @param readout index from addReadout()
+         * @param values in the order the format shows them
+         */
+        void set(int readout, std::initializer_list<float> values);
+
+        /**
+         * @param text index from addText()
+         * @param value copied, cut at TEXT_LENGTH - 1 characters. Only redrawn when it differs from what's shown
+         */
+        void setText(int text, const char* value);
+
+        /**
+         * Shows a line of text under the readouts on the first page, e.g. how far an auton has got.
+         */
+        void setStatus(const char* value);
+
+        /**
+         * Moves the robot on the map, and adds to its trail once it has moved far enough.
+         *
+         * @param pose field coordinates in inches with the origin in the middle, heading in degrees
+         */
+        void setPose(const lemlib::Pose& pose);
+
+        /**
+         * Draws a path on the map, e.g. the one the robot is about to follow.
+         */
+        void setPath(const lemlib::PathAsset& path);
+
+        /**
+         * Rubs out the trail, e.g. at the start of an auton.
+         */
+        void clearTrail();
+
+        /**
+         * Shows the next page, or the first after the last. Tapping the screen calls this.
+         */
+        void nextPage();
+
+        /**
+         * @return the page showing, or about to be at the next render()
+         */
+        int getPage() const;
+
+        /**
+         * Hands whatever changed to LVGL, unless the last redraw was less than a redraw period ago.
+         *
+         * @param now ms
+         */
+        void render(std::uint32_t now);
+    private:
+        struct Widget {
+                int page;
+                lv_obj_t* label = nullptr;
+                const char* format = nullptr; // nullptr for text
+                float epsilon = 0;
+                std::array<float, MAX_VALUES> values {};
+                std::array<float, MAX_VALUES> shown {}; // what the label shows
+                char text[TEXT_LENGTH] = "";
+                bool drawn = false; // false until the first render() after it was set
+                bool dirty = false;
+        };
+
+        int addWidget(int page, int line, int column, const char* format, float epsilon);
+        static void onClick(lv_event_t* event);
+
+        const int pageCount;
+        const std::uint32_t redrawPeriod; // ms
+        pros::Mutex mutex;
+        std::atomic<int> page = 0;
+        int shownPage = -1;
+        std::uint32_t lastRender = 0;
+        bool rendered = false;
+
+        std::vector<lv_obj_t*> pages;
+        std::vector<Widget> widgets;
+        int status = -1;
+
+        // the map, in px from its top left corner
+        lv_obj_t* map = nullptr;
+        lv_obj_t* robot = nullptr;
+        lv_obj_t* heading = nullptr;
+        lv_obj_t* pathLine = nullptr;
+        std::array<lv_obj_t*, TRAIL_CHUNKS> trailLines {};
+        lemlib::Pose pose {0, 0, 0};
+        bool poseSet = false; // since the map last drew it
+        std::array<lv_point_t, 2> headingPoints {};
+        lv_point_t robotShown {}; // top left corner
+        bool robotPlaced = false;
+        std::array<lv_point_t, PATH_POINTS> pathNext {}; // from setPath(), until render() draws it
+        int pathNextCount = 0;
+        bool pathDirty = false;
+        // LVGL draws from these, so only render() changes them
+        std::array<lv_point_t, PATH_POINTS> pathPoints {};
+        std::array<std::array<lv_point_t, CHUNK_POINTS>, TRAIL_CHUNKS> trail {};
+        std::array<int, TRAIL_CHUNKS> trailCounts {};
+        std::array<bool, TRAIL_CHUNKS> trailDirty {};
+        int trailChunk = 0;
+        bool trailCleared = false;
+};
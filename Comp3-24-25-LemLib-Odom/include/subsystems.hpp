@@ -5,9 +5,10 @@
 #include "pros/motors.hpp"
 #include "lemlib/api.hpp"
 #include "pros/optical.hpp"
-#include <atomic>
-
-extern std::atomic<bool> isRedTeam; // Atomic for thread safety
+#include "controlScheduler.hpp"
+#include "macroEngine.hpp"
+#include "ringSorter.hpp"
+#include "screenRenderer.hpp"
 
 void selectRedTeam();
 void selectBlueTeam();
@@ -19,10 +20,14 @@ extern lemlib::Chassis chassis;
 extern pros::Motor intakeLow;
 extern pros::Motor intakeHigh;
 extern pros::Optical colorsort;
+extern RingSorter ringSorter;
 extern pros::Motor ladybrown;
 // extern pros::ADIDigitalOut doinker;
 extern pros::ADIDigitalOut mogoclamp;
 extern pros::ADIDigitalOut intakePiston;
+extern MacroEngine macros;
+extern ControlScheduler scheduler;
+extern ScreenRenderer screen;
 
 void initializeSubsystems();
 
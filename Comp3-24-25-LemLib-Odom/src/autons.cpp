@@ -7,6 +7,7 @@
 // get a path used for pure pursuit
 // in the static folder 
 ASSET(example_txt); // '.' replaced with "_" to make c++ happy 
+ASSET(example_path); // the same path packed into floats at build time, see lemlib/pathAsset.hpp
 // void example_drive(){
 //     selectBlueTeam();
 //     chassis.moveToPoint(0, 10, 4000);
@@ -56,15 +57,18 @@ void auton_example() {
     // Follow the path in path.txt. Lookahead at 15, Timeout set to 4000
     // following the path with the back of the robot (forwards = false)
     // see line 116 to see how to define a path
-    chassis.follow(example_txt, 15, 4000, false);
+    // the binary example_path is already floats, so nothing is parsed when the motion starts
+    const lemlib::PathAsset path(example_path);
+    screen.setPath(path);
+    chassis.follow(path, 15, 4000, false);
     // wait until the chassis has traveled 10 inches. Otherwise the code directly after
     // the movement will run immediately
     // Unless its another movement, in which case it will wait
     chassis.waitUntil(10);
-    pros::lcd::print(4, "Traveled 10 inches during pure pursuit!");
+    screen.setStatus("Traveled 10 inches during pure pursuit!");
     // wait until the movement is done
     chassis.waitUntilDone();
-    pros::lcd::print(4, "pure pursuit finished!");
+    screen.setStatus("pure pursuit finished!");
 }
 
 // Initialize autonomous selection
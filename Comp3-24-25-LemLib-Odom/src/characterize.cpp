@@ -0,0 +1,60 @@
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+// drive characterization. Puts known voltages on the drive and logs what it
+// did, firmware/characterizeFit.py fits the feedforward constants to the log
+
+namespace {
+
+struct Test {
+        int id; // logged with every sample, so the fitter can tell the tests apart
+        float direction; // 1 forwards or clockwise, -1 backwards or counterclockwise
+        bool turning;
+        bool ramp; // slow ramp, otherwise a sudden step
+};
+
+// quasistatic then dynamic, driving then turning. Each straight test is followed by one the other way, so the robot
+// ends up about where it started
+constexpr Test TESTS[] = {
+    {0, 1, false, true}, {1, -1, false, true}, {2, 1, false, false}, {3, -1, false, false},
+    {4, 1, true, true},  {5, -1, true, true},  {6, 1, true, false},  {7, -1, true, false},
+};
+
+constexpr float MAX_VOLTS = 12;
+
+} // namespace
+
+void lemlib::Chassis::characterize(CharacterizeParams params) {
+    // the drive motors' encoders, not the tracking wheels, so the log is about the wheels the voltage is on
+    TrackingWheel left(drivetrain.leftMotors, drivetrain.wheelDiameter, -drivetrain.trackWidth / 2, drivetrain.rpm);
+    TrackingWheel right(drivetrain.rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2, drivetrain.rpm);
+    const auto telemetry = telemetrySink();
+
+    for (const Test& test : TESTS) {
+        left.reset();
+        right.reset();
+        const uint32_t start = pros::millis();
+        while (true) {
+            const uint32_t elapsed = pros::millis() - start;
+            const float volts = test.ramp ? std::min(params.rampRate * elapsed / 1000, MAX_VOLTS) : params.stepVoltage;
+            const float leftVolts = test.direction * volts;
+            const float rightVolts = test.turning ? -leftVolts : leftVolts;
+            const float leftDistance = left.getDistanceTraveled();
+            const float rightDistance = right.getDistanceTraveled();
+            telemetry->record<Level::INFO, "Drive characterization: {} {} {} {} {} {}">(
+                test.id, leftVolts, rightVolts, leftDistance, rightDistance, getPose().theta);
+
+            if (test.turning ? elapsed >= uint32_t(params.turnTime)
+                             : std::fabs(leftDistance + rightDistance) / 2 >= params.maxDistance)
+                break;
+            drivetrain.leftMotors->move_voltage(leftVolts * 1000);
+            drivetrain.rightMotors->move_voltage(rightVolts * 1000);
+            pros::delay(10);
+        }
+        drivetrain.leftMotors->move_voltage(0);
+        drivetrain.rightMotors->move_voltage(0);
+        pros::delay(params.restTime);
+    }
+}
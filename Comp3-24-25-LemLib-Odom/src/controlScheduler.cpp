@@ -0,0 +1,83 @@
+#include "controlScheduler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+namespace {
+const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::SENSE: return "sense";
+        case Stage::COMPUTE: return "compute";
+        case Stage::ACTUATE: return "actuate";
+        default: return "display";
+    }
+}
+} // namespace
+
+ControlScheduler::ControlScheduler(std::uint32_t tick)
+    : tick(std::max<std::uint32_t>(tick, 1)),
+      tickTimer("scheduler", this->tick) {}
+
+int ControlScheduler::add(const char* name, Stage stage, std::uint32_t period,
+                          std::function<void(std::uint32_t now)> job) {
+    period = std::max<std::uint32_t>((period + tick - 1) / tick, 1) * tick;
+    const int index = jobs.size();
+    // after every job that runs before it, so jobs that tie stay in the order they were added
+    const auto before = std::find_if(jobs.begin(), jobs.end(), [&](const Job& other) {
+        return std::make_pair(stage, period) < std::make_pair(other.stage, other.period);
+    });
+    jobs.insert(before, {stage, period, std::move(job), std::make_unique<LoopTimer>(name, period), index});
+    return index;
+}
+
+void ControlScheduler::run() {
+    std::uint32_t now = pros::millis();
+    while (true) {
+        update(now);
+        pros::Task::delay_until(&now, tick);
+    }
+}
+
+void ControlScheduler::update(std::uint32_t now) {
+    const std::uint64_t due = std::uint64_t(now) * 1000;
+    tickTimer.start(due);
+    for (Job& job : jobs) {
+        if (ticks % (job.period / tick) != 0) continue;
+        // late from waiting on the jobs before it as much as from running long itself
+        job.timer->start(due);
+        job.run(now);
+        job.timer->stop();
+    }
+    tickTimer.stop();
+    ticks++;
+}
+
+int ControlScheduler::getJobCount() const { return jobs.size(); }
+
+LoopStats ControlScheduler::getStats(int job) {
+    for (const Job& each : jobs) {
+        if (each.index == job) return each.timer->getStats();
+    }
+    return {};
+}
+
+LoopStats ControlScheduler::getTickStats() { return tickTimer.getStats(); }
+
+void ControlScheduler::resetStats() {
+    tickTimer.reset();
+    for (Job& job : jobs) job.timer->reset();
+}
+
+void ControlScheduler::printReport() {
+    for (const Job& job : jobs) {
+        const LoopStats stats = job.timer->getStats();
+        std::printf("%-12s %-8s %3lu ms  %7lu runs  mean %5lu us  max %6lu us  latency %6lu us  %lu missed\n",
+                    stats.name, stageName(job.stage), (unsigned long)stats.period, (unsigned long)stats.runs,
+                    (unsigned long)stats.meanTime(), (unsigned long)stats.maxTime, (unsigned long)stats.maxLatency,
+                    (unsigned long)stats.misses);
+    }
+    const LoopStats tickStats = tickTimer.getStats();
+    std::printf("%-12s %-8s %3lu ms  %7lu runs  mean %5lu us  max %6lu us  cpu %.1f%%\n", tickStats.name, "",
+                (unsigned long)tickStats.period, (unsigned long)tickStats.runs, (unsigned long)tickStats.meanTime(),
+                (unsigned long)tickStats.maxTime, 100 * tickStats.utilization());
+}
@@ -0,0 +1,53 @@
+#include "lemlib/feedforward.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+lemlib::DriveFeedforward driveFeedforward;
+bool feedforwardSet = false;
+
+// motor rpm at free speed for a cartridge
+float cartridgeRpm(pros::MotorGroup* motors) {
+    switch (motors->get_gearing()) {
+        case pros::MotorGears::red: return 100;
+        case pros::MotorGears::green: return 200;
+        default: return 600;
+    }
+}
+
+// inches per second one side of the drive is moving, off the motors' own velocity measurement
+float sideSpeed(pros::MotorGroup* motors, const lemlib::Drivetrain& drivetrain) {
+    const float wheelRpm = motors->get_actual_velocity() * drivetrain.rpm / cartridgeRpm(motors);
+    return wheelRpm / 60 * M_PI * drivetrain.wheelDiameter;
+}
+
+} // namespace
+
+float lemlib::Feedforward::calculate(float velocity, float acceleration) const {
+    // kS pushes the way the robot is going, or the way it is about to go when starting from a stop
+    const float direction = velocity != 0 ? velocity : acceleration;
+    const float friction = direction > 0 ? kS : direction < 0 ? -kS : 0;
+    return friction + kV * velocity + kA * acceleration;
+}
+
+void lemlib::setDriveFeedforward(const DriveFeedforward& feedforward) {
+    driveFeedforward = feedforward;
+    feedforwardSet = true;
+}
+
+const lemlib::DriveFeedforward& lemlib::getDriveFeedforward() { return driveFeedforward; }
+
+bool lemlib::hasDriveFeedforward() { return feedforwardSet; }
+
+void lemlib::Chassis::tankVelocity(float leftVelocity, float rightVelocity, float leftAcceleration,
+                                   float rightAcceleration) {
+    const DriveFeedforward& feedforward = getDriveFeedforward();
+    const float leftError = leftVelocity - sideSpeed(drivetrain.leftMotors, drivetrain);
+    const float rightError = rightVelocity - sideSpeed(drivetrain.rightMotors, drivetrain);
+    const float left = feedforward.left.calculate(leftVelocity, leftAcceleration) + feedforward.kP * leftError;
+    const float right = feedforward.right.calculate(rightVelocity, rightAcceleration) + feedforward.kP * rightError;
+    drivetrain.leftMotors->move_voltage(std::clamp(left, -12.0f, 12.0f) * 1000);
+    drivetrain.rightMotors->move_voltage(std::clamp(right, -12.0f, 12.0f) * 1000);
+}
@@ -0,0 +1,504 @@
+// The implementation below is mostly based off of
+// the document written by 5225A (Pilons)
+// Here is a link to the original document
+// http://thepilons.ca/wp-content/uploads/2018/10/Tracking.pdf
+
+// Rebuilt from LemLib 0.5.4 so odometry runs faster than the 10 ms the archive's
+// task does. It sits beside the archive's odometry rather than replacing it: the
+// functions are in odom.hpp's inline namespace and everything else here is
+// static, so no symbol clashes with the archive's. Chassis::calibrateOdom()
+// starts this one instead of the archive's, and update() copies the pose into
+// the archive's for its motions to read
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+#include "pros/rtos.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/snapshot.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/chassis/poseFilter.hpp"
+#include "lemlib/chassis/poseHistory.hpp"
+
+// tracking thread
+static pros::Task* trackingTask = nullptr;
+
+// global variables, static so they don't clash with the archive's of the same names
+static lemlib::OdomSensors odomSensors(nullptr, nullptr, nullptr, nullptr, nullptr); // the sensors used for odometry
+static lemlib::Drivetrain drive(nullptr, nullptr, 0, 0, 0, 0); // the drivetrain to be used for odometry
+static lemlib::Pose odomPose(0, 0, 0); // the pose of the robot
+static lemlib::Pose odomSpeed(0, 0, 0); // the speed of the robot
+static lemlib::Pose odomLocalSpeed(0, 0, 0); // the local speed of the robot
+
+static float prevVertical = 0;
+static float prevVertical1 = 0;
+static float prevVertical2 = 0;
+static float prevHorizontal = 0;
+static float prevHorizontal1 = 0;
+static float prevHorizontal2 = 0;
+static float prevImu = 0;
+
+static uint32_t odomPeriod = 5; // ms between updates
+static bool updateTask = true; // whether init() starts trackingTask
+static std::atomic<bool> initialized = false; // update() can be called from another task
+static uint64_t odomTime = 0; // when the sensors behind odomPose were read, in microseconds
+static uint64_t prevOdomTime = 0;
+
+// the chassis from calibrateOdom(), whose archive pose is kept the same as odomPose, and what it was last set to
+static lemlib::Chassis* chassis = nullptr;
+static lemlib::Pose chassisPose(0, 0, 0);
+
+// the globals above are only touched by the odometry task and setPose(), which take turns with this. Everything else
+// reads the copy published at the end of each update
+static pros::Mutex odomMutex;
+static lemlib::Snapshot<lemlib::OdomState> odomState({});
+
+static void publish() { odomState.store({odomPose, odomSpeed, odomLocalSpeed, odomTime}); }
+
+// only made when usePoseFilter() is called
+static lemlib::PoseFilter* poseFilter = nullptr;
+static bool filterReset = true; // start the filter again from odomPose on the next update
+static float imuOffset = 0; // added to the IMU rotation to line it up with the filter's heading
+static float prevLeftDrive = 0;
+static float prevRightDrive = 0;
+
+// only set when useGps() is called
+static pros::Gps* gps = nullptr;
+static lemlib::GpsSettings gpsSettings;
+static lemlib::PoseHistory poseHistory; // odomPose at each update, to compare late GPS readings with
+static bool gpsReset = true; // start the history again from odomPose on the next update
+static float gpsVariance = 0; // in^2, how far odometry might have drifted since the GPS last corrected it
+static lemlib::Pose prevHistoryPose(0, 0, 0);
+static pros::gps_status_s_t prevGpsStatus {};
+static uint32_t rejectedGps = 0;
+static uint32_t rejectedGpsInARow = 0;
+
+static bool samePose(const lemlib::Pose& a, const lemlib::Pose& b) {
+    return a.x == b.x && a.y == b.y && a.theta == b.theta;
+}
+
+// the archive's motions read the archive's pose, so it is set to odomPose after every update. Only setPose() on the
+// chassis changes it otherwise, so a pose there that isn't the one it was last set to was set by hand and is taken
+static void syncChassis() {
+    if (chassis == nullptr) return;
+    const lemlib::Pose set = chassis->getPose(true);
+    if (!samePose(set, chassisPose)) {
+        odomPose = set;
+        filterReset = true;
+        gpsReset = true;
+    }
+}
+
+static void mirrorChassis() {
+    if (chassis == nullptr) return;
+    chassis->setPose(odomPose, true);
+    chassisPose = odomPose;
+}
+
+// average distance one side of the drivetrain has rolled, in inches. Each motor is read on its own so nothing is
+// allocated, unlike the motor group tracking wheels
+static float driveDistance(pros::MotorGroup* motors) {
+    const int count = motors->size();
+    float total = 0;
+    for (int i = 0; i < count; i++) {
+        float cartridgeRpm;
+        switch (motors->get_gearing(i)) {
+            case pros::MotorGears::red: cartridgeRpm = 100; break;
+            case pros::MotorGears::green: cartridgeRpm = 200; break;
+            case pros::MotorGears::blue: cartridgeRpm = 600; break;
+            default: cartridgeRpm = 200; break;
+        }
+        total += motors->get_position(i) / 360 * (drive.wheelDiameter * M_PI) * (drive.rpm / cartridgeRpm);
+    }
+    return count == 0 ? 0 : total / count;
+}
+
+// the pose filter's half of update(), every wheel's speed and the IMU go in and the pose comes out
+static void filterUpdate(uint64_t time, const float deltaVertical[2], const float deltaHorizontal[2], float imuRaw,
+                         float deltaImu) {
+    const float leftDrive = driveDistance(drive.leftMotors);
+    const float rightDrive = driveDistance(drive.rightMotors);
+    const float deltaLeft = leftDrive - prevLeftDrive;
+    const float deltaRight = rightDrive - prevRightDrive;
+    prevLeftDrive = leftDrive;
+    prevRightDrive = rightDrive;
+
+    prevOdomTime = odomTime;
+    odomTime = time;
+    if (filterReset || prevOdomTime == 0 || time <= prevOdomTime) {
+        poseFilter->reset(odomPose);
+        imuOffset = odomPose.theta - imuRaw;
+        filterReset = false;
+        return;
+    }
+    const float dt = (time - prevOdomTime) / 1e6f;
+    const lemlib::PoseFilterSettings& settings = poseFilter->getSettings();
+
+    poseFilter->predict(dt);
+    lemlib::TrackingWheel* const vertical[2] = {odomSensors.vertical1, odomSensors.vertical2};
+    lemlib::TrackingWheel* const horizontal[2] = {odomSensors.horizontal1, odomSensors.horizontal2};
+    bool sideways = false;
+    for (int i = 0; i < 2; i++) {
+        // motor group wheels are the drivetrain standing in for a tracking wheel, it is read below
+        if (vertical[i] != nullptr && !vertical[i]->getType()) {
+            poseFilter->measureVertical(deltaVertical[i] / dt, vertical[i]->getOffset(), settings.trackerNoise);
+        }
+        if (horizontal[i] != nullptr) {
+            poseFilter->measureHorizontal(deltaHorizontal[i] / dt, horizontal[i]->getOffset(), settings.trackerNoise);
+            sideways = true;
+        }
+    }
+    if (!sideways) poseFilter->measureNoSideways();
+    poseFilter->measureVertical(deltaLeft / dt, -drive.trackWidth / 2, settings.driveNoise);
+    poseFilter->measureVertical(deltaRight / dt, drive.trackWidth / 2, settings.driveNoise);
+    if (odomSensors.imu != nullptr) {
+        poseFilter->measureHeading(imuRaw + imuOffset);
+        poseFilter->measureTurnRate(deltaImu / dt);
+    }
+
+    odomPose = poseFilter->getPose();
+    odomLocalSpeed = poseFilter->getLocalSpeed();
+    // the local speed turned to the field, the same way odometry moves the pose
+    const float s = std::sin(odomPose.theta);
+    const float c = std::cos(odomPose.theta);
+    odomSpeed = lemlib::Pose(odomLocalSpeed.y * s - odomLocalSpeed.x * c, odomLocalSpeed.y * c + odomLocalSpeed.x * s,
+                             odomLocalSpeed.theta);
+}
+
+void lemlib::setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain) {
+    odomSensors = sensors;
+    drive = drivetrain;
+}
+
+lemlib::OdomState lemlib::getOdomState(bool radians) {
+    OdomState state = odomState.load();
+    if (!radians) {
+        state.pose.theta = radToDeg(state.pose.theta);
+        state.speed.theta = radToDeg(state.speed.theta);
+        state.localSpeed.theta = radToDeg(state.localSpeed.theta);
+    }
+    return state;
+}
+
+lemlib::Pose lemlib::getPose(bool radians) { return getOdomState(radians).pose; }
+
+void lemlib::setPose(lemlib::Pose pose, bool radians) {
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    if (radians) odomPose = pose;
+    else odomPose = lemlib::Pose(pose.x, pose.y, degToRad(pose.theta));
+    filterReset = true;
+    gpsReset = true;
+    publish();
+    mirrorChassis();
+}
+
+lemlib::Pose lemlib::getSpeed(bool radians) { return getOdomState(radians).speed; }
+
+lemlib::Pose lemlib::getLocalSpeed(bool radians) { return getOdomState(radians).localSpeed; }
+
+uint64_t lemlib::getPoseTime() { return odomState.load().time; }
+
+lemlib::Pose lemlib::estimatePose(float time, bool radians) {
+    // get current position and speed, from the same update
+    const OdomState state = getOdomState(true);
+    Pose curPose = state.pose;
+    Pose localSpeed = state.localSpeed;
+    // the pose is as old as the sensor readings it came from, so look ahead from when they were read
+    if (state.time != 0) time += (pros::micros() - state.time) / 1e6f;
+    // calculate the change in local position
+    Pose deltaLocalPose = localSpeed * time;
+
+    // calculate the future pose
+    float avgHeading = curPose.theta + deltaLocalPose.theta / 2;
+    Pose futurePose = curPose;
+    futurePose.x += deltaLocalPose.y * sin(avgHeading);
+    futurePose.y += deltaLocalPose.y * cos(avgHeading);
+    futurePose.x += deltaLocalPose.x * -cos(avgHeading);
+    futurePose.y += deltaLocalPose.x * sin(avgHeading);
+    if (!radians) futurePose.theta = radToDeg(futurePose.theta);
+
+    return futurePose;
+}
+
+// dead reckoning or the pose filter, everything one update does but the GPS and publishing
+static void track() {
+    // get the current sensor values, and when they were read
+    const uint64_t time = pros::micros();
+    float vertical1Raw = 0;
+    float vertical2Raw = 0;
+    float horizontal1Raw = 0;
+    float horizontal2Raw = 0;
+    float imuRaw = 0;
+    if (odomSensors.vertical1 != nullptr) vertical1Raw = odomSensors.vertical1->getDistanceTraveled();
+    if (odomSensors.vertical2 != nullptr) vertical2Raw = odomSensors.vertical2->getDistanceTraveled();
+    if (odomSensors.horizontal1 != nullptr) horizontal1Raw = odomSensors.horizontal1->getDistanceTraveled();
+    if (odomSensors.horizontal2 != nullptr) horizontal2Raw = odomSensors.horizontal2->getDistanceTraveled();
+    if (odomSensors.imu != nullptr) imuRaw = lemlib::degToRad(odomSensors.imu->get_rotation());
+
+    // calculate the change in sensor values
+    float deltaVertical1 = vertical1Raw - prevVertical1;
+    float deltaVertical2 = vertical2Raw - prevVertical2;
+    float deltaHorizontal1 = horizontal1Raw - prevHorizontal1;
+    float deltaHorizontal2 = horizontal2Raw - prevHorizontal2;
+    float deltaImu = imuRaw - prevImu;
+
+    // update the previous sensor values
+    prevVertical1 = vertical1Raw;
+    prevVertical2 = vertical2Raw;
+    prevHorizontal1 = horizontal1Raw;
+    prevHorizontal2 = horizontal2Raw;
+    prevImu = imuRaw;
+
+    if (poseFilter != nullptr) {
+        const float deltaVertical[2] = {deltaVertical1, deltaVertical2};
+        const float deltaHorizontal[2] = {deltaHorizontal1, deltaHorizontal2};
+        filterUpdate(time, deltaVertical, deltaHorizontal, imuRaw, deltaImu);
+        return;
+    }
+
+    // calculate the heading of the robot
+    // Priority:
+    // 1. Horizontal tracking wheels
+    // 2. Vertical tracking wheels
+    // 3. Inertial Sensor
+    // 4. Drivetrain
+    float heading = odomPose.theta;
+    // calculate the heading using the horizontal tracking wheels
+    if (odomSensors.horizontal1 != nullptr && odomSensors.horizontal2 != nullptr)
+        heading -= (deltaHorizontal1 - deltaHorizontal2) /
+                   (odomSensors.horizontal1->getOffset() - odomSensors.horizontal2->getOffset());
+    // else, if both vertical tracking wheels aren't substituted by the drivetrain, use the vertical tracking wheels
+    else if (odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr &&
+             !odomSensors.vertical1->getType() && !odomSensors.vertical2->getType())
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    // else, if the inertial sensor exists, use it
+    else if (odomSensors.imu != nullptr) heading += deltaImu;
+    // else, use the the substituted tracking wheels
+    else if (odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr)
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    float deltaHeading = heading - odomPose.theta;
+    float avgHeading = odomPose.theta + deltaHeading / 2;
+
+    // choose tracking wheels to use
+    // Prioritize non-powered tracking wheels
+    lemlib::TrackingWheel* verticalWheel = nullptr;
+    lemlib::TrackingWheel* horizontalWheel = nullptr;
+    if (odomSensors.vertical1 != nullptr && !odomSensors.vertical1->getType()) verticalWheel = odomSensors.vertical1;
+    else if (odomSensors.vertical2 != nullptr && !odomSensors.vertical2->getType())
+        verticalWheel = odomSensors.vertical2;
+    else if (odomSensors.vertical1 != nullptr) verticalWheel = odomSensors.vertical1;
+    else verticalWheel = odomSensors.vertical2;
+    if (odomSensors.horizontal1 != nullptr) horizontalWheel = odomSensors.horizontal1;
+    else if (odomSensors.horizontal2 != nullptr) horizontalWheel = odomSensors.horizontal2;
+    // the readings from the top of the update, so everything comes from the same moment
+    float rawVertical = verticalWheel == odomSensors.vertical1 ? vertical1Raw : vertical2Raw;
+    float rawHorizontal = horizontalWheel == odomSensors.horizontal1 ? horizontal1Raw : horizontal2Raw;
+    float horizontalOffset = 0;
+    float verticalOffset = 0;
+    if (verticalWheel != nullptr) verticalOffset = verticalWheel->getOffset();
+    if (horizontalWheel != nullptr) horizontalOffset = horizontalWheel->getOffset();
+
+    // calculate change in x and y
+    float deltaX = 0;
+    float deltaY = 0;
+    if (verticalWheel != nullptr) deltaY = rawVertical - prevVertical;
+    if (horizontalWheel != nullptr) deltaX = rawHorizontal - prevHorizontal;
+    prevVertical = rawVertical;
+    prevHorizontal = rawHorizontal;
+
+    // calculate local x and y
+    float localX = 0;
+    float localY = 0;
+    if (deltaHeading == 0) { // prevent divide by 0
+        localX = deltaX;
+        localY = deltaY;
+    } else {
+        localX = 2 * sin(deltaHeading / 2) * (deltaX / deltaHeading + horizontalOffset);
+        localY = 2 * sin(deltaHeading / 2) * (deltaY / deltaHeading + verticalOffset);
+    }
+
+    // save previous pose
+    lemlib::Pose prevPose = odomPose;
+
+    // calculate global x and y
+    odomPose.x += localY * sin(avgHeading);
+    odomPose.y += localY * cos(avgHeading);
+    odomPose.x += localX * -cos(avgHeading);
+    odomPose.y += localX * sin(avgHeading);
+    odomPose.theta = heading;
+
+    // the time the sensors were actually read between updates, not the nominal period. The first update only sets
+    // the starting time
+    prevOdomTime = odomTime;
+    odomTime = time;
+    if (prevOdomTime == 0 || time <= prevOdomTime) return;
+    const float dt = (time - prevOdomTime) / 1e6f;
+    // the smoothing the original used at a 10 ms period, scaled so the filter settles just as fast at any period
+    const float smooth = 1 - std::pow(0.05f, dt / 0.01f);
+
+    // calculate speed
+    odomSpeed.x = lemlib::ema((odomPose.x - prevPose.x) / dt, odomSpeed.x, smooth);
+    odomSpeed.y = lemlib::ema((odomPose.y - prevPose.y) / dt, odomSpeed.y, smooth);
+    odomSpeed.theta = lemlib::ema((odomPose.theta - prevPose.theta) / dt, odomSpeed.theta, smooth);
+
+    // calculate local speed
+    odomLocalSpeed.x = lemlib::ema(localX / dt, odomLocalSpeed.x, smooth);
+    odomLocalSpeed.y = lemlib::ema(localY / dt, odomLocalSpeed.y, smooth);
+    odomLocalSpeed.theta = lemlib::ema(deltaHeading / dt, odomLocalSpeed.theta, smooth);
+}
+
+// compares the newest GPS reading, if there is one, with where odometry had the robot when it was taken, and moves
+// odomPose by the correction
+static void gpsUpdate() {
+    constexpr float INCHES_PER_METER = 39.3701;
+    if (gpsReset) {
+        poseHistory.clear();
+        // as sure of the pose just set as of the best GPS reading
+        gpsVariance = gpsSettings.minError * gpsSettings.minError;
+        prevHistoryPose = odomPose;
+        gpsReset = false;
+    }
+    // odometry drifts as it drives, more the further it goes
+    gpsVariance += gpsSettings.odomNoise * gpsSettings.odomNoise * odomPose.distance(prevHistoryPose);
+    poseHistory.push(odomTime, odomPose);
+    prevHistoryPose = odomPose;
+
+    // readings come every 20 ms or so, one that hasn't changed has already been used. PROS_ERR_F is infinite
+    const pros::gps_status_s_t status = gps->get_position_and_orientation();
+    if (!std::isfinite(status.x) || !std::isfinite(status.y) || !std::isfinite(status.yaw)) return;
+    if (status.x == prevGpsStatus.x && status.y == prevGpsStatus.y && status.yaw == prevGpsStatus.yaw) return;
+    prevGpsStatus = status;
+
+    const uint64_t latency = gpsSettings.latency * 1000;
+    if (odomTime <= latency) return;
+    const uint64_t sampleTime = odomTime - latency;
+    lemlib::Pose then(0, 0, 0);
+    if (!poseHistory.at(sampleTime, then)) return;
+
+    const float errorX = status.x * INCHES_PER_METER - then.x;
+    const float errorY = status.y * INCHES_PER_METER - then.y;
+    const float gpsError = std::max<float>(gpsSettings.minError, gps->get_error() * INCHES_PER_METER);
+    const float gpsVarianceNow = gpsError * gpsError;
+    // the expected squared distance between them is twice the variance of each, one for x and one for y
+    const float squaredError = errorX * errorX + errorY * errorY;
+    if (squaredError > gpsSettings.gate * 2 * (gpsVariance + gpsVarianceNow)) {
+        rejectedGps++;
+        if (++rejectedGpsInARow <= gpsSettings.trustAfter) return;
+        // every reading for a while says odometry is off by about this much, so it probably is
+        gpsVariance = std::max(gpsVariance, squaredError / 2);
+    }
+    rejectedGpsInARow = 0;
+
+    const float gain = gpsVariance / (gpsVariance + gpsVarianceNow);
+    const float errorTheta = lemlib::angleError(lemlib::degToRad(status.yaw), then.theta);
+    const lemlib::Pose corrected(then.x + gain * errorX, then.y + gain * errorY,
+                                 then.theta + gpsSettings.headingWeight * errorTheta);
+    gpsVariance *= 1 - gain;
+
+    // everything since the reading was taken, replayed from the corrected pose
+    const lemlib::Pose now = poseHistory.correct(sampleTime, corrected);
+    const float turn = now.theta - odomPose.theta;
+    odomPose = now;
+    prevHistoryPose = now;
+    if (poseFilter != nullptr) {
+        poseFilter->setPose(odomPose);
+        imuOffset += turn;
+    }
+}
+
+void lemlib::update() {
+    // nothing to read until setSensors() and init(), e.g. a scheduler job that starts before calibrateOdom()
+    if (!initialized) return;
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    syncChassis();
+    track();
+    if (gps != nullptr && odomTime != 0) gpsUpdate();
+    publish();
+    mirrorChassis();
+}
+
+void lemlib::setUpdatePeriod(uint32_t ms) { odomPeriod = std::max<uint32_t>(ms, 1); }
+
+void lemlib::setUpdateTask(bool enabled) { updateTask = enabled; }
+
+void lemlib::usePoseFilter(PoseFilterSettings settings) {
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    if (poseFilter == nullptr) poseFilter = new PoseFilter(settings);
+    else *poseFilter = PoseFilter(settings);
+    filterReset = true;
+}
+
+void lemlib::useGps(pros::Gps* sensor, GpsSettings settings) {
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    gps = sensor;
+    gpsSettings = settings;
+    gpsReset = true;
+}
+
+uint32_t lemlib::getRejectedGpsReadings() { return rejectedGps; }
+
+uint32_t lemlib::getRejectedReadings() { return poseFilter == nullptr ? 0 : poseFilter->getRejected(); }
+
+void lemlib::init() {
+    if (initialized) return;
+    initialized = true;
+    // have the sensors send new readings as often as they are used, 5 ms is as fast as they go
+    const uint32_t dataRate = std::max<uint32_t>(5, odomPeriod);
+    for (TrackingWheel* wheel :
+         {odomSensors.vertical1, odomSensors.vertical2, odomSensors.horizontal1, odomSensors.horizontal2}) {
+        if (wheel != nullptr) wheel->setDataRate(dataRate);
+    }
+    if (odomSensors.imu != nullptr) odomSensors.imu->set_data_rate(dataRate);
+    // the pose filter reads the drive motors itself
+    if (drive.leftMotors != nullptr) drive.leftMotors->set_encoder_units_all(pros::MotorEncoderUnits::degrees);
+    if (drive.rightMotors != nullptr) drive.rightMotors->set_encoder_units_all(pros::MotorEncoderUnits::degrees);
+    if (!updateTask) return;
+
+    // above the motion and user tasks, so a busy loop elsewhere doesn't stretch the time between updates
+    trackingTask = new pros::Task {[=] {
+        uint32_t now = pros::millis();
+        while (true) {
+            update();
+            pros::Task::delay_until(&now, odomPeriod);
+        }
+    }, TASK_PRIORITY_DEFAULT + 2, TASK_STACK_DEPTH_DEFAULT, "LemLib Odom"};
+}
+
+void lemlib::Chassis::calibrateOdom(bool calibrateImu) {
+    // what calibrate() does, but with the setSensors() and init() above
+    if (calibrateImu && sensors.imu != nullptr) {
+        sensors.imu->reset();
+        do pros::delay(10);
+        while (sensors.imu->is_calibrating());
+    }
+    // the drive sides stand in for missing vertical tracking wheels
+    if (sensors.vertical1 == nullptr) {
+        sensors.vertical1 = new TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                              -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    }
+    if (sensors.vertical2 == nullptr) {
+        sensors.vertical2 = new TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                              drivetrain.trackWidth / 2, drivetrain.rpm);
+    }
+    for (TrackingWheel* wheel : {sensors.vertical1, sensors.vertical2, sensors.horizontal1, sensors.horizontal2}) {
+        if (wheel != nullptr) wheel->reset();
+    }
+    {
+        std::lock_guard<pros::Mutex> lock(odomMutex);
+        chassis = this;
+        // whatever pose was set before this is where odometry starts
+        odomPose = getPose(true);
+        chassisPose = odomPose;
+        filterReset = true;
+        gpsReset = true;
+        publish();
+    }
+    lemlib::setSensors(sensors, drivetrain);
+    lemlib::init();
+}
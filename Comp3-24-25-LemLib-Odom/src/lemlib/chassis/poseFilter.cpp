@@ -0,0 +1,125 @@
+#include <cmath>
+
+#include "lemlib/chassis/poseFilter.hpp"
+
+namespace lemlib {
+// where each value is in the state
+constexpr size_t X = 0;
+constexpr size_t Y = 1;
+constexpr size_t THETA = 2;
+constexpr size_t FORWARD = 3;
+constexpr size_t SIDEWAYS = 4;
+constexpr size_t TURN = 5;
+
+PoseFilter::PoseFilter(PoseFilterSettings settings)
+    : settings(settings) {
+    reset(Pose(0, 0, 0));
+}
+
+void PoseFilter::reset(Pose pose) {
+    state = Vector<STATES>();
+    state(X, 0) = pose.x;
+    state(Y, 0) = pose.y;
+    state(THETA, 0) = pose.theta;
+    // the pose is what we were told, the robot is probably still
+    covariance = Matrix<STATES, STATES>();
+    covariance(X, X) = covariance(Y, Y) = 0.01;
+    covariance(THETA, THETA) = 0.0001;
+    covariance(FORWARD, FORWARD) = covariance(SIDEWAYS, SIDEWAYS) = 1;
+    covariance(TURN, TURN) = 0.01;
+}
+
+void PoseFilter::setPose(Pose pose) {
+    state(X, 0) = pose.x;
+    state(Y, 0) = pose.y;
+    state(THETA, 0) = pose.theta;
+}
+
+void PoseFilter::predict(float dt) {
+    const float theta = state(THETA, 0);
+    const float forward = state(FORWARD, 0);
+    const float sideways = state(SIDEWAYS, 0);
+    const float s = std::sin(theta);
+    const float c = std::cos(theta);
+
+    // local x is to the left, so it moves the robot along -cos, sin like in odom.cpp
+    state(X, 0) += (forward * s - sideways * c) * dt;
+    state(Y, 0) += (forward * c + sideways * s) * dt;
+    state(THETA, 0) += state(TURN, 0) * dt;
+
+    // how each new value changes with each old one
+    Matrix<STATES, STATES> jacobian = Matrix<STATES, STATES>::identity();
+    jacobian(X, THETA) = (forward * c + sideways * s) * dt;
+    jacobian(X, FORWARD) = s * dt;
+    jacobian(X, SIDEWAYS) = -c * dt;
+    jacobian(Y, THETA) = (-forward * s + sideways * c) * dt;
+    jacobian(Y, FORWARD) = c * dt;
+    jacobian(Y, SIDEWAYS) = s * dt;
+    jacobian(THETA, TURN) = dt;
+
+    // the speeds can have changed by up to an acceleration's worth since the last update, and the distance covered
+    // changes with them. Tying the two together is what lets a wheel's speed correct the position as well
+    Matrix<STATES, 3> speedChange;
+    speedChange(X, 0) = s * dt;
+    speedChange(X, 1) = -c * dt;
+    speedChange(Y, 0) = c * dt;
+    speedChange(Y, 1) = s * dt;
+    speedChange(THETA, 2) = dt;
+    speedChange(FORWARD, 0) = speedChange(SIDEWAYS, 1) = speedChange(TURN, 2) = 1;
+    Matrix<3, 3> speedNoise;
+    speedNoise(0, 0) = speedNoise(1, 1) = std::pow(settings.acceleration * dt, 2.0f);
+    speedNoise(2, 2) = std::pow(settings.angularAcceleration * dt, 2.0f);
+    const Matrix<STATES, STATES> noise = speedChange * speedNoise * speedChange.transpose();
+
+    covariance = jacobian * covariance * jacobian.transpose() + noise;
+}
+
+bool PoseFilter::measure(size_t stateIndex, float turnRateWeight, float reading, float variance, bool gated) {
+    // the reading is state[stateIndex] + turnRateWeight * state[TURN], so only two columns of the covariance matter
+    Vector<STATES> spread;
+    for (size_t i = 0; i < STATES; i++) spread(i, 0) = covariance(i, stateIndex) + turnRateWeight * covariance(i, TURN);
+    const float expected = state(stateIndex, 0) + turnRateWeight * state(TURN, 0);
+    const float innovation = reading - expected;
+    const float innovationVariance = spread(stateIndex, 0) + turnRateWeight * spread(TURN, 0) + variance;
+
+    if (gated && innovation * innovation > settings.gate * innovationVariance) {
+        rejected++;
+        return false;
+    }
+
+    const Vector<STATES> gain = spread * (1 / innovationVariance);
+    state = state + gain * innovation;
+    covariance = covariance - gain * spread.transpose();
+    return true;
+}
+
+bool PoseFilter::measureVertical(float speed, float offset, float noise) {
+    // turning clockwise moves a wheel on the right backwards
+    return measure(FORWARD, -offset, speed, noise * noise, true);
+}
+
+bool PoseFilter::measureHorizontal(float speed, float offset, float noise) {
+    // turning clockwise moves a wheel in front to the right, which is negative
+    return measure(SIDEWAYS, -offset, speed, noise * noise, true);
+}
+
+void PoseFilter::measureHeading(float theta) {
+    measure(THETA, 0, theta, settings.headingNoise * settings.headingNoise, false);
+}
+
+bool PoseFilter::measureTurnRate(float rate) {
+    return measure(TURN, 0, rate, settings.turnRateNoise * settings.turnRateNoise, true);
+}
+
+void PoseFilter::measureNoSideways() {
+    measure(SIDEWAYS, 0, 0, settings.sidewaysNoise * settings.sidewaysNoise, false);
+}
+
+Pose PoseFilter::getPose() const { return Pose(state(X, 0), state(Y, 0), state(THETA, 0)); }
+
+Pose PoseFilter::getLocalSpeed() const { return Pose(state(SIDEWAYS, 0), state(FORWARD, 0), state(TURN, 0)); }
+
+const PoseFilterSettings& PoseFilter::getSettings() const { return settings; }
+
+uint32_t PoseFilter::getRejected() const { return rejected; }
+} // namespace lemlib
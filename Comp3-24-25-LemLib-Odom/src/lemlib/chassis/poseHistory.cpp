@@ -0,0 +1,64 @@
+#include <cmath>
+
+#include "lemlib/chassis/poseHistory.hpp"
+
+namespace lemlib {
+void PoseHistory::push(uint64_t time, Pose pose) {
+    if (size == CAPACITY) {
+        oldest = index(1);
+        size--;
+    }
+    entries[index(size)] = {time, pose};
+    size++;
+}
+
+void PoseHistory::clear() {
+    oldest = 0;
+    size = 0;
+}
+
+bool PoseHistory::at(uint64_t time, Pose& pose) const {
+    if (size == 0 || time < entries[oldest].time) return false;
+    // newest first, a late reading is usually only a few updates old
+    for (size_t i = size; i-- > 0;) {
+        const Entry& before = entries[index(i)];
+        if (before.time > time) continue;
+        if (i == size - 1 || before.time == time) {
+            pose = before.pose;
+            return true;
+        }
+        const Entry& after = entries[index(i + 1)];
+        const float t = float(time - before.time) / float(after.time - before.time);
+        pose = before.pose.lerp(after.pose, t);
+        pose.theta = before.pose.theta + (after.pose.theta - before.pose.theta) * t;
+        return true;
+    }
+    return false;
+}
+
+Pose PoseHistory::correct(uint64_t time, Pose corrected) {
+    Pose pivot(0, 0, 0);
+    if (!at(time, pivot)) return corrected;
+    const float turn = corrected.theta - pivot.theta;
+    const float s = std::sin(turn);
+    const float c = std::cos(turn);
+
+    // move everything after the time
+    size_t later = size;
+    while (entries[index(later - 1)].time > time) later--;
+    for (size_t i = later; i < size; i++) {
+        Pose& pose = entries[index(i)].pose;
+        // clockwise, like the heading
+        const float dx = pose.x - pivot.x;
+        const float dy = pose.y - pivot.y;
+        pose.x = corrected.x + dx * c + dy * s;
+        pose.y = corrected.y - dx * s + dy * c;
+        pose.theta += turn;
+    }
+    // and let the corrected pose take the place of everything before, so it is what later corrections start from
+    oldest = index(later - 1);
+    size -= later - 1;
+    entries[oldest] = {time, corrected};
+    return entries[index(size - 1)].pose;
+}
+} // namespace lemlib
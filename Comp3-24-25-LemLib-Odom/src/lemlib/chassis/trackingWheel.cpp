@@ -0,0 +1,7 @@
+// The one member this adds to LemLib 0.5.4's TrackingWheel. The rest of it is the archive's
+
+#include "lemlib/chassis/trackingWheel.hpp"
+
+void lemlib::TrackingWheel::setDataRate(uint32_t rate) {
+    if (this->rotation != nullptr) this->rotation->set_data_rate(rate);
+}
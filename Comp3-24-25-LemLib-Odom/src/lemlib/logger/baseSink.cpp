@@ -0,0 +1,27 @@
+#include "lemlib/logger/baseSink.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+BaseSink::BaseSink(std::initializer_list<std::shared_ptr<BaseSink>> sinks)
+    : sinks(sinks) {}
+
+void BaseSink::setLowestLevel(Level level) {
+    if (!sinks.empty()) {
+        for (const std::shared_ptr<BaseSink>& sink : sinks) { sink->setLowestLevel(level); }
+        return;
+    }
+
+    lowestLevel = level;
+}
+
+Level BaseSink::getLowestLevel() const { return lowestLevel; }
+
+void BaseSink::setFormat(const std::string& format) { logFormat = format; }
+
+void BaseSink::sendMessage(const Message& message) {}
+
+fmt::dynamic_format_arg_store<fmt::format_context> BaseSink::getExtraFormattingArgs(const Message& messageInfo) {
+    return {};
+}
+} // namespace rebuilt
+} // namespace lemlib
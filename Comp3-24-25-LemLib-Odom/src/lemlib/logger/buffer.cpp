@@ -0,0 +1,52 @@
+#include "lemlib/logger/buffer.hpp"
+#include <array>
+
+namespace lemlib {
+inline namespace rebuilt {
+Buffer::Buffer(std::function<void(std::string_view)> bufferFunc, size_t capacity)
+    : bufferFunc(bufferFunc),
+      ring(capacity),
+      task([&]() { taskLoop(); }) {}
+
+Buffer::~Buffer() { task.remove(); }
+
+bool Buffer::pushToBuffer(const std::string& bufferData) { return pushToBuffer(bufferData.data(), bufferData.size()); }
+
+bool Buffer::pushToBuffer(const char* data, size_t size) {
+    if (size > RecordRing::MAX_RECORD) {
+        size = RecordRing::MAX_RECORD;
+        truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    while (!ring.push(data, size)) {
+        if (policy.load(std::memory_order_relaxed) == OverflowPolicy::DROP) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        pros::delay(1);
+    }
+    return true;
+}
+
+void Buffer::taskLoop() {
+    std::array<char, RecordRing::MAX_RECORD> record;
+    while (true) {
+        // everything that is ready, so a burst doesn't back up behind the rate
+        int size;
+        while ((size = ring.pop(record.data())) >= 0) bufferFunc(std::string_view(record.data(), size));
+        pros::delay(rate.load(std::memory_order_relaxed));
+    }
+}
+
+bool Buffer::buffersEmpty() { return ring.empty(); }
+
+void Buffer::setRate(uint32_t rate) { this->rate.store(rate, std::memory_order_relaxed); }
+
+void Buffer::setOverflowPolicy(OverflowPolicy policy) { this->policy.store(policy, std::memory_order_relaxed); }
+
+uint32_t Buffer::getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+uint32_t Buffer::getTruncated() const { return truncated.load(std::memory_order_relaxed); }
+
+size_t Buffer::getHighWater() const { return ring.getHighWater(); }
+} // namespace rebuilt
+} // namespace lemlib
@@ -0,0 +1,20 @@
+#include "lemlib/logger/infoSink.hpp"
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+InfoSink::InfoSink() { setFormat("[LemLib] {level}: {message}"); }
+
+void InfoSink::sendMessage(const Message& message) {
+    const char* color = "";
+    switch (message.level) {
+        case Level::INFO: color = "\033[32m"; break; // green
+        case Level::DEBUG: color = "\033[36m"; break; // cyan
+        case Level::WARN: color = "\033[33m"; break; // yellow
+        case Level::ERROR: color = "\033[31m"; break; // red
+        case Level::FATAL: color = "\033[31;1m"; break; // bold red
+    }
+    bufferedStdout().print("{}{}\033[0m\n", color, message.message);
+}
+} // namespace rebuilt
+} // namespace lemlib
@@ -0,0 +1,15 @@
+#include "lemlib/logger/logger.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+std::shared_ptr<InfoSink> infoSink() {
+    static std::shared_ptr<InfoSink> sink = std::make_shared<InfoSink>();
+    return sink;
+}
+
+std::shared_ptr<TelemetrySink> telemetrySink() {
+    static std::shared_ptr<TelemetrySink> sink = std::make_shared<TelemetrySink>();
+    return sink;
+}
+} // namespace rebuilt
+} // namespace lemlib
@@ -0,0 +1,16 @@
+#include "lemlib/logger/message.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+std::string format_as(Level level) {
+    switch (level) {
+        case Level::INFO: return "INFO";
+        case Level::DEBUG: return "DEBUG";
+        case Level::WARN: return "WARN";
+        case Level::ERROR: return "ERROR";
+        case Level::FATAL: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
+} // namespace rebuilt
+} // namespace lemlib
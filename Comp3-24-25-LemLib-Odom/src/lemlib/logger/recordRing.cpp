@@ -0,0 +1,95 @@
+#include "lemlib/logger/recordRing.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace lemlib {
+inline namespace rebuilt {
+namespace {
+uint32_t roundUpToPowerOfTwo(size_t value) {
+    uint32_t result = 4;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// header plus the record, padded so the next header is aligned
+uint32_t recordSize(size_t size) { return 4 + ((size + 3) & ~size_t(3)); }
+} // namespace
+
+RecordRing::RecordRing(size_t capacity)
+    : size(roundUpToPowerOfTwo(std::max<size_t>(capacity, recordSize(MAX_RECORD)))),
+      words(new uint32_t[size / 4]()) {}
+
+uint8_t* RecordRing::bytes() const { return reinterpret_cast<uint8_t*>(words.get()); }
+
+void RecordRing::copyIn(uint32_t position, const void* data, size_t count) {
+    const uint32_t offset = position & (size - 1);
+    const size_t first = std::min<size_t>(count, size - offset);
+    std::memcpy(bytes() + offset, data, first);
+    std::memcpy(bytes(), static_cast<const uint8_t*>(data) + first, count - first);
+}
+
+void RecordRing::clear(uint32_t position, size_t count) {
+    const uint32_t offset = position & (size - 1);
+    const size_t first = std::min<size_t>(count, size - offset);
+    std::memset(bytes() + offset, 0, first);
+    std::memset(bytes(), 0, count - first);
+}
+
+void RecordRing::copyOut(uint32_t position, void* out, size_t count) const {
+    const uint32_t offset = position & (size - 1);
+    const size_t first = std::min<size_t>(count, size - offset);
+    std::memcpy(out, bytes() + offset, first);
+    std::memcpy(static_cast<uint8_t*>(out) + first, bytes(), count - first);
+}
+
+bool RecordRing::push(const void* data, size_t count) {
+    if (count > MAX_RECORD) return false;
+    const uint32_t needed = recordSize(count);
+
+    // claim the space
+    uint32_t start = head.load(std::memory_order_relaxed);
+    uint32_t used;
+    do {
+        used = start + needed - tail.load(std::memory_order_acquire);
+        if (used > size) return false;
+    } while (!head.compare_exchange_weak(start, start + needed, std::memory_order_relaxed));
+
+    uint32_t mark = highWater.load(std::memory_order_relaxed);
+    while (used > mark && !highWater.compare_exchange_weak(mark, used, std::memory_order_relaxed));
+
+    // the header goes in last, it is what tells the reader the record is there
+    copyIn(start + 4, data, count);
+    std::atomic_ref<uint32_t>(words[(start & (size - 1)) / 4]).store(count | WRITTEN, std::memory_order_release);
+    return true;
+}
+
+int RecordRing::pop(void* out) {
+    const uint32_t start = tail.load(std::memory_order_relaxed);
+    if (start == head.load(std::memory_order_acquire)) return -1;
+
+    uint32_t& header = words[(start & (size - 1)) / 4];
+    const uint32_t value = std::atomic_ref<uint32_t>(header).load(std::memory_order_acquire);
+    // claimed, but the task pushing it hasn't finished
+    if ((value & WRITTEN) == 0) return -1;
+
+    const uint32_t count = value & ~WRITTEN;
+    copyOut(start + 4, out, count);
+
+    // any word can be a header next time around, so they all have to read as
+    // not written before the space is handed back
+    const uint32_t freed = recordSize(count);
+    clear(start, freed);
+    tail.store(start + freed, std::memory_order_release);
+    return count;
+}
+
+bool RecordRing::empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+size_t RecordRing::capacity() const { return size; }
+
+size_t RecordRing::getHighWater() const { return highWater.load(std::memory_order_relaxed); }
+} // namespace rebuilt
+} // namespace lemlib
@@ -0,0 +1,17 @@
+#include <cstdio>
+
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+BufferedStdout::BufferedStdout()
+    : Buffer([](std::string_view text) { std::fwrite(text.data(), 1, text.size(), stdout); }) {
+    setRate(50);
+}
+
+BufferedStdout& bufferedStdout() {
+    static BufferedStdout bufferedStdout;
+    return bufferedStdout;
+}
+} // namespace rebuilt
+} // namespace lemlib
@@ -0,0 +1,75 @@
+#include <mutex>
+
+#include "lemlib/logger/telemetrySink.hpp"
+#include "lemlib/logger/stdout.hpp"
+#include "pros/misc.hpp"
+
+namespace lemlib {
+inline namespace rebuilt {
+TelemetrySink::TelemetrySink()
+    : binary([this](std::string_view record) { sendRecord(record); }, 8192) {
+    setFormat("TELE_START{message}TELE_END");
+    binary.setRate(10);
+}
+
+TelemetrySink::~TelemetrySink() {
+    std::lock_guard<pros::Mutex> lock(fileMutex);
+    if (file != nullptr) std::fclose(file);
+}
+
+void TelemetrySink::sendMessage(const Message& message) {
+    // printed then wiped from the terminal, it is only there for tools reading the output
+    bufferedStdout().print("\033[s{}\033[u\033[0J", message.message);
+}
+
+void TelemetrySink::setMode(Mode mode) { this->mode.store(mode, std::memory_order_relaxed); }
+
+void TelemetrySink::setFile(const char* path) {
+    std::lock_guard<pros::Mutex> lock(fileMutex);
+    if (file != nullptr) std::fclose(file);
+    file = path == nullptr ? nullptr : std::fopen(path, "ab");
+    fileChosen = true;
+    generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t TelemetrySink::getDropped() const { return binary.getDropped(); }
+
+bool TelemetrySink::describe(uint32_t id, std::string_view codes, std::string_view format) {
+    char data[telemetry::MAX_RECORD];
+    char* out = data;
+    const uint8_t kind = uint8_t(telemetry::RecordKind::FORMAT);
+    telemetry::write(out, &kind, 1);
+    telemetry::write(out, &id, sizeof(id));
+    telemetry::write(out, codes.data(), codes.size());
+    *out++ = '\0';
+    const size_t size = std::min(format.size(), size_t(data + sizeof(data) - out));
+    telemetry::write(out, format.data(), size);
+    return binary.pushToBuffer(data, out - data);
+}
+
+void TelemetrySink::sendRecord(std::string_view record) {
+    std::lock_guard<pros::Mutex> lock(fileMutex);
+    if (!fileChosen) {
+        fileChosen = true;
+        if (pros::usd::is_installed()) file = std::fopen(DEFAULT_FILE, "ab");
+    }
+
+    if (file != nullptr) {
+        const uint16_t size = record.size();
+        std::fwrite(&size, sizeof(size), 1, file);
+        std::fwrite(record.data(), 1, record.size(), file);
+        // the SD card is slow, so only once the backlog is written
+        if (binary.buffersEmpty()) std::fflush(file);
+        return;
+    }
+
+    static constexpr char digits[] = "0123456789abcdef";
+    char hex[2 * telemetry::MAX_RECORD];
+    for (size_t i = 0; i < record.size(); i++) {
+        hex[2 * i] = digits[uint8_t(record[i]) >> 4];
+        hex[2 * i + 1] = digits[uint8_t(record[i]) & 0xf];
+    }
+    bufferedStdout().print("\033[sBTEL_START{}BTEL_END\033[u\033[0J", std::string_view(hex, 2 * record.size()));
+}
+} // namespace rebuilt
+} // namespace lemlib
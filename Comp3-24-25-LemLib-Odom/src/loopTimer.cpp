@@ -0,0 +1,105 @@
+#include "loopTimer.hpp"
+#include "lemlib/logger/logger.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+namespace {
+// every LoopTimer alive, built on first use so timers can be globals in any file
+pros::Mutex& timersMutex() {
+    static pros::Mutex mutex;
+    return mutex;
+}
+
+std::vector<LoopTimer*>& timers() {
+    static std::vector<LoopTimer*> all;
+    return all;
+}
+} // namespace
+
+std::uint32_t LoopStats::meanTime() const { return runs == 0 ? 0 : totalTime / runs; }
+
+float LoopStats::utilization() const { return period == 0 ? 0 : meanTime() / (period * 1000.0f); }
+
+LoopTimer::LoopTimer(const char* name, std::uint32_t period) {
+    stats.name = name;
+    stats.period = period;
+    std::lock_guard<pros::Mutex> lock(timersMutex());
+    timers().push_back(this);
+}
+
+LoopTimer::~LoopTimer() {
+    std::lock_guard<pros::Mutex> lock(timersMutex());
+    timers().erase(std::remove(timers().begin(), timers().end(), this), timers().end());
+}
+
+void LoopTimer::start(std::uint64_t due) {
+    const std::uint64_t now = pros::micros();
+    std::lock_guard<pros::Mutex> lock(mutex);
+    started = now;
+    this->due = due;
+    if (now > due) stats.maxLatency = std::max<std::uint64_t>(stats.maxLatency, now - due);
+    if (lastStart != 0) {
+        const std::int64_t interval = now - lastStart;
+        const std::uint64_t off = std::abs(interval - std::int64_t(stats.period) * 1000);
+        const auto bin = std::lower_bound(LoopStats::JITTER_EDGES.begin(), LoopStats::JITTER_EDGES.end(), off);
+        stats.jitter[bin - LoopStats::JITTER_EDGES.begin()]++;
+    }
+    lastStart = now;
+}
+
+void LoopTimer::start() {
+    std::uint64_t next = 0;
+    {
+        std::lock_guard<pros::Mutex> lock(mutex);
+        if (lastStart != 0) next = lastStart + stats.period * 1000;
+    }
+    // the first run is due whenever it starts
+    start(next == 0 ? pros::micros() : next);
+}
+
+void LoopTimer::stop() {
+    const std::uint64_t now = pros::micros();
+    std::lock_guard<pros::Mutex> lock(mutex);
+    const std::uint32_t time = now - started;
+    stats.runs++;
+    stats.lastTime = time;
+    stats.maxTime = std::max(stats.maxTime, time);
+    stats.totalTime += time;
+    if (now > due + stats.period * 1000) stats.misses++;
+}
+
+LoopStats LoopTimer::getStats() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return stats;
+}
+
+void LoopTimer::reset() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    const LoopStats old = stats;
+    stats = {};
+    stats.name = old.name;
+    stats.period = old.period;
+    lastStart = 0;
+}
+
+std::vector<LoopTimer*> LoopTimer::getAll() {
+    std::lock_guard<pros::Mutex> lock(timersMutex());
+    return timers();
+}
+
+void LoopTimer::resetAll() {
+    for (LoopTimer* timer : getAll()) timer->reset();
+}
+
+void LoopTimer::recordAll() {
+    const auto telemetry = lemlib::telemetrySink();
+    for (LoopTimer* timer : getAll()) {
+        const LoopStats stats = timer->getStats();
+        const auto& j = stats.jitter;
+        telemetry->record<lemlib::Level::INFO, "Loop timing: {} every {} ms, {} runs, mean {} us, max {} us, worst "
+                                               "latency {} us, {} missed, cpu {}, jitter {} {} {} {} {} {} {} {}">(
+            stats.name, stats.period, stats.runs, stats.meanTime(), stats.maxTime, stats.maxLatency, stats.misses,
+            stats.utilization(), j[0], j[1], j[2], j[3], j[4], j[5], j[6], j[7]);
+    }
+}
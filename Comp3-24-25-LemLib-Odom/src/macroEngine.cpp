@@ -0,0 +1,98 @@
+#include "macroEngine.hpp"
+#include <mutex>
+#include <utility>
+
+Macro::Macro(std::uint8_t mechanisms, std::initializer_list<MacroStep> steps, std::function<void()> finish)
+    : mechanisms(mechanisms),
+      steps(steps),
+      finish(std::move(finish)) {}
+
+std::uint8_t Macro::getMechanisms() const { return mechanisms; }
+
+void MacroEngine::run() {
+    std::uint32_t now = pros::millis();
+    while (true) {
+        update(now);
+        pros::Task::delay_until(&now, PERIOD);
+    }
+}
+
+bool MacroEngine::start(const Macro& macro) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    Slot* free = nullptr;
+    for (Slot& slot : slots) {
+        if (slot.macro != nullptr && (slot.macro->mechanisms & macro.mechanisms)) end(slot);
+        if (slot.macro == nullptr && free == nullptr) free = &slot;
+    }
+    if (free == nullptr) return false;
+    // the first step starts on the next tick, with every other macro
+    *free = {&macro, 0, false, 0};
+    return true;
+}
+
+void MacroEngine::cancel(const Macro& macro) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    for (Slot& slot : slots) {
+        if (slot.macro == &macro) end(slot);
+    }
+}
+
+void MacroEngine::cancelAll() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    for (Slot& slot : slots) {
+        if (slot.macro != nullptr) end(slot);
+    }
+}
+
+bool MacroEngine::isRunning(const Macro& macro) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    for (const Slot& slot : slots) {
+        if (slot.macro == &macro) return true;
+    }
+    return false;
+}
+
+bool MacroEngine::isUsing(std::uint8_t mechanisms) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    for (const Slot& slot : slots) {
+        if (slot.macro != nullptr && (slot.macro->mechanisms & mechanisms)) return true;
+    }
+    return false;
+}
+
+void MacroEngine::waitUntilDone(const Macro& macro, std::uint32_t timeout) {
+    const std::uint32_t start = pros::millis();
+    while (isRunning(macro)) {
+        if (timeout > 0 && pros::millis() - start >= timeout) return;
+        pros::delay(PERIOD);
+    }
+}
+
+void MacroEngine::end(Slot& slot) {
+    const Macro* macro = slot.macro;
+    slot = {};
+    if (macro->finish) macro->finish();
+}
+
+void MacroEngine::update(std::uint32_t now) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    for (Slot& slot : slots) {
+        // steps that are already done hand over on the same tick, so a macro never waits a tick for nothing
+        while (slot.macro != nullptr) {
+            if (slot.step == slot.macro->steps.size()) {
+                end(slot);
+                break;
+            }
+            const MacroStep& step = slot.macro->steps[slot.step];
+            if (!slot.started) {
+                if (step.action) step.action();
+                slot.started = true;
+                slot.startedAt = now;
+            }
+            const bool timedOut = step.timeout > 0 && now - slot.startedAt >= step.timeout;
+            if (step.done && !step.done() && !timedOut) break;
+            slot.step++;
+            slot.started = false;
+        }
+    }
+}
@@ -1,11 +1,13 @@
 #include "main.h"
 #include "lemlib/api.hpp" // IWYU pragma: keep
+#include "lemlib/chassis/odom.hpp"
 #include "lemlib/chassis/trackingWheel.hpp"
 #include "pros/adi.h"
 #include "pros/adi.hpp"
 #include "pros/misc.h"
 #include "pros/motors.h"
 #include <atomic>
+#include <cmath>
 #include "autons.hpp"
 #include "subsystems.hpp"
 
@@ -26,10 +28,6 @@ const int lbMid = 420;
 const int lbScore = 2000;
 const int positions[] = {lbDown, lbMid, lbScore};
 
-bool isColorSortEnabled = true;  // Start enabled by default
-std::atomic<bool> isRedTeam(true); // Atomic for thread safety
-pros::Task* colorSortTask = nullptr;
-
 // electronics declarations
 pros::Controller controller(pros::E_CONTROLLER_MASTER);
 
@@ -99,55 +97,71 @@ pros::Motor intakeHigh(-5);
 
 pros::Optical colorsort(2); //change port
 
+// hook degrees from the color sensor to the top of the hooks, where the sort stops them to throw a wrong color ring.
+// The old sort ran the hooks for 200 ms from the sensor and then stopped them. This stops them once the ring has gone
+// this far instead, so it throws at the same spot at any hook speed. 250 is an estimate, not measured: TUNE IT ON THE
+// ROBOT by feeding wrong color rings. If they ride over the top, lower it; if they drop back down the hooks, raise it
+const double sortTravel = 250;
+
+// color sort, throws wrong color rings off the top of intakeHigh
+RingSorter ringSorter(colorsort, intakeHigh, {
+    150, // proximity that counts as a ring in front of the sensor, 0-255
+    sortTravel, // hook degrees from the sensor to the top, see above
+    0, // stop the hooks at the top so the ring flies off
+    200, // for 200 ms
+    0 // stopping works at any speed
+});
+
 
 pros::Motor ladybrown(16);
 // pros::ADIDigitalOut doinker('A');
 pros::ADIDigitalOut intakePiston('B');
 pros::ADIDigitalOut mogoclamp('C');
 
+// runs the lady brown, hook and clamp macros below on the scheduler, alongside driving. The arm moves keep the speed
+// of 127 the driver code gave move_absolute()
+MacroEngine macros;
+// runs odometry, the sort, the macros and the screen, see initialize()
+ControlScheduler scheduler;
+// opcontrol's loop, timed alongside the scheduler's jobs
+LoopTimer driverLoop("opcontrol", 10);
+// the brain screen: the field map and pose, and tapping it, how every timed loop is keeping up
+ScreenRenderer screen;
+
+// where the hooks were when they started backing off a ring
+double hooksBackedFrom = 0;
+
+// arm up to take the ring off the hooks, then back the hooks off it so it isn't dragged back down
+const Macro loadLadyBrown(LADY_BROWN | HOOKS, {
+    {[] { ladybrown.move_absolute(380, 127); }, [] { return std::abs(ladybrown.get_position() - 380) < 15; }, 800},
+    {[] {
+         hooksBackedFrom = intakeHigh.get_position();
+         ringSorter.setIntake(-127);
+     },
+     [] { return intakeHigh.get_position() <= hooksBackedFrom - 200; }, 300},
+}, [] { ringSorter.setIntake(0); });
+
+const Macro scoreLadyBrown(LADY_BROWN, {
+    {[] { ladybrown.move_absolute(1850, 127); }, [] { return ladybrown.get_position() > 1850 - 15; }, 2000},
+});
+
+const Macro lowerLadyBrown(LADY_BROWN, {
+    {[] { ladybrown.move_absolute(0, 127); }, [] { return ladybrown.get_position() < 15; }, 2000},
+});
+
+// stop the hooks before letting go of the goal, so a ring half way up isn't flung off with it
+const Macro releaseGoal(HOOKS | CLAMP, {
+    {[] { ringSorter.setIntake(0); }, [] { return std::abs(intakeHigh.get_actual_velocity()) < 20; }, 200},
+    {[] { mogoclamp.set_value(LOW); }, {}, 0},
+});
+
 //use these with the autons selector
 void selectRedTeam() {
-    isRedTeam.store(true);
-    
+    ringSorter.setRedTeam(true);
 }
 
 void selectBlueTeam() {
-    isRedTeam.store(false);
-}
-
-void sorting() {
-    while (true) {
-        if (isColorSortEnabled) {
-            auto values = colorsort.get_rgb();
-            bool bad_ring_detected;
-            
-            if (isRedTeam.load()) {  // check team color multithread
-                bad_ring_detected = values.blue > 220 && values.red < 220; //red team
-                if (bad_ring_detected) {
-                    intakeHigh.move(127); // Fling off wrong color
-                    pros::delay(200);
-                    intakeHigh.move(0);
-                }
-            } 
-            else {
-                bad_ring_detected = values.blue < 220 && values.red > 220; //blue team
-                if (bad_ring_detected) {
-                    intakeHigh.move(127); // Fling off wrong color
-                    pros::delay(200);
-                    intakeHigh.move(0);
-                }
-            }
-            
-            // Update LED based on sorting status
-            colorsort.set_led_pwm(100); //if color sort on then led on
-        } 
-        else {
-            // Turn off LED when sorting is disabled
-            colorsort.set_led_pwm(0);
-        }
-        
-        pros::delay(20); // Small delay to prevent killing our CPU
-    }
+    ringSorter.setRedTeam(false);
 }
 
 
@@ -163,10 +177,67 @@ void sorting() {
 
 
 void initialize() {
-    pros::lcd::initialize(); // initialize brain screen
-    chassis.calibrate(); // calibrate sensors
-    // thread to for brain screen and position logging
-    colorSortTask = new pros::Task(sorting);
+    screen.init(); // the screen job below draws it
+    lemlib::setUpdateTask(false); // odometry runs on the scheduler below
+    chassis.calibrateOdom(); // calibrate sensors
+    // pose telemetry goes out raw, firmware/telemetryDecode.py formats it on the laptop
+    lemlib::telemetrySink()->setMode(lemlib::TelemetrySink::Mode::BINARY);
+    ringSorter.loadCalibration(); // bands fit at this venue, if there are any on the SD card
+
+    // every periodic job on one tick: odometry first, then the sort, then the macros, the screen last
+    scheduler.add("odometry", Stage::SENSE, 5, [](std::uint32_t) { lemlib::update(); });
+    scheduler.add("ring sorter", Stage::COMPUTE, RingSorter::PERIOD, [](std::uint32_t now) { ringSorter.step(now); });
+    scheduler.add("macros", Stage::ACTUATE, 10, [](std::uint32_t now) { macros.update(now); });
+    // held for the job, so each message doesn't copy the shared_ptr
+    static const auto telemetry = lemlib::telemetrySink();
+    // print robot location to the brain screen, each line redrawn only once its number moves past what it shows
+    static const int x = screen.addReadout(0, 0, 0, "X: %.2f", 0.005);
+    static const int y = screen.addReadout(0, 1, 0, "Y: %.2f", 0.005);
+    static const int theta = screen.addReadout(0, 2, 0, "Theta: %.2f", 0.005);
+    static const int rotation = screen.addReadout(0, 3, 0, "Rotation Sensor: %.0f", 0.5);
+    // every timed loop on the next page, its readouts for period, mean and longest run, latest start and CPU share
+    static std::vector<std::pair<LoopTimer*, std::array<int, 5>>> loopLines;
+    scheduler.add("screen", Stage::DISPLAY, 50, [](std::uint32_t now) {
+        // one read, so x, y and theta all come from the same odometry update
+        const lemlib::Pose pose = chassis.getPose();
+        screen.setPose(pose);
+        screen.set(x, {pose.x});
+        screen.set(y, {pose.y});
+        screen.set(theta, {pose.theta});
+        screen.set(rotation, {float(verticalEnc.get_position())});
+        if (screen.getPage() == 1) {
+            for (const auto& [timer, readouts] : loopLines) {
+                const LoopStats stats = timer->getStats();
+                screen.set(readouts[0], {float(stats.period)});
+                screen.set(readouts[1], {float(stats.meanTime())});
+                screen.set(readouts[2], {float(stats.maxTime)});
+                screen.set(readouts[3], {float(stats.maxLatency)});
+                screen.set(readouts[4], {100 * stats.utilization()});
+            }
+        }
+        screen.render(now);
+        // log position telemetry
+        telemetry->record<lemlib::Level::INFO, "Chassis pose: {}">(pose);
+    });
+    // every timed loop's stats once a second, firmware/loopReport.py reads them back on a computer
+    scheduler.add("loop log", Stage::DISPLAY, 1000, [](std::uint32_t) { LoopTimer::recordAll(); });
+    // in columns, the font isn't monospaced
+    constexpr int columns[] = {0, 120, 170, 240, 310, 380};
+    const char* const headings[] = {"loop", "ms", "mean us", "max us", "late us", "cpu"};
+    const char* const formats[] = {"%.0f", "%.0f", "%.0f", "%.0f", "%.1f%%"};
+    for (int column = 0; column < 6; column++) screen.setText(screen.addText(1, 0, columns[column]), headings[column]);
+    for (LoopTimer* timer : LoopTimer::getAll()) {
+        const int line = loopLines.size() + 1;
+        if (line == ScreenRenderer::LINES) break;
+        screen.setText(screen.addText(1, line, 0), timer->getStats().name);
+        std::array<int, 5> readouts;
+        for (int i = 0; i < 5; i++) {
+            readouts[i] = screen.addReadout(1, line, columns[i + 1], formats[i], i < 4 ? 0.5f : 0.05f);
+        }
+        loopLines.push_back({timer, readouts});
+    }
+    // above the motion and user tasks like odometry's own task was, so a busy loop elsewhere can't make a tick late
+    pros::Task schedulerTask([] { scheduler.run(); }, TASK_PRIORITY_DEFAULT + 2, TASK_STACK_DEPTH_DEFAULT, "Scheduler");
     
     // AutonSelector::getInstance().init();    
     
@@ -177,26 +248,16 @@ void initialize() {
     //         pros::delay(50);
     //     }
     // });
-
-    pros::Task screenTask([&]() {
-        while (true) {
-            // print robot location to the brain screen
-            pros::lcd::print(0, "X: %f", chassis.getPose().x); // x
-            pros::lcd::print(1, "Y: %f", chassis.getPose().y); // y
-            pros::lcd::print(2, "Theta: %f", chassis.getPose().theta); // heading
-            pros::lcd::print(3, "Rotation Sensor: %i", verticalEnc.get_position());
-            // log position telemetry
-            lemlib::telemetrySink()->info("Chassis pose: {}", chassis.getPose());
-            // delay to save resources
-            pros::delay(50);
-        }
-    });
 }
 
 /**
  * Runs while the robot is disabled
  */
-void disabled() {}
+void disabled() {
+    // how the jobs kept up through the auton or match that just ended
+    scheduler.printReport();
+    LoopTimer::recordAll();
+}
 
 /**
  * runs after initialize if the robot is connected to field control
@@ -220,10 +281,12 @@ void example_drive(){
 
 
 void autonomous() {
+    LoopTimer::resetAll();
+    screen.clearTrail();
     ladybrown.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);  	
   	// doinker.set_value(LOW);
   	mogoclamp.set_value(LOW);
-	isColorSortEnabled = true; //enable color sort for all of auto -- we could cook on the corners??
+	ringSorter.setEnabled(true); //enable color sort for all of auto -- we could cook on the corners??
 
     example_drive();
     
@@ -234,17 +297,35 @@ void autonomous() {
  * Runs in driver control
  */
 void opcontrol() {
+    LoopTimer::resetAll();
 	chassis.setBrakeMode(pros::E_MOTOR_BRAKE_COAST);
 	ladybrown.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
-    isColorSortEnabled = true; //start with color sort on
+    ringSorter.setEnabled(true); //start with color sort on
 
 	while (true) {
+        driverLoop.start();
         if (!pros::competition::is_connected()) {
             if (controller.get_digital(DIGITAL_B) && 
                 controller.get_digital(DIGITAL_DOWN)) {
                 autonomous(); //runs auton
                 chassis.setBrakeMode(pros::E_MOTOR_BRAKE_COAST); //when done go back to coast for driver
             }
+            //color sort calibration, A steps through red rings -> blue rings -> save
+            if (controller.get_digital_new_press(DIGITAL_A)) {
+                switch (ringSorter.getCalibration()) {
+                    case RingColor::NONE:
+                        ringSorter.startCalibration(RingColor::RED);
+                        controller.print(0, 0, "Cal: feed red   ");
+                        break;
+                    case RingColor::RED:
+                        ringSorter.startCalibration(RingColor::BLUE);
+                        controller.print(0, 0, "Cal: feed blue  ");
+                        break;
+                    case RingColor::BLUE:
+                        controller.print(0, 0, ringSorter.finishCalibration() ? "Cal: saved      " : "Cal: too few    ");
+                        break;
+                }
+            }
         //     //switches from auton selector to the coords and vise versa
         //     if (controller.get_digital(DIGITAL_A) && 
         //         controller.get_digital(DIGITAL_RIGHT)) {
@@ -252,30 +333,29 @@ void opcontrol() {
         //     }
         }
 
-        //intake 
+        //intake, the hooks are left to a macro while one is using them
+        int intakePower = 0;
         if (controller.get_digital(DIGITAL_R1)) {
-            intakeLow.move(127);
-            intakeHigh.move(127);
+            intakePower = 127;
         } 
         else if (controller.get_digital(DIGITAL_R2)) {
-            intakeLow.move(-127);
-            intakeHigh.move(-127);
+            intakePower = -127;
         } 
-        else {
-            intakeLow.move(0);
-            intakeHigh.move(0);
-        }   
+        intakeLow.move(intakePower);
+        if (!macros.isUsing(HOOKS)) ringSorter.setIntake(intakePower);
 
-        //mogo
+        //mogo, releaseGoal lets go itself once the hooks stop
         if (isClamp){
             mogoclamp.set_value(HIGH);
         } 
-        else {
+        else if (!macros.isUsing(CLAMP)) {
             mogoclamp.set_value(LOW);
         }
         if (controller.get_digital(DIGITAL_L2)) {
             if (!clampLatch) {
                 isClamp = !isClamp;
+                if (isClamp) macros.cancel(releaseGoal);
+                else macros.start(releaseGoal);
                 clampLatch = true;
             } 
         }    
@@ -317,38 +397,30 @@ void opcontrol() {
         //     doinkerLatch = false;
         // }
 
-        // ladybrown
-        if (controller.get_digital(DIGITAL_DOWN)) {
-            // currentPositionIndex = (currentPositionIndex + 1) % 3;
-            ladybrown.move_absolute(0, 127);
-            // ladyBrownAngle(positions[currentPositionIndex]);
+        // ladybrown, each press takes over from the last
+        if (controller.get_digital_new_press(DIGITAL_DOWN)) {
+            macros.start(lowerLadyBrown);
         }
 
-        if (controller.get_digital(DIGITAL_UP)) {
-            // currentPositionIndex = 0;
-            ladybrown.move_absolute(1850, 127);
-
-            // ladyBrownAngle(positions[0]);
-            // ladybrown.tare_position();
+        if (controller.get_digital_new_press(DIGITAL_UP)) {
+            macros.start(scoreLadyBrown);
         }
 
-        if (controller.get_digital(DIGITAL_LEFT)) {
-            // currentPositionIndex = 0;
-            ladybrown.move_absolute(380, 127);
-            intakeHigh.move_relative(200, -127); //need to get a super short outtake
+        if (controller.get_digital_new_press(DIGITAL_LEFT)) {
+            macros.start(loadLadyBrown);
         }
 
 
 
         //color sort
         if (controller.get_digital(DIGITAL_Y)) {
-            isColorSortEnabled = true;
+            ringSorter.setEnabled(true);
         }
         else if (controller.get_digital(DIGITAL_X)) {
-            isColorSortEnabled = false;
+            ringSorter.setEnabled(false);
         }
         else {
-            isColorSortEnabled = true;
+            ringSorter.setEnabled(true);
         }
 
           
@@ -359,6 +431,7 @@ void opcontrol() {
         int rightX = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
         // move the chassis with curvature drive
         chassis.arcade(-1* leftY, rightX);
+        driverLoop.stop();
         // delay to save resources
         pros::delay(10);
 
@@ -0,0 +1,131 @@
+#include "lemlib/motionProfile.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// seconds spent at the jerk limit on each end of a change in speed, and seconds at the acceleration limit between
+// them. No jerk limit means the acceleration switches on at once
+void changeTimes(float change, const lemlib::ProfileLimits& limits, float& rampTime, float& flatTime) {
+    if (limits.jerk <= 0) {
+        rampTime = 0;
+        flatTime = change / limits.acceleration;
+    } else if (change * limits.jerk >= limits.acceleration * limits.acceleration) {
+        rampTime = limits.acceleration / limits.jerk;
+        flatTime = change / limits.acceleration - rampTime;
+    } else {
+        // never gets to full acceleration
+        rampTime = std::sqrt(change / limits.jerk);
+        flatTime = 0;
+    }
+}
+
+// distance covered changing speed from one to the other. The acceleration is symmetric over the change, so the
+// average speed is halfway between them
+float changeDistance(float from, float to, const lemlib::ProfileLimits& limits) {
+    float rampTime;
+    float flatTime;
+    changeTimes(std::fabs(to - from), limits, rampTime, flatTime);
+    return (from + to) / 2 * (2 * rampTime + flatTime);
+}
+
+} // namespace
+
+namespace lemlib {
+ProfileState MotionProfile::Piece::at(float t) const {
+    return {position + velocity * t + acceleration * t * t / 2 + jerk * t * t * t / 6,
+            velocity + acceleration * t + jerk * t * t / 2, acceleration + jerk * t};
+}
+
+MotionProfile::MotionProfile(float distance, ProfileLimits limits, float startVelocity, float endVelocity)
+    : limits(limits),
+      distance(std::fabs(distance)) {
+    this->limits.velocity = std::max(this->limits.velocity, 1e-3f);
+    this->limits.acceleration = std::max(this->limits.acceleration, 1e-3f);
+    startVelocity = std::clamp(startVelocity, 0.0f, this->limits.velocity);
+    this->startVelocity = startVelocity;
+    endVelocity = std::clamp(endVelocity, 0.0f, this->limits.velocity);
+    // not enough room to speed up to the end speed, so arrive at what can be reached
+    if (endVelocity > startVelocity && changeDistance(startVelocity, endVelocity, this->limits) > this->distance) {
+        float low = startVelocity;
+        float high = endVelocity;
+        for (int i = 0; i < 20; i++) {
+            const float middle = (low + high) / 2;
+            if (changeDistance(startVelocity, middle, this->limits) > this->distance) high = middle;
+            else low = middle;
+        }
+        endVelocity = low;
+    }
+    this->endVelocity = endVelocity;
+
+    // the highest speed that still leaves room to slow down to the end speed. Coming in too fast to stop in time
+    // only slows down, and overshoots
+    const float floor = std::max(startVelocity, endVelocity);
+    float peak = this->limits.velocity;
+    auto needed = [&](float top) {
+        return changeDistance(startVelocity, top, this->limits) + changeDistance(top, endVelocity, this->limits);
+    };
+    if (needed(peak) > this->distance) {
+        float low = floor;
+        float high = peak;
+        for (int i = 0; i < 24; i++) {
+            const float middle = (low + high) / 2;
+            if (needed(middle) > this->distance) high = middle;
+            else low = middle;
+        }
+        peak = low;
+    }
+
+    addChange(startVelocity, peak);
+    const float cruise = (this->distance - needed(peak)) / peak;
+    if (cruise > 0) addPiece(cruise, 0, 0);
+    addChange(peak, endVelocity);
+    // where it really ends, a hair off the distance from the searches above, or past it when it came in too fast
+    if (count > 0) this->distance = pieces[count - 1].at(pieces[count - 1].duration).position;
+}
+
+void MotionProfile::addPiece(float duration, float jerk, float acceleration) {
+    if (duration <= 0) return;
+    Piece piece = {duration, jerk, 0, 0, acceleration};
+    if (count > 0) {
+        const ProfileState end = pieces[count - 1].at(pieces[count - 1].duration);
+        piece.position = end.position;
+        piece.velocity = end.velocity;
+    } else {
+        piece.velocity = startVelocity;
+    }
+    pieces[count++] = piece;
+    this->duration += duration;
+}
+
+// up to 3 pieces, ramping the acceleration up, holding it, then ramping it back to 0
+void MotionProfile::addChange(float from, float to) {
+    float rampTime;
+    float flatTime;
+    changeTimes(std::fabs(to - from), limits, rampTime, flatTime);
+    const float sign = to > from ? 1 : -1;
+    const float jerk = sign * limits.jerk;
+    const float peakAcceleration = limits.jerk > 0 ? jerk * rampTime : sign * limits.acceleration;
+    addPiece(rampTime, jerk, 0);
+    addPiece(flatTime, 0, peakAcceleration);
+    addPiece(rampTime, -jerk, peakAcceleration);
+}
+
+ProfileState MotionProfile::sample(float time) const {
+    if (count == 0) return {distance, endVelocity, 0};
+    time = std::max(time, 0.0f);
+    size_t i = 0;
+    while (i + 1 < count && time >= pieces[i].duration) {
+        time -= pieces[i].duration;
+        i++;
+    }
+    if (time >= pieces[i].duration) return {distance, endVelocity, 0};
+    return pieces[i].at(time);
+}
+
+float MotionProfile::getDuration() const { return duration; }
+
+float MotionProfile::getDistance() const { return distance; }
+
+float MotionProfile::getEndVelocity() const { return endVelocity; }
+} // namespace lemlib
@@ -0,0 +1,244 @@
+#include "lemlib/motionQueue.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+// the motion queue. The motions run as one, so the robot never waits on the chassis mutex between them. Each move
+// hands over to the next before it stops, at the speed the corner between them allows, and the output fades from
+// one controller to the next so the handoff doesn't jerk
+
+namespace {
+
+// close enough to the last point that the angle to it swings around, stop steering and settle like moveToPoint()
+constexpr float SETTLE_RANGE = 7.5;
+
+// the lowest top speed once settling on the last point, so it doesn't crawl in
+constexpr float SETTLE_SPEED = 60;
+
+// the speed to keep through a corner: all of it going straight on, minExitSpeed turning right around
+float cornerSpeed(float corner, float maxSpeed, float minExitSpeed) {
+    if (maxSpeed <= minExitSpeed) return maxSpeed;
+    return minExitSpeed + (maxSpeed - minExitSpeed) * (1 + std::cos(corner)) / 2;
+}
+
+// how far the robot turns at a point, in radians, going from one motion to the next. travel is the direction the
+// robot is driving into the point in, radians clockwise from +y
+float cornerAngle(const lemlib::QueuedMotion& motion, float travel, const lemlib::QueuedMotion& next) {
+    if (next.type == lemlib::QueuedMotionType::HEADING) {
+        const float facing = motion.forwards ? travel : travel + M_PI;
+        return std::fabs(lemlib::angleError(lemlib::degToRad(next.theta), facing));
+    }
+    // backing out of a point the robot drove into is turning right around
+    if (next.forwards != motion.forwards) return M_PI;
+    const float out = std::atan2(next.x - motion.x, next.y - motion.y);
+    return std::fabs(lemlib::angleError(out, travel));
+}
+
+} // namespace
+
+bool lemlib::MotionQueue::moveToPoint(float x, float y, int timeout, MoveToPointParams params) {
+    return push({QueuedMotionType::POINT, x, y, 0, timeout, params.forwards, params.maxSpeed, AngularDirection::AUTO});
+}
+
+bool lemlib::MotionQueue::turnToHeading(float theta, int timeout, TurnToHeadingParams params) {
+    return push({QueuedMotionType::HEADING, 0, 0, theta, timeout, true, float(params.maxSpeed), params.direction});
+}
+
+bool lemlib::MotionQueue::push(const QueuedMotion& motion) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (count == CAPACITY) return false;
+    motions[(first + count) % CAPACITY] = motion;
+    count++;
+    return true;
+}
+
+std::optional<lemlib::QueuedMotion> lemlib::MotionQueue::pop() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (count == 0) return std::nullopt;
+    const QueuedMotion motion = motions[first];
+    first = (first + 1) % CAPACITY;
+    count--;
+    return motion;
+}
+
+std::optional<lemlib::QueuedMotion> lemlib::MotionQueue::peek() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (count == 0) return std::nullopt;
+    return motions[first];
+}
+
+int lemlib::MotionQueue::size() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return count;
+}
+
+void lemlib::MotionQueue::clear() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    first = 0;
+    count = 0;
+}
+
+void lemlib::Chassis::runQueue(MotionQueue& queue, MotionQueueParams params, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        // the queue is not copied, it has to outlive the motion
+        pros::Task task([this, &queue, params] { runQueue(queue, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    const int compState = pros::competition::get_status();
+    Pose lastPose = this->getPose(true);
+    distTraveled = 0;
+    // what the last cycle sent to the drive, the next motion fades in from it
+    float lastLateral = 0;
+    float lastAngular = 0;
+    bool first = true;
+    // where the line to the next point starts: the last point when the last motion was a move, so a corner cut
+    // short steers back onto the next line instead of aiming straight at the point
+    std::optional<Pose> lineStart = std::nullopt;
+
+    while (this->motionRunning) {
+        const std::optional<QueuedMotion> popped = queue.pop();
+        if (!popped) break;
+        const QueuedMotion motion = *popped;
+
+        lateralPID.reset();
+        angularPID.reset();
+        lateralLargeExit.reset();
+        lateralSmallExit.reset();
+        angularLargeExit.reset();
+        angularSmallExit.reset();
+
+        const Pose start = lineStart.value_or(this->getPose(true));
+        lineStart = motion.type == QueuedMotionType::POINT ? std::optional(Pose(motion.x, motion.y)) : std::nullopt;
+        const float length = std::hypot(motion.x - start.x, motion.y - start.y);
+        // the direction the robot drives into the point in, radians clockwise from +y
+        const float travel = std::atan2(motion.x - start.x, motion.y - start.y);
+        const float fromLateral = first ? 0 : lastLateral;
+        const float fromAngular = first ? 0 : lastAngular;
+        // the controller picks up the speed the robot already has instead of speeding up from a stop
+        float prevLateralOut = fromLateral;
+        float maxSpeed = motion.maxSpeed;
+        bool settling = false;
+        std::optional<bool> prevSide = std::nullopt;
+        std::optional<float> prevDeltaTheta = std::nullopt;
+
+        Timer timer(motion.timeout);
+        const uint32_t handoff = pros::millis();
+        while (!timer.isDone() && this->motionRunning) {
+            // stop if the competition state changes
+            if (compState != pros::competition::get_status()) {
+                this->motionRunning = false;
+                break;
+            }
+
+            const Pose pose = this->getPose(true);
+            distTraveled += pose.distance(lastPose);
+            lastPose = pose;
+            // looked at every cycle, a motion can be queued while this one runs
+            const std::optional<QueuedMotion> next = queue.peek();
+
+            float lateralOut = 0;
+            float angularOut = 0;
+            if (motion.type == QueuedMotionType::POINT) {
+                const float distTarget = std::hypot(motion.x - pose.x, motion.y - pose.y);
+                const float toTarget = std::atan2(motion.x - pose.x, motion.y - pose.y);
+                // steer at a point lookahead further along the line than the robot, the target itself near the end
+                const float along = (pose.x - start.x) * std::sin(travel) + (pose.y - start.y) * std::cos(travel);
+                const float carrot = std::clamp(along + params.lookahead, 0.0f, length);
+                const float toCarrot = std::atan2(start.x + carrot * std::sin(travel) - pose.x,
+                                                  start.y + carrot * std::cos(travel) - pose.y);
+                const float facing = motion.forwards ? pose.theta : pose.theta + M_PI;
+
+                if (next) {
+                    // hand over once close, or once past the line through the point square to the way in
+                    const bool side =
+                        (pose.x - motion.x) * std::sin(travel) + (pose.y - motion.y) * std::cos(travel) < 0;
+                    if (prevSide == std::nullopt) prevSide = side;
+                    if (distTarget < params.blendDistance || side != *prevSide) break;
+                    prevSide = side;
+                } else {
+                    if (distTarget < SETTLE_RANGE && !settling) {
+                        settling = true;
+                        maxSpeed = std::fmax(std::fabs(prevLateralOut), SETTLE_SPEED);
+                    }
+                    if (settling && (lateralSmallExit.getExit() || lateralLargeExit.getExit())) break;
+                }
+
+                // distance to the point along the way the robot faces, negative once past it
+                const float lateralError = distTarget * std::cos(angleError(toTarget, pose.theta));
+                lateralSmallExit.update(lateralError);
+                lateralLargeExit.update(lateralError);
+                lateralOut = std::clamp(lateralPID.update(lateralError), -maxSpeed, maxSpeed);
+                if (!settling) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+                // don't drive the wrong way before settling
+                if (!settling) lateralOut = motion.forwards ? std::fmax(lateralOut, 0) : std::fmin(lateralOut, 0);
+                if (next) {
+                    // the PID slows down into the point, but no slower than the corner there needs
+                    const float exitSpeed =
+                        std::fmin(cornerSpeed(cornerAngle(motion, travel, *next), maxSpeed, params.minExitSpeed),
+                                  next->maxSpeed);
+                    lateralOut = motion.forwards ? std::fmax(lateralOut, exitSpeed) : std::fmin(lateralOut, -exitSpeed);
+                }
+                prevLateralOut = lateralOut;
+
+                // slow down while facing away from the line so the turn onto it is tight
+                const float steer = angleError(toCarrot, facing);
+                if (!settling) lateralOut *= std::fmax(std::cos(steer), 0);
+                if (!settling) angularOut = angularPID.update(radToDeg(steer));
+                angularOut = std::clamp(angularOut, -maxSpeed, maxSpeed);
+            } else {
+                const float deltaTheta = angleError(motion.theta, radToDeg(pose.theta), false, motion.direction);
+                if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+                if (next) {
+                    // hand over once close, or once past the heading
+                    if (std::fabs(deltaTheta) < params.blendAngle || sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+                } else if (angularSmallExit.getExit() || angularLargeExit.getExit()) {
+                    break;
+                }
+                prevDeltaTheta = deltaTheta;
+                angularSmallExit.update(deltaTheta);
+                angularLargeExit.update(deltaTheta);
+                angularOut = std::clamp(angularPID.update(deltaTheta), -maxSpeed, maxSpeed);
+                prevLateralOut = 0;
+            }
+
+            // fade from what the last motion was sending
+            const float blend = params.blendTime > 0 ? std::fmin(float(pros::millis() - handoff) / params.blendTime, 1)
+                                                     : 1;
+            lateralOut = fromLateral + blend * (lateralOut - fromLateral);
+            angularOut = fromAngular + blend * (angularOut - fromAngular);
+            lastLateral = lateralOut;
+            lastAngular = angularOut;
+
+            // keep the ratio between the sides if either is saturated
+            float leftPower = lateralOut + angularOut;
+            float rightPower = lateralOut - angularOut;
+            const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / 127;
+            if (ratio > 1) {
+                leftPower /= ratio;
+                rightPower /= ratio;
+            }
+            drivetrain.leftMotors->move(leftPower);
+            drivetrain.rightMotors->move(rightPower);
+
+            pros::delay(10);
+        }
+        first = false;
+    }
+
+    // cancelled, the rest of the queue goes with it
+    if (!this->motionRunning) queue.clear();
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,45 @@
+#include "lemlib/pathAsset.hpp"
+#include <cstring>
+
+namespace lemlib {
+PathAsset::PathAsset(const asset& path) {
+    if (path.buf == nullptr || path.size < sizeof(PathHeader)) return;
+    // the floats are read in place, which faults on the brain if they aren't aligned
+    if (reinterpret_cast<uintptr_t>(path.buf) % alignof(PathHeader) != 0) return;
+
+    const PathHeader* header = reinterpret_cast<const PathHeader*>(path.buf);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) return;
+    if (header->version != VERSION || header->pointSize != sizeof(PathPoint)) return;
+    if (header->boxSize != sizeof(PathBox) || header->boxPoints < 2) return;
+    const size_t pointBytes = header->count * sizeof(PathPoint);
+    if (path.size < sizeof(PathHeader) + pointBytes + header->boxCount * sizeof(PathBox)) return;
+    // every segment has to be in a box
+    const size_t segments = header->count > 0 ? header->count - 1 : 0;
+    if (header->boxCount * (header->boxPoints - 1) < segments) return;
+
+    points = reinterpret_cast<const PathPoint*>(path.buf + sizeof(PathHeader));
+    count = header->count;
+    totalLength = header->length;
+    boxList = reinterpret_cast<const PathBox*>(path.buf + sizeof(PathHeader) + pointBytes);
+    numBoxes = header->boxCount;
+    pointsPerBox = header->boxPoints;
+}
+
+bool PathAsset::isValid() const { return points != nullptr; }
+
+size_t PathAsset::size() const { return count; }
+
+float PathAsset::length() const { return totalLength; }
+
+const PathPoint& PathAsset::operator[](size_t index) const { return points[index]; }
+
+const PathPoint* PathAsset::begin() const { return points; }
+
+const PathPoint* PathAsset::end() const { return points + count; }
+
+size_t PathAsset::boxCount() const { return numBoxes; }
+
+const PathBox& PathAsset::box(size_t index) const { return boxList[index]; }
+
+size_t PathAsset::boxPoints() const { return pointsPerBox; }
+} // namespace lemlib
@@ -0,0 +1,100 @@
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/pathTracker.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+#include <cmath>
+
+// pure pursuit over a binary path asset. Same controller as the text path
+// follow() in LemLib, only reading the points in place and letting PathTracker
+// find the closest and lookahead points instead of scanning the whole path
+
+namespace {
+
+// signed curvature of the arc from the robot to the lookahead point
+float lookaheadCurvature(lemlib::Pose pose, float heading, lemlib::Pose lookahead) {
+    const float side =
+        lemlib::sgn(std::sin(heading) * (lookahead.x - pose.x) - std::cos(heading) * (lookahead.y - pose.y));
+    const float a = -std::tan(heading);
+    const float c = std::tan(heading) * pose.x - pose.y;
+    const float x = std::fabs(a * lookahead.x + lookahead.y + c) / std::sqrt((a * a) + 1);
+    const float d = std::hypot(lookahead.x - pose.x, lookahead.y - pose.y);
+    return side * ((2 * x) / (d * d));
+}
+
+} // namespace
+
+void lemlib::Chassis::follow(const PathAsset& path, float lookahead, int timeout, bool forwards, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        // the asset lives as long as the program, so the view can be copied into the task
+        pros::Task task([this, path, lookahead, timeout, forwards] { follow(path, lookahead, timeout, forwards, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    if (!path.isValid() || path.size() == 0) {
+        infoSink()->error("Not a binary path asset, or it is empty! Was it packed by pathAsset.py? Skipping motion");
+        this->endMotion();
+        return;
+    }
+
+    Pose pose = this->getPose(true);
+    Pose lastPose = pose;
+    PathTracker tracker(path, lookahead);
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+
+    Timer timer(timeout);
+    while (!timer.isDone() && this->motionRunning) {
+        // stop if the competition state changes
+        if (compState != pros::competition::get_status()) break;
+
+        pose = this->getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // the last point has a speed of 0, reaching it ends the motion
+        tracker.update(pose.x, pose.y);
+        const size_t closest = tracker.getClosest();
+        if (path[closest].speed == 0) break;
+
+        const Pose lookaheadPose(tracker.getLookahead().x, tracker.getLookahead().y);
+
+        // the curvature wants a standard position heading
+        const float curvature = lookaheadCurvature(pose, M_PI / 2 - pose.theta, lookaheadPose);
+
+        const float targetVel = path[closest].speed;
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // keep the ratio between the sides if either is saturated
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        if (forwards) {
+            drivetrain.leftMotors->move(targetLeftVel);
+            drivetrain.rightMotors->move(targetRightVel);
+        } else {
+            drivetrain.leftMotors->move(-targetRightVel);
+            drivetrain.rightMotors->move(-targetLeftVel);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,98 @@
+#include "lemlib/pathTracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float distanceSquared(const lemlib::PathPoint& point, float x, float y) {
+    return (point.x - x) * (point.x - x) + (point.y - y) * (point.y - y);
+}
+
+// whether a circle can cross any segment inside the box. Not if the box is
+// all outside the circle, or all inside it
+bool circleCrossesBox(const lemlib::PathBox& box, float x, float y, float radius) {
+    const float nearX = std::clamp(x, box.minX, box.maxX) - x;
+    const float nearY = std::clamp(y, box.minY, box.maxY) - y;
+    if (nearX * nearX + nearY * nearY > radius * radius) return false;
+    const float farX = std::max(std::fabs(box.minX - x), std::fabs(box.maxX - x));
+    const float farY = std::max(std::fabs(box.minY - y), std::fabs(box.maxY - y));
+    return farX * farX + farY * farY >= radius * radius;
+}
+
+// where along p1 -> p2 the circle crosses it, -1 if it doesn't. The crossing
+// further along is preferred
+float circleIntersect(const lemlib::PathPoint& p1, const lemlib::PathPoint& p2, float x, float y, float radius) {
+    const float dx = p2.x - p1.x;
+    const float dy = p2.y - p1.y;
+    const float fx = p1.x - x;
+    const float fy = p1.y - y;
+    const float a = dx * dx + dy * dy;
+    const float b = 2 * (fx * dx + fy * dy);
+    const float c = fx * fx + fy * fy - radius * radius;
+    float discriminant = b * b - 4 * a * c;
+    if (a == 0 || discriminant < 0) return -1;
+    discriminant = std::sqrt(discriminant);
+    const float t1 = (-b - discriminant) / (2 * a);
+    const float t2 = (-b + discriminant) / (2 * a);
+    if (t2 >= 0 && t2 <= 1) return t2;
+    if (t1 >= 0 && t1 <= 1) return t1;
+    return -1;
+}
+
+lemlib::PathPoint lerp(const lemlib::PathPoint& a, const lemlib::PathPoint& b, float t) {
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.speed + (b.speed - a.speed) * t,
+            a.distance + (b.distance - a.distance) * t};
+}
+
+} // namespace
+
+namespace lemlib {
+PathTracker::PathTracker(const PathAsset& path, float lookahead)
+    : path(path),
+      lookahead(lookahead) {
+    if (path.size() > 0) lookaheadPoint = path[0];
+}
+
+void PathTracker::update(float x, float y) {
+    const size_t size = path.size();
+    if (size == 0) return;
+
+    // closest point, from the last one up to a lookahead further along. The
+    // next point is always looked at, in case the points are far apart
+    const float closestEnd = path[closest].distance + lookahead;
+    float closestDist = distanceSquared(path[closest], x, y);
+    for (size_t i = closest + 1; i < size; i++) {
+        const float dist = distanceSquared(path[i], x, y);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = i;
+        }
+        if (path[i].distance > closestEnd) break;
+    }
+
+    // lookahead point, from the last one up to two lookaheads past the closest
+    const float lookaheadEnd = path[closest].distance + 2 * lookahead;
+    const size_t boxStep = path.boxPoints() - 1;
+    size_t i = std::max(closest, lookaheadSegment);
+    while (i + 1 < size && path[i].distance <= lookaheadEnd) {
+        const size_t box = i / boxStep;
+        if (!circleCrossesBox(path.box(box), x, y, lookahead)) {
+            i = (box + 1) * boxStep;
+            continue;
+        }
+        const float t = circleIntersect(path[i], path[i + 1], x, y, lookahead);
+        if (t >= 0) {
+            lookaheadPoint = lerp(path[i], path[i + 1], t);
+            lookaheadSegment = i;
+            return;
+        }
+        i++;
+    }
+}
+
+size_t PathTracker::getClosest() const { return closest; }
+
+const PathPoint& PathTracker::getLookahead() const { return lookaheadPoint; }
+
+size_t PathTracker::getLookaheadSegment() const { return lookaheadSegment; }
+} // namespace lemlib
@@ -0,0 +1,184 @@
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/feedforward.hpp"
+#include "lemlib/motionProfile.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+#include <algorithm>
+#include <cmath>
+
+// moveToPoint() and turnToHeading() driven along a motion profile. The plan
+// gives the speed to drive at every cycle, so most of the power is feedforward
+// and the PIDs only make up for the robot falling behind or running ahead of it
+
+namespace {
+
+// inches per second the drive wheels roll at full power, nothing in the way
+float freeSpeed(const lemlib::Drivetrain& drivetrain) {
+    return drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter;
+}
+
+// the top speed of a profile when the params leave it at 0
+constexpr float DEFAULT_SPEED_FRACTION = 0.9;
+
+// close enough to the point that the angle to it swings around, hold the heading instead
+constexpr float HOLD_HEADING_RANGE = 6;
+
+// motor power for each volt of feedforward
+constexpr float POWER_PER_VOLT = 127.0 / 12;
+
+// seconds since a motion started
+float secondsSince(uint32_t start) { return (pros::millis() - start) / 1000.0f; }
+
+} // namespace
+
+void lemlib::Chassis::moveToPointProfiled(float x, float y, int timeout, MoveToPointProfiledParams params,
+                                          bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, x, y, timeout, params] { moveToPointProfiled(x, y, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    lateralPID.reset();
+    angularPID.reset();
+
+    const Pose start = this->getPose(true);
+    const float length = std::hypot(x - start.x, y - start.y);
+    // the line to the point, as a unit vector
+    const float lineX = length > 0 ? (x - start.x) / length : 0;
+    const float lineY = length > 0 ? (y - start.y) / length : 0;
+    float heading = std::atan2(lineX, lineY);
+
+    const float top = freeSpeed(drivetrain);
+    const float kV = 127 / top;
+    const MotionProfile profile(length, {params.maxVelocity > 0 ? params.maxVelocity : DEFAULT_SPEED_FRACTION * top,
+                                         params.maxAcceleration, params.maxJerk});
+    const float direction = params.forwards ? 1 : -1;
+    const int compState = pros::competition::get_status();
+    Pose lastPose = start;
+    distTraveled = 0;
+
+    Timer timer(timeout);
+    const uint32_t startTime = pros::millis();
+    while (!timer.isDone() && this->motionRunning) {
+        // stop if the competition state changes
+        if (compState != pros::competition::get_status()) break;
+
+        const Pose pose = this->getPose(true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        const float elapsed = secondsSince(startTime);
+        const ProfileState planned = profile.sample(elapsed);
+        const float along = (pose.x - start.x) * lineX + (pose.y - start.y) * lineY;
+        const float remaining = length - along;
+        if (elapsed >= profile.getDuration()) {
+            if (std::fabs(remaining) < params.exitRange) break;
+            if (elapsed >= profile.getDuration() + params.settleTime / 1000.0f) break;
+        }
+
+        // the power for the planned speed and acceleration, from the characterized feedforward when there is one,
+        // and the PID on how far off the plan the robot is
+        const float velocity = direction * planned.velocity;
+        const float acceleration = direction * planned.acceleration;
+        float leftFeed = kV * velocity + params.kA * acceleration;
+        float rightFeed = leftFeed;
+        if (hasDriveFeedforward()) {
+            leftFeed = POWER_PER_VOLT * getDriveFeedforward().left.calculate(velocity, acceleration);
+            rightFeed = POWER_PER_VOLT * getDriveFeedforward().right.calculate(velocity, acceleration);
+        }
+        const float lateralOut = direction * lateralPID.update(planned.position - along);
+
+        if (std::hypot(x - pose.x, y - pose.y) > HOLD_HEADING_RANGE) heading = std::atan2(x - pose.x, y - pose.y);
+        const float facing = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularOut = angularPID.update(radToDeg(angleError(heading, facing)));
+
+        // keep the ratio between the sides if either is saturated
+        float leftPower = leftFeed + lateralOut + angularOut;
+        float rightPower = rightFeed + lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / 127;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+        drivetrain.leftMotors->move(leftPower);
+        drivetrain.rightMotors->move(rightPower);
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    this->endMotion();
+}
+
+void lemlib::Chassis::turnToHeadingProfiled(float theta, int timeout, TurnToHeadingProfiledParams params,
+                                            bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, theta, timeout, params] { turnToHeadingProfiled(theta, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    angularPID.reset();
+
+    // the heading keeps counting past 360, so how far the robot has turned is the difference from the start
+    const float startTheta = this->getPose().theta;
+    const float turn = angleError(theta, startTheta, false, params.direction);
+    const float direction = sgn(turn);
+
+    // wheel inches per second for each degree per second the robot turns
+    const float wheelSpeed = degToRad(1) * drivetrain.trackWidth / 2;
+    const float kV = 127 / freeSpeed(drivetrain) * wheelSpeed;
+    const float top = DEFAULT_SPEED_FRACTION * freeSpeed(drivetrain) / wheelSpeed;
+    const MotionProfile profile(std::fabs(turn), {params.maxVelocity > 0 ? params.maxVelocity : top,
+                                                  params.maxAcceleration, params.maxJerk});
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+
+    Timer timer(timeout);
+    const uint32_t startTime = pros::millis();
+    while (!timer.isDone() && this->motionRunning) {
+        // stop if the competition state changes
+        if (compState != pros::competition::get_status()) break;
+
+        const float turned = direction * (this->getPose().theta - startTheta);
+        distTraveled = std::fabs(turned);
+
+        const float elapsed = secondsSince(startTime);
+        const ProfileState planned = profile.sample(elapsed);
+        if (elapsed >= profile.getDuration()) {
+            if (std::fabs(profile.getDistance() - turned) < params.exitRange) break;
+            if (elapsed >= profile.getDuration() + params.settleTime / 1000.0f) break;
+        }
+
+        const float velocity = direction * planned.velocity;
+        const float acceleration = direction * planned.acceleration;
+        const float feed = hasDriveFeedforward()
+                               ? POWER_PER_VOLT * getDriveFeedforward().angular.calculate(velocity, acceleration)
+                               : kV * velocity + params.kA * acceleration;
+        float power = feed + direction * angularPID.update(planned.position - turned);
+        power = std::clamp<float>(power, -127, 127);
+        drivetrain.leftMotors->move(power);
+        drivetrain.rightMotors->move(-power);
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,135 @@
+#include "ringColor.hpp"
+#include "pros/misc.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// signed shortest angle from a to b, deg
+double hueDistance(double a, double b) {
+    double d = std::fmod(b - a, 360);
+    if (d > 180) d -= 360;
+    if (d < -180) d += 360;
+    return d;
+}
+
+double radians(double degrees) { return degrees * M_PI / 180; }
+
+double degrees(double radians) { return radians * 180 / M_PI; }
+
+const char* labelName(RingColor label) {
+    switch (label) {
+        case RingColor::RED: return "red";
+        case RingColor::BLUE: return "blue";
+        default: return "none";
+    }
+}
+
+} // namespace
+
+RingClassifier::RingClassifier()
+    : RingClassifier(Settings {}) {}
+
+RingClassifier::RingClassifier(Settings settings)
+    : settings(settings) {}
+
+RingColor RingClassifier::classify(double hue, double saturation) const {
+    if (saturation < settings.minSaturation) return RingColor::NONE;
+    // distance in spreads, so a tight band doesn't lose to a loose one
+    const double red = std::abs(hueDistance(settings.red.hue, hue)) / settings.red.spread;
+    const double blue = std::abs(hueDistance(settings.blue.hue, hue)) / settings.blue.spread;
+    if (std::min(red, blue) > settings.width) return RingColor::NONE;
+    return red < blue ? RingColor::RED : RingColor::BLUE;
+}
+
+void RingClassifier::startCalibration(RingColor label) { calibrating = label; }
+
+RingColor RingClassifier::getCalibration() const { return calibrating; }
+
+void RingClassifier::record(const Sample& sample) {
+    if (calibrating == RingColor::NONE || sampleCount(calibrating) >= MAX_SAMPLES) return;
+    Sample labelled = sample;
+    labelled.label = calibrating;
+    samples.push_back(labelled);
+}
+
+int RingClassifier::sampleCount(RingColor label) const {
+    return std::count_if(samples.begin(), samples.end(), [&](const Sample& s) { return s.label == label; });
+}
+
+RingClassifier::Settings RingClassifier::fit(const std::vector<Sample>& samples, const Settings& defaults) {
+    Settings fitted = defaults;
+    double minSaturation = 1;
+    for (RingColor label : {RingColor::RED, RingColor::BLUE}) {
+        // hue wraps around, so average it as a direction
+        double sin = 0, cos = 0, saturation = 0, saturationSquared = 0;
+        int n = 0;
+        for (const Sample& s : samples) {
+            if (s.label != label) continue;
+            sin += std::sin(radians(s.hue));
+            cos += std::cos(radians(s.hue));
+            saturation += s.saturation;
+            saturationSquared += s.saturation * s.saturation;
+            n++;
+        }
+        if (n == 0) continue;
+        const double length = std::hypot(sin, cos) / n;
+        Band band = {std::fmod(degrees(std::atan2(sin, cos)) + 360, 360),
+                     std::max(3.0, degrees(std::sqrt(-2 * std::log(std::max(length, 1e-9)))))};
+        (label == RingColor::RED ? fitted.red : fitted.blue) = band;
+
+        const double mean = saturation / n;
+        const double deviation = std::sqrt(std::max(0.0, saturationSquared / n - mean * mean));
+        minSaturation = std::min(minSaturation, mean - 3 * deviation);
+    }
+    fitted.minSaturation = std::clamp(minSaturation, 0.1, 0.9);
+    // the bands can touch but not overlap
+    const double gap = std::abs(hueDistance(fitted.red.hue, fitted.blue.hue));
+    fitted.width = std::min(defaults.width, gap / (fitted.red.spread + fitted.blue.spread));
+    return fitted;
+}
+
+bool RingClassifier::finishCalibration() {
+    calibrating = RingColor::NONE;
+    if (sampleCount(RingColor::RED) < MIN_SAMPLES || sampleCount(RingColor::BLUE) < MIN_SAMPLES) return false;
+    settings = fit(samples, settings);
+    save();
+    samples.clear();
+    return true;
+}
+
+bool RingClassifier::save() const {
+    if (!pros::usd::is_installed()) return false;
+
+    FILE* file = std::fopen(SETTINGS_FILE, "w");
+    if (file == nullptr) return false;
+    std::fprintf(file, "%f %f %f %f %f %f\n", settings.red.hue, settings.red.spread, settings.blue.hue,
+                 settings.blue.spread, settings.minSaturation, settings.width);
+    std::fclose(file);
+
+    // the raw samples are kept so a bad fit can be looked at after the event
+    file = std::fopen(SAMPLES_FILE, "a");
+    if (file == nullptr) return false;
+    for (const Sample& s : samples) {
+        std::fprintf(file, "%s,%f,%f,%ld,%lu\n", labelName(s.label), s.hue, s.saturation,
+                     static_cast<long>(s.proximity), static_cast<unsigned long>(s.clear));
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool RingClassifier::load() {
+    if (!pros::usd::is_installed()) return false;
+    FILE* file = std::fopen(SETTINGS_FILE, "r");
+    if (file == nullptr) return false;
+    Settings loaded;
+    const int read = std::fscanf(file, "%lf %lf %lf %lf %lf %lf", &loaded.red.hue, &loaded.red.spread,
+                                 &loaded.blue.hue, &loaded.blue.spread, &loaded.minSaturation, &loaded.width);
+    std::fclose(file);
+    if (read != 6) return false;
+    settings = loaded;
+    return true;
+}
+
+const RingClassifier::Settings& RingClassifier::getSettings() const { return settings; }
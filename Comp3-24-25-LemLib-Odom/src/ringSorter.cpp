@@ -0,0 +1,138 @@
+#include "ringSorter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+RingSorter::RingSorter(pros::Optical& sensor, pros::Motor& hooks, Settings settings, RingClassifier classifier)
+    : sensor(sensor),
+      hooks(hooks),
+      settings(settings),
+      classifier(classifier) {}
+
+void RingSorter::run() {
+    while (true) {
+        std::uint32_t wait;
+        {
+            std::lock_guard<pros::Mutex> lock(mutex);
+            wait = update(pros::millis());
+        }
+        pros::delay(wait);
+    }
+}
+
+void RingSorter::step(std::uint32_t now) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    update(now);
+}
+
+void RingSorter::setEnabled(bool enabled) { this->enabled.store(enabled); }
+
+bool RingSorter::isEnabled() const { return enabled.load(); }
+
+void RingSorter::setRedTeam(bool red) { redTeam.store(red); }
+
+bool RingSorter::isRedTeam() const { return redTeam.load(); }
+
+void RingSorter::setIntake(int power) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    requested = power;
+    if (!ejecting) hooks.move(power);
+}
+
+int RingSorter::ringsOnHooks() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return count;
+}
+
+bool RingSorter::loadCalibration() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return classifier.load();
+}
+
+void RingSorter::startCalibration(RingColor label) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    classifier.startCalibration(label);
+}
+
+RingColor RingSorter::getCalibration() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return classifier.getCalibration();
+}
+
+bool RingSorter::finishCalibration() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return classifier.finishCalibration();
+}
+
+bool RingSorter::wrongColor(RingColor color) const {
+    if (classifier.getCalibration() != RingColor::NONE) return false;
+    return color == (redTeam.load() ? RingColor::BLUE : RingColor::RED);
+}
+
+void RingSorter::eject(std::uint32_t now) {
+    // too slow to fling it, stopping at least keeps it off the stake
+    const bool canThrow = std::abs(hooks.get_actual_velocity()) >= settings.minEjectSpeed;
+    hooks.move(canThrow ? settings.ejectPower : 0);
+    ejecting = true;
+    ejectUntil = now + settings.ejectTime;
+}
+
+// one pass of the sort, returns how long to sleep before the next one
+std::uint32_t RingSorter::update(std::uint32_t now) {
+    // calibrating needs the sensor running even with the sort off
+    const bool on = enabled.load() || classifier.getCalibration() != RingColor::NONE;
+    if (on != ledOn) {
+        sensor.set_led_pwm(on ? 100 : 0);
+        ledOn = on;
+    }
+    if (!on) {
+        count = 0;
+        ringPresent = false;
+    }
+
+    const double position = hooks.get_position();
+
+    if (on) {
+        // a ring arriving is a rising edge on proximity, its color is read
+        // every pass until it has gone past
+        const bool present = sensor.get_proximity() > settings.proximity;
+        if (present && !ringPresent && count < MAX_RINGS) {
+            rings[(first + count) % MAX_RINGS] = {now, position + settings.travel, false};
+            count++;
+        }
+        if (present && count > 0) {
+            const double hue = sensor.get_hue();
+            const double saturation = sensor.get_saturation();
+            Ring& newest = rings[(first + count - 1) % MAX_RINGS];
+            newest.wrongColor = newest.wrongColor || wrongColor(classifier.classify(hue, saturation));
+            if (classifier.getCalibration() != RingColor::NONE) {
+                classifier.record({RingColor::NONE, hue, saturation, sensor.get_proximity(), sensor.get_raw().clear});
+            }
+        }
+        ringPresent = present;
+
+        // running the hooks backwards takes rings back out past the sensor
+        while (count > 0 && position < rings[(first + count - 1) % MAX_RINGS].ejectAt - settings.travel - 1) count--;
+
+        while (count > 0 && position >= rings[first].ejectAt) {
+            if (rings[first].wrongColor) eject(now);
+            first = (first + 1) % MAX_RINGS;
+            count--;
+        }
+    }
+
+    if (ejecting && now >= ejectUntil) {
+        ejecting = false;
+        hooks.move(requested);
+    }
+
+    // wake up right when the next thing is due instead of on the next poll
+    std::uint32_t wait = PERIOD;
+    if (ejecting) wait = std::min(wait, ejectUntil - now);
+    const double degPerMs = hooks.get_actual_velocity() * 360 / 60000;
+    if (count > 0 && degPerMs > 0) {
+        const double eta = (rings[first].ejectAt - position) / degPerMs;
+        wait = std::min<std::uint32_t>(wait, std::ceil(eta));
+    }
+    return std::max<std::uint32_t>(wait, 1);
+}
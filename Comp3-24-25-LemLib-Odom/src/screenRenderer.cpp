@@ -0,0 +1,233 @@
+#include "screenRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace {
+constexpr int SCREEN_WIDTH = 480; // px
+constexpr int SCREEN_HEIGHT = 240;
+constexpr int MARGIN = 10;
+constexpr int MAP_SIZE = 220;          // px square, the whole field
+constexpr float FIELD_SIZE = 144;      // in
+constexpr int LINE_HEIGHT = 22;        // px
+constexpr int ROBOT_SIZE = 10;         // px
+constexpr float HEADING_LENGTH = 14;   // px
+constexpr int TRAIL_SPACING = 3;       // px between trail points, about 2 in
+
+lv_point_t toMap(float x, float y) {
+    const float scale = MAP_SIZE / FIELD_SIZE;
+    const auto clamp = [](float px) { return lv_coord_t(std::clamp<float>(std::round(px), 0, MAP_SIZE)); };
+    return {clamp(MAP_SIZE / 2.0f + x * scale), clamp(MAP_SIZE / 2.0f - y * scale)};
+}
+
+bool operator!=(const lv_point_t& a, const lv_point_t& b) { return a.x != b.x || a.y != b.y; }
+
+// a box with no padding, border or scrolling
+lv_obj_t* makeBox(lv_obj_t* parent, int x, int y, int width, int height, std::uint32_t color) {
+    lv_obj_t* box = lv_obj_create(parent);
+    lv_obj_set_pos(box, x, y);
+    lv_obj_set_size(box, width, height);
+    lv_obj_set_style_pad_all(box, 0, 0);
+    lv_obj_set_style_border_width(box, 0, 0);
+    lv_obj_set_style_radius(box, 0, 0);
+    lv_obj_set_style_bg_color(box, lv_color_hex(color), 0);
+    lv_obj_clear_flag(box, LV_OBJ_FLAG_SCROLLABLE);
+    return box;
+}
+
+lv_obj_t* makeLine(lv_obj_t* parent, std::uint32_t color) {
+    lv_obj_t* line = lv_line_create(parent);
+    lv_obj_set_style_line_width(line, 2, 0);
+    lv_obj_set_style_line_color(line, lv_color_hex(color), 0);
+    lv_obj_clear_flag(line, LV_OBJ_FLAG_CLICKABLE);
+    return line;
+}
+} // namespace
+
+ScreenRenderer::ScreenRenderer(int pages, std::uint32_t redrawPeriod)
+    : pageCount(std::max(pages, 1)),
+      redrawPeriod(redrawPeriod) {}
+
+void ScreenRenderer::init() {
+    for (int i = 0; i < pageCount; i++) {
+        lv_obj_t* page = makeBox(lv_scr_act(), 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0x000000);
+        lv_obj_add_flag(page, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(page, onClick, LV_EVENT_CLICKED, this);
+        pages.push_back(page);
+    }
+
+    map = makeBox(pages[0], MARGIN, MARGIN, MAP_SIZE, MAP_SIZE, 0x202020);
+    lv_obj_clear_flag(map, LV_OBJ_FLAG_CLICKABLE);
+    pathLine = makeLine(map, 0x606060);
+    for (lv_obj_t*& line : trailLines) line = makeLine(map, 0x00a0ff);
+    heading = makeLine(map, 0xffffff);
+    robot = makeBox(map, 0, 0, ROBOT_SIZE, ROBOT_SIZE, 0xffffff);
+    lv_obj_clear_flag(robot, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(robot, LV_OBJ_FLAG_HIDDEN); // until there's a pose
+
+    status = addText(0, LINES - 1, 0);
+}
+
+int ScreenRenderer::addWidget(int page, int line, int column, const char* format, float epsilon) {
+    if (page < 0 || page >= int(pages.size())) return -1;
+    Widget widget;
+    widget.page = page;
+    widget.format = format;
+    widget.epsilon = epsilon;
+    widget.label = lv_label_create(pages[page]);
+    lv_obj_set_pos(widget.label, (page == 0 ? MAP_SIZE + 2 * MARGIN : MARGIN) + column, MARGIN + line * LINE_HEIGHT);
+    lv_obj_set_style_text_color(widget.label, lv_color_hex(0xffffff), 0);
+    lv_label_set_text(widget.label, "");
+    std::lock_guard<pros::Mutex> lock(mutex);
+    widgets.push_back(widget);
+    return widgets.size() - 1;
+}
+
+int ScreenRenderer::addReadout(int page, int line, int column, const char* format, float epsilon) {
+    return addWidget(page, line, column, format, epsilon);
+}
+
+int ScreenRenderer::addText(int page, int line, int column) { return addWidget(page, line, column, nullptr, 0); }
+
+void ScreenRenderer::set(int readout, std::initializer_list<float> values) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (readout < 0 || readout >= int(widgets.size())) return;
+    Widget& widget = widgets[readout];
+    int i = 0;
+    for (float value : values) {
+        if (i == MAX_VALUES) break;
+        widget.values[i] = value;
+        // against what's on the screen, so a number creeping a little at a time still gets redrawn
+        if (!widget.drawn || std::abs(value - widget.shown[i]) > widget.epsilon) widget.dirty = true;
+        i++;
+    }
+}
+
+void ScreenRenderer::setText(int text, const char* value) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (text < 0 || text >= int(widgets.size())) return;
+    Widget& widget = widgets[text];
+    if (widget.drawn && std::strncmp(widget.text, value, TEXT_LENGTH - 1) == 0) return;
+    std::snprintf(widget.text, TEXT_LENGTH, "%s", value);
+    widget.dirty = true;
+}
+
+void ScreenRenderer::setStatus(const char* value) { setText(status, value); }
+
+void ScreenRenderer::setPose(const lemlib::Pose& pose) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    this->pose = pose;
+    poseSet = true;
+}
+
+void ScreenRenderer::setPath(const lemlib::PathAsset& path) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    pathNextCount = 0;
+    const int size = path.size();
+    if (size > 0) {
+        // every step'th point and the last, so the path keeps its ends whatever its length
+        const int step = (size + PATH_POINTS - 2) / (PATH_POINTS - 1);
+        for (int i = 0; i < size; i += step) pathNext[pathNextCount++] = toMap(path[i].x, path[i].y);
+        if ((size - 1) % step != 0) pathNext[pathNextCount++] = toMap(path[size - 1].x, path[size - 1].y);
+    }
+    pathDirty = true;
+}
+
+void ScreenRenderer::clearTrail() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    trailCleared = true;
+}
+
+void ScreenRenderer::nextPage() { page = (page + 1) % pageCount; }
+
+int ScreenRenderer::getPage() const { return page; }
+
+void ScreenRenderer::onClick(lv_event_t* event) {
+    static_cast<ScreenRenderer*>(lv_event_get_user_data(event))->nextPage();
+}
+
+void ScreenRenderer::render(std::uint32_t now) {
+    if (pages.empty() || (rendered && now - lastRender < redrawPeriod)) return;
+    rendered = true;
+    lastRender = now;
+    std::lock_guard<pros::Mutex> lock(mutex);
+
+    const int showing = page;
+    if (showing != shownPage) {
+        for (int i = 0; i < pageCount; i++) {
+            if (i == showing) lv_obj_clear_flag(pages[i], LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_add_flag(pages[i], LV_OBJ_FLAG_HIDDEN);
+        }
+        shownPage = showing;
+    }
+
+    char line[TEXT_LENGTH];
+    for (Widget& widget : widgets) {
+        if (!widget.dirty || widget.page != showing) continue;
+        if (widget.format == nullptr) {
+            lv_label_set_text(widget.label, widget.text);
+        } else {
+            const auto& v = widget.values;
+            std::snprintf(line, sizeof(line), widget.format, v[0], v[1], v[2], v[3], v[4], v[5]);
+            lv_label_set_text(widget.label, line);
+            widget.shown = widget.values;
+        }
+        widget.drawn = true;
+        widget.dirty = false;
+    }
+
+    // the trail keeps growing while another page is up, so it's all there when the map is back
+    if (trailCleared) {
+        trailCounts.fill(0);
+        trailDirty.fill(true);
+        trailChunk = 0;
+        trailCleared = false;
+    }
+    const lv_point_t at = toMap(pose.x, pose.y);
+    if (poseSet) {
+        const int count = trailCounts[trailChunk];
+        const lv_point_t* last = count > 0 ? &trail[trailChunk][count - 1] : nullptr;
+        if (last == nullptr || std::hypot(at.x - last->x, at.y - last->y) >= TRAIL_SPACING) {
+            if (count == CHUNK_POINTS) {
+                // start the next piece where this one ends, over the oldest once they're all full
+                const lv_point_t end = *last;
+                trailChunk = (trailChunk + 1) % TRAIL_CHUNKS;
+                trail[trailChunk][0] = end;
+                trailCounts[trailChunk] = 1;
+            }
+            trail[trailChunk][trailCounts[trailChunk]++] = at;
+            trailDirty[trailChunk] = true;
+        }
+    }
+    if (showing != 0) return;
+
+    if (poseSet) {
+        const lv_point_t corner {lv_coord_t(at.x - ROBOT_SIZE / 2), lv_coord_t(at.y - ROBOT_SIZE / 2)};
+        if (!robotPlaced || corner != robotShown) {
+            if (!robotPlaced) lv_obj_clear_flag(robot, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_set_pos(robot, corner.x, corner.y);
+            robotShown = corner;
+            robotPlaced = true;
+        }
+        const float theta = pose.theta * float(M_PI) / 180;
+        const lv_point_t tip {lv_coord_t(at.x + std::round(std::sin(theta) * HEADING_LENGTH)),
+                              lv_coord_t(at.y - std::round(std::cos(theta) * HEADING_LENGTH))};
+        if (at != headingPoints[0] || tip != headingPoints[1]) {
+            headingPoints = {at, tip};
+            lv_line_set_points(heading, headingPoints.data(), 2);
+        }
+        poseSet = false;
+    }
+    if (pathDirty) {
+        pathPoints = pathNext;
+        lv_line_set_points(pathLine, pathPoints.data(), pathNextCount);
+        pathDirty = false;
+    }
+    for (int i = 0; i < TRAIL_CHUNKS; i++) {
+        if (!trailDirty[i]) continue;
+        lv_line_set_points(trailLines[i], trail[i].data(), trailCounts[i]);
+        trailDirty[i] = false;
+    }
+}
@@ -0,0 +1,121 @@
+#include "lemlib/trajectory.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float SAME_POINT = 1e-3; // in, closer points are repeats
+
+// heading from one point to the next, radians, 0 facing +y and clockwise positive like the chassis pose
+float direction(const lemlib::PathPoint& from, const lemlib::PathPoint& to) {
+    return std::atan2(to.x - from.x, to.y - from.y);
+}
+
+float angleBetween(float from, float to) { return std::remainder(to - from, 2 * M_PI); }
+
+} // namespace
+
+namespace lemlib {
+Trajectory::Trajectory(const PathAsset& path, TrajectoryLimits limits, bool forwards) {
+    // the points up to the first with a speed of 0, where follow() stops too
+    std::vector<PathPoint> points;
+    for (const PathPoint& point : path) {
+        if (points.empty() || std::hypot(point.x - points.back().x, point.y - points.back().y) > SAME_POINT) {
+            points.push_back(point);
+        }
+        if (point.speed == 0) break;
+    }
+    if (points.empty()) return;
+    const size_t count = points.size();
+    if (count == 1) {
+        states.push_back({0, points[0].x, points[0].y, 0, 0, 0, 0});
+        return;
+    }
+
+    std::vector<float> length(count - 1);
+    std::vector<float> heading(count - 1);
+    for (size_t i = 0; i + 1 < count; i++) {
+        length[i] = std::hypot(points[i + 1].x - points[i].x, points[i + 1].y - points[i].y);
+        heading[i] = direction(points[i], points[i + 1]);
+    }
+
+    // heading and curvature at each point from the segments either side, then the fastest the outside wheel and the
+    // path's own speed allow there
+    states.resize(count);
+    std::vector<float> curvature(count, 0);
+    std::vector<float> speed(count);
+    for (size_t i = 0; i < count; i++) {
+        TrajectoryState& state = states[i];
+        state.x = points[i].x;
+        state.y = points[i].y;
+        if (i == 0) {
+            state.theta = heading[0];
+        } else if (i == count - 1) {
+            state.theta = heading[i - 1];
+        } else {
+            const float turn = angleBetween(heading[i - 1], heading[i]);
+            state.theta = heading[i - 1] + turn / 2;
+            curvature[i] = turn / ((length[i - 1] + length[i]) / 2);
+        }
+        const float pathSpeed = limits.velocity * std::clamp(points[i].speed / 127, 0.0f, 1.0f);
+        speed[i] = std::min(pathSpeed, limits.velocity / (1 + std::fabs(curvature[i]) * limits.trackWidth / 2));
+    }
+
+    // speed up from a stop and slow down to one at the acceleration limit
+    speed.front() = 0;
+    speed.back() = 0;
+    for (size_t i = 1; i < count; i++) {
+        speed[i] = std::min(speed[i], std::sqrt(speed[i - 1] * speed[i - 1] + 2 * limits.acceleration * length[i - 1]));
+    }
+    for (size_t i = count - 1; i-- > 0;) {
+        speed[i] = std::min(speed[i], std::sqrt(speed[i + 1] * speed[i + 1] + 2 * limits.acceleration * length[i]));
+    }
+
+    // constant acceleration along each segment, so its time is its length over the average of its end speeds
+    const float sign = forwards ? 1 : -1;
+    float time = 0;
+    for (size_t i = 0; i < count; i++) {
+        TrajectoryState& state = states[i];
+        state.time = time;
+        state.velocity = sign * speed[i];
+        state.angularVelocity = curvature[i] * speed[i];
+        state.acceleration = 0;
+        if (!forwards) state.theta += M_PI;
+        state.theta = std::remainder(state.theta, 2 * M_PI);
+        if (i + 1 < count) {
+            state.acceleration = sign * (speed[i + 1] * speed[i + 1] - speed[i] * speed[i]) / (2 * length[i]);
+            time += 2 * length[i] / std::max(speed[i] + speed[i + 1], 1e-6f);
+        }
+        maxVelocity = std::max(maxVelocity, speed[i]);
+    }
+}
+
+TrajectoryState Trajectory::sample(float time) const {
+    if (states.empty()) return {0, 0, 0, 0, 0, 0, 0};
+    if (time <= 0) return states.front();
+    if (time >= states.back().time) return states.back();
+
+    const auto after = std::upper_bound(states.begin(), states.end(), time,
+                                        [](float t, const TrajectoryState& state) { return t < state.time; });
+    const TrajectoryState& a = *(after - 1);
+    const TrajectoryState& b = *after;
+    // the speed changes evenly with time, so how far along the segment it is goes with the average speed so far
+    const float elapsed = (time - a.time) / (b.time - a.time);
+    const float velocity = a.velocity + (b.velocity - a.velocity) * elapsed;
+    const float total = a.velocity + b.velocity;
+    const float along = total != 0 ? (a.velocity + velocity) * elapsed / total : elapsed;
+    return {time,
+            a.x + (b.x - a.x) * along,
+            a.y + (b.y - a.y) * along,
+            a.theta + angleBetween(a.theta, b.theta) * along,
+            velocity,
+            a.angularVelocity + (b.angularVelocity - a.angularVelocity) * along,
+            a.acceleration};
+}
+
+float Trajectory::getDuration() const { return states.empty() ? 0 : states.back().time; }
+
+float Trajectory::getMaxVelocity() const { return maxVelocity; }
+
+const std::vector<TrajectoryState>& Trajectory::getStates() const { return states; }
+} // namespace lemlib
@@ -0,0 +1,81 @@
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/feedforward.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/trajectoryTracker.hpp"
+#include "pros/misc.hpp"
+#include <algorithm>
+#include <cmath>
+
+// trajectory tracking, the alternative to pure pursuit. The trajectory says where the robot should be each moment,
+// the tracker turns how far it is from there into a speed and a turn rate, and the wheels are driven at those on the
+// drive feedforward, or on the free speed when there isn't one
+
+void lemlib::Chassis::follow(const Trajectory& trajectory, int timeout, TrajectoryTrackerParams params, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        // the trajectory is not copied, it has to outlive the motion
+        pros::Task task([this, &trajectory, timeout, params] { follow(trajectory, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    if (trajectory.getStates().empty()) {
+        infoSink()->error("Empty trajectory! Was its path asset packed by pathAsset.py? Skipping motion");
+        this->endMotion();
+        return;
+    }
+
+    const TrajectoryTracker tracker(params, trajectory.getMaxVelocity());
+    const float freeSpeed = drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter;
+    const int compState = pros::competition::get_status();
+    Pose lastPose = this->getPose(true);
+    distTraveled = 0;
+
+    Timer timer(timeout);
+    const uint32_t start = pros::millis();
+    while (!timer.isDone() && this->motionRunning) {
+        // stop if the competition state changes
+        if (compState != pros::competition::get_status()) break;
+
+        const float elapsed = (pros::millis() - start) / 1000.0f;
+        if (elapsed > trajectory.getDuration()) break;
+
+        const Pose pose = this->getPose(true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        const TrajectoryState target = trajectory.sample(elapsed);
+        const UnicycleCommand command = tracker.calculate(pose, target);
+        // turning clockwise speeds the left side up
+        const float turn = command.angularVelocity * drivetrain.trackWidth / 2;
+        float left = command.velocity + turn;
+        float right = command.velocity - turn;
+
+        if (hasDriveFeedforward()) {
+            tankVelocity(left, right, target.acceleration, target.acceleration);
+        } else {
+            left *= 127 / freeSpeed;
+            right *= 127 / freeSpeed;
+            // keep the ratio between the sides if either is saturated
+            const float ratio = std::max(std::fabs(left), std::fabs(right)) / 127;
+            if (ratio > 1) {
+                left /= ratio;
+                right /= ratio;
+            }
+            drivetrain.leftMotors->move(left);
+            drivetrain.rightMotors->move(right);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    this->endMotion();
+}
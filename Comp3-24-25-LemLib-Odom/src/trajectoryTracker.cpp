@@ -0,0 +1,112 @@
+#include "lemlib/trajectoryTracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Errors and gains are worked out the usual way round for these controllers, x forwards, y to the left and angles
+// counterclockwise, then the turn rate is flipped back to the chassis' clockwise
+
+namespace {
+
+constexpr float DT = 0.01;           // s, the control loop period the LTV gains are for
+constexpr float MIN_SPEED = 0.01;    // in/s, stopped the drive can't correct sideways and the gains don't settle
+constexpr int MAX_ITERATIONS = 1000; // of the Riccati recursion
+constexpr float TOLERANCE = 1e-5;    // change in the Riccati solution, relative to its size, that counts as settled
+
+float sinc(float x) { return std::fabs(x) < 1e-6 ? 1 : std::sin(x) / x; }
+
+float largest(const lemlib::Matrix<3, 3>& m) {
+    float result = 0;
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t col = 0; col < 3; col++) result = std::max(result, std::fabs(m(row, col)));
+    }
+    return result;
+}
+
+lemlib::Matrix<2, 2> inverse(const lemlib::Matrix<2, 2>& m) {
+    const float determinant = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    lemlib::Matrix<2, 2> result;
+    result(0, 0) = m(1, 1) / determinant;
+    result(0, 1) = -m(0, 1) / determinant;
+    result(1, 0) = -m(1, 0) / determinant;
+    result(1, 1) = m(0, 0) / determinant;
+    return result;
+}
+
+// infinite horizon LQR gain for the unicycle linearized at a speed, by iterating the discrete Riccati equation
+lemlib::Matrix<2, 3> lqrGain(float velocity, const lemlib::Matrix<3, 3>& q, const lemlib::Matrix<2, 2>& r) {
+    if (std::fabs(velocity) < MIN_SPEED) velocity = velocity < 0 ? -MIN_SPEED : MIN_SPEED;
+    // the sideways error grows with the heading error at the speed. That is the only coupling, so the discrete model
+    // is exact
+    lemlib::Matrix<3, 3> a = lemlib::Matrix<3, 3>::identity();
+    a(1, 2) = velocity * DT;
+    lemlib::Matrix<3, 2> b;
+    b(0, 0) = DT;
+    b(1, 1) = velocity * DT * DT / 2;
+    b(2, 1) = DT;
+
+    const lemlib::Matrix<3, 3> at = a.transpose();
+    const lemlib::Matrix<2, 3> bt = b.transpose();
+    lemlib::Matrix<3, 3> p = q;
+    for (int i = 0; i < MAX_ITERATIONS; i++) {
+        const lemlib::Matrix<2, 3> gain = inverse(r + bt * p * b) * (bt * p * a);
+        const lemlib::Matrix<3, 3> next = q + at * p * a - at * p * b * gain;
+        const bool settled = largest(next - p) <= TOLERANCE * largest(next);
+        p = next;
+        if (settled) break;
+    }
+    return inverse(r + bt * p * b) * (bt * p * a);
+}
+
+} // namespace
+
+namespace lemlib {
+TrajectoryTracker::TrajectoryTracker(TrajectoryTrackerParams params, float maxVelocity)
+    : params(params),
+      maxVelocity(std::max(maxVelocity, 1.0f)) {
+    if (params.type != TrajectoryTrackerType::LTV) return;
+    // Bryson's rule, each error and correction weighed by how much of it is acceptable
+    Matrix<3, 3> q;
+    q(0, 0) = 1 / (params.maxErrorX * params.maxErrorX);
+    q(1, 1) = 1 / (params.maxErrorY * params.maxErrorY);
+    const float maxErrorTheta = params.maxErrorTheta * M_PI / 180;
+    q(2, 2) = 1 / (maxErrorTheta * maxErrorTheta);
+    Matrix<2, 2> r;
+    r(0, 0) = 1 / (params.maxVelocityCorrection * params.maxVelocityCorrection);
+    const float maxAngularCorrection = params.maxAngularCorrection * M_PI / 180;
+    r(1, 1) = 1 / (maxAngularCorrection * maxAngularCorrection);
+    for (int i = 0; i < 2 * GAIN_STEPS + 1; i++) {
+        gains[i] = lqrGain(this->maxVelocity * (i - GAIN_STEPS) / GAIN_STEPS, q, r);
+    }
+}
+
+UnicycleCommand TrajectoryTracker::calculate(const Pose& pose, const TrajectoryState& target) const {
+    // the error from the robot, forwards, to the left, and counterclockwise
+    const float dx = target.x - pose.x;
+    const float dy = target.y - pose.y;
+    const float sinTheta = std::sin(pose.theta);
+    const float cosTheta = std::cos(pose.theta);
+    const float errorX = dx * sinTheta + dy * cosTheta;
+    const float errorY = dy * sinTheta - dx * cosTheta;
+    const float errorTheta = std::remainder(pose.theta - target.theta, 2 * M_PI);
+    const float velocity = target.velocity;
+    const float angularVelocity = -target.angularVelocity;
+
+    if (params.type == TrajectoryTrackerType::RAMSETE) {
+        const float k = 2 * params.zeta * std::sqrt(angularVelocity * angularVelocity + params.b * velocity * velocity);
+        return {velocity * std::cos(errorTheta) + k * errorX,
+                -(angularVelocity + k * errorTheta + params.b * velocity * sinc(errorTheta) * errorY)};
+    }
+
+    // gains between the two speeds either side of the target's
+    const float index = std::clamp(velocity / maxVelocity, -1.0f, 1.0f) * GAIN_STEPS + GAIN_STEPS;
+    const int low = std::min(int(index), 2 * GAIN_STEPS - 1);
+    const float blend = index - low;
+    const Matrix<2, 3> gain = gains[low] * (1 - blend) + gains[low + 1] * blend;
+    Vector<3> error;
+    error(0, 0) = errorX;
+    error(1, 0) = errorY;
+    error(2, 0) = errorTheta;
+    const Vector<2> correction = gain * error;
+    return {velocity + correction(0, 0), -(angularVelocity + correction(1, 0))};
+}
+} // namespace lemlib
@@ -0,0 +1,161 @@
+#pragma once
+
+// EZ-Code and EZ-Code-Odom each have a copy of this file, and the two have to stay the same: change
+// both.  Host-Sim's `make syntax` fails if they differ.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "api.h"
+
+/**
+ * Drives an arm on one motor, like the lady brown, to encoder positions
+ * without blocking.
+ *
+ * Every move follows a trapezoid: speed up at max_acceleration, cruise at
+ * max_velocity, slow down to stop on the target.  The power each loop is
+ * feedforward for where the plan is, kV for its speed, kA for its
+ * acceleration and kG times the cosine of the arm angle to hold the arm up
+ * against gravity, with a PD on how far the arm is off the plan.  The plan
+ * never asks for more than the arm can do, so the PD only corrects small
+ * errors and the arm comes in on the target without overshooting or sagging
+ * below it.
+ *
+ * Positions and speeds are motor encoder degrees, the same numbers
+ * get_position() gives.  The motor should be tared with the arm down on its
+ * stop, at rest_angle.
+ */
+class ArmController {
+ public:
+  struct Settings {
+    double gear_ratio;        // motor degrees per degree the arm turns
+    double rest_angle;        // deg the arm is above horizontal at position 0
+    double kg;                // power that holds the arm level
+    double kv;                // power per deg/s of planned speed
+    double ka;                // power per deg/s^2 of planned acceleration
+    double kp;                // power per deg the arm is off the plan
+    double kd;                // power per deg/s the arm is off the planned speed
+    double max_velocity;      // deg/s
+    double max_acceleration;  // deg/s^2
+    double tolerance = 20;    // deg from the target a move counts as reached
+    std::uint32_t settle_time = 60;  // ms the arm stays inside the tolerance before a move is reached
+  };
+
+  /**
+   * Where a move is at.
+   */
+  enum class MoveStatus { RUNNING, REACHED, REPLACED };
+
+  /**
+   * Handle on a move from move_to(), to check on it or wait for it.  Copies
+   * share the same move.
+   */
+  class Move {
+   public:
+    /**
+     * Returns the status, REPLACED once a later move_to() took over before
+     * this one was reached.
+     */
+    MoveStatus status_get() const;
+
+    /**
+     * Returns true once the move is reached or replaced.
+     */
+    bool done() const;
+
+    /**
+     * Blocks until the move is done.
+     *
+     * \param timeout
+     *        ms to give up after, 0 to wait for as long as it takes
+     *
+     * Returns true if the arm reached the target.
+     */
+    bool wait(std::uint32_t timeout = 0) const;
+
+   private:
+    friend class ArmController;
+    explicit Move(std::shared_ptr<std::atomic<MoveStatus>> status);
+
+    std::shared_ptr<std::atomic<MoveStatus>> status;
+  };
+
+  /**
+   * ArmController constructor.
+   *
+   * \param motor
+   *        the arm motor, positive raising the arm
+   * \param settings
+   *        see Settings
+   */
+  ArmController(pros::Motor& motor, Settings settings);
+
+  static constexpr std::uint32_t PERIOD = 10;  // ms
+
+  /**
+   * Runs the arm.  Leaves the motor alone until the first move and after
+   * release().  Never returns, start it in its own task.
+   */
+  void run();
+
+  /**
+   * One loop of the arm, what run() does every PERIOD.  For running it from
+   * a scheduler instead of its own task.
+   *
+   * \param now
+   *        ms
+   */
+  void update(std::uint32_t now);
+
+  /**
+   * Starts moving to a position and returns straight away.  Takes over from
+   * a move still going, carrying on from the speed it had.  Asking for the
+   * target already being moved to or held returns that move.
+   *
+   * \param target
+   *        motor encoder degrees
+   */
+  Move move_to(double target);
+
+  /**
+   * Stops driving the motor until the next move_to(), so it can be run by
+   * hand.  A move still going is replaced.
+   */
+  void release();
+
+  /**
+   * Returns the position the arm is moving to or holding.
+   */
+  double target_get();
+
+  /**
+   * Returns true if the arm has reached its target and is holding there.
+   */
+  bool settled();
+
+  /**
+   * Changes the settings, e.g. after retuning kG.
+   */
+  void settings_set(Settings input);
+
+ private:
+  // one loop of the controller, with the mutex held
+  void step(std::uint32_t now);
+  // one loop of the trapezoid, from where the plan is towards the target
+  void plan_step(double dt);
+  double gravity(double position) const;
+
+  pros::Motor& motor;
+  Settings settings;
+  pros::Mutex mutex;
+  double target = 0;
+  bool holding = false;  // driving the motor, from move_to() until release()
+  // where the plan says the arm should be now
+  double planned_position = 0;
+  double planned_velocity = 0;
+  double planned_acceleration = 0;
+  std::uint32_t inside_since = 0;
+  bool inside = false;
+  std::shared_ptr<std::atomic<MoveStatus>> current;
+};
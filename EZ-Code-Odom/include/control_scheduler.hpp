@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "api.h"
+
+/**
+ * Where in a tick a job runs.  Every job due on a tick runs stage by stage, so
+ * the controllers work from readings taken on that tick and their outputs go
+ * out before anything slow like the screen gets a turn.
+ */
+enum class Stage : std::uint8_t {
+  SENSE,    // reading sensors, e.g. GPS fusion
+  COMPUTE,  // deciding what to do with them
+  ACTUATE,  // driving motors and pistons
+  DISPLAY   // screen and logging
+};
+
+/**
+ * Runs the robot's periodic jobs from one task on one shared tick.
+ *
+ * The same scheduler as Comp3's ControlScheduler, written for this project.
+ * Separate tasks each with their own delay loop drift in and out of phase with
+ * each other, so whether the sort sees this tick's hook position or the last
+ * one's changes from run to run.  Here every job has a period that is a
+ * multiple of the tick, and every job due on a tick runs in the same order.
+ *
+ * Jobs run by stage, then shortest period first, then in the order they were
+ * added.  A job must never block or delay, the jobs after it wait for it.
+ * EZ-Template's own drive and odom tasks are left as they are.
+ */
+class ControlScheduler {
+ public:
+  struct Stats {
+    const char* name;
+    std::uint32_t period;           // ms
+    std::uint32_t runs = 0;
+    std::uint64_t total_time = 0;   // us spent running
+    std::uint32_t max_time = 0;     // us, longest run
+    std::uint32_t max_latency = 0;  // us from when it was due to when it started
+    std::uint32_t misses = 0;       // runs that finished after the next one was due
+  };
+
+  /**
+   * Control scheduler constructor.
+   *
+   * \param tick
+   *        ms between ticks, every job's period is a multiple of it
+   */
+  ControlScheduler(std::uint32_t tick = 5);
+
+  /**
+   * Adds a job.  Add every job before run() starts.
+   *
+   * \param name
+   *        shown in reports, a string literal or something else that lives as long
+   * \param stage
+   *        where in the tick it runs
+   * \param period
+   *        ms between runs, rounded up to a multiple of the tick
+   * \param job
+   *        gets the time the tick was due, in ms
+   *
+   * \return the job's index for stats_get()
+   */
+  int add(const char* name, Stage stage, std::uint32_t period, std::function<void(std::uint32_t now)> job);
+
+  /**
+   * Runs the jobs.  Never returns, start it in its own task, above the
+   * priority of anything that could hold it up.
+   */
+  void run();
+
+  /**
+   * Runs every job due on one tick.  run() calls this every tick.
+   *
+   * \param now
+   *        the time the tick was due, ms
+   */
+  void update(std::uint32_t now);
+
+  /**
+   * Returns a job's stats.
+   *
+   * \param job
+   *        index from add(), in the order they were added
+   */
+  Stats stats_get(int job) const;
+
+  /**
+   * Starts every job's stats again, e.g. at the start of a match.
+   */
+  void stats_reset();
+
+  /**
+   * Prints every job's stats to the terminal, one line each.
+   */
+  void report_print() const;
+
+ private:
+  struct Job {
+    Stage stage;
+    std::function<void(std::uint32_t)> run;
+    int index;  // add() order
+    Stats stats;
+  };
+
+  const std::uint32_t tick;  // ms
+  std::uint32_t ticks = 0;   // since run() started
+  std::vector<Job> jobs;     // in the order they run
+};
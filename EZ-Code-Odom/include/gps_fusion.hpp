@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "api.h"
+
+/**
+ * Pulls EZ-Template's odometry towards the GPS sensor.
+ *
+ * A GPS reading is already old when it reaches the brain, so it is compared
+ * with where odometry had the robot when the reading was taken, from a short
+ * history of odom poses, not with where odometry has the robot now.  The old
+ * pose is corrected, and the same correction is applied to the pose now, so
+ * everything odometry measured since the reading is kept.
+ *
+ * How much a reading moves the pose depends on how far the robot has driven
+ * since the last one, so a robot sitting still doesn't wander with the GPS's
+ * noise.  Readings that are far off, like one off a robot blocking the field
+ * strip, are skipped unless they keep saying the same thing.
+ *
+ * The GPS works in field coordinates, inches from the center and degrees
+ * clockwise from its 0, so odometry has to too.  Off until enabled_set(true).
+ */
+class GpsFusion {
+ public:
+  struct Settings {
+    double latency;          // ms from the GPS taking a reading to the brain having it
+    double min_error;        // in, the least a reading is ever taken to be off by
+    double odom_noise;       // in odometry drifts per square root inch driven
+    double heading_weight;   // 0-1, how much of the heading difference one reading fixes
+    double gate;             // readings this many times further off than expected, squared, are skipped
+    int trust_after;         // skipped readings in a row before odometry is taken to be the one that's off
+  };
+
+  /**
+   * GPS fusion constructor.
+   *
+   * \param drive
+   *        the chassis, its odom pose is read and corrected
+   * \param gps
+   *        the GPS sensor, set up with its offset on the robot
+   * \param settings
+   *        see Settings
+   */
+  GpsFusion(ez::Drive& drive, pros::Gps& gps, Settings settings);
+
+  static constexpr std::uint32_t PERIOD = 10;  // ms
+
+  /**
+   * Takes in the newest GPS reading, if there is one.  Call it every PERIOD,
+   * main.cpp runs it on the ControlScheduler.
+   */
+  void update();
+
+  /**
+   * Turns the fusion on or off.  Turn it on once odometry has been set to
+   * where the robot is on the field.
+   */
+  void enabled_set(bool enabled);
+
+  /**
+   * Returns true if the fusion is on.
+   */
+  bool enabled_get() const;
+
+  /**
+   * Returns how many GPS readings have been skipped for being too far off.
+   */
+  std::uint32_t rejected_get();
+
+ private:
+  struct Sample {
+    std::uint32_t time;  // us
+    ez::pose pose;
+  };
+
+  static constexpr int HISTORY = 64;  // odom poses kept, 640 ms
+
+  void fuse();
+  bool pose_at(std::uint32_t time, ez::pose& pose) const;
+  void correct(const ez::pose& then, const ez::pose& corrected);
+
+  ez::Drive& drive;
+  pros::Gps& gps;
+  const Settings settings;
+
+  std::atomic<bool> enabled = false;
+  bool started = false;
+
+  pros::Mutex mutex;
+  std::array<Sample, HISTORY> history{};
+  int newest = 0;
+  int count = 0;
+  ez::pose last_pose{0, 0, 0};
+  double variance = 0;  // in^2, how far odometry might have drifted since the GPS last corrected it
+  pros::gps_status_s_t last_reading{};
+  std::uint32_t rejected = 0;
+  int rejected_in_a_row = 0;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "api.h"
+#include "ring_sorter.hpp"
+
+/**
+ * Backs the intake out of jams.
+ *
+ * Both intake motors are watched while they are asked to run.  A motor that
+ * draws stall current but barely turns for most of a window has a ring stuck
+ * in it, so it is run backwards for a moment and then forwards again.  If it
+ * keeps jamming it is stopped until it is asked for something else, instead of
+ * sitting at full current until someone notices.
+ *
+ * Everything should drive the intake through intake_set() instead of the
+ * motors.  The hooks are still driven through the RingSorter, and are left
+ * alone while it throws a ring.
+ */
+class IntakeSupervisor {
+ public:
+  struct Settings {
+    int min_power;               // 0-127, asking for less than this never counts as a jam
+    double stall_velocity;       // rpm, turning slower than this in the direction asked for is stalled
+    double stall_current;        // mA, drawing more than this is pushing against something
+    std::uint32_t window;        // ms a motor has to look stalled for, up to 320
+    int reverse_power;           // 0-127, power the jam is backed out with
+    std::uint32_t reverse_time;  // ms it is backed out for
+    int max_retries;             // jams in a row before the motor is stopped
+  };
+
+  struct Stats {
+    int jams = 0;                 // jams backed out of
+    int stopped = 0;              // times a motor ran out of retries and was stopped
+    std::uint32_t time_lost = 0;  // ms from motors jamming until they ran forwards again
+  };
+
+  /**
+   * Intake supervisor constructor.
+   *
+   * \param low
+   *        the bottom intake motor, forward taking rings in
+   * \param hooks
+   *        the hook motor, the one sorter drives
+   * \param sorter
+   *        ring sort on the hooks
+   * \param settings
+   *        see Settings
+   */
+  IntakeSupervisor(pros::Motor& low, pros::Motor& hooks, RingSorter& sorter, Settings settings);
+
+  static constexpr std::uint32_t PERIOD = 10;  // ms
+
+  /**
+   * Checks both motors for jams.  Call it every PERIOD, main.cpp runs it on
+   * the ControlScheduler.
+   *
+   * \param now
+   *        ms
+   */
+  void update(std::uint32_t now);
+
+  /**
+   * Sets the power of both intake motors.  Can be called every loop, only a
+   * change of power cancels a retry or restarts a stopped motor.
+   *
+   * \param low_power
+   *        -127 to 127, bottom intake
+   * \param hook_power
+   *        -127 to 127, hooks
+   */
+  void intake_set(int low_power, int hook_power);
+
+  /**
+   * Sets both intake motors to the same power.
+   */
+  void intake_set(int power);
+
+  /**
+   * Returns true while a motor is backing out of a jam or stopped.
+   */
+  bool jammed_get();
+
+  /**
+   * Returns the jams and time lost since the last stats_reset(), both motors
+   * together.
+   */
+  Stats stats_get();
+
+  /**
+   * Clears the stats, e.g. at the start of a match.
+   */
+  void stats_reset();
+
+ private:
+  enum class State { RUNNING, REVERSING, STOPPED };
+
+  static constexpr int MAX_SAMPLES = 32;
+  static constexpr double JAM_FRACTION = 0.8;  // of the window that has to look stalled
+
+  struct Channel {
+    pros::Motor& motor;
+    RingSorter* sorter;  // drives the motor when set
+    int requested = 0;
+    State state = State::RUNNING;
+    std::uint32_t state_until = 0;  // ms the reverse ends
+    int retries = 0;
+    bool losing_time = false;  // jammed and not running forwards again yet
+    std::uint32_t jammed_at = 0;
+    std::uint32_t recovered_at = 0;  // ms it last ran forwards again, a new jam is counted from after this
+    std::array<bool, MAX_SAMPLES> stalled{};  // ring buffer of the last samples
+    int next = 0;
+    int samples = 0;
+    int stalled_count = 0;
+  };
+
+  void request(Channel& channel, int power, std::uint32_t now);
+  void update(Channel& channel, std::uint32_t now);
+  void drive(Channel& channel, int power);
+  void window_clear(Channel& channel);
+  void time_lost_end(Channel& channel, std::uint32_t now);
+
+  const Settings settings;
+  const int window_samples;
+
+  pros::Mutex mutex;
+  Channel low;
+  Channel hooks;
+  Stats stats;
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "api.h"
+#include "ring_color.hpp"
+
+/**
+ * Color sort that follows each ring up the hooks.
+ *
+ * Ring colors come from a RingClassifier, which can be recalibrated at an
+ * event through calibration_start() / calibration_finish().
+ *
+ * A ring is logged the moment it shows up in front of the optical sensor,
+ * along with where the hook motor was at the time.  The hooks carry it a fixed
+ * number of degrees to the top, so the eject is timed off the hook encoder
+ * instead of a fixed delay, and the sensor keeps being watched while a ring is
+ * thrown.  Back to back rings each get their own eject.
+ *
+ * The sort only takes over the hooks while it is throwing a ring.  Everything
+ * else should drive the hooks through intake_set() so they go back to what was
+ * asked for afterwards.
+ */
+class RingSorter {
+ public:
+  struct Settings {
+    int proximity;            // 0-255, a ring is in front of the sensor above this
+    double travel;            // hook degrees from the sensor to the top, where the ring is thrown
+    int eject_power;          // -127 to 127, hook power while throwing
+    std::uint32_t eject_time; // ms the eject power is held
+    double min_eject_speed;   // rpm, slower hooks can't throw a ring so they are stopped instead
+    double integration_time = 10;  // ms the sensor takes per reading, 3-712, shorter keeps up with a faster intake
+  };
+
+  /**
+   * Ring sorter constructor.
+   *
+   * \param sensor
+   *        optical sensor at the bottom of the hooks
+   * \param hooks
+   *        the hook motor, forward carrying rings up
+   * \param settings
+   *        see Settings
+   * \param classifier
+   *        red/blue decision, replaced by saved calibration on calibration_load()
+   */
+  RingSorter(pros::Optical& sensor, pros::Motor& hooks, Settings settings, RingClassifier classifier = {});
+
+  static constexpr std::uint32_t PERIOD = 5;  // ms
+
+  /**
+   * One pass of the sort.  Call it every PERIOD, main.cpp runs it on the
+   * ControlScheduler.
+   *
+   * \param now
+   *        ms
+   */
+  void update(std::uint32_t now);
+
+  /**
+   * Turns the sort on or off.  When off the sensor LED is turned off and rings
+   * already on the hooks are forgotten.
+   */
+  void enabled_set(bool enabled);
+
+  /**
+   * Returns true if the sort is on.
+   */
+  bool enabled_get() const;
+
+  /**
+   * Sets which alliance we are, rings of the other color are thrown.
+   */
+  void red_team_set(bool red);
+
+  /**
+   * Returns true if we are red.
+   */
+  bool red_team_get() const;
+
+  /**
+   * Sets the hook power.  Applied straight away unless a ring is being thrown,
+   * then it is applied once the throw is done.
+   *
+   * \param power
+   *        -127 to 127
+   */
+  void intake_set(int power);
+
+  /**
+   * Returns true while a ring is being thrown and the hooks are not doing
+   * what intake_set() asked for.
+   */
+  bool ejecting_get();
+
+  /**
+   * Returns the number of rings between the sensor and the top.
+   */
+  int rings_on_hooks();
+
+  /**
+   * Loads the classifier calibration saved on the SD card, if any.
+   */
+  bool calibration_load();
+
+  /**
+   * Records every ring that passes the sensor as the given color until
+   * calibration_finish().  Sorting is paused meanwhile.
+   */
+  void calibration_start(RingColor label);
+
+  /**
+   * Returns the color being recorded, NONE when not calibrating.
+   */
+  RingColor calibration_get();
+
+  /**
+   * Fits and saves the calibration, see RingClassifier::calibration_finish().
+   */
+  bool calibration_finish();
+
+ private:
+  struct Ring {
+    std::uint32_t seen_at;  // ms
+    double eject_at;        // hook position where it reaches the top, deg
+    bool wrong_color;
+  };
+
+  static constexpr int MAX_RINGS = 4;
+
+  bool wrong_color(RingColor color) const;
+  void eject(std::uint32_t now);
+
+  pros::Optical& sensor;
+  pros::Motor& hooks;
+  const Settings settings;
+  RingClassifier classifier;
+
+  std::atomic<bool> enabled = false;
+  std::atomic<bool> red_team = true;
+
+  pros::Mutex mutex;
+  std::array<Ring, MAX_RINGS> rings{};
+  int first = 0;  // oldest ring
+  int count = 0;
+  bool ring_present = false;
+  bool configured = false;  // integration time set on the sensor
+  bool led_on = false;
+  int requested = 0;
+  bool ejecting = false;
+  std::uint32_t eject_until = 0;
+};
@@ -2,7 +2,11 @@
 
 #include "EZ-Template/api.hpp"
 #include "api.h"
+#include "arm_controller.hpp"
+#include "gps_fusion.hpp"
+#include "intake_supervisor.hpp"
 #include "pros/optical.hpp"
+#include "ring_sorter.hpp"
 
 extern Drive chassis;
 
@@ -14,34 +18,83 @@ inline pros::Motor ladybrown(4);
 // inline ez::Piston doinker('A');
 inline pros::Optical colorsort(16);
 
+// Throws wrong color rings off the top of intakeHigh
+inline RingSorter ring_sorter(colorsort, intakeHigh, {
+    150,  // Proximity that counts as a ring in front of the sensor, 0-255
+    250,  // Hook degrees from the sensor to the top
+    -127, // Reverse the hooks
+    100,  // for 100 ms
+    100   // Under 100 rpm the hooks just stop
+});
+
+// Drive intakeLow and the hooks through this, it backs them out of jams
+inline IntakeSupervisor intake_supervisor(intakeLow, intakeHigh, ring_sorter, {
+    60,    // Asking for less power than this never counts as a jam
+    20,    // rpm, slower than this is stalled
+    1800,  // mA, while drawing more than this
+    200,   // for most of 200 ms
+    127,   // Back the jam out at full power
+    150,   // for 150 ms
+    3      // Stop the motor after 3 jams in a row
+});
+
+// GPS fusion stays off, and the GPS is never read, until this is true.  The port and offset below are
+// placeholders, set them to where the sensor really is on the robot first
+inline constexpr bool USE_GPS_FUSION = false;
+
+// GPS, offset is meters from the center of the drive to the sensor, right and forward.  Placeholders, see above
+inline pros::Gps gps_sensor(6, 0, 0);
+
+// Corrects odom with the GPS once enabled_set(true), after odom is set to the field
+inline GpsFusion gps_fusion(chassis, gps_sensor, {
+    50,    // ms the GPS readings are late by
+    0.5,   // in, the least a reading is taken to be off by
+    0.1,   // in odom drifts per square root inch driven
+    0.05,  // Fix 5% of the heading difference per reading
+    9,     // Skip readings more than 3 standard deviations off
+    5      // unless 5 in a row say the same thing
+});
+
 // inline ez::Piston intakePiston('B');
 inline ez::Piston mogoclamp('C');
 
 
-inline void set_lb(int input) {
-  ladybrown.move(input);
-}
-
-inline ez::PID lbPID{0.45, 0, 0, 0, "ladybrown"};
+// Moves the lady brown along motion profiles and holds it up against gravity
+//
+// None of these are measured yet, TUNE THEM ON THE ROBOT.  gear_ratio and rest_angle are the ones
+// Host-Sim's lady_brown bench arm is built with, count the gear teeth and measure the arm's angle
+// sitting on its stop.  The gains were fitted against that bench arm, whose mass and reach are
+// guesses: raise kg until the arm holds level without drifting, then ka until moves keep up with
+// the plan at the start, then kp and kd until the ring doesn't sag at the middle position.  kv is
+// 127 power over the 1200 deg/s the motor spins at full power.
+inline ArmController lb_controller(ladybrown, {
+    12,            // Motor degrees per degree of arm
+    -60,           // Arm degrees above horizontal sitting down on its stop
+    7,             // Power that holds the arm level
+    127.0 / 1200,  // Power per deg/s
+    0.005,         // Power per deg/s^2
+    1.0,           // Power per deg behind the plan
+    0.02,          // Power per deg/s behind the plan
+    1100,          // deg/s top speed
+    9000           // deg/s^2 to speed up and slow down
+});
 
+// Waits for the lady brown to reach its target, for up to 3 seconds
 inline void lb_wait() {
-  while (lbPID.exit_condition({ladybrown}, true) == ez::RUNNING) {
+  const std::uint32_t start = pros::millis();
+  while (!lb_controller.settled() && pros::millis() - start < 3000) {
     pros::delay(ez::util::DELAY_TIME);
   }
 }
 
 //vars
 
-inline bool isColorSortEnabled = false;  // Start enabled by default
-inline std::atomic<bool> isRedTeam(true); // Atomic for thread safety
-
 inline void selectRedTeam() {
-    isRedTeam.store(true);
-    
+    ring_sorter.red_team_set(true);
 }
 
 inline void selectBlueTeam() {
-    isRedTeam.store(false);
+    ring_sorter.red_team_set(false);
 }
 
 
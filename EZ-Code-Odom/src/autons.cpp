@@ -64,13 +64,11 @@ void drive_example() {
   chassis.pid_odom_set(-4_in, DRIVE_SPEED, true);
   chassis.pid_wait();
   mogoclamp.set(true);
-  intakeHigh.move(106);
-  intakeLow.move(127);
+  intake_supervisor.intake_set(127, 106);
   chassis.pid_drive_set(30_in, DRIVE_SPEED*0.2, true);
   chassis.pid_wait();
   
-  intakeHigh.move(0);
-  intakeLow.move(0);
+  intake_supervisor.intake_set(0);
   
 }
 
@@ -281,9 +279,9 @@ void odom_pure_pursuit_wait_until_example() {
                         {{0_in, 0_in}, rev, DRIVE_SPEED}},
                        true);
   chassis.pid_wait_until_index(1);  // Waits until the robot passes 12, 24
-  intakeHigh.move(127);  // Set your intake to start moving once it passes through the second point in the index
+  intake_supervisor.intake_set(127);  // Set your intake to start moving once it passes through the second point in the index
   chassis.pid_wait();
-  intakeHigh.move(0);  // Turn the intake off
+  intake_supervisor.intake_set(0);  // Turn the intake off
 }
 
 ///
@@ -397,8 +395,7 @@ void blue_negative_auton() {
     chassis.pid_turn_relative_set(205_deg, TURN_SPEED);
     chassis.pid_wait();
     // BLOCK 2 - get 3 rings 
-    intakeHigh.move(106);
-    intakeLow.move(127);
+    intake_supervisor.intake_set(127, 106);
     chassis.pid_drive_set(12_in, DRIVE_SPEED);
     chassis.pid_wait();
     chassis.pid_turn_relative_set(32.5_deg, TURN_SPEED);
@@ -421,7 +418,7 @@ void blue_negative_auton() {
     chassis.pid_odom_set({{-1.0_in, -49.26_in, -90_deg}, fwd, DRIVE_SPEED}, 
     true);
     chassis.pid_wait();
-    lbPID.target_set(2200);
+    lb_controller.move_to(2200);
 
 
     // chassis.pid_turn_relative_set(118_deg, TURN_SPEED);
@@ -482,8 +479,7 @@ void red_negative_auton() {
     chassis.pid_turn_relative_set(-205_deg, TURN_SPEED);
     chassis.pid_wait();
     // BLOCK 2 - get 3 rings 
-    intakeHigh.move(106);
-    intakeLow.move(127);
+    intake_supervisor.intake_set(127, 106);
     chassis.pid_drive_set(12_in, DRIVE_SPEED);
     chassis.pid_wait();
     chassis.pid_turn_relative_set(-32.5_deg, TURN_SPEED);
@@ -505,7 +501,7 @@ void red_negative_auton() {
     chassis.pid_odom_set({{-1.0_in, -49.26_in, -90_deg}, fwd, DRIVE_SPEED}, 
     true);
     chassis.pid_wait();
-    lbPID.target_set(2200);
+    lb_controller.move_to(2200);
     // chassis.pid_turn_relative_set(-118_deg, TURN_SPEED);
     // chassis.pid_wait();
     // chassis.pid_drive_set(5_in, DRIVE_SPEED);
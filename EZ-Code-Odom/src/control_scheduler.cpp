@@ -0,0 +1,83 @@
+#include "control_scheduler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+namespace {
+
+const char* stage_name(Stage stage) {
+  switch (stage) {
+    case Stage::SENSE: return "sense";
+    case Stage::COMPUTE: return "compute";
+    case Stage::ACTUATE: return "actuate";
+    default: return "display";
+  }
+}
+
+}  // namespace
+
+ControlScheduler::ControlScheduler(std::uint32_t tick) : tick(std::max<std::uint32_t>(tick, 1)) {}
+
+int ControlScheduler::add(const char* name, Stage stage, std::uint32_t period,
+                          std::function<void(std::uint32_t now)> job) {
+  period = std::max<std::uint32_t>((period + tick - 1) / tick, 1) * tick;
+  const int index = jobs.size();
+  // after every job that runs before it, so jobs that tie stay in the order they were added
+  const auto before = std::find_if(jobs.begin(), jobs.end(), [&](const Job& other) {
+    return std::make_pair(stage, period) < std::make_pair(other.stage, other.stats.period);
+  });
+  Stats stats;
+  stats.name = name;
+  stats.period = period;
+  jobs.insert(before, {stage, std::move(job), index, stats});
+  return index;
+}
+
+void ControlScheduler::run() {
+  std::uint32_t now = pros::millis();
+  while (true) {
+    update(now);
+    pros::Task::delay_until(&now, tick);
+  }
+}
+
+void ControlScheduler::update(std::uint32_t now) {
+  const std::uint64_t due = std::uint64_t(now) * 1000;
+  for (Job& job : jobs) {
+    Stats& stats = job.stats;
+    if (ticks % (stats.period / tick) != 0) continue;
+    // late from waiting on the jobs before it as much as from running long itself
+    const std::uint64_t start = pros::micros();
+    job.run(now);
+    const std::uint64_t end = pros::micros();
+    const std::uint32_t time = end - start;
+    stats.runs++;
+    stats.total_time += time;
+    stats.max_time = std::max(stats.max_time, time);
+    if (start > due) stats.max_latency = std::max<std::uint32_t>(stats.max_latency, start - due);
+    if (end > due + stats.period * 1000) stats.misses++;
+  }
+  ticks++;
+}
+
+ControlScheduler::Stats ControlScheduler::stats_get(int job) const {
+  for (const Job& each : jobs) {
+    if (each.index == job) return each.stats;
+  }
+  return {};
+}
+
+void ControlScheduler::stats_reset() {
+  for (Job& job : jobs) job.stats = {job.stats.name, job.stats.period};
+}
+
+void ControlScheduler::report_print() const {
+  for (const Job& job : jobs) {
+    const Stats& stats = job.stats;
+    const unsigned long mean = stats.runs == 0 ? 0 : stats.total_time / stats.runs;
+    printf("%-12s %-8s %3lu ms  %7lu runs  mean %5lu us  max %6lu us  latency %6lu us  %lu missed\n", stats.name,
+           stage_name(job.stage), (unsigned long)stats.period, (unsigned long)stats.runs, mean,
+           (unsigned long)stats.max_time, (unsigned long)stats.max_latency, (unsigned long)stats.misses);
+  }
+}
@@ -0,0 +1,122 @@
+#include "gps_fusion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace {
+
+constexpr double INCHES_PER_METER = 39.3701;
+
+double radians(double degrees) { return degrees * M_PI / 180; }
+
+// -180 to 180
+double wrap(double degrees) { return std::remainder(degrees, 360); }
+
+}  // namespace
+
+GpsFusion::GpsFusion(ez::Drive& drive, pros::Gps& gps, Settings settings)
+    : drive(drive), gps(gps), settings(settings) {}
+
+void GpsFusion::update() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  fuse();
+}
+
+void GpsFusion::enabled_set(bool input) { enabled.store(input); }
+
+bool GpsFusion::enabled_get() const { return enabled.load(); }
+
+std::uint32_t GpsFusion::rejected_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return rejected;
+}
+
+void GpsFusion::fuse() {
+  if (!enabled.load()) {
+    started = false;
+    return;
+  }
+  const std::uint32_t time = pros::micros();
+  const ez::pose pose = drive.odom_pose_get();
+  if (!started) {
+    // odometry was just set, as sure of it as of the best GPS reading
+    count = 0;
+    variance = settings.min_error * settings.min_error;
+    last_pose = pose;
+    started = true;
+  }
+  // odometry drifts as it drives, more the further it goes
+  variance += settings.odom_noise * settings.odom_noise * std::hypot(pose.x - last_pose.x, pose.y - last_pose.y);
+  last_pose = pose;
+  newest = (newest + 1) % HISTORY;
+  history[newest] = {time, pose};
+  count = std::min(count + 1, HISTORY);
+
+  // readings come every 20 ms or so, one that hasn't changed has already been used. PROS_ERR_F is infinite
+  const pros::gps_status_s_t reading = gps.get_position_and_orientation();
+  if (!std::isfinite(reading.x) || !std::isfinite(reading.y) || !std::isfinite(reading.yaw)) return;
+  if (reading.x == last_reading.x && reading.y == last_reading.y && reading.yaw == last_reading.yaw) return;
+  last_reading = reading;
+
+  ez::pose then{0, 0, 0};
+  if (!pose_at(time - std::uint32_t(settings.latency * 1000), then)) return;
+  const double error_x = reading.x * INCHES_PER_METER - then.x;
+  const double error_y = reading.y * INCHES_PER_METER - then.y;
+  const double gps_error = std::max(settings.min_error, gps.get_error() * INCHES_PER_METER);
+  const double gps_variance = gps_error * gps_error;
+
+  // the expected squared distance between them is twice the variance of each, one for x and one for y
+  const double squared_error = error_x * error_x + error_y * error_y;
+  if (squared_error > settings.gate * 2 * (variance + gps_variance)) {
+    rejected++;
+    if (++rejected_in_a_row <= settings.trust_after) return;
+    // every reading for a while says odometry is off by about this much, so it probably is
+    variance = std::max(variance, squared_error / 2);
+  }
+  rejected_in_a_row = 0;
+
+  const double gain = variance / (variance + gps_variance);
+  correct(then, {then.x + gain * error_x, then.y + gain * error_y,
+                 then.theta + settings.heading_weight * wrap(reading.yaw - then.theta)});
+  variance *= 1 - gain;
+}
+
+// Odom pose at a time, between the two samples either side of it
+bool GpsFusion::pose_at(std::uint32_t time, ez::pose& pose) const {
+  for (int i = 0; i < count - 1; i++) {
+    const Sample& after = history[(newest - i + HISTORY) % HISTORY];
+    const Sample& before = history[(newest - i - 1 + HISTORY) % HISTORY];
+    // signed, so it still works when micros() wraps after 71 minutes
+    if (std::int32_t(time - before.time) < 0) continue;
+    const double t = std::min(1.0, double(time - before.time) / double(after.time - before.time));
+    pose = {before.pose.x + (after.pose.x - before.pose.x) * t, before.pose.y + (after.pose.y - before.pose.y) * t,
+            before.pose.theta + wrap(after.pose.theta - before.pose.theta) * t};
+    return true;
+  }
+  return false;
+}
+
+// Turns and slides the path since `then` so it starts from `corrected`, which
+// moves the pose now and every pose in the history after it the same way
+void GpsFusion::correct(const ez::pose& then, const ez::pose& corrected) {
+  const double turn = radians(wrap(corrected.theta - then.theta));
+  const double s = std::sin(turn);
+  const double c = std::cos(turn);
+  auto move = [&](ez::pose& pose) {
+    // clockwise, like the heading
+    const double dx = pose.x - then.x;
+    const double dy = pose.y - then.y;
+    pose = {corrected.x + dx * c + dy * s, corrected.y - dx * s + dy * c, pose.theta + (corrected.theta - then.theta)};
+  };
+  for (int i = 0; i < count; i++) move(history[i].pose);
+
+  // EZ-Template's odometry task can move the pose between reading it here and
+  // setting it, so it is read again right before.  At most one of its updates
+  // can slip through, and that only loses the correction's effect on that
+  // update's motion, a fraction of an inch
+  ez::pose now = drive.odom_pose_get();
+  move(now);
+  drive.odom_pose_set(now);
+  last_pose = now;
+}
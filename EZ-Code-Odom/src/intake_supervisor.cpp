@@ -0,0 +1,143 @@
+#include "intake_supervisor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+
+IntakeSupervisor::IntakeSupervisor(pros::Motor& low, pros::Motor& hooks, RingSorter& sorter, Settings settings)
+    : settings(settings),
+      window_samples(std::clamp<int>(settings.window / PERIOD, 1, MAX_SAMPLES)),
+      low{low, nullptr},
+      hooks{hooks, &sorter} {}
+
+void IntakeSupervisor::update(std::uint32_t now) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  update(low, now);
+  update(hooks, now);
+}
+
+void IntakeSupervisor::intake_set(int low_power, int hook_power) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  const std::uint32_t now = pros::millis();
+  request(low, low_power, now);
+  request(hooks, hook_power, now);
+}
+
+void IntakeSupervisor::intake_set(int power) { intake_set(power, power); }
+
+bool IntakeSupervisor::jammed_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return low.state != State::RUNNING || hooks.state != State::RUNNING;
+}
+
+IntakeSupervisor::Stats IntakeSupervisor::stats_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  Stats now_stats = stats;
+  // count a jam that is still going up to now
+  const std::uint32_t now = pros::millis();
+  for (const Channel* channel : {&low, &hooks}) {
+    if (channel->losing_time) now_stats.time_lost += now - channel->jammed_at;
+  }
+  return now_stats;
+}
+
+void IntakeSupervisor::stats_reset() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  stats = {};
+  const std::uint32_t now = pros::millis();
+  for (Channel* channel : {&low, &hooks}) {
+    if (channel->losing_time) channel->jammed_at = now;
+  }
+}
+
+void IntakeSupervisor::drive(Channel& channel, int power) {
+  if (channel.sorter != nullptr) {
+    channel.sorter->intake_set(power);
+  } else {
+    channel.motor.move(power);
+  }
+}
+
+void IntakeSupervisor::window_clear(Channel& channel) {
+  channel.stalled.fill(false);
+  channel.next = 0;
+  channel.samples = 0;
+  channel.stalled_count = 0;
+}
+
+void IntakeSupervisor::time_lost_end(Channel& channel, std::uint32_t now) {
+  if (!channel.losing_time) return;
+  stats.time_lost += now - channel.jammed_at;
+  channel.losing_time = false;
+  channel.recovered_at = now;
+}
+
+void IntakeSupervisor::request(Channel& channel, int power, std::uint32_t now) {
+  // opcontrol asks for the same thing every loop, that mustn't cancel a retry
+  if (power == channel.requested) return;
+  channel.requested = power;
+  // a new command is the driver taking over, whatever was jammed
+  time_lost_end(channel, now);
+  channel.state = State::RUNNING;
+  channel.retries = 0;
+  window_clear(channel);
+  drive(channel, power);
+}
+
+void IntakeSupervisor::update(Channel& channel, std::uint32_t now) {
+  if (channel.state == State::STOPPED) return;
+  if (channel.state == State::REVERSING) {
+    if (now < channel.state_until) return;
+    channel.state = State::RUNNING;
+    drive(channel, channel.requested);
+    return;
+  }
+
+  // A throw reverses the hooks on purpose, and a motor asked for little power
+  // may well be stopped by a ring without anything being wrong
+  const bool ejecting = channel.sorter != nullptr && channel.sorter->ejecting_get();
+  if (ejecting || std::abs(channel.requested) < settings.min_power) {
+    window_clear(channel);
+    return;
+  }
+
+  const int direction = channel.requested > 0 ? 1 : -1;
+  const double velocity = direction * channel.motor.get_actual_velocity();
+  const bool stalled =
+      velocity < settings.stall_velocity && std::abs(channel.motor.get_current_draw()) > settings.stall_current;
+  if (!stalled && velocity >= settings.stall_velocity) time_lost_end(channel, now);
+
+  // sliding window over the last window_samples passes
+  if (channel.samples == window_samples) {
+    channel.stalled_count -= channel.stalled[channel.next];
+  } else {
+    channel.samples++;
+  }
+  channel.stalled[channel.next] = stalled;
+  channel.stalled_count += stalled;
+  channel.next = (channel.next + 1) % window_samples;
+
+  if (channel.samples < window_samples) return;
+  if (channel.stalled_count == 0) channel.retries = 0;  // running clean again
+  if (channel.stalled_count < JAM_FRACTION * window_samples) return;
+
+  // Jammed since about the start of the window
+  if (!channel.losing_time) {
+    channel.losing_time = true;
+    channel.jammed_at = std::max(now - std::min(now, settings.window), channel.recovered_at);
+  }
+  window_clear(channel);
+  if (channel.retries >= settings.max_retries) {
+    // Still jammed after every retry, give up until asked for something else
+    stats.stopped++;
+    channel.state = State::STOPPED;
+    drive(channel, 0);
+    return;
+  }
+  stats.jams++;
+  channel.retries++;
+  channel.state = State::REVERSING;
+  channel.state_until = now + settings.reverse_time;
+  drive(channel, -direction * settings.reverse_power);
+}
@@ -1,6 +1,7 @@
 #include "main.h"
 #include "autons.hpp"
 #include "subsystems.hpp"
+#include "control_scheduler.hpp"
 
 /////
 // For installation, upgrading, documentations, and tutorials, check out our website!
@@ -25,66 +26,14 @@ ez::Drive chassis(
 ez::tracking_wheel horiz_tracker(-5, 2, 3.0);  // This tracking wheel is perpendicular to the drive wheels
 ez::tracking_wheel vert_tracker(12, 2, 0.0);   // This tracking wheel is parallel to the drive wheels
 
-void sorting_task() {
-    pros::delay(2000);  // Set EZ-Template calibrate before this function starts running
-    while (true) {
-        if (isColorSortEnabled) {
-            auto values = colorsort.get_rgb();
-            bool bad_ring_detected;
-            
-            if (isRedTeam.load()) {  // check team color multithread
-                bad_ring_detected = values.blue > 220 && values.red < 220; //red team
-                if (bad_ring_detected) {
-                    if (intakeHigh.get_actual_velocity() < 100) {
-                        intakeHigh.move(0);
-                    }
-                    else {
-                        intakeHigh.move(-127);
-                        pros::delay(100);
-                        intakeHigh.move(0);
-                    }
-                }
-            } 
-            else {
-                bad_ring_detected = values.blue < 220 && values.red > 220; //blue team
-                if (bad_ring_detected) {
-                    if (intakeHigh.get_actual_velocity() < 100) {
-                        intakeHigh.move(0);
-                    }
-                    else {
-                        intakeHigh.move(-127);
-                        pros::delay(100);
-                        intakeHigh.move(0);                    }
-                }
-            }
-            
-            // Update LED based on sorting status
-            colorsort.set_led_pwm(100); //if color sort on then led on
-        } 
-        else {
-            // Turn off LED when sorting is disabled
-            colorsort.set_led_pwm(0);
-        }
-
-        pros::delay(ez::util::DELAY_TIME);
-    }
-}
-pros::Task SORTING_TASK(sorting_task);
-
-
-
-void lb_task() {
-  pros::delay(2000);  // Set EZ-Template calibrate before this function starts running
-  while (true) {
-    set_lb(lbPID.compute(ladybrown.get_position()));
-
-    pros::delay(ez::util::DELAY_TIME);
-  }
-}
-
-pros::Task LB_TASK(lb_task);
+// Runs GPS fusion, the sort, the intake, the lady brown and the odom page on one 5 ms tick, in that order within a
+// tick.  Started at the end of initialize(), once EZ-Template has calibrated
+ControlScheduler scheduler;
 
+// Odom page timing, printing it any faster than a person can read it only takes time from the control jobs
+const int SCREEN_PERIOD = 100;  // ms between checks for anything to reprint
 
+void ez_screen_update();
 
 /**
  * Runs initialization code. This occurs as soon as the program is started.
@@ -116,7 +65,6 @@ void initialize() {
   default_constants();
   
   ladybrown.tare_position();
-  lbPID.exit_condition_set(80, 50, 300, 150, 500, 500);
   intakeHigh.tare_position();
   
 
@@ -154,6 +102,17 @@ void initialize() {
   chassis.initialize();
   ez::as::initialize();
   master.rumble(chassis.drive_imu_calibrated() ? "." : "---");
+
+  ring_sorter.calibration_load();  // Bands fit at this venue, if there are any on the SD card
+  if (USE_GPS_FUSION)
+    scheduler.add("gps fusion", Stage::SENSE, GpsFusion::PERIOD, [](std::uint32_t) { gps_fusion.update(); });
+  scheduler.add("ring sorter", Stage::COMPUTE, RingSorter::PERIOD, [](std::uint32_t now) { ring_sorter.update(now); });
+  scheduler.add("intake", Stage::ACTUATE, IntakeSupervisor::PERIOD,
+                [](std::uint32_t now) { intake_supervisor.update(now); });
+  scheduler.add("lady brown", Stage::ACTUATE, ArmController::PERIOD,
+                [](std::uint32_t now) { lb_controller.update(now); });
+  scheduler.add("screen", Stage::DISPLAY, SCREEN_PERIOD, [](std::uint32_t) { ez_screen_update(); });
+  pros::Task scheduler_task([] { scheduler.run(); }, TASK_PRIORITY_DEFAULT + 2, TASK_STACK_DEPTH_DEFAULT, "Scheduler");
 }
 
 /**
@@ -162,7 +121,11 @@ void initialize() {
  * the robot is enabled, this task will exit.
  */
 void disabled() {
-  // . . .
+  // Jams from the auton or match that just ended, on the terminal
+  const IntakeSupervisor::Stats jams = intake_supervisor.stats_get();
+  printf("Intake: %d jams, %d stopped, %.1f s lost\n", jams.jams, jams.stopped, jams.time_lost / 1000.0);
+  // How long each job on the scheduler took and how late it ran
+  scheduler.report_print();
 }
 
 /**
@@ -198,7 +161,8 @@ void autonomous() {
 
   mogoclamp.set(false);
   // intakePiston.set(false);
-	isColorSortEnabled = false; //enable color sort for all of auto -- we could cook on the corners??
+  intake_supervisor.stats_reset();
+	ring_sorter.enabled_set(false); //enable color sort for all of auto -- we could cook on the corners??
 
   ladybrown.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
   /*
@@ -217,57 +181,89 @@ void autonomous() {
   ez::as::auton_selector.selected_auton_call();  // Calls selected auton from autonomous selector
 }
 
+const double SCREEN_EPSILON = 0.005;  // to_string_with_precision shows 2 decimals, so half the last one
+
 /**
- * Simplifies printing tracker values to the brain screen
+ * What a line of the odom page last showed, so it's only rebuilt and reprinted once a number on it
+ * has moved further than the screen can show
  */
-void screen_print_tracker(ez::tracking_wheel *tracker, std::string name, int line) {
+struct screen_line {
+  std::array<double, 3> shown{};
+  bool drawn = false;
+
+  // true, and remembers the values, when the line needs printing again
+  bool changed(const std::array<double, 3> &values) {
+    bool moved = !drawn;
+    for (int i = 0; i < 3; i++) moved |= std::abs(values[i] - shown[i]) > SCREEN_EPSILON;
+    if (moved) {
+      shown = values;
+      drawn = true;
+    }
+    return moved;
+  }
+};
+
+/**
+ * Simplifies printing tracker values to the brain screen, only when they change
+ */
+void screen_print_tracker(ez::tracking_wheel *tracker, std::string name, int line, screen_line &shown) {
+  const std::array<double, 3> values = {tracker != nullptr ? tracker->get() : 0.0,
+                                        tracker != nullptr ? tracker->distance_to_center_get() : 0.0, 0};
+  if (!shown.changed(values)) return;
   std::string tracker_value = "", tracker_width = "";
   // Check if the tracker exists
   if (tracker != nullptr) {
-    tracker_value = name + " tracker: " + util::to_string_with_precision(tracker->get());             // Make text for the tracker value
-    tracker_width = "  width: " + util::to_string_with_precision(tracker->distance_to_center_get());  // Make text for the distance to center
+    tracker_value = name + " tracker: " + util::to_string_with_precision(values[0]);             // Make text for the tracker value
+    tracker_width = "  width: " + util::to_string_with_precision(values[1]);                     // Make text for the distance to center
   }
   ez::screen_print(tracker_value + tracker_width, line);  // Print final tracker text
 }
 
 /**
- * Ez screen task
+ * Ez screen page, one pass of it.  The scheduler runs it every SCREEN_PERIOD
  * Adding new pages here will let you view them during user control or autonomous
  * and will help you debug problems you're having
  */
-void ez_screen_task() {
-  while (true) {
-    // Only run this when not connected to a competition switch
-    if (!pros::competition::is_connected()) {
-      // Blank page for odom debugging
-      if (chassis.odom_enabled() && !chassis.pid_tuner_enabled()) {
-        // If we're on the first blank page...
-        if (ez::as::page_blank_is_on(0)) {
-          // Display X, Y, and Theta
-          ez::screen_print("x: " + util::to_string_with_precision(chassis.odom_x_get()) +
-                               "\ny: " + util::to_string_with_precision(chassis.odom_y_get()) +
-                               "\na: " + util::to_string_with_precision(chassis.odom_theta_get()),
+void ez_screen_update() {
+  static screen_line pose_line, tracker_lines[4];
+  bool page_on = false;
+  // Only run this when not connected to a competition switch
+  if (!pros::competition::is_connected()) {
+    // Blank page for odom debugging
+    if (chassis.odom_enabled() && !chassis.pid_tuner_enabled()) {
+      // If we're on the first blank page...
+      page_on = ez::as::page_blank_is_on(0);
+      if (page_on) {
+        // Display X, Y, and Theta, all from one read so they come from the same odom update
+        const pose current = chassis.odom_pose_get();
+        if (pose_line.changed({current.x, current.y, current.theta})) {
+          ez::screen_print("x: " + util::to_string_with_precision(current.x) +
+                               "\ny: " + util::to_string_with_precision(current.y) +
+                               "\na: " + util::to_string_with_precision(current.theta),
                            1);  // Don't override the top Page line
-
-          // Display all trackers that are being used
-          screen_print_tracker(chassis.odom_tracker_left, "l", 4);
-          screen_print_tracker(chassis.odom_tracker_right, "r", 5);
-          screen_print_tracker(chassis.odom_tracker_back, "b", 6);
-          screen_print_tracker(chassis.odom_tracker_front, "f", 7);
         }
+
+        // Display all trackers that are being used
+        screen_print_tracker(chassis.odom_tracker_left, "l", 4, tracker_lines[0]);
+        screen_print_tracker(chassis.odom_tracker_right, "r", 5, tracker_lines[1]);
+        screen_print_tracker(chassis.odom_tracker_back, "b", 6, tracker_lines[2]);
+        screen_print_tracker(chassis.odom_tracker_front, "f", 7, tracker_lines[3]);
       }
     }
+  }
 
-    // Remove all blank pages when connected to a comp switch
-    else {
-      if (ez::as::page_blank_amount() > 0)
-        ez::as::page_blank_remove_all();
-    }
+  // Remove all blank pages when connected to a comp switch
+  else {
+    if (ez::as::page_blank_amount() > 0)
+      ez::as::page_blank_remove_all();
+  }
 
-    pros::delay(ez::util::DELAY_TIME);
+  // Print the whole page again when coming back to it, something else may have drawn over it
+  if (!page_on) {
+    pose_line.drawn = false;
+    for (screen_line &line : tracker_lines) line.drawn = false;
   }
 }
-pros::Task ezScreenTask(ez_screen_task);
 
 /**
  * Gives you some extras to run in your opcontrol:
@@ -289,6 +285,24 @@ void ez_template_extras() {
     if (master.get_digital_new_press(DIGITAL_X))
       chassis.pid_tuner_toggle();
 
+    // Color sort calibration, A steps through red rings -> blue rings -> save
+    //  A belongs to the PID Tuner while it is open
+    if (!chassis.pid_tuner_enabled() && master.get_digital_new_press(DIGITAL_A)) {
+      switch (ring_sorter.calibration_get()) {
+        case RingColor::NONE:
+          ring_sorter.calibration_start(RingColor::RED);
+          master.print(0, 0, "Cal: feed red   ");
+          break;
+        case RingColor::RED:
+          ring_sorter.calibration_start(RingColor::BLUE);
+          master.print(0, 0, "Cal: feed blue  ");
+          break;
+        case RingColor::BLUE:
+          master.print(0, 0, ring_sorter.calibration_finish() ? "Cal: saved      " : "Cal: too few    ");
+          break;
+      }
+    }
+
     // Trigger the selected autonomous routine
     if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_DOWN)) {
       pros::motor_brake_mode_e_t preference = chassis.drive_brake_get();
@@ -324,7 +338,8 @@ void opcontrol() {
     // This is preference to what you like to drive on
     chassis.drive_brake_set(MOTOR_BRAKE_COAST);
     ladybrown.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
-    lbPID.target_set(0);
+    lb_controller.move_to(0);
+    intake_supervisor.stats_reset();
     while (true) {
       // Gives you some extras to make EZ-Template ezier
       ez_template_extras();
@@ -343,20 +358,17 @@ void opcontrol() {
     
       // doinker.set(false);
       // intakePiston.set(false);
-      isColorSortEnabled = false;
+      ring_sorter.enabled_set(false);
 
 
       if (master.get_digital(DIGITAL_R1)) {
-          intakeLow.move(127);
-          intakeHigh.move(106);
+          intake_supervisor.intake_set(127, 106);
       } 
       else if (master.get_digital(DIGITAL_R2)) {
-          intakeLow.move(-127);
-          intakeHigh.move(-106);
+          intake_supervisor.intake_set(-127, -106);
       } 
       else {
-          intakeLow.move(0);
-          intakeHigh.move(0);
+          intake_supervisor.intake_set(0);
       }
 
       mogoclamp.button_toggle(master.get_digital(DIGITAL_L2)); 
@@ -366,28 +378,28 @@ void opcontrol() {
 
       if (master.get_digital(DIGITAL_DOWN)) {
           
-          lbPID.target_set(0);
+          lb_controller.move_to(0);
           
       }
 
       if (master.get_digital(DIGITAL_UP)) {
-          lbPID.target_set(1600);
+          lb_controller.move_to(1600);
       }
 
       if (master.get_digital(DIGITAL_LEFT)) {
-          lbPID.target_set(190);
+          lb_controller.move_to(190);
       }
 
       //color sort
       // if (master.get_digital(DIGITAL_Y)) {
-      //     isColorSortEnabled = true;
+      //     ring_sorter.enabled_set(true);
       // }
       // else if (master.get_digital(DIGITAL_X)) {
-      //     isColorSortEnabled = false;
+      //     ring_sorter.enabled_set(false);
           
       // }
       // else {
-      //     isColorSortEnabled = false;
+      //     ring_sorter.enabled_set(false);
       // }
 
       pros::delay(ez::util::DELAY_TIME);  // This is used for timer calculations!  Keep this ez::util::DELAY_TIME
@@ -0,0 +1,136 @@
+#include "ring_color.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// Signed shortest angle from a to b, deg
+double hue_distance(double a, double b) {
+  double d = fmod(b - a, 360);
+  if (d > 180) d -= 360;
+  if (d < -180) d += 360;
+  return d;
+}
+
+double to_rad(double deg) { return deg * M_PI / 180; }
+
+double to_deg(double rad) { return rad * 180 / M_PI; }
+
+const char* label_name(RingColor label) {
+  switch (label) {
+    case RingColor::RED:
+      return "red";
+    case RingColor::BLUE:
+      return "blue";
+    default:
+      return "none";
+  }
+}
+
+}  // namespace
+
+RingClassifier::RingClassifier() : RingClassifier(Settings{}) {}
+
+RingClassifier::RingClassifier(Settings settings) : settings(settings) {}
+
+RingColor RingClassifier::classify(double hue, double saturation) const {
+  if (saturation < settings.min_saturation) return RingColor::NONE;
+  // Distance in spreads, so a tight band doesn't lose to a loose one
+  const double red = fabs(hue_distance(settings.red.hue, hue)) / settings.red.spread;
+  const double blue = fabs(hue_distance(settings.blue.hue, hue)) / settings.blue.spread;
+  if (std::min(red, blue) > settings.width) return RingColor::NONE;
+  return red < blue ? RingColor::RED : RingColor::BLUE;
+}
+
+void RingClassifier::calibration_start(RingColor label) { calibrating = label; }
+
+RingColor RingClassifier::calibration_get() const { return calibrating; }
+
+void RingClassifier::record(const Sample& sample) {
+  if (calibrating == RingColor::NONE) return;
+  Sample labelled = sample;
+  labelled.label = calibrating;
+  samples.push_back(labelled);
+}
+
+int RingClassifier::sample_count(RingColor label) const {
+  return std::count_if(samples.begin(), samples.end(), [&](const Sample& s) { return s.label == label; });
+}
+
+RingClassifier::Settings RingClassifier::fit(const std::vector<Sample>& samples, const Settings& defaults) {
+  Settings fitted = defaults;
+  double min_saturation = 1;
+  for (RingColor label : {RingColor::RED, RingColor::BLUE}) {
+    // Hue wraps around, so average it as a direction
+    double sin_sum = 0, cos_sum = 0, sat_sum = 0, sat_squared_sum = 0;
+    int n = 0;
+    for (const Sample& s : samples) {
+      if (s.label != label) continue;
+      sin_sum += sin(to_rad(s.hue));
+      cos_sum += cos(to_rad(s.hue));
+      sat_sum += s.saturation;
+      sat_squared_sum += s.saturation * s.saturation;
+      n++;
+    }
+    if (n == 0) continue;
+    const double length = hypot(sin_sum, cos_sum) / n;
+    Band band = {fmod(to_deg(atan2(sin_sum, cos_sum)) + 360, 360),
+                 std::max(3.0, to_deg(sqrt(-2 * log(std::max(length, 1e-9)))))};
+    (label == RingColor::RED ? fitted.red : fitted.blue) = band;
+
+    const double mean = sat_sum / n;
+    const double deviation = sqrt(std::max(0.0, sat_squared_sum / n - mean * mean));
+    min_saturation = std::min(min_saturation, mean - 3 * deviation);
+  }
+  fitted.min_saturation = std::clamp(min_saturation, 0.1, 0.9);
+  // The bands can touch but not overlap
+  const double gap = fabs(hue_distance(fitted.red.hue, fitted.blue.hue));
+  fitted.width = std::min(defaults.width, gap / (fitted.red.spread + fitted.blue.spread));
+  return fitted;
+}
+
+bool RingClassifier::calibration_finish() {
+  calibrating = RingColor::NONE;
+  if (sample_count(RingColor::RED) < MIN_SAMPLES || sample_count(RingColor::BLUE) < MIN_SAMPLES) return false;
+  settings = fit(samples, settings);
+  save();
+  samples.clear();
+  return true;
+}
+
+bool RingClassifier::save() const {
+  if (!pros::usd::is_installed()) return false;
+
+  FILE* file = fopen(SETTINGS_FILE, "w");
+  if (file == nullptr) return false;
+  fprintf(file, "%f %f %f %f %f %f\n", settings.red.hue, settings.red.spread, settings.blue.hue,
+          settings.blue.spread, settings.min_saturation, settings.width);
+  fclose(file);
+
+  // The raw samples are kept so a bad fit can be looked at after the event
+  file = fopen(SAMPLES_FILE, "a");
+  if (file == nullptr) return false;
+  for (const Sample& s : samples) {
+    fprintf(file, "%s,%f,%f,%ld,%lu\n", label_name(s.label), s.hue, s.saturation,
+            static_cast<long>(s.proximity), static_cast<unsigned long>(s.clear));
+  }
+  fclose(file);
+  return true;
+}
+
+bool RingClassifier::load() {
+  if (!pros::usd::is_installed()) return false;
+  FILE* file = fopen(SETTINGS_FILE, "r");
+  if (file == nullptr) return false;
+  Settings loaded;
+  const int read = fscanf(file, "%lf %lf %lf %lf %lf %lf", &loaded.red.hue, &loaded.red.spread,
+                          &loaded.blue.hue, &loaded.blue.spread, &loaded.min_saturation, &loaded.width);
+  fclose(file);
+  if (read != 6) return false;
+  settings = loaded;
+  return true;
+}
+
+const RingClassifier::Settings& RingClassifier::settings_get() const { return settings; }
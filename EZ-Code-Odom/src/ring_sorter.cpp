@@ -0,0 +1,117 @@
+#include "ring_sorter.hpp"
+
+#include <cmath>
+#include <mutex>
+
+RingSorter::RingSorter(pros::Optical& sensor, pros::Motor& hooks, Settings settings, RingClassifier classifier)
+    : sensor(sensor), hooks(hooks), settings(settings), classifier(classifier) {}
+
+void RingSorter::enabled_set(bool input) { enabled.store(input); }
+
+bool RingSorter::enabled_get() const { return enabled.load(); }
+
+void RingSorter::red_team_set(bool red) { red_team.store(red); }
+
+bool RingSorter::red_team_get() const { return red_team.load(); }
+
+void RingSorter::intake_set(int power) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  requested = power;
+  if (!ejecting) hooks.move(power);
+}
+
+bool RingSorter::ejecting_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return ejecting;
+}
+
+int RingSorter::rings_on_hooks() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return count;
+}
+
+bool RingSorter::calibration_load() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return classifier.load();
+}
+
+void RingSorter::calibration_start(RingColor label) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  classifier.calibration_start(label);
+}
+
+RingColor RingSorter::calibration_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return classifier.calibration_get();
+}
+
+bool RingSorter::calibration_finish() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return classifier.calibration_finish();
+}
+
+bool RingSorter::wrong_color(RingColor color) const {
+  if (classifier.calibration_get() != RingColor::NONE) return false;
+  return color == (red_team.load() ? RingColor::BLUE : RingColor::RED);
+}
+
+void RingSorter::eject(std::uint32_t now) {
+  // Too slow to fling it, stopping at least keeps it off the stake
+  const bool can_throw = fabs(hooks.get_actual_velocity()) >= settings.min_eject_speed;
+  hooks.move(can_throw ? settings.eject_power : 0);
+  ejecting = true;
+  eject_until = now + settings.eject_time;
+}
+
+void RingSorter::update(std::uint32_t now) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  if (!configured) {
+    sensor.set_integration_time(settings.integration_time);
+    configured = true;
+  }
+  // Calibrating needs the sensor running even with the sort off
+  const bool on = enabled.load() || classifier.calibration_get() != RingColor::NONE;
+  if (on != led_on) {
+    sensor.set_led_pwm(on ? 100 : 0);
+    led_on = on;
+  }
+  if (!on) {
+    count = 0;
+    ring_present = false;
+  }
+
+  const double position = hooks.get_position();
+
+  if (on) {
+    // A ring arriving is a rising edge on proximity, its color is read every
+    // pass until it has gone past
+    const bool present = sensor.get_proximity() > settings.proximity;
+    if (present && !ring_present && count < MAX_RINGS) {
+      rings[(first + count) % MAX_RINGS] = {now, position + settings.travel, false};
+      count++;
+    }
+    if (present && count > 0) {
+      const double hue = sensor.get_hue();
+      const double saturation = sensor.get_saturation();
+      Ring& newest = rings[(first + count - 1) % MAX_RINGS];
+      newest.wrong_color = newest.wrong_color || wrong_color(classifier.classify(hue, saturation));
+      if (classifier.calibration_get() != RingColor::NONE)
+        classifier.record({RingColor::NONE, hue, saturation, sensor.get_proximity(), sensor.get_raw().clear});
+    }
+    ring_present = present;
+
+    // Running the hooks backwards takes rings back out past the sensor
+    while (count > 0 && position < rings[(first + count - 1) % MAX_RINGS].eject_at - settings.travel - 1) count--;
+
+    while (count > 0 && position >= rings[first].eject_at) {
+      if (rings[first].wrong_color) eject(now);
+      first = (first + 1) % MAX_RINGS;
+      count--;
+    }
+  }
+
+  if (ejecting && now >= eject_until) {
+    ejecting = false;
+    hooks.move(requested);
+  }
+}
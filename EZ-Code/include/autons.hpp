@@ -1,8 +1,16 @@
 #pragma once
 
 #include "EZ-Template/drive/drive.hpp"
+#include "arm_controller.hpp"
+#include "localizer.hpp"
+#include "motion_profile.hpp"
+#include "path_cache.hpp"
 
 extern Drive chassis;
+extern Localizer localizer;
+extern ProfiledDrive profiled_drive;
+extern PathCache path_cache;
+extern ArmController lb_controller;
 
 void drive_example();
 void turn_example();
@@ -11,6 +19,9 @@ void red_negative_auton();
 void red_positive_auton();
 void blue_positive_auton();
 void drive_and_turn();
+void drive_and_turn_profiled();
+void spline_example();
+void drive_characterization();
 void wait_until_change_speed();
 void swing_example();
 void motion_chaining();
@@ -18,4 +29,5 @@ void combining_movements();
 void interfered_example();
 void skills_auton();
 
-void default_constants();
\ No newline at end of file
+void default_constants();
+void paths_generate();
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "EZ-Template/drive/drive.hpp"
+#include "api.h"
+
+/**
+ * Motor voltage for a speed and an acceleration, ks sgn(v) + kv v + ka a.
+ *
+ * ks is what it takes to get moving against friction, kv what it takes to
+ * hold each unit of speed, and ka what it takes to speed the robot up.
+ * Unlike PID gains they are properties of the robot, so they hold at any
+ * speed.  Measure them with drive_characterize().
+ */
+struct Feedforward {
+  double ks = 0;  // V
+  double kv = 0;  // V per unit/s
+  double ka = 0;  // V per unit/s^2
+
+  /**
+   * Returns volts for a speed and an acceleration, 0 when stopped and not
+   * speeding up.
+   */
+  double calculate(double velocity, double acceleration = 0) const;
+};
+
+/**
+ * The feedforward of the drive, what characterizeFit.py prints.
+ */
+struct DriveFeedforward {
+  Feedforward left;     // in/s of the left wheels
+  Feedforward right;    // in/s of the right wheels
+  Feedforward angular;  // deg/s of the robot turning in place, volts on each side opposite ways
+  double kp = 0;        // V per in/s a side is off its target speed, see ProfiledDrive::velocity_set()
+
+  /**
+   * Returns true once it has been filled in.
+   */
+  bool is_set() const;
+};
+
+/**
+ * See drive_characterize().
+ */
+struct CharacterizeSettings {
+  double ramp_rate = 1.5;    // V/s the slow ramps speed up by
+  double step_voltage = 7;   // V the sudden steps jump to
+  double max_distance = 36;  // in a straight test may cover, it needs that much clear field in front
+  int turn_time = 4000;      // ms a turning test runs for
+  int rest_time = 1000;      // ms to coast to a stop between tests
+};
+
+/**
+ * Runs the drive characterization tests, meant as an auton next to the
+ * examples.  Slow voltage ramps and sudden voltage steps, driving forwards,
+ * backwards and turning both ways, coasting to a stop between each.
+ *
+ * Every 10 ms it prints "characterize,ms,test,left V,right V,left in,right in,
+ * heading" to the terminal.  Save the terminal output and run
+ * Comp3-24-25-LemLib-Odom/firmware/characterizeFit.py on it to get the
+ * constants for ProfiledDrive::Settings::feedforward.  Blocks until done,
+ * about 30 seconds, and takes the drive off EZ-Template's PID.
+ */
+void drive_characterize(ez::Drive& drive, CharacterizeSettings settings);
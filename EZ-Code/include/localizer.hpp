@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "api.h"
+
+/**
+ * Where the robot is on the field.  Inches from the center of the field, and
+ * degrees clockwise from facing +y like the IMU.
+ */
+struct FieldPose {
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+};
+
+/**
+ * A straight piece of field wall or field element, inches.
+ */
+struct FieldWall {
+  float x1;
+  float y1;
+  float x2;
+  float y2;
+};
+
+/**
+ * What the distance sensors can see of the High Stakes field: the perimeter
+ * and the four ladder posts.  +x is towards the blue alliance stake, so the
+ * red alliance stake is at (-70.2, 0).  Rings, goals and robots move, so they
+ * are left out.
+ */
+std::vector<FieldWall> high_stakes_field();
+
+/**
+ * How far to trust the drive and the distance sensors, see Localizer.
+ */
+struct LocalizerSettings {
+  float drive_noise = 0.04;    // fraction of each move the particles spread by, wheel slip
+  float side_noise = 0.02;     // in sideways per in driven, skidding on turns
+  float turn_noise = 0.02;     // fraction of each turn the heading errors spread by
+  float sensor_noise = 0.5;    // in, plus sensor_scale of the reading
+  float sensor_scale = 0.03;
+  int min_confidence = 30;     // 0-63, weaker readings are ignored
+  float max_range = 78;        // in, the sensors can't see further than 2 m
+  float max_spread = 6;        // in, RMS distance of the particles from the pose past which it isn't trusted
+};
+
+/**
+ * Monte Carlo localization off distance sensors pointed at the field walls.
+ *
+ * Keeps a cloud of guesses (particles) of where the robot is.  Every update
+ * each one is moved by what the drive encoders and the IMU say happened, with
+ * a little noise for wheel slip, then weighed by how well the distance
+ * sensors agree with what it would see from there.  Unlikely guesses die out
+ * and likely ones multiply, so the cloud stays on the real robot even as the
+ * encoders drift.
+ *
+ * The IMU heading is trusted, each particle only carries a small heading
+ * error on top of it.  That keeps trig out of the per particle loops, and the
+ * particles live as one array per value so those loops run over contiguous
+ * floats without branches and the compiler can vectorize them.
+ *
+ * Dead reckoning off the same encoders and IMU is kept alongside, see
+ * odom_pose_get().
+ */
+class Localizer {
+ public:
+  static constexpr int PARTICLES = 512;
+  static constexpr int MAX_SENSORS = 4;
+
+  /**
+   * A distance sensor and where it is on the robot.
+   */
+  struct Mount {
+    pros::Distance* sensor;
+    float x;      // in, right of the center of the drive
+    float y;      // in, forward of the center of the drive
+    float angle;  // deg clockwise from straight ahead
+  };
+
+  /**
+   * Localizer constructor.
+   *
+   * \param drive
+   *        the chassis, its left and right encoders and IMU are read
+   * \param mounts
+   *        up to MAX_SENSORS distance sensors
+   * \param field
+   *        what they can see, usually high_stakes_field()
+   * \param settings
+   *        see LocalizerSettings
+   */
+  Localizer(ez::Drive& drive, std::vector<Mount> mounts, std::vector<FieldWall> field, LocalizerSettings settings = {});
+
+  /**
+   * Runs the localizer every ez::util::DELAY_TIME.  Never returns, start it in
+   * its own task.  Does nothing until pose_set().
+   */
+  void run();
+
+  /**
+   * Tells the localizer where the robot is and starts it.  Call after
+   * resetting the drive sensors and IMU.
+   */
+  void pose_set(FieldPose pose);
+
+  /**
+   * Returns where the robot most likely is.
+   */
+  FieldPose pose_get();
+
+  /**
+   * Returns where the drive encoders and IMU alone put the robot.
+   */
+  FieldPose odom_pose_get();
+
+  /**
+   * Returns true once pose_set() has started it and the particles agree on
+   * where the robot is, to within LocalizerSettings::max_spread.
+   */
+  bool confident();
+
+  /**
+   * Returns how far to drive straight ahead, negative backwards, to get level
+   * with a point on the field.  Meant for pid_drive_set() in place of a fixed
+   * distance on long drives, check confident() first.
+   */
+  double distance_to(double x, double y);
+
+  /**
+   * Returns how long the last update took, us.
+   */
+  std::uint32_t update_time_get();
+
+  /**
+   * Reads the sensors and moves the particles along.  run() calls this.
+   */
+  void update();
+
+  /**
+   * One pass of the filter on readings that were already taken, without
+   * touching the hardware.  Public so it can be timed and replayed off the
+   * robot.
+   *
+   * \param forward
+   *        in the center of the drive moved since the last step
+   * \param theta
+   *        IMU heading now, field degrees
+   * \param readings
+   *        in from each mount, negative when it saw nothing
+   */
+  void step(float forward, float theta, const std::array<float, MAX_SENSORS>& readings);
+
+ private:
+  void spread(float forward, float theta);
+  void weigh(const Mount& mount, float reading, float theta);
+  void resample();
+  void estimate(float theta);
+
+  ez::Drive& drive;
+  const std::vector<Mount> mounts;
+  const std::vector<FieldWall> field;
+  const LocalizerSettings settings;
+
+  pros::Mutex mutex;
+  bool started = false;
+  FieldPose pose;
+  float pose_spread = 0;    // in, RMS distance of the particles from pose
+  FieldPose odom;
+  double imu_offset = 0;    // field heading minus the IMU
+  double last_left = 0;     // in
+  double last_right = 0;
+  float last_theta = 0;     // field degrees
+  std::array<float, MAX_SENSORS> last_readings{};
+  std::uint32_t update_time = 0;
+
+  // the particles, one array per value.  theta is each one's heading error
+  // from the IMU, radians
+  alignas(16) std::array<float, PARTICLES> x{};
+  alignas(16) std::array<float, PARTICLES> y{};
+  alignas(16) std::array<float, PARTICLES> theta{};
+  alignas(16) std::array<float, PARTICLES> weight{};
+  alignas(16) std::array<float, PARTICLES> scratch{};
+  alignas(16) std::array<std::uint32_t, PARTICLES> seed{};  // each particle's own random sequence
+  std::array<std::uint16_t, PARTICLES> picked{};             // which particle each slot copies when resampling
+};
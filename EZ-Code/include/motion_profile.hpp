@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "api.h"
+#include "feedforward.hpp"
+#include "path_cache.hpp"
+
+/**
+ * How hard a motion profile may drive, in the units of the distance it covers.
+ */
+struct ProfileLimits {
+  double velocity;      // per second
+  double acceleration;  // per second squared
+  double jerk = 0;      // per second cubed, 0 for no limit, which makes the profile a trapezoid
+};
+
+/**
+ * Where a motion profile is at one moment.
+ */
+struct ProfileState {
+  double position;
+  double velocity;
+  double acceleration;
+};
+
+/**
+ * The quickest way from a stop over a distance and back to a stop that keeps
+ * to limits on speed, acceleration and jerk.
+ *
+ * Speeds up as hard as it may, cruises, then slows down as hard as it may.
+ * With a jerk limit the acceleration ramps up and down instead of switching
+ * on and off, an S-curve, which keeps the wheels from breaking loose.  Too
+ * short to reach the top speed, it peaks at whatever speed it can.
+ *
+ * Planned once up front, then sampled every loop.  At most 7 pieces of
+ * constant jerk, nothing is allocated.
+ */
+class MotionProfile {
+ public:
+  /**
+   * \param distance
+   *        how far to go.  Negative is taken as its size
+   * \param limits
+   *        see ProfileLimits
+   */
+  MotionProfile(double distance, ProfileLimits limits);
+
+  /**
+   * Returns where the profile is a number of seconds after the start.  Past
+   * duration_get() it stays at the end.
+   */
+  ProfileState sample(double time) const;
+
+  /**
+   * Returns seconds from start to end.
+   */
+  double duration_get() const;
+
+  /**
+   * Returns how far it goes.
+   */
+  double distance_get() const;
+
+ private:
+  struct Piece {
+    double duration;
+    double jerk;
+    // where the piece starts
+    double position;
+    double velocity;
+    double acceleration;
+
+    ProfileState at(double time) const;
+  };
+
+  void piece_add(double duration, double jerk, double acceleration);
+  void change_add(double from, double to);
+
+  ProfileLimits limits;
+  double distance;
+  std::array<Piece, 7> pieces{};
+  std::size_t count = 0;
+  double duration = 0;
+};
+
+/**
+ * Drives and turns along motion profiles, in place of pid_drive_set() and
+ * pid_turn_set() followed by pid_wait().
+ *
+ * The profile says how fast the robot should be going every loop, so most of
+ * the power is feedforward, kV for the speed and kA for the acceleration.  A
+ * PID with the chassis' own drive or turn constants only makes up for the
+ * robot falling behind or running ahead of the plan, so there is no long
+ * crawl into the target at the end.  Drives hold the heading the last turn
+ * ended on with the chassis' heading constants, same as pid_drive_set().
+ *
+ * Both block until the motion is done, and take the drive off EZ-Template's
+ * PID while they run (drive_set() does that).  Once Settings::feedforward is
+ * filled in from drive_characterize(), its constants replace the ka settings
+ * and the guess from the free speed.
+ */
+class ProfiledDrive {
+ public:
+  struct Settings {
+    double wheel_diameter = 2.75;    // in, same as the chassis
+    double rpm = 450;                // wheel rpm, same as the chassis
+    double track_width = 13.5;       // in, center to center of the drive wheels
+    double drive_speed = 0;          // in/s, 0 is 90% of the free speed
+    double drive_acceleration = 300; // in/s^2
+    double drive_jerk = 6000;        // in/s^3, 0 for a trapezoid profile
+    double drive_ka = 0.25;          // power per in/s^2
+    double turn_speed = 0;           // deg/s, 0 is 90% of what the drive can do
+    double turn_acceleration = 2400; // deg/s^2
+    double turn_jerk = 48000;        // deg/s^3, 0 for a trapezoid profile
+    double turn_ka = 0.015;          // power per deg/s^2
+    double drive_exit = 1;           // in from the target the drive exits at once the profile is done
+    double turn_exit = 2;            // deg from the target the turn exits at once the profile is done
+    int settle_time = 250;           // ms after the profile is done the motion gives up getting inside the exit
+    DriveFeedforward feedforward;    // from drive_characterize(), once set it replaces the ka and free speed guesses
+  };
+
+  /**
+   * ProfiledDrive constructor.
+   *
+   * \param drive
+   *        the chassis, its encoders, IMU and PID constants are used
+   * \param settings
+   *        see Settings
+   */
+  ProfiledDrive(ez::Drive& drive, Settings settings);
+
+  /**
+   * Drives straight, negative backwards, holding the heading.  Blocks until done.
+   */
+  void drive(double inches);
+
+  /**
+   * Turns to a heading, degrees like pid_turn_set().  Blocks until done.
+   */
+  void turn(double heading);
+
+  /**
+   * Drives along a spline path from a PathCache, starting at its first point
+   * facing its first heading.  Each side gets the feedforward for its own
+   * wheel speed through the curves, the drive PID makes up for falling
+   * behind the distance the path should have covered by now and the heading
+   * PID steers onto the path's heading.  Blocks until done.
+   */
+  void follow(const SplinePath& path);
+
+  /**
+   * Drives each side at a speed, voltage control with Settings::feedforward
+   * and its kp on how far each side is off its speed.  Call it every loop,
+   * like drive_set().  Does nothing until the feedforward is set.
+   *
+   * \param left
+   *        in/s of the left wheels
+   * \param right
+   *        in/s of the right wheels
+   * \param left_acceleration
+   *        in/s^2 the left side should be speeding up by
+   * \param right_acceleration
+   *        in/s^2 the right side should be speeding up by
+   */
+  void velocity_set(double left, double right, double left_acceleration = 0, double right_acceleration = 0);
+
+  /**
+   * Changes the settings, e.g. to run a trapezoid with jerk 0.
+   */
+  void settings_set(Settings input);
+
+ private:
+  double free_speed() const;  // in/s the wheels roll at full power
+  double side_speed(std::vector<pros::Motor>& motors) const;  // in/s, off the first motor's velocity
+
+  ez::Drive& chassis;
+  Settings settings;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "okapi/squiggles/squiggles.hpp"
+
+/**
+ * A point a spline path goes through.  Inches and degrees like FieldPose,
+ * 0 facing +y and clockwise positive like the IMU.
+ */
+struct Waypoint {
+  double x;
+  double y;
+  double angle;         // deg the path is heading as it goes through
+  double tangent = 0;   // in, how far the path keeps to the angle, 0 for 1.2x the distance to the next waypoint
+
+  bool operator==(const Waypoint&) const = default;
+};
+
+/**
+ * How hard a spline path may drive.
+ */
+struct PathConstraints {
+  double max_velocity = 50;       // in/s of the outside wheel, corners are slower
+  double max_acceleration = 150;  // in/s^2
+  double track_width = 13.5;      // in, center to center of the drive wheels
+  double spacing = 0.5;           // in between points on the path
+
+  bool operator==(const PathConstraints&) const = default;
+};
+
+/**
+ * A spline path with a velocity profile.  Each point is a
+ * squiggles::ProfilePoint with squiggles' own units: the pose yaw in radians
+ * counterclockwise from +x, the speed and acceleration in in/s, curvature in
+ * 1/in counterclockwise positive, wheel_velocities {left, right} in in/s and
+ * time in seconds from the start.
+ */
+using SplinePath = std::vector<squiggles::ProfilePoint>;
+
+/**
+ * Joins the waypoints with quintic Hermite splines, curving through each at
+ * its angle with no jump in curvature, then fits a velocity profile to them:
+ * as fast as the outside wheel allows through each curve, speeding up from a
+ * stop and slowing to one at max_acceleration.
+ *
+ * Built on squiggles' QuinticPolynomial and ProfilePoint.  Allocates and
+ * walks every point, so call it through PathCache from initialize().
+ */
+SplinePath spline_path_generate(const std::vector<Waypoint>& waypoints, PathConstraints constraints = {});
+
+/**
+ * Spline paths, generated once and kept.
+ *
+ * Paths are looked up by a hash of their waypoints and constraints, then
+ * matched on the waypoints and constraints themselves, so the same list always
+ * gets the same path back without generating it again.
+ * Asking for every path in initialize() or competition_initialize() means
+ * autonomous() only ever looks them up.  A path generated while autonomous
+ * is running prints a warning to the terminal, it still drives but the
+ * generation holds the robot up.
+ */
+class PathCache {
+ public:
+  /**
+   * Returns the path through the waypoints, generating it the first time.
+   * The reference stays valid until clear().
+   */
+  const SplinePath& get(const std::vector<Waypoint>& waypoints, PathConstraints constraints = {});
+
+  /**
+   * Returns true if the path has been generated.
+   */
+  bool contains(const std::vector<Waypoint>& waypoints, PathConstraints constraints = {}) const;
+
+  /**
+   * Returns how many paths have been generated.
+   */
+  std::size_t size() const;
+
+  /**
+   * Drops every path.
+   */
+  void clear();
+
+ private:
+  struct Entry {
+    std::vector<Waypoint> waypoints;
+    PathConstraints constraints;
+    SplinePath path;
+  };
+
+  static std::uint64_t hash(const std::vector<Waypoint>& waypoints, const PathConstraints& constraints);
+  const Entry* find(const std::vector<Waypoint>& waypoints, const PathConstraints& constraints) const;
+
+  std::unordered_multimap<std::uint64_t, Entry> paths;  // paths with the same hash each keep their own entry
+};
@@ -11,6 +11,11 @@ inline pros::Motor ladybrown(16);
 inline ez::Piston intakePiston('B');
 inline ez::Piston mogoclamp('C');
 
+// Distance sensors for the localizer, pointed out the sides and back at the field walls
+inline pros::Distance distanceLeft(6);
+inline pros::Distance distanceRight(7);
+inline pros::Distance distanceBack(10);
+
 // inline pros::adi::DigitalIn limit_switch('A');
 
 
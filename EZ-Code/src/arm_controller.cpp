@@ -0,0 +1,127 @@
+// EZ-Code and EZ-Code-Odom each have a copy of this file, and the two have to stay the same: change
+// both.  Host-Sim's `make syntax` fails if they differ.
+
+#include "arm_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+ArmController::Move::Move(std::shared_ptr<std::atomic<MoveStatus>> status) : status(std::move(status)) {}
+
+ArmController::MoveStatus ArmController::Move::status_get() const { return status->load(); }
+
+bool ArmController::Move::done() const { return status->load() != MoveStatus::RUNNING; }
+
+bool ArmController::Move::wait(std::uint32_t timeout) const {
+  const std::uint32_t start = pros::millis();
+  while (!done()) {
+    if (timeout > 0 && pros::millis() - start >= timeout) break;
+    pros::delay(PERIOD);
+  }
+  return status->load() == MoveStatus::REACHED;
+}
+
+ArmController::ArmController(pros::Motor& motor, Settings settings)
+    : motor(motor), settings(settings), current(std::make_shared<std::atomic<MoveStatus>>(MoveStatus::REACHED)) {}
+
+void ArmController::settings_set(Settings input) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  settings = input;
+}
+
+ArmController::Move ArmController::move_to(double position) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  // called every loop while a button is held, keep the move going
+  if (holding && position == target) return Move(current);
+  if (!holding) {
+    // not driving the arm yet, plan from where it is
+    planned_position = motor.get_position();
+    planned_velocity = 0;
+    holding = true;
+  }
+  if (current->load() == MoveStatus::RUNNING) current->store(MoveStatus::REPLACED);
+  current = std::make_shared<std::atomic<MoveStatus>>(MoveStatus::RUNNING);
+  target = position;
+  inside = false;
+  return Move(current);
+}
+
+void ArmController::release() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  if (current->load() == MoveStatus::RUNNING) current->store(MoveStatus::REPLACED);
+  holding = false;
+}
+
+double ArmController::target_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return target;
+}
+
+bool ArmController::settled() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return current->load() == MoveStatus::REACHED;
+}
+
+double ArmController::gravity(double position) const {
+  const double angle = settings.rest_angle + position / settings.gear_ratio;
+  return settings.kg * std::cos(angle * M_PI / 180);
+}
+
+// The fastest speed that can still stop on the target, capped at
+// max_velocity, reached no faster than max_acceleration allows
+void ArmController::plan_step(double dt) {
+  const double remaining = target - planned_position;
+  const double a = settings.max_acceleration;
+  double wanted = std::copysign(std::sqrt(2 * a * std::fabs(remaining)), remaining);
+  wanted = std::clamp(wanted, -settings.max_velocity, settings.max_velocity);
+  const double velocity = planned_velocity + std::clamp(wanted - planned_velocity, -a * dt, a * dt);
+
+  // stepping past the target, or close enough to stop in one loop, lands on it
+  const double moved = (planned_velocity + velocity) / 2 * dt;
+  if (std::fabs(moved) >= std::fabs(remaining) && std::fabs(velocity) <= a * dt) {
+    planned_acceleration = -planned_velocity / dt;
+    planned_position = target;
+    planned_velocity = 0;
+    return;
+  }
+  planned_acceleration = (velocity - planned_velocity) / dt;
+  planned_position += moved;
+  planned_velocity = velocity;
+}
+
+void ArmController::step(std::uint32_t now) {
+  const double position = motor.get_position();
+  const double velocity = motor.get_actual_velocity() * 6;  // rpm to deg/s
+  plan_step(PERIOD / 1000.0);
+
+  const double power = gravity(position) + settings.kv * planned_velocity + settings.ka * planned_acceleration +
+                       settings.kp * (planned_position - position) + settings.kd * (planned_velocity - velocity);
+  motor.move(std::clamp(power, -127.0, 127.0));
+
+  // reached once the plan is done and the arm has stayed on it for settle_time
+  const bool on_target = planned_position == target && std::fabs(target - position) < settings.tolerance;
+  if (!on_target) {
+    inside = false;
+  } else if (!inside) {
+    inside = true;
+    inside_since = now;
+  }
+  if (inside && now - inside_since >= settings.settle_time && current->load() == MoveStatus::RUNNING) {
+    current->store(MoveStatus::REACHED);
+  }
+}
+
+void ArmController::run() {
+  std::uint32_t now = pros::millis();
+  while (true) {
+    update(now);
+    pros::Task::delay_until(&now, PERIOD);
+  }
+}
+
+void ArmController::update(std::uint32_t now) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  // before the first move_to() and after release() the motor is left alone
+  if (holding) step(now);
+}
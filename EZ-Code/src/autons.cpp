@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "main.h"
 #include "api.h"
 #include "subsystems.hpp"
@@ -13,13 +15,6 @@ const int DRIVE_SPEED = 110;
 const int TURN_SPEED = 90;
 const int SWING_SPEED = 90;
 
-const float Kp = 0.75;
-const float Ki = 0.01;
-const float Kd = 0.2;
-
-const int tolerance = 50;
-const int max_output = 50;
-
 const int lbDown = 0;
 const int lbMid = 480;
 const int lbScore = 1900;
@@ -27,31 +22,9 @@ const int positions[] = {lbDown, lbMid, lbScore};
 
 
 
+// Moves the lady brown and waits for it to get there, the arm is held there after
 void autoLadyBrownAngle(int target) {
-    int error = 0; 
-    int last_error = 0;
-    int integral = 0;
-    int derivative = 0;
-
-    while(true) {
-        int currentPosition = ladybrown.get_position();
-        error = target - currentPosition;
-
-        if (std::abs(error) <= tolerance) {
-            ladybrown.move_velocity(0);
-            break;
-        }
-
-        integral += error;
-        derivative = error - last_error;
-        last_error = error;
-
-        int output = (Kp * error) + (Ki * integral) + (Kd * derivative);
-        output = std::clamp(output, -max_output, max_output);
-
-        ladybrown.move_velocity(output);
-        pros::delay(20);
-    }
+    lb_controller.move_to(target).wait(3000);
 }
 
 ///
@@ -121,6 +94,43 @@ void drive_and_turn() {
   chassis.pid_wait();
 }
 
+///
+// Drive and Turn on motion profiles, see motion_profile.hpp
+///
+void drive_and_turn_profiled() {
+  profiled_drive.drive(24);
+  profiled_drive.turn(45);
+  profiled_drive.turn(-45);
+  profiled_drive.turn(0);
+  profiled_drive.drive(-24);
+}
+
+///
+// Spline Paths
+///
+// Poses relative to where the robot starts, facing +y
+const std::vector<Waypoint> S_CURVE = {
+    {0, 0, 0},
+    {12, 24, 45},
+    {0, 48, 0},
+};
+
+void paths_generate() {
+  path_cache.get(S_CURVE);
+}
+
+void spline_example() {
+  profiled_drive.follow(path_cache.get(S_CURVE));
+}
+
+///
+// Drive Characterization
+///
+void drive_characterization() {
+  // Needs 3 feet clear in front of the robot, prints what characterizeFit.py reads to the terminal
+  drive_characterize(chassis, {});
+}
+
 ///
 // Wait Until and Changing Max Speed
 ///
@@ -331,6 +341,7 @@ void blue_negative_auton() {
 
     // intakeLow.move(0);
     // intakeHigh.move(0);
+    lb_controller.release();  // run the arm by hand
     ladybrown.move(127);
     pros::delay(600);
     ladybrown.move(0);
@@ -439,6 +450,7 @@ void red_negative_auton() {
 
     // intakeLow.move(0);
     // intakeHigh.move(0);
+    lb_controller.release();  // run the arm by hand
     ladybrown.move(127);
     pros::delay(600);
     ladybrown.move(0);
@@ -574,17 +586,27 @@ void blue_positive_auton() {
     chassis.pid_drive_set(-8_in, DRIVE_SPEED);
     chassis.pid_wait();
 
+    lb_controller.release();  // run the arm by hand
     ladybrown.move(127);
     pros::delay(200);
     ladybrown.move(0);
 
 }
 
+// How far to drive to get level with a field point, from the localizer.  Falls back to the distance the drive used
+// to be hard-coded to when the localizer isn't started or isn't sure where the robot is, and never strays more than
+// max_change from it, so a bad estimate can't send the robot across the field
+double localized_distance(double x, double y, double fallback, double max_change = 12) {
+  if (!localizer.confident()) return fallback;
+  return std::clamp(localizer.distance_to(x, y), fallback - max_change, fallback + max_change);
+}
+
 void skills_auton() {
   ladybrown.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
   // doinker.set(false);
   intakePiston.set(false);
   mogoclamp.set(false);
+  localizer.pose_set({-58, 0, 90});  // Back to the red alliance stake, facing the blue side
   //Section Red
   //Block 1: Ally Stake
   chassis.pid_drive_set(-5_in, DRIVE_SPEED, true);
@@ -715,8 +737,10 @@ void skills_auton() {
   chassis.pid_turn_relative_set(-200_deg, TURN_SPEED); // Don't know the exact angle
   chassis.pid_wait_quick();
 
-  chassis.pid_drive_set(-100_in,DRIVE_SPEED);
-  chassis.pid_wait_until(-87_in); //maybe postive idk
+  // Long drives aim for where the localizer says they should end instead of a fixed distance
+  const double to_blue_mogo = localized_distance(-58.3, 35.2, -100);
+  chassis.pid_drive_set(to_blue_mogo, DRIVE_SPEED);
+  chassis.pid_wait_until(to_blue_mogo + 13); //maybe postive idk
   mogoclamp.set(true);
   chassis.pid_wait_quick_chain();
 
@@ -827,8 +851,9 @@ void skills_auton() {
   chassis.pid_turn_relative_set(-60_deg,TURN_SPEED);
   chassis.pid_wait_quick();
 
-  chassis.pid_drive_set(100_in,DRIVE_SPEED);
-  chassis.pid_wait_until(90_in);
+  const double to_red_rings = localized_distance(36.9, 26.9, 100);
+  chassis.pid_drive_set(to_red_rings, DRIVE_SPEED);
+  chassis.pid_wait_until(to_red_rings - 10);
   intakeLow.move(40);
   intakeHigh.move(40);
   chassis.pid_wait_quick_chain();
@@ -870,8 +895,9 @@ void skills_auton() {
   // SECTION Gold
   // Block 10: Grab 3 more red rings, deposit mogo at corner
 
-  chassis.pid_drive_set(75_in,DRIVE_SPEED);
-  chassis.pid_wait_until(70_in);
+  const double to_corner_rings = localized_distance(36.3, 14.5, 75);
+  chassis.pid_drive_set(to_corner_rings, DRIVE_SPEED);
+  chassis.pid_wait_until(to_corner_rings - 5);
   intakeLow.move(127);
   intakeHigh.move(127);
   chassis.pid_wait_quick_chain();
@@ -0,0 +1,68 @@
+#include "feedforward.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+struct Test {
+  int id;            // printed with every sample, so the fitter can tell the tests apart
+  double direction;  // 1 forwards or clockwise, -1 backwards or counterclockwise
+  bool turning;
+  bool ramp;         // slow ramp, otherwise a sudden step
+};
+
+// Quasistatic then dynamic, driving then turning.  Each straight test is
+// followed by one the other way, so the robot ends up about where it started
+constexpr Test TESTS[] = {
+    {0, 1, false, true}, {1, -1, false, true}, {2, 1, false, false}, {3, -1, false, false},
+    {4, 1, true, true},  {5, -1, true, true},  {6, 1, true, false},  {7, -1, true, false},
+};
+
+constexpr double MAX_VOLTS = 12;
+
+void motors_set(std::vector<pros::Motor>& motors, double volts) {
+  for (auto& motor : motors) motor.move_voltage(volts * 1000);
+}
+
+}  // namespace
+
+double Feedforward::calculate(double velocity, double acceleration) const {
+  // ks pushes the way the robot is going, or the way it is about to go from a stop
+  const double direction = velocity != 0 ? velocity : acceleration;
+  const double friction = direction > 0 ? ks : direction < 0 ? -ks : 0;
+  return friction + kv * velocity + ka * acceleration;
+}
+
+bool DriveFeedforward::is_set() const { return left.kv > 0 && right.kv > 0; }
+
+void drive_characterize(ez::Drive& drive, CharacterizeSettings settings) {
+  drive.drive_mode_set(ez::DISABLE);
+  for (const Test& test : TESTS) {
+    const double left_start = drive.drive_sensor_left();
+    const double right_start = drive.drive_sensor_right();
+    const std::uint32_t start = pros::millis();
+    while (true) {
+      const std::uint32_t now = pros::millis();
+      const std::uint32_t elapsed = now - start;
+      const double volts = test.ramp ? std::min(settings.ramp_rate * elapsed / 1000, MAX_VOLTS) : settings.step_voltage;
+      const double left_volts = test.direction * volts;
+      const double right_volts = test.turning ? -left_volts : left_volts;
+      const double left = drive.drive_sensor_left() - left_start;
+      const double right = drive.drive_sensor_right() - right_start;
+      printf("characterize,%u,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n", static_cast<unsigned>(now), test.id, left_volts,
+             right_volts, left, right, drive.drive_imu_get());
+
+      if (test.turning ? elapsed >= static_cast<std::uint32_t>(settings.turn_time)
+                       : std::fabs(left + right) / 2 >= settings.max_distance)
+        break;
+      motors_set(drive.left_motors, left_volts);
+      motors_set(drive.right_motors, right_volts);
+      pros::delay(ez::util::DELAY_TIME);
+    }
+    motors_set(drive.left_motors, 0);
+    motors_set(drive.right_motors, 0);
+    pros::delay(settings.rest_time);
+  }
+}
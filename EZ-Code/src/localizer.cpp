@@ -0,0 +1,273 @@
+#include "localizer.hpp"
+
+#include <cmath>
+#include <mutex>
+
+namespace {
+
+constexpr float MM_PER_INCH = 25.4;
+constexpr float HEADING_DRIFT = 0.0001;  // rad the heading errors spread by each update even when not turning
+constexpr float NOTHING_SEEN = 1000;     // in, what a beam that misses every wall is taken to see
+
+float radians(float degrees) { return degrees * float(M_PI) / 180; }
+
+float degrees(float radians) { return radians * 180 / float(M_PI); }
+
+// 0 to 1 from a particle's own xorshift sequence.  Plain integer math on one
+// lane, so loops over every particle vectorize
+inline float uniform(std::uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return float(state) * (1.0f / 4294967296.0f);
+}
+
+// Close to a standard normal, two uniforms have a variance of 1/6
+inline float gaussian(std::uint32_t& state) { return (uniform(state) + uniform(state) - 1) * 2.4494897f; }
+
+}  // namespace
+
+std::vector<FieldWall> high_stakes_field() {
+  constexpr float WALL = 70.2;  // in from the center to the inside of the perimeter
+  constexpr float POST = 1.2;   // half the width of a ladder post
+  std::vector<FieldWall> field = {
+      {-WALL, -WALL, WALL, -WALL},
+      {WALL, -WALL, WALL, WALL},
+      {WALL, WALL, -WALL, WALL},
+      {-WALL, WALL, -WALL, -WALL},
+  };
+  // the ladder stands on the four tile corners around the center
+  for (const auto& [px, py] : {std::pair{24.0f, 0.0f}, {0.0f, 24.0f}, {-24.0f, 0.0f}, {0.0f, -24.0f}}) {
+    field.push_back({px - POST, py - POST, px + POST, py - POST});
+    field.push_back({px + POST, py - POST, px + POST, py + POST});
+    field.push_back({px + POST, py + POST, px - POST, py + POST});
+    field.push_back({px - POST, py + POST, px - POST, py - POST});
+  }
+  return field;
+}
+
+Localizer::Localizer(ez::Drive& drive, std::vector<Mount> mounts, std::vector<FieldWall> field,
+                     LocalizerSettings settings)
+    : drive(drive), mounts(std::move(mounts)), field(std::move(field)), settings(settings) {
+  for (int i = 0; i < PARTICLES; i++) seed[i] = 0x9e3779b9u * (i + 1);
+}
+
+void Localizer::run() {
+  while (true) {
+    update();
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
+
+void Localizer::pose_set(FieldPose input) {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  imu_offset = input.theta - drive.drive_imu_get();
+  last_left = drive.drive_sensor_left();
+  last_right = drive.drive_sensor_right();
+  last_theta = input.theta;
+  last_readings.fill(-1);
+  pose = odom = input;
+  pose_spread = 0;
+
+  // the start is measured, but not to the hundredth
+  for (int i = 0; i < PARTICLES; i++) {
+    x[i] = input.x + 0.5f * gaussian(seed[i]);
+    y[i] = input.y + 0.5f * gaussian(seed[i]);
+    theta[i] = radians(0.5f) * gaussian(seed[i]);
+    weight[i] = 1.0f / PARTICLES;
+  }
+  started = true;
+}
+
+FieldPose Localizer::pose_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return pose;
+}
+
+FieldPose Localizer::odom_pose_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return odom;
+}
+
+bool Localizer::confident() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return started && pose_spread <= settings.max_spread;
+}
+
+double Localizer::distance_to(double target_x, double target_y) {
+  const FieldPose now = pose_get();
+  const double heading = radians(now.theta);
+  return (target_x - now.x) * std::sin(heading) + (target_y - now.y) * std::cos(heading);
+}
+
+std::uint32_t Localizer::update_time_get() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  return update_time;
+}
+
+void Localizer::update() {
+  std::lock_guard<pros::Mutex> lock(mutex);
+  if (!started) return;
+  const std::uint32_t start = pros::micros();
+
+  const double left = drive.drive_sensor_left();
+  const double right = drive.drive_sensor_right();
+  const float heading = drive.drive_imu_get() + imu_offset;
+
+  std::array<float, MAX_SENSORS> readings;
+  readings.fill(-1);
+  for (std::size_t i = 0; i < mounts.size() && i < MAX_SENSORS; i++) {
+    pros::Distance& sensor = *mounts[i].sensor;
+    const std::int32_t mm = sensor.get();
+    const bool seen = mm > 0 && mm < 9999 && sensor.get_confidence() >= settings.min_confidence;
+    const float reading = seen ? mm / MM_PER_INCH : -1;
+    // the sensor sends about every 33 ms, the same reading again is nothing new
+    if (reading != last_readings[i]) readings[i] = reading;
+    last_readings[i] = reading;
+  }
+
+  step((left - last_left + right - last_right) / 2, heading, readings);
+  last_left = left;
+  last_right = right;
+  update_time = pros::micros() - start;
+}
+
+void Localizer::step(float forward, float heading, const std::array<float, MAX_SENSORS>& readings) {
+  spread(forward, heading);
+
+  bool weighed = false;
+  for (std::size_t i = 0; i < mounts.size() && i < MAX_SENSORS; i++) {
+    if (readings[i] < 0 || readings[i] > settings.max_range) continue;
+    weigh(mounts[i], readings[i], heading);
+    weighed = true;
+  }
+  if (weighed) resample();
+
+  estimate(heading);
+  last_theta = heading;
+}
+
+// Moves every particle by the encoders and IMU, each with its own slip
+void Localizer::spread(float forward, float heading) {
+  const float turn = radians(heading - last_theta);
+  const float middle = radians(last_theta) + turn / 2;
+  const float s = std::sin(middle);
+  const float c = std::cos(middle);
+  const float drive_sd = settings.drive_noise * std::fabs(forward);
+  const float side_sd = settings.side_noise * std::fabs(forward);
+  const float turn_sd = settings.turn_noise * std::fabs(turn) + HEADING_DRIFT;
+
+  odom.x += forward * s;
+  odom.y += forward * c;
+  odom.theta = heading;
+
+  for (int i = 0; i < PARTICLES; i++) {
+    const float moved = forward + drive_sd * gaussian(seed[i]);
+    const float side = side_sd * gaussian(seed[i]);
+    // each heading error is a fraction of a degree, so sin is the error and cos is 1
+    const float dx = s + c * theta[i];
+    const float dy = c - s * theta[i];
+    x[i] += moved * dx + side * dy;
+    y[i] += moved * dy - side * dx;
+    theta[i] += turn_sd * gaussian(seed[i]);
+  }
+}
+
+// Scales each particle's weight by how well one reading fits what it would see
+void Localizer::weigh(const Mount& mount, float reading, float heading) {
+  const float robot = radians(heading);
+  const float beam = robot + radians(mount.angle);
+  const float s = std::sin(robot);
+  const float c = std::cos(robot);
+  const float beam_x = std::sin(beam);
+  const float beam_y = std::cos(beam);
+  // where the sensor is from the center of the drive, and how that moves with a particle's heading error
+  const float offset_x = mount.x * c + mount.y * s;
+  const float offset_y = -mount.x * s + mount.y * c;
+
+  scratch.fill(NOTHING_SEEN);
+  for (const FieldWall& wall : field) {
+    // copied out so the compiler knows writing scratch can't change them
+    const float start_x = wall.x1;
+    const float start_y = wall.y1;
+    const float wall_x = wall.x2 - wall.x1;
+    const float wall_y = wall.y2 - wall.y1;
+    for (int i = 0; i < PARTICLES; i++) {
+      const float dx = beam_x + beam_y * theta[i];
+      const float dy = beam_y - beam_x * theta[i];
+      const float to_x = start_x - (x[i] + offset_x + offset_y * theta[i]);
+      const float to_y = start_y - (y[i] + offset_y - offset_x * theta[i]);
+      // parallel walls divide by zero, the infinities and NaNs fail the hit test below
+      const float denominator = dx * wall_y - dy * wall_x;
+      const float along = (to_x * wall_y - to_y * wall_x) / denominator;
+      const float across = (to_x * dy - to_y * dx) / denominator;
+      const bool hit = (along >= 0) & (across >= 0) & (across <= 1) & (along < scratch[i]);
+      scratch[i] = hit ? along : scratch[i];
+    }
+  }
+
+  // a long tailed fit, so a ring or a robot in front of the sensor costs a
+  // particle some weight but doesn't wipe out the right ones
+  const float sd = settings.sensor_noise + settings.sensor_scale * reading;
+  const float inverse_variance = 1 / (sd * sd);
+  for (int i = 0; i < PARTICLES; i++) {
+    const float error = reading - scratch[i];
+    weight[i] *= 1 / (1 + error * error * inverse_variance);
+  }
+}
+
+// Normalizes the weights, and once too few particles carry most of the weight
+// replaces the cloud with copies drawn in proportion to it
+void Localizer::resample() {
+  float total = 0;
+  for (int i = 0; i < PARTICLES; i++) total += weight[i];
+  if (!(total > 1e-30f)) {
+    // nothing fits, which only happens with something stuck in front of every sensor. Keep the cloud as it is
+    weight.fill(1.0f / PARTICLES);
+    return;
+  }
+  float squares = 0;
+  for (int i = 0; i < PARTICLES; i++) {
+    weight[i] /= total;
+    squares += weight[i] * weight[i];
+  }
+  if (1 / squares > PARTICLES / 2) return;
+
+  // one random start then evenly spaced picks, the low variance way
+  const float gap = 1.0f / PARTICLES;
+  float pick = gap * uniform(seed[0]);
+  float reached = weight[0];
+  int from = 0;
+  for (int i = 0; i < PARTICLES; i++) {
+    while (pick > reached && from < PARTICLES - 1) reached += weight[++from];
+    picked[i] = from;
+    pick += gap;
+  }
+  for (auto* values : {&x, &y, &theta}) {
+    for (int i = 0; i < PARTICLES; i++) scratch[i] = (*values)[picked[i]];
+    *values = scratch;
+  }
+  weight.fill(1.0f / PARTICLES);
+}
+
+void Localizer::estimate(float heading) {
+  float total = 0;
+  float sum_x = 0;
+  float sum_y = 0;
+  float sum_theta = 0;
+  for (int i = 0; i < PARTICLES; i++) {
+    total += weight[i];
+    sum_x += weight[i] * x[i];
+    sum_y += weight[i] * y[i];
+    sum_theta += weight[i] * theta[i];
+  }
+  pose = {sum_x / total, sum_y / total, heading + degrees(sum_theta / total)};
+
+  float sum_squares = 0;
+  for (int i = 0; i < PARTICLES; i++) {
+    const float dx = x[i] - float(pose.x);
+    const float dy = y[i] - float(pose.y);
+    sum_squares += weight[i] * (dx * dx + dy * dy);
+  }
+  pose_spread = std::sqrt(sum_squares / total);
+}
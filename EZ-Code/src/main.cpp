@@ -18,17 +18,44 @@ ez::Drive chassis(
     2.75,  // Wheel Diameter (Remember, 4" wheels without screw holes are actually 4.125!)
     450);   // Wheel RPM
 
+// Corrects the drive's position off the field walls, see localizer.hpp
+Localizer localizer(
+    chassis,
+    {{&distanceLeft, -6.5, 0, -90},    // sensor, inches right of center, inches forward of center, degrees from forward
+     {&distanceRight, 6.5, 0, 90},
+     {&distanceBack, 0, -7, 180}},
+    high_stakes_field());
+
+// Drives and turns along motion profiles, see motion_profile.hpp
+ProfiledDrive profiled_drive(chassis, {.wheel_diameter = 2.75, .rpm = 450});
+
+// Spline paths for the autons, generated in initialize(), see path_cache.hpp
+PathCache path_cache;
+
+// Moves the lady brown along motion profiles and holds it up against gravity, see arm_controller.hpp
+//
+// None of these are measured yet, TUNE THEM ON THE ROBOT.  gear_ratio and rest_angle are the ones
+// Host-Sim's lady_brown bench arm is built with, count the gear teeth and measure the arm's angle
+// sitting on its stop.  The gains were fitted against that bench arm, whose mass and reach are
+// guesses: raise kg until the arm holds level without drifting, then ka until moves keep up with
+// the plan at the start, then kp and kd until the ring doesn't sag at lbMid.  kv is 127 power over
+// the 1200 deg/s the motor spins at full power.
+ArmController lb_controller(
+    ladybrown,
+    {.gear_ratio = 12,   // motor degrees per degree of arm
+     .rest_angle = -60,  // arm degrees above horizontal sitting down on its stop
+     .kg = 7,
+     .kv = 127.0 / 1200,
+     .ka = 0.005,
+     .kp = 1.0,
+     .kd = 0.02,
+     .max_velocity = 1100,
+     .max_acceleration = 9000});
+
 
 int currentPositionIndex = 0;
 bool lastCycleButtonState = false;
 
-const float Kp = 0.75;
-const float Ki = 0.01;
-const float Kd = 0.2;
-
-const int tolerance = 50;
-const int max_output = 50;
-
 const int lbDown = 0;
 const int lbMid = 420;
 const int lbScore = 2000;
@@ -36,41 +63,6 @@ const int positions[] = {lbDown, lbMid, lbScore};
 
 
 
-void ladyBrownAngle(int target) {
-    int error = 0; 
-    int last_error = 0;
-    int integral = 0;
-    int derivative = 0;
-
-    // while(true) {
-    //     int currentPosition = ladybrown.get_position();
-    //     error = target - currentPosition;
-
-    //     if (std::abs(error) <= tolerance) {
-    //         ladybrown.move_velocity(0);
-    //         break;
-    //     }
-
-
-
-        integral += error;
-        derivative = error - last_error;
-        last_error = error;
-
-        int output = (Kp * error) + (Ki * integral) + (Kd * derivative);
-        output = std::clamp(output, -max_output, max_output);
-
-        ladybrown.move_velocity(output);
-
-        //Break, if any other button is pressed
-
-        pros::delay(20);
-    }
-
-
-
-
-
 /**
  * Runs initialization code. This occurs as soon as the program is started.
  *
@@ -107,6 +99,9 @@ void initialize() {
       Auton("Example Drive\n\nDrive forward and come back.", drive_example),
       Auton("Example Turn\n\nTurn 3 times.", turn_example),
       Auton("Drive and Turn\n\nDrive forward, turn, come back. ", drive_and_turn),
+      Auton("Drive and Turn Profiled\n\nSame as Drive and Turn on motion profiles.", drive_and_turn_profiled),
+      Auton("Spline Path\n\nS-curve along a cached spline path.", spline_example),
+      Auton("Drive Characterization\n\nVoltage ramps and steps for characterizeFit.py.", drive_characterization),
       Auton("Drive and Turn\n\nSlow down during drive.", wait_until_change_speed),
       Auton("Swing Example\n\nSwing in an 'S' curve", swing_example),
       Auton("Motion Chaining\n\nDrive forward, turn, and come back, but blend everything together :D", motion_chaining),
@@ -118,6 +113,9 @@ void initialize() {
   // Initialize chassis and auton selector
   chassis.initialize();
   ez::as::initialize();
+  paths_generate();  // Every spline path the autons drive, so autonomous only looks them up
+  pros::Task localizer_task([] { localizer.run(); });  // Idles until an auton gives it a start pose
+  pros::Task lb_task([] { lb_controller.run(); });  // Leaves the lady brown alone until its first move
   master.rumble(".");
 }
 
@@ -238,13 +236,13 @@ void opcontrol() {
 
     if (master.get_digital(DIGITAL_DOWN)) {
         // currentPositionIndex = (currentPositionIndex + 1) % 3;
-        ladybrown.move_absolute(0, 127);
+        lb_controller.move_to(0);
         // ladyBrownAngle(positions[currentPositionIndex]);
     }
 
     if (master.get_digital(DIGITAL_UP)) {
         // currentPositionIndex = 0;
-        ladybrown.move_absolute(1850, 127);
+        lb_controller.move_to(1850);
 
         // ladyBrownAngle(positions[0]);
         // ladybrown.tare_position();
@@ -252,7 +250,7 @@ void opcontrol() {
 
     if (master.get_digital(DIGITAL_LEFT)) {
         // currentPositionIndex = 0;
-        ladybrown.move_absolute(380, 127);
+        lb_controller.move_to(380);
     }
 
     // bool currentCycleButtonState = master.get_digital(DIGITAL_DOWN);
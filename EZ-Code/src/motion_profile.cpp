@@ -0,0 +1,306 @@
+#include "motion_profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double SPEED_FRACTION = 0.9;  // of the free speed a profile tops out at when the settings leave it at 0
+
+// Seconds spent at the jerk limit on each end of a change in speed, and
+// seconds at the acceleration limit between them.  No jerk limit means the
+// acceleration switches on at once
+void change_times(double change, const ProfileLimits& limits, double& ramp_time, double& flat_time) {
+  if (limits.jerk <= 0) {
+    ramp_time = 0;
+    flat_time = change / limits.acceleration;
+  } else if (change * limits.jerk >= limits.acceleration * limits.acceleration) {
+    ramp_time = limits.acceleration / limits.jerk;
+    flat_time = change / limits.acceleration - ramp_time;
+  } else {
+    // never gets to full acceleration
+    ramp_time = std::sqrt(change / limits.jerk);
+    flat_time = 0;
+  }
+}
+
+// Distance covered getting from a stop to a speed, the acceleration is
+// symmetric over the change so the average speed is half of it
+double change_distance(double speed, const ProfileLimits& limits) {
+  double ramp_time;
+  double flat_time;
+  change_times(speed, limits, ramp_time, flat_time);
+  return speed / 2 * (2 * ramp_time + flat_time);
+}
+
+constexpr double POWER_PER_VOLT = 127.0 / 12;
+
+double seconds_since(std::uint32_t start) { return (pros::millis() - start) / 1000.0; }
+
+// motor rpm at free speed for a cartridge
+double cartridge_rpm(pros::MotorGears gearing) {
+  switch (gearing) {
+    case pros::MotorGears::red:
+      return 100;
+    case pros::MotorGears::green:
+      return 200;
+    default:
+      return 600;
+  }
+}
+
+}  // namespace
+
+ProfileState MotionProfile::Piece::at(double t) const {
+  return {position + velocity * t + acceleration * t * t / 2 + jerk * t * t * t / 6,
+          velocity + acceleration * t + jerk * t * t / 2, acceleration + jerk * t};
+}
+
+MotionProfile::MotionProfile(double distance, ProfileLimits limits) : limits(limits), distance(std::fabs(distance)) {
+  this->limits.velocity = std::max(this->limits.velocity, 1e-3);
+  this->limits.acceleration = std::max(this->limits.acceleration, 1e-3);
+
+  // the highest speed that still leaves room to slow back down
+  double peak = this->limits.velocity;
+  if (2 * change_distance(peak, this->limits) > this->distance) {
+    double low = 0;
+    double high = peak;
+    for (int i = 0; i < 24; i++) {
+      const double middle = (low + high) / 2;
+      if (2 * change_distance(middle, this->limits) > this->distance)
+        high = middle;
+      else
+        low = middle;
+    }
+    peak = low;
+  }
+  if (peak <= 0) return;
+
+  change_add(0, peak);
+  piece_add((this->distance - 2 * change_distance(peak, this->limits)) / peak, 0, 0);
+  change_add(peak, 0);
+  // where it really ends, a hair off the distance from the search above
+  this->distance = pieces[count - 1].at(pieces[count - 1].duration).position;
+}
+
+void MotionProfile::piece_add(double duration, double jerk, double acceleration) {
+  if (duration <= 0) return;
+  Piece piece = {duration, jerk, 0, 0, acceleration};
+  if (count > 0) {
+    const ProfileState end = pieces[count - 1].at(pieces[count - 1].duration);
+    piece.position = end.position;
+    piece.velocity = end.velocity;
+  }
+  pieces[count++] = piece;
+  this->duration += duration;
+}
+
+// Up to 3 pieces, ramping the acceleration up, holding it, then ramping it back to 0
+void MotionProfile::change_add(double from, double to) {
+  double ramp_time;
+  double flat_time;
+  change_times(std::fabs(to - from), limits, ramp_time, flat_time);
+  const double sign = to > from ? 1 : -1;
+  const double jerk = sign * limits.jerk;
+  const double peak_acceleration = limits.jerk > 0 ? jerk * ramp_time : sign * limits.acceleration;
+  piece_add(ramp_time, jerk, 0);
+  piece_add(flat_time, 0, peak_acceleration);
+  piece_add(ramp_time, -jerk, peak_acceleration);
+}
+
+ProfileState MotionProfile::sample(double time) const {
+  if (count == 0) return {distance, 0, 0};
+  time = std::max(time, 0.0);
+  std::size_t i = 0;
+  while (i + 1 < count && time >= pieces[i].duration) {
+    time -= pieces[i].duration;
+    i++;
+  }
+  if (time >= pieces[i].duration) return {distance, 0, 0};
+  return pieces[i].at(time);
+}
+
+double MotionProfile::duration_get() const { return duration; }
+
+double MotionProfile::distance_get() const { return distance; }
+
+ProfiledDrive::ProfiledDrive(ez::Drive& drive, Settings settings) : chassis(drive), settings(settings) {}
+
+void ProfiledDrive::settings_set(Settings input) { settings = input; }
+
+double ProfiledDrive::free_speed() const { return settings.rpm / 60 * M_PI * settings.wheel_diameter; }
+
+double ProfiledDrive::side_speed(std::vector<pros::Motor>& motors) const {
+  const pros::Motor& motor = motors.front();
+  const double wheel_rpm = motor.get_actual_velocity() * settings.rpm / cartridge_rpm(motor.get_gearing());
+  return wheel_rpm / 60 * M_PI * settings.wheel_diameter;
+}
+
+void ProfiledDrive::velocity_set(double left, double right, double left_acceleration, double right_acceleration) {
+  const DriveFeedforward& feedforward = settings.feedforward;
+  if (!feedforward.is_set()) return;
+  chassis.drive_mode_set(ez::DISABLE);
+  const double left_volts = feedforward.left.calculate(left, left_acceleration) +
+                            feedforward.kp * (left - side_speed(chassis.left_motors));
+  const double right_volts = feedforward.right.calculate(right, right_acceleration) +
+                             feedforward.kp * (right - side_speed(chassis.right_motors));
+  for (auto& motor : chassis.left_motors) motor.move_voltage(std::clamp(left_volts, -12.0, 12.0) * 1000);
+  for (auto& motor : chassis.right_motors) motor.move_voltage(std::clamp(right_volts, -12.0, 12.0) * 1000);
+}
+
+void ProfiledDrive::drive(double inches) {
+  const double top = free_speed();
+  const MotionProfile profile(inches, {settings.drive_speed > 0 ? settings.drive_speed : SPEED_FRACTION * top,
+                                       settings.drive_acceleration, settings.drive_jerk});
+  const double direction = inches < 0 ? -1 : 1;
+  const double kv = 127 / top;
+
+  // the correction works on how far off the plan the robot is, target 0
+  const PID::Constants drive_constants = chassis.pid_drive_constants_get();
+  const PID::Constants heading_constants = chassis.pid_heading_constants_get();
+  PID correction(drive_constants.kp, drive_constants.ki, drive_constants.kd, drive_constants.start_i);
+  PID heading(heading_constants.kp, heading_constants.ki, heading_constants.kd, heading_constants.start_i);
+  correction.target_set(0);
+  heading.target_set(chassis.headingPID.target_get());
+
+  const double left_start = chassis.drive_sensor_left();
+  const double right_start = chassis.drive_sensor_right();
+  const std::uint32_t start = pros::millis();
+  while (true) {
+    const double elapsed = seconds_since(start);
+    const ProfileState planned = profile.sample(elapsed);
+    const double travelled =
+        direction * (chassis.drive_sensor_left() - left_start + chassis.drive_sensor_right() - right_start) / 2;
+    if (elapsed >= profile.duration_get()) {
+      if (std::fabs(profile.distance_get() - travelled) < settings.drive_exit) break;
+      if (elapsed >= profile.duration_get() + settings.settle_time / 1000.0) break;
+    }
+
+    // the characterized feedforward for the planned speed when there is one, the guess from the free speed when not
+    const double velocity = direction * planned.velocity;
+    const double acceleration = direction * planned.acceleration;
+    double left_feed = kv * velocity + settings.drive_ka * acceleration;
+    double right_feed = left_feed;
+    if (settings.feedforward.is_set()) {
+      left_feed = POWER_PER_VOLT * settings.feedforward.left.calculate(velocity, acceleration);
+      right_feed = POWER_PER_VOLT * settings.feedforward.right.calculate(velocity, acceleration);
+    }
+    const double forward = direction * correction.compute(travelled - planned.position);
+    const double turn = heading.compute(chassis.drive_imu_get());
+    // keep the ratio between the sides if either is saturated
+    const double left = left_feed + forward + turn;
+    const double right = right_feed + forward - turn;
+    const double scale = std::max(1.0, std::max(std::fabs(left), std::fabs(right)) / 127);
+    chassis.drive_set(left / scale, right / scale);
+    pros::delay(ez::util::DELAY_TIME);
+  }
+  chassis.drive_set(0, 0);
+}
+
+void ProfiledDrive::turn(double target) {
+  const double start_heading = chassis.drive_imu_get();
+  const double direction = target < start_heading ? -1 : 1;
+  // wheel in/s for each deg/s the robot turns
+  const double wheel_speed = M_PI / 180 * settings.track_width / 2;
+  const double kv = 127 / free_speed() * wheel_speed;
+  const double top = settings.turn_speed > 0 ? settings.turn_speed : SPEED_FRACTION * free_speed() / wheel_speed;
+  const MotionProfile profile(target - start_heading, {top, settings.turn_acceleration, settings.turn_jerk});
+
+  const PID::Constants turn_constants = chassis.pid_turn_constants_get();
+  PID correction(turn_constants.kp, turn_constants.ki, turn_constants.kd, turn_constants.start_i);
+  correction.target_set(0);
+
+  const std::uint32_t start = pros::millis();
+  while (true) {
+    const double elapsed = seconds_since(start);
+    const ProfileState planned = profile.sample(elapsed);
+    const double turned = direction * (chassis.drive_imu_get() - start_heading);
+    if (elapsed >= profile.duration_get()) {
+      if (std::fabs(profile.distance_get() - turned) < settings.turn_exit) break;
+      if (elapsed >= profile.duration_get() + settings.settle_time / 1000.0) break;
+    }
+
+    const double velocity = direction * planned.velocity;
+    const double acceleration = direction * planned.acceleration;
+    const double feed = settings.feedforward.is_set()
+                            ? POWER_PER_VOLT * settings.feedforward.angular.calculate(velocity, acceleration)
+                            : kv * velocity + settings.turn_ka * acceleration;
+    const double power = feed + direction * correction.compute(turned - planned.position);
+    chassis.drive_set(std::clamp(power, -127.0, 127.0), std::clamp(-power, -127.0, 127.0));
+    pros::delay(ez::util::DELAY_TIME);
+  }
+  chassis.drive_set(0, 0);
+  // the next drive holds this heading, like after pid_turn_set()
+  chassis.headingPID.target_set(target);
+}
+
+void ProfiledDrive::follow(const SplinePath& path) {
+  if (path.size() < 2) return;
+  const double kv = 127 / free_speed();
+  // in covered from the first point up to each one, the paths only store the time
+  std::vector<double> distances(path.size(), 0);
+  for (std::size_t i = 1; i < path.size(); i++) {
+    distances[i] = distances[i - 1] + path[i - 1].vector.pose.dist(path[i].vector.pose);
+  }
+  const double total_time = path.back().time;
+
+  const PID::Constants drive_constants = chassis.pid_drive_constants_get();
+  const PID::Constants heading_constants = chassis.pid_heading_constants_get();
+  PID correction(drive_constants.kp, drive_constants.ki, drive_constants.kd, drive_constants.start_i);
+  PID heading(heading_constants.kp, heading_constants.ki, heading_constants.kd, heading_constants.start_i);
+  correction.target_set(0);
+
+  const double left_start = chassis.drive_sensor_left();
+  const double right_start = chassis.drive_sensor_right();
+  const std::uint32_t start = pros::millis();
+  std::size_t i = 0;
+  double target_heading = chassis.drive_imu_get();
+  while (true) {
+    const double elapsed = seconds_since(start);
+    const double travelled =
+        (chassis.drive_sensor_left() - left_start + chassis.drive_sensor_right() - right_start) / 2;
+    if (elapsed >= total_time) {
+      if (std::fabs(distances.back() - travelled) < settings.drive_exit) break;
+      if (elapsed >= total_time + settings.settle_time / 1000.0) break;
+    }
+
+    // the points are in time order, so the one to be at only ever moves forward
+    while (i + 2 < path.size() && path[i + 1].time <= elapsed) i++;
+    const squiggles::ProfilePoint& from = path[i];
+    const squiggles::ProfilePoint& to = path[i + 1];
+    const double step = to.time - from.time;
+    const double fraction = step > 0 ? std::clamp((elapsed - from.time) / step, 0.0, 1.0) : 1.0;
+    const double planned = distances[i] + fraction * (distances[i + 1] - distances[i]);
+
+    // squiggles' yaw is counterclockwise from +x, the IMU is clockwise from +y, kept near the IMU so it never spins
+    const double imu = chassis.drive_imu_get();
+    const double turned = std::remainder(to.vector.pose.yaw - from.vector.pose.yaw, 2 * M_PI);
+    const double yaw = from.vector.pose.yaw + fraction * turned;
+    target_heading = imu + std::remainder(90 - yaw * 180 / M_PI - imu, 360.0);
+    heading.target_set(target_heading);
+
+    const double velocity = from.vector.vel + fraction * (to.vector.vel - from.vector.vel);
+    const double acceleration = from.vector.accel;
+    const double turn_ratio = from.curvature * settings.track_width / 2;
+    const double left_velocity = velocity * (1 - turn_ratio);
+    const double right_velocity = velocity * (1 + turn_ratio);
+    const double left_acceleration = acceleration * (1 - turn_ratio);
+    const double right_acceleration = acceleration * (1 + turn_ratio);
+    double left_feed = kv * left_velocity + settings.drive_ka * left_acceleration;
+    double right_feed = kv * right_velocity + settings.drive_ka * right_acceleration;
+    if (settings.feedforward.is_set()) {
+      left_feed = POWER_PER_VOLT * settings.feedforward.left.calculate(left_velocity, left_acceleration);
+      right_feed = POWER_PER_VOLT * settings.feedforward.right.calculate(right_velocity, right_acceleration);
+    }
+    const double forward = correction.compute(travelled - planned);
+    const double turn = heading.compute(imu);
+    const double left = left_feed + forward + turn;
+    const double right = right_feed + forward - turn;
+    const double scale = std::max(1.0, std::max(std::fabs(left), std::fabs(right)) / 127);
+    chassis.drive_set(left / scale, right / scale);
+    pros::delay(ez::util::DELAY_TIME);
+  }
+  chassis.drive_set(0, 0);
+  // the next drive holds the heading the path ended on
+  chassis.headingPID.target_set(target_heading);
+}
@@ -0,0 +1,165 @@
+#include "path_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "api.h"
+
+namespace {
+
+constexpr double TANGENT_SCALE = 1.2;   // of the distance between waypoints, when a waypoint leaves it at 0
+constexpr int LENGTH_STEPS = 64;        // to estimate how long a segment is before spacing points along it
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+// a point on the splines before the velocity profile, squiggles' angles
+struct SplinePoint {
+  double x;
+  double y;
+  double yaw;
+  double curvature;
+  double distance;  // in along the path from the start
+};
+
+void hash_add(std::uint64_t& hash, double value) {
+  if (value == 0) value = 0;  // -0 and 0 are the same path
+  unsigned char bytes[sizeof(double)];
+  std::memcpy(bytes, &value, sizeof(double));
+  for (unsigned char byte : bytes) hash = (hash ^ byte) * FNV_PRIME;
+}
+
+// Samples one segment, start included and end left for the next one
+void segment_add(const Waypoint& from, const Waypoint& to, double spacing, std::vector<SplinePoint>& points) {
+  const double chord = std::hypot(to.x - from.x, to.y - from.y);
+  const double from_tangent = from.tangent > 0 ? from.tangent : TANGENT_SCALE * chord;
+  const double to_tangent = to.tangent > 0 ? to.tangent : TANGENT_SCALE * chord;
+  const double from_angle = from.angle * M_PI / 180;
+  const double to_angle = to.angle * M_PI / 180;
+  // heading clockwise from +y is sin for x and cos for y, no acceleration at the waypoints keeps curvature continuous
+  squiggles::QuinticPolynomial x(from.x, from_tangent * std::sin(from_angle), 0, to.x, to_tangent * std::sin(to_angle),
+                                 0, 1);
+  squiggles::QuinticPolynomial y(from.y, from_tangent * std::cos(from_angle), 0, to.y, to_tangent * std::cos(to_angle),
+                                 0, 1);
+
+  double length = 0;
+  for (int i = 0; i < LENGTH_STEPS; i++) {
+    const double u = (i + 0.5) / LENGTH_STEPS;
+    length += std::hypot(x.calc_first_derivative(u), y.calc_first_derivative(u)) / LENGTH_STEPS;
+  }
+  const int steps = std::max(1, static_cast<int>(std::ceil(length / spacing)));
+
+  for (int i = 0; i < steps; i++) {
+    const double u = static_cast<double>(i) / steps;
+    const double dx = x.calc_first_derivative(u);
+    const double dy = y.calc_first_derivative(u);
+    const double ddx = x.calc_second_derivative(u);
+    const double ddy = y.calc_second_derivative(u);
+    const double speed = std::hypot(dx, dy);
+    SplinePoint point = {x.calc_point(u), y.calc_point(u), std::atan2(dy, dx), 0, 0};
+    if (speed > 1e-9) point.curvature = (dx * ddy - dy * ddx) / (speed * speed * speed);
+    if (!points.empty()) {
+      point.distance = points.back().distance + std::hypot(point.x - points.back().x, point.y - points.back().y);
+    }
+    points.push_back(point);
+  }
+}
+
+}  // namespace
+
+SplinePath spline_path_generate(const std::vector<Waypoint>& waypoints, PathConstraints constraints) {
+  SplinePath path;
+  if (waypoints.size() < 2) return path;
+
+  std::vector<SplinePoint> points;
+  for (std::size_t i = 0; i + 1 < waypoints.size(); i++) {
+    segment_add(waypoints[i], waypoints[i + 1], constraints.spacing, points);
+  }
+  const Waypoint& last = waypoints.back();
+  const double last_yaw = M_PI / 2 - last.angle * M_PI / 180;
+  points.push_back({last.x, last.y, last_yaw, points.back().curvature,
+                    points.back().distance + std::hypot(last.x - points.back().x, last.y - points.back().y)});
+
+  // the fastest the outside wheel allows through each curve, then speeding up from a stop and slowing to one
+  const std::size_t count = points.size();
+  std::vector<double> speed(count);
+  for (std::size_t i = 0; i < count; i++) {
+    speed[i] = constraints.max_velocity / (1 + std::fabs(points[i].curvature) * constraints.track_width / 2);
+  }
+  speed.front() = 0;
+  speed.back() = 0;
+  for (std::size_t i = 1; i < count; i++) {
+    const double length = points[i].distance - points[i - 1].distance;
+    speed[i] = std::min(speed[i], std::sqrt(speed[i - 1] * speed[i - 1] + 2 * constraints.max_acceleration * length));
+  }
+  for (std::size_t i = count - 1; i-- > 0;) {
+    const double length = points[i + 1].distance - points[i].distance;
+    speed[i] = std::min(speed[i], std::sqrt(speed[i + 1] * speed[i + 1] + 2 * constraints.max_acceleration * length));
+  }
+
+  // constant acceleration between points, so each step takes its length over the average of its speeds
+  path.reserve(count);
+  double time = 0;
+  for (std::size_t i = 0; i < count; i++) {
+    const SplinePoint& point = points[i];
+    double acceleration = 0;
+    if (i + 1 < count) {
+      const double length = points[i + 1].distance - point.distance;
+      if (length > 0) acceleration = (speed[i + 1] * speed[i + 1] - speed[i] * speed[i]) / (2 * length);
+    }
+    // turning counterclockwise slows the left side
+    const double turn = point.curvature * constraints.track_width / 2;
+    path.emplace_back(squiggles::ControlVector(squiggles::Pose(point.x, point.y, point.yaw), speed[i], acceleration),
+                      std::vector<double>{speed[i] * (1 - turn), speed[i] * (1 + turn)}, point.curvature, time);
+    if (i + 1 < count) {
+      time += 2 * (points[i + 1].distance - point.distance) / std::max(speed[i] + speed[i + 1], 1e-6);
+    }
+  }
+  return path;
+}
+
+std::uint64_t PathCache::hash(const std::vector<Waypoint>& waypoints, const PathConstraints& constraints) {
+  std::uint64_t hash = FNV_OFFSET;
+  for (const Waypoint& waypoint : waypoints) {
+    hash_add(hash, waypoint.x);
+    hash_add(hash, waypoint.y);
+    hash_add(hash, waypoint.angle);
+    hash_add(hash, waypoint.tangent);
+  }
+  hash_add(hash, constraints.max_velocity);
+  hash_add(hash, constraints.max_acceleration);
+  hash_add(hash, constraints.track_width);
+  hash_add(hash, constraints.spacing);
+  return hash;
+}
+
+const PathCache::Entry* PathCache::find(const std::vector<Waypoint>& waypoints,
+                                        const PathConstraints& constraints) const {
+  // paths with the same hash sit side by side, only the one with these waypoints will do
+  const auto [first, last] = paths.equal_range(hash(waypoints, constraints));
+  for (auto found = first; found != last; ++found) {
+    const Entry& entry = found->second;
+    if (entry.waypoints == waypoints && entry.constraints == constraints) return &entry;
+  }
+  return nullptr;
+}
+
+const SplinePath& PathCache::get(const std::vector<Waypoint>& waypoints, PathConstraints constraints) {
+  if (const Entry* entry = find(waypoints, constraints)) return entry->path;
+  if (pros::competition::is_autonomous()) {
+    printf("PathCache: a path was generated inside autonomous(), ask for it in initialize() instead\n");
+  }
+  // a new entry even when another path has the same hash, so references to that one stay valid
+  const auto added = paths.emplace(hash(waypoints, constraints),
+                                   Entry{waypoints, constraints, spline_path_generate(waypoints, constraints)});
+  return added->second.path;
+}
+
+bool PathCache::contains(const std::vector<Waypoint>& waypoints, PathConstraints constraints) const {
+  return find(waypoints, constraints) != nullptr;
+}
+
+std::size_t PathCache::size() const { return paths.size(); }
+
+void PathCache::clear() { paths.clear(); }
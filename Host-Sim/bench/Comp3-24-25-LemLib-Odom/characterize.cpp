@@ -0,0 +1,199 @@
+// Runs Chassis::characterize() on main.cpp's chassis, each time with slightly
+// different motors, traction and weight, logging through the binary telemetry
+// sink. Decodes the log with firmware/telemetryDecode.py and fits it with
+// firmware/characterizeFit.py, then drives a velocity profile out and back
+// with Chassis::tankVelocity() on the fitted constants, and again on the kV
+// that the drivetrain's free speed suggests with no kS or kA, and reports how
+// closely each follows the profile.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_characterize        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_characterize 20     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/feedforward.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/motionProfile.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 4;
+constexpr std::uint32_t TIMEOUT_MS = 120000;
+constexpr float KP = 0.1; // volts per in/s, the same for both runs
+const lemlib::ProfileLimits PROFILE = {50, 150, 1500};
+constexpr float PROFILE_DISTANCE = 48;
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    config.mass *= 1 + 0.1 * spread(rng);
+    config.rolling_resistance *= 1 + 0.2 * spread(rng);
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+lemlib::ControllerSettings linearController(10, 0, 3, 3, 1, 100, 3, 500, 20);
+lemlib::ControllerSettings angularController(2, 0, 12, 0, 0.5, 100, 3, 500, 0);
+lemlib::OdomSensors sensors(&vertical, nullptr, &horizontal, nullptr, &imu);
+lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors);
+
+sim::Drivetrain* truth = nullptr;
+std::string logFile;
+
+void characterize() {
+    chassis.calibrateOdom();
+    auto sink = lemlib::telemetrySink();
+    sink->setLowestLevel(lemlib::Level::INFO);
+    sink->setFile(logFile.c_str());
+    sink->setMode(lemlib::TelemetrySink::Mode::BINARY);
+    chassis.characterize();
+    // let the buffer task write the rest out before closing the file
+    pros::delay(50);
+    sink->setFile(nullptr);
+}
+
+// Returns the setDriveFeedforward() call the fitter printed, and everything else it printed through fits
+std::string fit(std::string& fits) {
+    const std::string command = SIM_PYTHON " " SIM_PROJDIR "/firmware/telemetryDecode.py --csv --match "
+                                "\"Drive characterization\" " + logFile + " | " SIM_PYTHON " " SIM_PROJDIR
+                                "/firmware/characterizeFit.py";
+    std::string call;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) return call;
+    char line[512];
+    while (std::fgets(line, sizeof(line), pipe)) {
+        if (std::strncmp(line, "lemlib::", 8) == 0) call = line;
+        else fits += line;
+    }
+    pclose(pipe);
+    return call;
+}
+
+double rmsError = 0;
+
+// drives the profile out and back on tankVelocity(), RMS of how far the robot is from where the profile is, in
+void followProfile() {
+    const lemlib::MotionProfile profile(PROFILE_DISTANCE, PROFILE);
+    double squares = 0;
+    int count = 0;
+    for (const float direction : {1.0f, -1.0f}) {
+        const sim::Pose start = truth->pose();
+        const double heading = start.theta * M_PI / 180;
+        const std::uint32_t startTime = sim::now_ms();
+        while (true) {
+            const float elapsed = (sim::now_ms() - startTime) / 1000.0f;
+            if (elapsed > profile.getDuration() + 0.3f) break;
+            const lemlib::ProfileState planned = profile.sample(elapsed);
+            const sim::Pose pose = truth->pose();
+            const double along = (pose.x - start.x) * std::sin(heading) + (pose.y - start.y) * std::cos(heading);
+            const double error = direction * planned.position - along;
+            squares += error * error;
+            count++;
+            const float velocity = direction * planned.velocity;
+            const float acceleration = direction * planned.acceleration;
+            chassis.tankVelocity(velocity, velocity, acceleration, acceleration);
+            pros::delay(10);
+        }
+        leftMotors.move_voltage(0);
+        rightMotors.move_voltage(0);
+        pros::delay(1000);
+    }
+    rmsError = std::sqrt(squares / count);
+}
+
+// Returns {left kS, kV, kA, angular kS, kV, kA, RMS error fitted, RMS error free speed guess}
+std::vector<double> trial(int index) {
+    static sim::Drivetrain robot(drivetrainConfig(index));
+    truth = &robot;
+    logFile = SIM_BUILDDIR "/characterize_" + std::to_string(index) + ".bin";
+    std::remove(logFile.c_str());
+    if (!sim::run_task(characterize, TIMEOUT_MS)) return {};
+
+    std::string fits;
+    const std::string call = fit(fits);
+    std::remove(logFile.c_str());
+    lemlib::DriveFeedforward fitted;
+    if (std::sscanf(call.c_str(), "lemlib::setDriveFeedforward({.left = {%f, %f, %f}, .right = {%f, %f, %f}, "
+                                  ".angular = {%f, %f, %f}});",
+                    &fitted.left.kS, &fitted.left.kV, &fitted.left.kA, &fitted.right.kS, &fitted.right.kV,
+                    &fitted.right.kA, &fitted.angular.kS, &fitted.angular.kV, &fitted.angular.kA) != 9) {
+        std::fprintf(stderr, "fit failed:\n%s%s", fits.c_str(), call.c_str());
+        return {};
+    }
+    fitted.kP = KP;
+
+    lemlib::setDriveFeedforward(fitted);
+    if (!sim::run_task(followProfile, TIMEOUT_MS)) return {};
+    const double fittedError = rmsError;
+
+    // what a team would guess without characterizing: full voltage at free speed
+    const float freeSpeed = drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter;
+    lemlib::DriveFeedforward guess;
+    guess.left.kV = guess.right.kV = 12 / freeSpeed;
+    guess.kP = KP;
+    lemlib::setDriveFeedforward(guess);
+    if (!sim::run_task(followProfile, TIMEOUT_MS)) return {};
+
+    return {fitted.left.kS, fitted.left.kV,    fitted.left.kA, fitted.angular.kS,
+            fitted.angular.kV, fitted.angular.kA, fittedError, rmsError};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int trials = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) trials = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, trials, trial);
+
+    std::vector<double> columns[8];
+    for (const auto& result : results) {
+        if (result.size() != 8) continue;
+        for (int c = 0; c < 8; c++) columns[c].push_back(result[c]);
+    }
+    std::printf("characterize, %zu robots fitted\n", columns[0].size());
+    const char* names[] = {"left kS V:", "left kV V/(in/s):", "left kA V/(in/s^2):", "angular kS V:",
+                           "angular kV V/(deg/s):", "angular kA V/(deg/s^2):"};
+    for (int c = 0; c < 6; c++) std::printf("  %-24s %s\n", names[c], sim::to_string(sim::stats(columns[c]), 4).c_str());
+    std::printf("tankVelocity() following a %.0f in profile out and back\n", PROFILE_DISTANCE);
+    std::printf("  fitted RMS error in:     %s\n", sim::to_string(sim::stats(columns[6])).c_str());
+    std::printf("  free speed RMS error in: %s\n", sim::to_string(sim::stats(columns[7])).c_str());
+    const double fitted = columns[6].empty() ? 0 : sim::stats(columns[6]).mean;
+    const double guess = columns[7].empty() ? 0 : sim::stats(columns[7]).mean;
+    std::printf("characterize: %.2f in RMS off the profile with fitted feedforward, %.2f in with the free speed kV\n",
+                fitted, guess);
+    return columns[0].size() == std::size_t(trials) ? 0 : 1;
+}
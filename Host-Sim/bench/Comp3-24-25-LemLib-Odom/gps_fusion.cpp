@@ -0,0 +1,197 @@
+// Drives main.cpp's chassis around the field through the same hard starts,
+// stops and bumped tracking wheels as bench_pose_filter, with a GPS sensor
+// whose readings are noisy and 50 ms old by the time they arrive. Runs it
+// with dead reckoning alone, with the GPS taken as if it were current, and
+// with the GPS compared against the pose history from when each reading was
+// taken, and reports how far each is from the true pose along the way and at
+// the end.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_gps_fusion        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_gps_fusion 200    more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "pros/gps.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 8;
+constexpr int MODE_COUNT = 3;
+constexpr const char* MODES[] = {"dead reckoning", "gps, latency ignored", "gps, latency compensated"};
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+constexpr std::uint32_t CHECK_MS = 10;
+constexpr int GPS_PORT = 11;
+constexpr std::uint32_t GPS_LATENCY_MS = 50;
+
+const sim::Pose START = {-36, -36, 45};
+
+// left power, right power, ms
+struct Leg {
+        int left;
+        int right;
+        std::uint32_t ms;
+};
+
+const Leg ROUTE[] = {
+    {127, 127, 600}, {-127, -127, 500}, {127, -127, 500}, {127, 127, 700}, {-127, 127, 400},
+    {127, 60, 800}, {-127, -127, 600}, {127, 127, 500}, {0, 0, 600},
+};
+
+// rotation sensor port, ms into the route, degrees the wheel spins while off the ground
+struct Bump {
+        int port;
+        std::uint32_t at;
+        double degrees;
+};
+
+const Bump BUMPS[] = {{13, 700, 250}, {1, 1400, -180}, {13, 2600, -300}, {1, 3600, 220}};
+
+// Same ports and wheels as the chassis in main.cpp, plus a GPS
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    config.gps_port = GPS_PORT;
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    config.imu_scale = 1 + 0.003 * spread(rng);
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+pros::Gps gps(GPS_PORT);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+
+int mode = 0;
+sim::Drivetrain* truth = nullptr;
+std::vector<double> errors;
+
+// what Chassis::calibrateOdom() does, the right side stands in for the missing second vertical wheel
+void calibrate() {
+    imu.reset(true);
+    static lemlib::TrackingWheel rightWheel(&rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                                            drivetrain.rpm);
+    vertical.reset();
+    rightWheel.reset();
+    horizontal.reset();
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, &rightWheel, &horizontal, nullptr, &imu), drivetrain);
+    lemlib::init();
+    lemlib::setPose({float(START.x), float(START.y), float(START.theta)});
+    if (mode > 0) {
+        lemlib::GpsSettings settings;
+        settings.latency = mode == 2 ? GPS_LATENCY_MS : 0;
+        lemlib::useGps(&gps, settings);
+    }
+    pros::delay(50);
+}
+
+double error() {
+    const lemlib::Pose pose = lemlib::getPose();
+    return std::hypot(pose.x - truth->pose().x, pose.y - truth->pose().y);
+}
+
+void check() {
+    while (true) {
+        pros::delay(CHECK_MS);
+        errors.push_back(error());
+    }
+}
+
+void drive() {
+    pros::Task checker(check);
+    const std::uint32_t start = sim::now_ms();
+    const Bump* bump = BUMPS;
+    for (const Leg& leg : ROUTE) {
+        leftMotors.move(leg.left);
+        rightMotors.move(leg.right);
+        const std::uint32_t end = sim::now_ms() + leg.ms;
+        while (sim::now_ms() < end) {
+            if (bump != std::end(BUMPS) && sim::now_ms() - start >= bump->at) {
+                sim::rotation(bump->port).angle += bump->degrees;
+                bump++;
+            }
+            pros::delay(1);
+        }
+    }
+    leftMotors.brake();
+    rightMotors.brake();
+    pros::delay(500);
+}
+
+// Returns {mean error in, worst error in, end error in, readings left out}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    static sim::Drivetrain drivetrain(drivetrainConfig(index / MODE_COUNT), START);
+    truth = &drivetrain;
+    sim::Gps& sensor = sim::gps(GPS_PORT);
+    sensor.latency = GPS_LATENCY_MS;
+    sensor.noise_state += index / MODE_COUNT;
+    // the sensors start sending whenever they finish booting, so at a different point in each run
+    std::mt19937 rng(index / MODE_COUNT);
+    for (std::uint32_t* phase : {&sim::imu(15).data_phase, &sim::rotation(1).data_phase,
+                                 &sim::rotation(13).data_phase, &sensor.data_phase})
+        *phase = rng() % 1000;
+    if (!sim::run_task(calibrate, TIMEOUT_MS) || !sim::run_task(drive, TIMEOUT_MS)) return {};
+
+    const sim::Stats stats = sim::stats(errors);
+    return {stats.mean, stats.max, error(), double(lemlib::getRejectedGpsReadings())};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true;
+    double meanError[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> columns[4];
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 4) {
+                complete = false;
+                continue;
+            }
+            for (int c = 0; c < 4; c++) columns[c].push_back(results[i][c]);
+        }
+        meanError[m] = sim::stats(columns[0]).mean;
+        std::printf("%s, %zu runs\n", MODES[m], columns[0].size());
+        std::printf("  mean error in:       %s\n", sim::to_string(sim::stats(columns[0])).c_str());
+        std::printf("  worst error in:      %s\n", sim::to_string(sim::stats(columns[1])).c_str());
+        std::printf("  end error in:        %s\n", sim::to_string(sim::stats(columns[2])).c_str());
+        if (m > 0) std::printf("  readings left out:   %s\n", sim::to_string(sim::stats(columns[3]), 0).c_str());
+    }
+    std::printf("gps fusion: %.2f in dead reckoning, %.2f in latency ignored, %.2f in latency compensated\n",
+                meanError[0], meanError[1], meanError[2]);
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+// Hammers lemlib::RecordRing with several producer threads and one reader on
+// real threads, checking every record comes out whole, in order per producer,
+// and that pushed = popped + dropped. Then compares the cost and heap use of a
+// log push against the deque + mutex the LemLib Buffer used to have.
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lemlib/logger/recordRing.hpp"
+
+namespace {
+
+std::atomic<long> allocations = 0;
+
+constexpr int PRODUCERS = 3;
+constexpr std::uint32_t RECORDS = 30000; // per producer
+constexpr int TIMED = 200000;
+
+struct Record {
+    std::uint8_t producer;
+    std::uint32_t sequence;
+    std::uint8_t fill[60];
+};
+
+// 9 to 69 bytes, every byte of the fill says which record it belongs to
+std::size_t makeRecord(Record& record, int producer, std::uint32_t sequence) {
+    record.producer = producer;
+    record.sequence = sequence;
+    const std::size_t fill = sequence % sizeof(record.fill);
+    std::memset(record.fill, std::uint8_t(sequence * 7 + producer), fill);
+    return offsetof(Record, fill) + fill;
+}
+
+bool stress() {
+    lemlib::RecordRing ring(4096);
+    std::atomic<std::uint32_t> dropped[PRODUCERS] = {};
+    std::atomic<int> running = PRODUCERS;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&, p] {
+            Record record {}; // padding included, it is compared
+            for (std::uint32_t i = 0; i < RECORDS; i++) {
+                if (!ring.push(&record, makeRecord(record, p, i))) dropped[p]++;
+                if (i % 8 == 0) std::this_thread::yield();
+            }
+            running--;
+        });
+    }
+
+    std::uint32_t popped[PRODUCERS] = {};
+    std::int64_t last[PRODUCERS] = {-1, -1, -1};
+    int corrupt = 0;
+    int outOfOrder = 0;
+    std::uint8_t out[lemlib::RecordRing::MAX_RECORD];
+    while (running > 0 || !ring.empty()) {
+        const int size = ring.pop(out);
+        if (size < 0) continue;
+        Record record {};
+        std::memcpy(&record, out, size);
+        Record expected {};
+        if (record.producer >= PRODUCERS ||
+            std::size_t(size) != makeRecord(expected, record.producer, record.sequence) ||
+            std::memcmp(&record, &expected, size) != 0) {
+            corrupt++;
+            continue;
+        }
+        if (record.sequence <= last[record.producer]) outOfOrder++;
+        last[record.producer] = record.sequence;
+        popped[record.producer]++;
+    }
+    for (auto& thread : producers) thread.join();
+
+    bool ok = corrupt == 0 && outOfOrder == 0;
+    std::uint32_t totalPopped = 0;
+    std::uint32_t totalDropped = 0;
+    for (int p = 0; p < PRODUCERS; p++) {
+        ok = ok && popped[p] + dropped[p] == RECORDS;
+        totalPopped += popped[p];
+        totalDropped += dropped[p];
+    }
+    std::printf("stress: %d producers x %u records, %u popped, %u dropped (ring full), %d corrupt, %d out of order, "
+                "high water %zu/%zu bytes\n",
+                PRODUCERS, RECORDS, totalPopped, totalDropped, corrupt, outOfOrder, ring.getHighWater(),
+                ring.capacity());
+    return ok;
+}
+
+// what lemlib::Buffer::pushToBuffer did before
+struct DequeBuffer {
+    std::deque<std::string> buffer;
+    std::mutex mutex;
+
+    void push(const std::string& data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer.push_back(data);
+    }
+};
+
+template <typename P, typename D> void timed(const char* name, P&& push, D&& drain) {
+    const long before = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TIMED; i++) {
+        push(i);
+        if (i % 100 == 99) drain(); // the buffer task keeps up every so often
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("%-30s %6.1f ns/push, %.2f heap allocations/push\n", name,
+                std::chrono::duration<double, std::nano>(elapsed).count() / TIMED,
+                double(allocations - before) / TIMED);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    const bool ok = stress();
+
+    // a pose line the size the screen task logs, already formatted
+    const std::string line = "TELE_START[LemLib] INFO: Chassis pose: x: 12.345, y: -67.890, theta: 123.456TELE_END";
+
+    DequeBuffer deque;
+    timed("deque<string> + mutex", [&](int) { deque.push(line); },
+          [&] {
+              std::lock_guard<std::mutex> lock(deque.mutex);
+              deque.buffer.clear();
+          });
+
+    lemlib::RecordRing ring(8192);
+    std::uint8_t out[lemlib::RecordRing::MAX_RECORD];
+    timed("RecordRing", [&](int) { ring.push(line.data(), line.size()); },
+          [&] {
+              while (ring.pop(out) >= 0) {}
+          });
+
+    return ok ? 0 : 1;
+}
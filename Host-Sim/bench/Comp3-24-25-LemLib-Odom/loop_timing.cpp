@@ -0,0 +1,155 @@
+// Runs a ControlScheduler with a job that now and then blocks for a few ms,
+// like a slow SD card write, next to an opcontrol style loop on pros::delay()
+// that now and then stalls, all timed by LoopTimers that log to the binary
+// telemetry file like main.cpp's "loop log" job. Then runs the file through
+// firmware/telemetryDecode.py and firmware/loopReport.py, prints the table and
+// checks it against the stats on the brain and against the stalls there were.
+// Last, times what a start()/stop() pair costs.
+//
+// The sim's pros::micros() only moves in whole ms, so run times are the
+// stalls and nothing else.
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "controlScheduler.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "loopTimer.hpp"
+#include "pros/rtos.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+
+constexpr std::uint32_t RUN_MS = 10000;
+constexpr std::uint32_t SLOW_MS = 8;  // a slow job run blocks the scheduler this long
+constexpr int SLOW_EVERY = 40;        // runs of the slow job between blocks
+constexpr int OVERHEAD_PAIRS = 100000;
+const std::string FILE_PATH = SIM_BUILDDIR "/loop_timing.bin";
+
+using Clock = std::chrono::steady_clock;
+
+ControlScheduler scheduler;
+LoopTimer driverLoop("opcontrol", 10);
+int slowRuns = 0; // times the slow job blocked
+int stalls[5] = {}; // driver loop stalls by ms
+std::vector<LoopStats> onBrain; // every timer's stats as the run ended
+double overheadNs = 0;
+
+void run() {
+    auto sink = lemlib::telemetrySink();
+    sink->setLowestLevel(lemlib::Level::INFO);
+    sink->setFile(FILE_PATH.c_str());
+    sink->setMode(lemlib::TelemetrySink::Mode::BINARY);
+
+    scheduler.add("odometry", Stage::SENSE, 5, [](std::uint32_t) {});
+    scheduler.add("slow job", Stage::COMPUTE, 20, [](std::uint32_t) {
+        static int runs = 0;
+        if (++runs % SLOW_EVERY != 0) return;
+        slowRuns++;
+        pros::delay(SLOW_MS);
+    });
+    scheduler.add("loop log", Stage::DISPLAY, 1000, [](std::uint32_t) { LoopTimer::recordAll(); });
+    pros::Task schedulerTask([] { scheduler.run(); }, TASK_PRIORITY_DEFAULT + 2);
+
+    std::mt19937 rng(1755);
+    LoopTimer::resetAll();
+    const std::uint32_t end = pros::millis() + RUN_MS;
+    while (pros::millis() < end) {
+        driverLoop.start();
+        // none in the last run, so every stall is followed by a start that sees it
+        if (pros::millis() + 20 < end && rng() % 10 == 0) {
+            const int stall = 1 + rng() % 4;
+            stalls[stall]++;
+            pros::delay(stall);
+        }
+        driverLoop.stop();
+        pros::delay(10);
+    }
+
+    // nothing else runs until this task blocks, so the log matches
+    for (LoopTimer* timer : LoopTimer::getAll()) onBrain.push_back(timer->getStats());
+    LoopTimer::recordAll();
+
+    LoopTimer timed("overhead", 10);
+    const auto start = Clock::now();
+    for (int i = 0; i < OVERHEAD_PAIRS; i++) {
+        timed.start();
+        timed.stop();
+    }
+    overheadNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / OVERHEAD_PAIRS;
+
+    // let the buffer task write the rest out before closing the file
+    pros::delay(50);
+    sink->setFile(nullptr);
+}
+
+std::vector<std::string> report(const std::string& options) {
+    const std::string command = SIM_PYTHON " " SIM_PROJDIR "/firmware/telemetryDecode.py --csv --match \"Loop timing\" " +
+                                FILE_PATH + " | " SIM_PYTHON " " SIM_PROJDIR "/firmware/loopReport.py " + options;
+    std::vector<std::string> lines;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) return lines;
+    char line[512];
+    while (std::fgets(line, sizeof(line), pipe)) {
+        std::string text(line);
+        if (!text.empty() && text.back() == '\n') text.pop_back();
+        lines.push_back(text);
+    }
+    pclose(pipe);
+    return lines;
+}
+
+// loopReport.py --csv row: loop, period, runs, mean, max, latency, missed, ...
+bool matches(const std::string& row, const LoopStats& stats) {
+    std::stringstream stream(row);
+    std::string name;
+    unsigned long period, runs, mean, longest, latency, misses;
+    char comma;
+    if (!std::getline(stream, name, ',')) return false;
+    stream >> period >> comma >> runs >> comma >> mean >> comma >> longest >> comma >> latency >> comma >> misses;
+    return stream && name == stats.name && period == stats.period && runs == stats.runs &&
+           mean == stats.meanTime() && longest == stats.maxTime && latency == stats.maxLatency &&
+           misses == stats.misses;
+}
+
+const LoopStats* find(const char* name) {
+    for (const LoopStats& stats : onBrain) {
+        if (std::string(stats.name) == name) return &stats;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+int main() {
+    std::remove(FILE_PATH.c_str());
+    const bool finished = sim::run_task(run, 60000);
+
+    for (const std::string& line : report("")) std::printf("  %s\n", line.c_str());
+
+    const std::vector<std::string> rows = report("--csv");
+    int matched = 0;
+    for (size_t i = 1; i < rows.size(); i++) {
+        const std::string name = rows[i].substr(0, rows[i].find(','));
+        const LoopStats* stats = find(name.c_str());
+        if (stats != nullptr && matches(rows[i], *stats)) matched++;
+    }
+    const bool exported = matched == int(onBrain.size());
+
+    // each block makes its tick finish after the next was due, and nothing else does
+    const LoopStats* tick = find("scheduler");
+    const LoopStats* driver = find("opcontrol");
+    const bool ticks = tick != nullptr && int(tick->misses) == slowRuns && tick->maxTime == SLOW_MS * 1000;
+    // a stall of n ms puts the next start n ms off the period, in the bin with edge n ms and the two over 2 ms together
+    const bool jitter = driver != nullptr && int(driver->jitter[4]) == stalls[1] && int(driver->jitter[5]) == stalls[2] &&
+                        int(driver->jitter[6]) == stalls[3] + stalls[4];
+
+    std::printf("loop timing: %d/%zu loops match the brain in loopReport.py, %d blocks %s in the tick misses, "
+                "opcontrol jitter %s the stalls; start()+stop() %.0f ns\n",
+                matched, onBrain.size(), slowRuns, ticks ? "all" : "not", jitter ? "matches" : "doesn't match",
+                overheadNs);
+    return finished && exported && ticks && jitter ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// Loads a ring into the lady brown and scores it three ways: opcontrol's old
+// DIGITAL_LEFT handler firing the arm and the hooks on the same tick, then UP
+// once the driver sees it loaded; a string of moves and fixed delays like the
+// autons use; and main.cpp's loadLadyBrown and scoreLadyBrown macros on a
+// MacroEngine, each time with a slightly different arm. Reports how far the
+// arm still was from the load position when the hooks started moving, which
+// way and how far they moved, how long until the arm is at the score
+// position, how far short of it the arm is when the sequence says it is done
+// and the longest the calling loop went without running.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_macros        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_macros 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "macroEngine.hpp"
+#include "pros/motors.hpp"
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "ringSorter.hpp"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"same tick", "fixed delays", "macros"};
+constexpr int MODE_COUNT = 3;
+constexpr std::uint32_t TIMEOUT_MS = 10000;
+constexpr int LADY_BROWN_PORT = 16;
+constexpr int HOOK_PORT = 5;
+constexpr double LOAD = 380;
+constexpr double SCORE = 1850;
+constexpr double BAND = 15;               // ticks from a position the arm counts as there
+constexpr std::uint32_t DRIVER_WAIT = 600; // ms the driver waits after LEFT before pressing UP
+
+// same ports and settings as main.cpp
+pros::Motor ladybrown(LADY_BROWN_PORT);
+pros::Motor intakeHigh(-HOOK_PORT);
+pros::Optical colorsort(2);
+RingSorter ringSorter(colorsort, intakeHigh, {150, 250, 0, 200, 0});
+MacroEngine macros;
+
+// main.cpp's macros
+double hooksBackedFrom = 0;
+
+const Macro loadLadyBrown(LADY_BROWN | HOOKS, {
+    {[] { ladybrown.move_absolute(LOAD, 127); }, [] { return std::abs(ladybrown.get_position() - LOAD) < BAND; }, 800},
+    {[] {
+         hooksBackedFrom = intakeHigh.get_position();
+         ringSorter.setIntake(-127);
+     },
+     [] { return intakeHigh.get_position() <= hooksBackedFrom - 200; }, 300},
+}, [] { ringSorter.setIntake(0); });
+
+const Macro scoreLadyBrown(LADY_BROWN, {
+    {[] { ladybrown.move_absolute(SCORE, 127); }, [] { return ladybrown.get_position() > SCORE - BAND; }, 2000},
+});
+
+int mode = 0;
+// where the arm was when the hooks were first driven
+double armAtHooks = NAN;
+// when the arm first got to SCORE, ms
+std::uint32_t scoredAt = 0;
+// longest gap between two passes of the loop that runs the sequence, ms
+std::uint32_t longestLoop = 0;
+
+void watch(std::uint32_t now, double) {
+    if (std::isnan(armAtHooks) && sim::motor(HOOK_PORT).voltage != 0) armAtHooks = ladybrown.get_position();
+    if (scoredAt == 0 && ladybrown.get_position() > SCORE - BAND) scoredAt = now;
+}
+
+// one pass of a 10 ms loop, like opcontrol's
+void loopDelay(std::uint32_t& last, std::uint32_t ms) {
+    pros::delay(ms);
+    longestLoop = std::max(longestLoop, sim::now_ms() - last);
+    last = sim::now_ms();
+}
+
+void sequence() {
+    std::uint32_t last = sim::now_ms();
+    if (mode == 0) {
+        ladybrown.move_absolute(LOAD, 127);
+        intakeHigh.move_relative(200, -127);
+        const std::uint32_t pressed = sim::now_ms();
+        while (sim::now_ms() - pressed < DRIVER_WAIT) loopDelay(last, 10);
+        ladybrown.move_absolute(SCORE, 127);
+        while (ladybrown.get_position() < SCORE - BAND) loopDelay(last, 10);
+    } else if (mode == 1) {
+        ladybrown.move_absolute(LOAD, 127);
+        loopDelay(last, 600);
+        intakeHigh.move(-127);
+        loopDelay(last, 150);
+        intakeHigh.move(0);
+        ladybrown.move_absolute(SCORE, 127);
+        loopDelay(last, 1200);
+    } else {
+        macros.start(loadLadyBrown);
+        while (macros.isRunning(loadLadyBrown)) loopDelay(last, 10);
+        macros.start(scoreLadyBrown);
+        while (macros.isRunning(scoreLadyBrown)) loopDelay(last, 10);
+    }
+    loopDelay(last, 0);
+}
+
+// Returns {arm ticks from LOAD when the hooks moved, hook travel deg, s until the arm is at SCORE, ticks the arm is
+// short of SCORE when the sequence is done, longest loop ms}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    std::mt19937 rng(index / MODE_COUNT);
+    std::normal_distribution<double> spread(0, 1);
+    sim::motor(LADY_BROWN_PORT).load_inertia = 2e-4 * (1 + 0.1 * spread(rng));
+    sim::motor(LADY_BROWN_PORT).load_torque = 0.05 * (1 + 0.1 * spread(rng));
+    sim::motor(HOOK_PORT).load_torque = 0.3; // chain and rings
+    sim::plant_add(watch);
+    if (mode == 2) pros::Task task([] { macros.run(); });
+
+    const std::uint32_t start = sim::now_ms();
+    if (!sim::run_task(sequence, TIMEOUT_MS)) return {};
+    const double hookTravel = intakeHigh.get_position();
+    const double shortOfScore = std::max(0.0, SCORE - ladybrown.get_position());
+    if (!sim::run_until([] { return scoredAt != 0; }, TIMEOUT_MS)) return {};
+    return {std::abs(armAtHooks - LOAD), hookTravel, (scoredAt - start) / 1000.0, shortOfScore, double(longestLoop)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true;
+    double meanTime[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> armAt, travel, time, shortOf, loop;
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 5) {
+                complete = false;
+                continue;
+            }
+            armAt.push_back(results[i][0]);
+            travel.push_back(results[i][1]);
+            time.push_back(results[i][2]);
+            shortOf.push_back(results[i][3]);
+            loop.push_back(results[i][4]);
+        }
+        meanTime[m] = time.empty() ? 0 : sim::stats(time).mean;
+        std::printf("%s, %zu load and score sequences\n", MODES[m], time.size());
+        std::printf("  arm off load as hooks move: %s\n", sim::to_string(sim::stats(armAt), 0).c_str());
+        std::printf("  hook travel deg:            %s\n", sim::to_string(sim::stats(travel), 0).c_str());
+        std::printf("  s until arm at score:       %s\n", sim::to_string(sim::stats(time)).c_str());
+        std::printf("  short of score when done:   %s\n", sim::to_string(sim::stats(shortOf), 0).c_str());
+        std::printf("  longest loop ms:            %s\n", sim::to_string(sim::stats(loop), 0).c_str());
+    }
+    std::printf("macros: %.2f s same tick, %.2f s fixed delays, %.2f s macros (%+.0f%% on fixed delays)\n", meanTime[0],
+                meanTime[1], meanTime[2], 100 * (meanTime[2] / meanTime[1] - 1));
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// Drives main.cpp's chassis through a short square of moves and turns with
+// LemLib's moveToPoint() and turnToHeading(), then with the profiled versions
+// on a trapezoid and on an S-curve, each time with slightly different motors
+// and traction. Reports how long the routine takes and how far from each
+// target the robot comes to rest.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_motion_profile        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_motion_profile 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"PID", "trapezoid", "S-curve"};
+constexpr int MODE_COUNT = 3;
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+constexpr int MOTION_TIMEOUT_MS = 3000;
+
+// a point to drive to, then a heading to turn to there
+struct Stop {
+        float x;
+        float y;
+        float theta;
+};
+
+const Stop ROUTE[] = {{0, 36, 90}, {36, 36, 180}, {36, 12, 270}, {0, 12, 0}};
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    config.mass *= 1 + 0.03 * spread(rng);
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+lemlib::ControllerSettings linearController(10, 0, 3, 3, 1, 100, 3, 500, 20);
+lemlib::ControllerSettings angularController(2, 0, 12, 0, 0.5, 100, 3, 500, 0);
+lemlib::OdomSensors sensors(&vertical, nullptr, &horizontal, nullptr, &imu);
+lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors);
+
+sim::Drivetrain* truth = nullptr;
+int mode = 0;
+std::vector<double> moveError;
+std::vector<double> turnError;
+
+void calibrate() { chassis.calibrateOdom(); }
+
+// how far the robot really is from a point, and from a heading
+double distanceTo(const Stop& stop) { return std::hypot(truth->pose().x - stop.x, truth->pose().y - stop.y); }
+
+double headingError(const Stop& stop) { return std::abs(std::remainder(truth->pose().theta - stop.theta, 360)); }
+
+void runRoute() {
+    for (const Stop& stop : ROUTE) {
+        if (mode == 0) {
+            chassis.moveToPoint(stop.x, stop.y, MOTION_TIMEOUT_MS);
+        } else {
+            lemlib::MoveToPointProfiledParams params;
+            if (mode == 1) params.maxJerk = 0;
+            chassis.moveToPointProfiled(stop.x, stop.y, MOTION_TIMEOUT_MS, params);
+        }
+        chassis.waitUntilDone();
+        moveError.push_back(distanceTo(stop));
+
+        if (mode == 0) {
+            chassis.turnToHeading(stop.theta, MOTION_TIMEOUT_MS);
+        } else {
+            lemlib::TurnToHeadingProfiledParams params;
+            if (mode == 1) params.maxJerk = 0;
+            chassis.turnToHeadingProfiled(stop.theta, MOTION_TIMEOUT_MS, params);
+        }
+        chassis.waitUntilDone();
+        turnError.push_back(headingError(stop));
+    }
+}
+
+double mean(const std::vector<double>& values) { return values.empty() ? 0 : sim::stats(values).mean; }
+
+// Returns {seconds for the route, mean end error in, mean end error deg}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    static sim::Drivetrain robot(drivetrainConfig(index / MODE_COUNT));
+    truth = &robot;
+    if (!sim::run_task(calibrate, TIMEOUT_MS)) return {};
+    const std::uint32_t start = sim::now_ms();
+    if (!sim::run_task(runRoute, TIMEOUT_MS)) return {};
+    return {(sim::now_ms() - start) / 1000.0, mean(moveError), mean(turnError)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true;
+    double meanTime[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> time, moveEnd, turnEnd;
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 3) {
+                complete = false;
+                continue;
+            }
+            time.push_back(results[i][0]);
+            moveEnd.push_back(results[i][1]);
+            turnEnd.push_back(results[i][2]);
+        }
+        meanTime[m] = mean(time);
+        std::printf("%s, %zu runs of %zu moves and turns\n", MODES[m], time.size(), std::size(ROUTE));
+        std::printf("  route s:             %s\n", sim::to_string(sim::stats(time)).c_str());
+        std::printf("  move end error in:   %s\n", sim::to_string(sim::stats(moveEnd)).c_str());
+        std::printf("  turn end error deg:  %s\n", sim::to_string(sim::stats(turnEnd)).c_str());
+    }
+    std::printf("motion profile: %.2f s with PID, %.2f s trapezoid (%+.0f%%), %.2f s S-curve (%+.0f%%)\n", meanTime[0],
+                meanTime[1], 100 * (meanTime[1] / meanTime[0] - 1), meanTime[2],
+                100 * (meanTime[2] / meanTime[0] - 1));
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+// Drives main.cpp's chassis through a zig-zag of moves ending on a turn,
+// four ways: moveToPoint() waiting for each move to stop, moveToPoint() chained
+// with minSpeed and earlyExitRange, the same with a 1 in earlyExitRange so it
+// has to pass close to every point, and runQueue() on a MotionQueue, each time
+// with slightly different motors and traction. Reports how long the routine
+// takes, how close the robot gets to each point on the way and how far from
+// the last one it comes to rest.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_motion_queue        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_motion_queue 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/motionQueue.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"stop at each point", "minSpeed chaining", "motion queue", "tight minSpeed chaining"};
+constexpr int MODE_COUNT = 4;
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+constexpr int MOTION_TIMEOUT_MS = 3000;
+// the turn at the end hangs just outside the angular exit ranges, give it what an auton would
+constexpr int TURN_TIMEOUT_MS = 1000;
+constexpr float CHAIN_MIN_SPEED = 60;
+constexpr float CHAIN_EXIT_RANGE = 6;
+// small enough that chaining goes through the points, not past them
+constexpr float TIGHT_EXIT_RANGE = 1;
+
+struct Point {
+        float x;
+        float y;
+};
+
+const Point ROUTE[] = {{0, 24}, {18, 42}, {0, 60}, {18, 78}, {18, 96}};
+constexpr float END_HEADING = 270;
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    config.mass *= 1 + 0.03 * spread(rng);
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+lemlib::ControllerSettings linearController(10, 0, 3, 3, 1, 100, 3, 500, 20);
+lemlib::ControllerSettings angularController(2, 0, 12, 0, 0.5, 100, 3, 500, 0);
+lemlib::OdomSensors sensors(&vertical, nullptr, &horizontal, nullptr, &imu);
+lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors);
+lemlib::MotionQueue queue;
+
+sim::Drivetrain* truth = nullptr;
+int mode = 0;
+// closest the robot has come to each point
+double closest[std::size(ROUTE)];
+
+void calibrate() { chassis.calibrateOdom(); }
+
+void watch() {
+    while (true) {
+        for (std::size_t i = 0; i < std::size(ROUTE); i++) {
+            closest[i] = std::min(closest[i], std::hypot(truth->pose().x - ROUTE[i].x, truth->pose().y - ROUTE[i].y));
+        }
+        pros::delay(10);
+    }
+}
+
+void runRoute() {
+    pros::Task watcher(watch);
+    const std::size_t last = std::size(ROUTE) - 1;
+    for (std::size_t i = 0; i <= last; i++) {
+        if (mode == 0) {
+            chassis.moveToPoint(ROUTE[i].x, ROUTE[i].y, MOTION_TIMEOUT_MS);
+            chassis.waitUntilDone();
+        } else if (mode == 1 || mode == 3) {
+            lemlib::MoveToPointParams params;
+            const float exitRange = mode == 1 ? CHAIN_EXIT_RANGE : TIGHT_EXIT_RANGE;
+            if (i < last) params = {.minSpeed = CHAIN_MIN_SPEED, .earlyExitRange = exitRange};
+            chassis.moveToPoint(ROUTE[i].x, ROUTE[i].y, MOTION_TIMEOUT_MS, params);
+        } else {
+            queue.moveToPoint(ROUTE[i].x, ROUTE[i].y, MOTION_TIMEOUT_MS);
+        }
+    }
+    if (mode == 2) {
+        queue.turnToHeading(END_HEADING, TURN_TIMEOUT_MS);
+        chassis.runQueue(queue);
+    } else {
+        chassis.turnToHeading(END_HEADING, TURN_TIMEOUT_MS);
+    }
+    chassis.waitUntilDone();
+}
+
+double mean(const std::vector<double>& values) { return values.empty() ? 0 : sim::stats(values).mean; }
+
+// Returns {seconds for the route, worst miss of a point on the way in, end error in, end error deg}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    static sim::Drivetrain robot(drivetrainConfig(index / MODE_COUNT));
+    truth = &robot;
+    for (double& distance : closest) distance = INFINITY;
+    if (!sim::run_task(calibrate, TIMEOUT_MS)) return {};
+    const std::uint32_t start = sim::now_ms();
+    if (!sim::run_task(runRoute, TIMEOUT_MS)) return {};
+
+    double miss = 0;
+    for (std::size_t i = 0; i + 1 < std::size(ROUTE); i++) miss = std::max(miss, closest[i]);
+    const Point& end = ROUTE[std::size(ROUTE) - 1];
+    return {(sim::now_ms() - start) / 1000.0, miss, std::hypot(robot.pose().x - end.x, robot.pose().y - end.y),
+            std::abs(std::remainder(robot.pose().theta - END_HEADING, 360))};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true;
+    double meanTime[MODE_COUNT] = {};
+    double meanMiss[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> time, miss, endError, headingError;
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 4) {
+                complete = false;
+                continue;
+            }
+            time.push_back(results[i][0]);
+            miss.push_back(results[i][1]);
+            endError.push_back(results[i][2]);
+            headingError.push_back(results[i][3]);
+        }
+        meanTime[m] = mean(time);
+        meanMiss[m] = mean(miss);
+        std::printf("%s, %zu runs of %zu moves and a turn\n", MODES[m], time.size(), std::size(ROUTE));
+        std::printf("  route s:             %s\n", sim::to_string(sim::stats(time)).c_str());
+        std::printf("  worst point miss in: %s\n", sim::to_string(sim::stats(miss)).c_str());
+        std::printf("  end error in:        %s\n", sim::to_string(sim::stats(endError)).c_str());
+        std::printf("  end error deg:       %s\n", sim::to_string(sim::stats(headingError)).c_str());
+    }
+    std::printf("motion queue: %.2f s stopping at each point, %.2f s minSpeed chaining (%+.0f%%), %.2f s queued "
+                "(%+.0f%%)\n",
+                meanTime[0], meanTime[1], 100 * (meanTime[1] / meanTime[0] - 1), meanTime[2],
+                100 * (meanTime[2] / meanTime[0] - 1));
+    // chaining is only faster by cutting the corners, held to the points it is slower than the queue
+    std::printf("motion queue: worst miss %.2f in stopping, %.2f in chaining, %.2f in tight chaining in %.2f s, "
+                "%.2f in queued in %.2f s (%+.0f%% on tight chaining)\n",
+                meanMiss[0], meanMiss[1], meanMiss[3], meanTime[3], meanMiss[2], meanTime[2],
+                100 * (meanTime[2] / meanTime[3] - 1));
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// Drives main.cpp's chassis hard around the field open loop, spins and sharp
+// arcs at the drivetrain's full 450 rpm, with LemLib odometry running every
+// 10 ms like the prebuilt archive and every 5 ms with the sensors sending data
+// just as often. Reports how far the odometry pose ends up from the true one
+// once the robot has stopped, and how far a read during the run is off, both
+// straight from getPose() and looked ahead to now with estimatePose(0).
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_odom_drift         a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_odom_drift 200     more runs per period
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 12;
+constexpr std::uint32_t PERIODS[] = {10, 5}; // ms
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+
+// left power, right power, ms
+struct Leg {
+        int left;
+        int right;
+        std::uint32_t ms;
+};
+
+const Leg ROUTE[] = {
+    {127, 127, 800}, {127, 40, 900}, {127, -127, 700}, {127, 127, 600}, {-30, 127, 800},
+    {-127, -127, 500}, {-127, 127, 900}, {127, 90, 1200}, {60, 127, 700}, {0, 0, 600},
+};
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    return config;
+}
+
+double distance(const lemlib::Pose& pose, const sim::Pose& truth) {
+    return std::hypot(pose.x - truth.x, pose.y - truth.y);
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+
+sim::Drivetrain* truth = nullptr;
+std::uint32_t period = 0;
+double readError = 0;
+double estimateError = 0;
+int reads = 0;
+
+// what Chassis::calibrateOdom() does, the right side stands in for the missing second vertical wheel
+void calibrate() {
+    imu.reset(true);
+    static lemlib::TrackingWheel rightWheel(&rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                                            drivetrain.rpm);
+    vertical.reset();
+    rightWheel.reset();
+    horizontal.reset();
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, &rightWheel, &horizontal, nullptr, &imu), drivetrain);
+    lemlib::setUpdatePeriod(period);
+    lemlib::init();
+    pros::delay(50);
+}
+
+void drive() {
+    for (const Leg& leg : ROUTE) {
+        leftMotors.move(leg.left);
+        rightMotors.move(leg.right);
+        // read on a 1 ms grid, like a control loop that isn't in step with odometry
+        for (std::uint32_t t = 0; t < leg.ms; t++) {
+            pros::delay(1);
+            readError += distance(lemlib::getPose(), truth->pose());
+            estimateError += distance(lemlib::estimatePose(0), truth->pose());
+            reads++;
+        }
+    }
+    leftMotors.brake();
+    rightMotors.brake();
+    pros::delay(500);
+}
+
+// Returns {period, end error in, end error deg, mean getPose error in, mean estimatePose error in}
+std::vector<double> trial(int index) {
+    period = PERIODS[index % 2];
+    static sim::Drivetrain drivetrain(drivetrainConfig(index / 2));
+    truth = &drivetrain;
+    // the sensors start sending whenever they finish booting, so at a different point in each run
+    std::mt19937 rng(index / 2);
+    for (std::uint32_t* phase : {&sim::imu(15).data_phase, &sim::rotation(1).data_phase, &sim::rotation(13).data_phase})
+        *phase = rng() % 1000;
+    if (!sim::run_task(calibrate, TIMEOUT_MS) || !sim::run_task(drive, TIMEOUT_MS)) return {};
+
+    const lemlib::Pose end = lemlib::getPose();
+    const double headingError = std::remainder(end.theta - truth->pose().theta, 360);
+    return {double(period), distance(end, truth->pose()), std::abs(headingError), readError / reads,
+            estimateError / reads};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perPeriod = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perPeriod = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, 2 * perPeriod, trial);
+
+    bool complete = true;
+    double meanEnd[2] = {};
+    for (int p = 0; p < 2; p++) {
+        std::vector<double> endError, headingError, readError, estimateError;
+        for (int i = p; i < 2 * perPeriod; i += 2) {
+            if (results[i].size() != 5) {
+                complete = false;
+                continue;
+            }
+            endError.push_back(results[i][1]);
+            headingError.push_back(results[i][2]);
+            readError.push_back(results[i][3]);
+            estimateError.push_back(results[i][4]);
+        }
+        meanEnd[p] = sim::stats(endError).mean;
+        std::printf("odometry every %u ms, %zu runs\n", PERIODS[p], endError.size());
+        std::printf("  end error in:        %s\n", sim::to_string(sim::stats(endError)).c_str());
+        std::printf("  end error deg:       %s\n", sim::to_string(sim::stats(headingError)).c_str());
+        std::printf("  getPose() error in:  %s\n", sim::to_string(sim::stats(readError)).c_str());
+        std::printf("  estimatePose(0) in:  %s\n", sim::to_string(sim::stats(estimateError)).c_str());
+    }
+    std::printf("odom drift: %.2f in at %u ms, %.2f in at %u ms\n", meanEnd[0], PERIODS[0], meanEnd[1], PERIODS[1]);
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Checks that the binary path assets packed by firmware/pathAsset.py hold the
+// same points as the text paths, that broken assets are turned away, and times
+// parsing the text the way LemLib's follow() does against opening the binary
+// asset in place.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "lemlib/asset.hpp"
+#include "lemlib/pathAsset.hpp"
+
+ASSET(example_txt);
+ASSET(example_path);
+ASSET(red_negative_txt);
+ASSET(red_negative_path);
+
+namespace {
+
+constexpr int REPEATS = 2000;
+
+std::vector<std::string> split(const std::string& input, const std::string& delimiter) {
+    std::vector<std::string> output;
+    std::size_t start = 0;
+    std::size_t end;
+    while ((end = input.find(delimiter, start)) != std::string::npos) {
+        output.push_back(input.substr(start, end - start));
+        start = end + delimiter.size();
+    }
+    output.push_back(input.substr(start));
+    return output;
+}
+
+// what the text follow() does before its first cycle
+std::vector<lemlib::PathPoint> parseText(const asset& path) {
+    std::vector<lemlib::PathPoint> points;
+    const std::string data(reinterpret_cast<char*>(path.buf), path.size);
+    for (const std::string& line : split(data, "\n")) {
+        if (line == "endData" || line == "endData\r") break;
+        const std::vector<std::string> fields = split(line, ", ");
+        points.push_back({std::stof(fields.at(0)), std::stof(fields.at(1)), std::stof(fields.at(2)), 0});
+    }
+    return points;
+}
+
+template <typename F> double nsPerCall(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEATS; i++) f();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / REPEATS;
+}
+
+bool check(const char* name, const asset& text, const asset& binary) {
+    const std::vector<lemlib::PathPoint> expected = parseText(text);
+    const lemlib::PathAsset path(binary);
+    bool same = path.isValid() && path.size() == expected.size();
+    double length = 0;
+    for (std::size_t i = 0; same && i < expected.size(); i++) {
+        if (i > 0) length += std::hypot(expected[i].x - expected[i - 1].x, expected[i].y - expected[i - 1].y);
+        same = path[i].x == expected[i].x && path[i].y == expected[i].y && path[i].speed == expected[i].speed &&
+               std::fabs(path[i].distance - length) < 0.01;
+    }
+    same = same && std::fabs(path.length() - length) < 0.01;
+    // every segment inside the box it belongs to
+    const std::size_t step = path.boxPoints() - 1;
+    for (std::size_t i = 0; same && i < expected.size(); i++) {
+        for (std::size_t b : {i / step, i > 0 ? (i - 1) / step : 0}) {
+            const lemlib::PathBox& box = path.box(b);
+            same = same && b < path.boxCount() && box.minX <= path[i].x && path[i].x <= box.maxX &&
+                   box.minY <= path[i].y && path[i].y <= box.maxY;
+        }
+    }
+
+    volatile std::size_t sink = 0;
+    const double textNs = nsPerCall([&] { sink = sink + parseText(text).size(); });
+    const double binaryNs = nsPerCall([&] { sink = sink + lemlib::PathAsset(binary).size(); });
+    std::printf("%-13s %4zu points, %6.1f in, %s: text parse %8.0f ns, binary open %4.0f ns (%zu -> %zu bytes)\n",
+                name, expected.size(), path.length(), same ? "same points" : "MISMATCH", textNs, binaryNs, text.size,
+                binary.size);
+    return same;
+}
+
+// corrupt copies of a good asset that must all come out empty
+bool rejectsBroken(const asset& good) {
+    alignas(8) static std::uint8_t copy[4096];
+    if (good.size + 1 > sizeof(copy)) return false;
+    bool ok = true;
+    auto rejected = [&](const char* what, std::uint8_t* buf, std::size_t size) {
+        const lemlib::PathAsset path(asset {buf, size});
+        if (path.isValid() || path.size() != 0) {
+            std::printf("accepted a %s asset\n", what);
+            ok = false;
+        }
+    };
+    std::memcpy(copy, good.buf, good.size);
+    copy[0] = 'X';
+    rejected("bad magic", copy, good.size);
+    std::memcpy(copy, good.buf, good.size);
+    copy[4] = lemlib::PathAsset::VERSION + 1;
+    rejected("newer version", copy, good.size);
+    std::memcpy(copy, good.buf, good.size);
+    rejected("truncated", copy, good.size - 1);
+    std::memcpy(copy, good.buf, good.size);
+    reinterpret_cast<lemlib::PathHeader*>(copy)->boxCount = 1;
+    rejected("too few boxes", copy, good.size);
+    std::memcpy(copy + 1, good.buf, good.size);
+    rejected("misaligned", copy + 1, good.size);
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = check("example", example_txt, example_path);
+    ok = check("red_negative", red_negative_txt, red_negative_path) && ok;
+    ok = rejectsBroken(red_negative_path) && ok;
+    return ok ? 0 : 1;
+}
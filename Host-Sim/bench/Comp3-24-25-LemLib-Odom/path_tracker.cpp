@@ -0,0 +1,171 @@
+// Per control cycle cost of finding the closest and lookahead points, for
+// LemLib's whole-path scan and for lemlib::PathTracker, on paths from a short
+// auton up to far longer than a skills run. Also checks the two pick the same
+// lookahead point while the robot is on the path.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "lemlib/pathAsset.hpp"
+#include "lemlib/pathTracker.hpp"
+
+namespace {
+
+constexpr float SPACING = 0.5;     // in between points, 50 in/s at one point per cycle
+constexpr float LOOKAHEAD = 15;    // in
+constexpr float OFFSET = 1;        // in the robot is off to the side of the path
+constexpr int SCAN_CYCLES = 2000;  // the scan is too slow to run a whole long path
+
+struct Packed {
+    std::vector<std::uint64_t> storage; // 8 byte aligned, like the linker puts it
+    asset data;
+};
+
+// same layout as firmware/pathAsset.py
+Packed pack(const std::vector<lemlib::PathPoint>& points) {
+    constexpr std::uint16_t BOX_POINTS = 16;
+    std::vector<lemlib::PathBox> boxes;
+    for (std::size_t first = 0; first + 1 < points.size(); first += BOX_POINTS - 1) {
+        lemlib::PathBox box = {INFINITY, INFINITY, -INFINITY, -INFINITY};
+        for (std::size_t i = first; i < std::min(points.size(), first + BOX_POINTS); i++) {
+            box = {std::min(box.minX, points[i].x), std::min(box.minY, points[i].y), std::max(box.maxX, points[i].x),
+                   std::max(box.maxY, points[i].y)};
+        }
+        boxes.push_back(box);
+    }
+    lemlib::PathHeader header = {{'L', 'L', 'P', 'B'},
+                                 lemlib::PathAsset::VERSION,
+                                 sizeof(lemlib::PathPoint),
+                                 std::uint32_t(points.size()),
+                                 points.back().distance,
+                                 BOX_POINTS,
+                                 sizeof(lemlib::PathBox),
+                                 std::uint32_t(boxes.size())};
+    const std::size_t size =
+        sizeof(header) + points.size() * sizeof(lemlib::PathPoint) + boxes.size() * sizeof(lemlib::PathBox);
+    Packed packed;
+    packed.storage.resize(size / 8 + 1);
+    std::uint8_t* buf = reinterpret_cast<std::uint8_t*>(packed.storage.data());
+    std::memcpy(buf, &header, sizeof(header));
+    std::memcpy(buf + sizeof(header), points.data(), points.size() * sizeof(lemlib::PathPoint));
+    std::memcpy(buf + sizeof(header) + points.size() * sizeof(lemlib::PathPoint), boxes.data(),
+                boxes.size() * sizeof(lemlib::PathBox));
+    packed.data = {buf, size};
+    return packed;
+}
+
+// weaves back and forth across the field like a skills run, never crossing itself
+std::vector<lemlib::PathPoint> weave(std::size_t count) {
+    std::vector<lemlib::PathPoint> points;
+    float distance = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const float s = i * SPACING;
+        const lemlib::PathPoint point = {s, 24 * std::sin(s / 20), i + 1 < count ? 100.0f : 0.0f, 0};
+        if (i > 0) distance += std::hypot(point.x - points.back().x, point.y - points.back().y);
+        points.push_back(point);
+        points.back().distance = distance;
+    }
+    return points;
+}
+
+// LemLib's follow(): closest point over the whole path, then the first crossing
+// from the closest or last lookahead point to the end
+struct Scan {
+        const lemlib::PathAsset& path;
+        std::size_t closest = 0;
+        std::size_t lookaheadSegment = 0;
+        float lookaheadX = 0;
+        float lookaheadY = 0;
+
+        void update(float x, float y) {
+            float closestDist = INFINITY;
+            for (std::size_t i = 0; i < path.size(); i++) {
+                const float dist = std::hypot(path[i].x - x, path[i].y - y);
+                if (dist < closestDist) {
+                    closestDist = dist;
+                    closest = i;
+                }
+            }
+            for (std::size_t i = std::max(closest, lookaheadSegment); i + 1 < path.size(); i++) {
+                const float dx = path[i + 1].x - path[i].x, dy = path[i + 1].y - path[i].y;
+                const float fx = path[i].x - x, fy = path[i].y - y;
+                const float a = dx * dx + dy * dy, b = 2 * (fx * dx + fy * dy);
+                const float c = fx * fx + fy * fy - LOOKAHEAD * LOOKAHEAD;
+                float discriminant = b * b - 4 * a * c;
+                if (discriminant < 0) continue;
+                discriminant = std::sqrt(discriminant);
+                const float t1 = (-b - discriminant) / (2 * a), t2 = (-b + discriminant) / (2 * a);
+                const float t = t2 >= 0 && t2 <= 1 ? t2 : t1 >= 0 && t1 <= 1 ? t1 : -1;
+                if (t < 0) continue;
+                lookaheadX = path[i].x + dx * t;
+                lookaheadY = path[i].y + dy * t;
+                lookaheadSegment = i;
+                return;
+            }
+        }
+};
+
+// robot for a cycle, riding alongside the path
+void robotAt(const lemlib::PathAsset& path, std::size_t cycle, float& x, float& y) {
+    const std::size_t i = std::min(cycle, path.size() - 1);
+    x = path[i].x;
+    y = path[i].y + OFFSET;
+}
+
+template <typename Tracker> double nsPerCycle(Tracker& tracker, const lemlib::PathAsset& path, std::size_t cycles) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t cycle = 0; cycle < cycles; cycle++) {
+        float x, y;
+        robotAt(path, cycle, x, y);
+        tracker.update(x, y);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / cycles;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = true;
+    double smallest = 0;
+    double largest = 0;
+    std::printf("%8s %9s %14s %16s %10s\n", "points", "length", "scan ns/cycle", "tracker ns/cycle", "mismatches");
+    for (std::size_t count : {100, 1000, 5000, 20000, 100000}) {
+        const std::vector<lemlib::PathPoint> points = weave(count);
+        const Packed packed = pack(points);
+        const lemlib::PathAsset path(packed.data);
+        if (!path.isValid()) {
+            std::printf("packed path was not valid\n");
+            return 1;
+        }
+
+        // agree cycle by cycle on the stretch both run
+        Scan scan {path};
+        lemlib::PathTracker tracker(path, LOOKAHEAD);
+        int mismatches = 0;
+        for (std::size_t cycle = 0; cycle < std::min<std::size_t>(count, SCAN_CYCLES); cycle++) {
+            float x, y;
+            robotAt(path, cycle, x, y);
+            scan.update(x, y);
+            tracker.update(x, y);
+            const bool same = scan.closest == tracker.getClosest() &&
+                              std::hypot(scan.lookaheadX - tracker.getLookahead().x,
+                                         scan.lookaheadY - tracker.getLookahead().y) < 1e-3;
+            mismatches += !same;
+        }
+        ok = ok && mismatches == 0;
+
+        Scan timedScan {path};
+        const double scanNs = nsPerCycle(timedScan, path, std::min<std::size_t>(count, SCAN_CYCLES));
+        lemlib::PathTracker timedTracker(path, LOOKAHEAD);
+        const double trackerNs = nsPerCycle(timedTracker, path, count);
+        if (smallest == 0) smallest = trackerNs;
+        largest = trackerNs;
+        std::printf("%8zu %7.0f in %14.0f %16.0f %10d\n", count, path.length(), scanNs, trackerNs, mismatches);
+    }
+    // the tracker should not care how long the path is
+    std::printf("tracker cost, longest / shortest path: %.2fx\n", largest / smallest);
+    return ok && largest < 4 * smallest ? 0 : 1;
+}
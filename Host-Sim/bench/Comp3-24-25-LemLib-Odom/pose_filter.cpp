@@ -0,0 +1,190 @@
+// Drives main.cpp's chassis through hard starts, stops and spins, the kind of
+// driving that makes the drive wheels spin out, and knocks both tracking
+// wheels off the ground for a moment a few times on the way, like riding over
+// a ring or being hit. Runs it with LemLib's dead reckoning and with the pose
+// filter, and reports how far each ends up from the true pose. Then times one
+// filter update on the host.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_pose_filter        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_pose_filter 200    more runs
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/poseFilter.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 12;
+constexpr const char* MODES[] = {"dead reckoning", "pose filter"};
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+constexpr int TIMED = 200000;
+
+// left power, right power, ms
+struct Leg {
+        int left;
+        int right;
+        std::uint32_t ms;
+};
+
+const Leg ROUTE[] = {
+    {127, 127, 600}, {-127, -127, 500}, {127, -127, 500}, {127, 127, 700}, {-127, 127, 400},
+    {127, 60, 800}, {-127, -127, 600}, {127, 127, 500}, {0, 0, 600},
+};
+
+// rotation sensor port, ms into the route, degrees the wheel spins while off the ground
+struct Bump {
+        int port;
+        std::uint32_t at;
+        double degrees;
+};
+
+const Bump BUMPS[] = {{13, 700, 250}, {1, 1400, -180}, {13, 2600, -300}, {1, 3600, 220}};
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    config.imu_scale = 1 + 0.003 * spread(rng);
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+
+bool filtered = false;
+
+// what Chassis::calibrateOdom() does, the right side stands in for the missing second vertical wheel
+void calibrate() {
+    imu.reset(true);
+    static lemlib::TrackingWheel rightWheel(&rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                                            drivetrain.rpm);
+    vertical.reset();
+    rightWheel.reset();
+    horizontal.reset();
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, &rightWheel, &horizontal, nullptr, &imu), drivetrain);
+    if (filtered) lemlib::usePoseFilter();
+    lemlib::init();
+    pros::delay(50);
+}
+
+void drive() {
+    const std::uint32_t start = sim::now_ms();
+    const Bump* bump = BUMPS;
+    for (const Leg& leg : ROUTE) {
+        leftMotors.move(leg.left);
+        rightMotors.move(leg.right);
+        const std::uint32_t end = sim::now_ms() + leg.ms;
+        while (sim::now_ms() < end) {
+            if (bump != std::end(BUMPS) && sim::now_ms() - start >= bump->at) {
+                sim::rotation(bump->port).angle += bump->degrees;
+                bump++;
+            }
+            pros::delay(1);
+        }
+    }
+    leftMotors.brake();
+    rightMotors.brake();
+    pros::delay(500);
+}
+
+// Returns {mode, end error in, end error deg, readings thrown out}
+std::vector<double> trial(int index) {
+    filtered = index % 2 == 1;
+    static sim::Drivetrain truth(drivetrainConfig(index / 2));
+    // the sensors start sending whenever they finish booting, so at a different point in each run
+    std::mt19937 rng(index / 2);
+    for (std::uint32_t* phase : {&sim::imu(15).data_phase, &sim::rotation(1).data_phase, &sim::rotation(13).data_phase})
+        *phase = rng() % 1000;
+    if (!sim::run_task(calibrate, TIMEOUT_MS) || !sim::run_task(drive, TIMEOUT_MS)) return {};
+
+    const lemlib::Pose end = lemlib::getPose();
+    const double headingError = std::remainder(end.theta - truth.pose().theta, 360);
+    return {double(filtered), std::hypot(end.x - truth.pose().x, end.y - truth.pose().y), std::abs(headingError),
+            double(lemlib::getRejectedReadings())};
+}
+
+// one odometry update's worth of filter work: predict, two tracking wheels, two drive sides and the IMU
+double nsPerUpdate() {
+    lemlib::PoseFilter filter;
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0, 1);
+    float theta = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TIMED; i++) {
+        const float turn = 2 * std::sin(i * 0.001f);
+        theta += turn * 0.005f;
+        filter.predict(0.005);
+        filter.measureVertical(40 + turn + noise(rng), -1, 0.5);
+        filter.measureHorizontal(-6 * turn + noise(rng), -6, 0.5);
+        filter.measureVertical(40 + 6.75f * turn + noise(rng), -6.75, 4);
+        filter.measureVertical(40 - 6.75f * turn + noise(rng), 6.75, 4);
+        filter.measureHeading(theta);
+        filter.measureTurnRate(turn);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return filter.getPose().x == 12345 ? 0 : ns / TIMED; // keeps the filter from being optimised out
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, 2 * perMode, trial);
+
+    bool complete = true;
+    double meanEnd[2] = {};
+    for (int m = 0; m < 2; m++) {
+        std::vector<double> endError, headingError, rejected;
+        for (int i = m; i < 2 * perMode; i += 2) {
+            if (results[i].size() != 4) {
+                complete = false;
+                continue;
+            }
+            endError.push_back(results[i][1]);
+            headingError.push_back(results[i][2]);
+            rejected.push_back(results[i][3]);
+        }
+        meanEnd[m] = sim::stats(endError).mean;
+        std::printf("%s, %zu runs\n", MODES[m], endError.size());
+        std::printf("  end error in:        %s\n", sim::to_string(sim::stats(endError)).c_str());
+        std::printf("  end error deg:       %s\n", sim::to_string(sim::stats(headingError)).c_str());
+        if (m == 1) std::printf("  readings left out:   %s\n", sim::to_string(sim::stats(rejected), 0).c_str());
+    }
+    std::printf("pose filter: %.2f in dead reckoning, %.2f in filtered, %.0f ns per update on this host\n",
+                meanEnd[0], meanEnd[1], nsPerUpdate());
+    return complete ? 0 : 1;
+}
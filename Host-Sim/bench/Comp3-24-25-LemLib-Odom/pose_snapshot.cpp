@@ -0,0 +1,125 @@
+// Publishes odometry states through lemlib::Snapshot from one thread while
+// others read them on real threads, checking every read is one whole update
+// and never goes back in time. Then times a read against copying the state
+// under a mutex, with the writer going as fast as it can.
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/snapshot.hpp"
+
+namespace {
+
+constexpr int READERS = 3;
+constexpr auto STRESS_TIME = std::chrono::seconds(1);
+constexpr int TIMED = 1000000;
+
+using Clock = std::chrono::steady_clock;
+
+// every field follows from the update number, so a read mixing two updates shows
+lemlib::OdomState state(std::uint32_t update) {
+    const float f = float(update % 1000000);
+    lemlib::OdomState state;
+    state.pose = lemlib::Pose(f, -f, 2 * f);
+    state.speed = lemlib::Pose(f + 1, f + 2, f + 3);
+    state.localSpeed = lemlib::Pose(-f - 1, -f - 2, -f - 3);
+    state.time = update;
+    return state;
+}
+
+bool same(const lemlib::Pose& a, const lemlib::Pose& b) { return a.x == b.x && a.y == b.y && a.theta == b.theta; }
+
+bool whole(const lemlib::OdomState& read) {
+    const lemlib::OdomState expected = state(std::uint32_t(read.time));
+    return same(read.pose, expected.pose) && same(read.speed, expected.speed) &&
+           same(read.localSpeed, expected.localSpeed);
+}
+
+struct Result {
+        std::uint32_t updates = 0;
+        long reads = 0;
+        long torn = 0;
+        long backwards = 0;
+};
+
+Result stress() {
+    lemlib::Snapshot<lemlib::OdomState> snapshot(state(0));
+    std::atomic<bool> done = false;
+    std::vector<Result> results(READERS);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) {
+        readers.emplace_back([&, r] {
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const lemlib::OdomState read = snapshot.load();
+                results[r].reads++;
+                if (!whole(read)) results[r].torn++;
+                if (read.time < last) results[r].backwards++;
+                last = read.time;
+            }
+        });
+    }
+    Result total;
+    const auto start = Clock::now();
+    while (Clock::now() - start < STRESS_TIME) {
+        snapshot.store(state(++total.updates));
+        if (total.updates % 64 == 0) std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    for (const Result& result : results) {
+        total.reads += result.reads;
+        total.torn += result.torn;
+        total.backwards += result.backwards;
+    }
+    return total;
+}
+
+template <typename Read> double nsPerRead(Read&& read) {
+    std::atomic<bool> done = false;
+    std::thread writer([&] {
+        for (std::uint32_t update = 0; !done.load(std::memory_order_relaxed); update++) read.store(state(update));
+    });
+    std::uint64_t sum = 0;
+    const auto start = Clock::now();
+    for (int i = 0; i < TIMED; i++) sum += read.load().time;
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / TIMED;
+    done = true;
+    writer.join();
+    return sum == 1 ? 0 : ns; // keeps the reads from being optimised out
+}
+
+struct Locked {
+        std::mutex mutex;
+        lemlib::OdomState value;
+
+        void store(const lemlib::OdomState& next) {
+            std::lock_guard<std::mutex> lock(mutex);
+            value = next;
+        }
+
+        lemlib::OdomState load() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return value;
+        }
+};
+
+} // namespace
+
+int main() {
+    const Result result = stress();
+    std::printf("stress: %u updates, %d readers, %ld reads, %ld torn, %ld went back in time\n", result.updates,
+                READERS, result.reads, result.torn, result.backwards);
+
+    lemlib::Snapshot<lemlib::OdomState> snapshot(state(0));
+    Locked locked;
+    const double snapshotNs = nsPerRead(snapshot);
+    const double lockedNs = nsPerRead(locked);
+    std::printf("state read while publishing: Snapshot %.1f ns, mutex %.1f ns\n", snapshotNs, lockedNs);
+    return result.torn == 0 && result.backwards == 0 ? 0 : 1;
+}
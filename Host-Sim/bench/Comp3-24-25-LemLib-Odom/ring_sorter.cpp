@@ -0,0 +1,119 @@
+// Feeds a stream of red and blue rings past the color sort, some of them back
+// to back, and checks that every blue ring is thrown within 10 ms of reaching
+// the top of the hooks and no red ring is. Also checks that a calibration fit
+// on noisy samples lands its bands on the ring colors.
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "pros/motors.hpp"
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "ringSorter.hpp"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+
+constexpr int HOOK_PORT = 5;
+constexpr int SENSOR_PORT = 2;
+constexpr double TRAVEL = 250;      // deg, sensor to top
+constexpr double RING_WIDTH = 30;   // deg of hook travel a ring spends in front of the sensor
+constexpr int EJECT_POWER = -127;   // distinct from the intake power so the bench can see it
+
+struct FeedRing {
+    double enteredAt; // hook position when it reaches the sensor
+    bool blue;
+    std::uint32_t topAt = 0;
+};
+
+pros::Motor hooks(-HOOK_PORT);
+pros::Optical sensor(SENSOR_PORT);
+RingSorter sorter(sensor, hooks, {150, TRAVEL, EJECT_POWER, 100, 0});
+
+// spacing of 40 deg is as close as two rings fit on the hooks
+std::vector<FeedRing> feed = {
+    {100, false}, {140, true}, {180, true}, {220, false}, {500, true}, {540, false},
+    {900, true}, {1300, false}, {1340, true}, {1380, false}, {1420, true}, {1800, true},
+};
+std::vector<std::uint32_t> ejects;
+bool ejectingLast = false;
+
+void plant(std::uint32_t now, double) {
+    const double position = hooks.get_position();
+    sim::Optical& optical = sim::optical(SENSOR_PORT);
+    // the grey hooks behind the sensor are washed out, whatever their hue
+    optical.proximity = 20;
+    optical.hue = 120;
+    optical.saturation = 0.1;
+    for (auto& ring : feed) {
+        if (position >= ring.enteredAt && position < ring.enteredAt + RING_WIDTH) {
+            optical.proximity = 230;
+            optical.hue = ring.blue ? 215 : 8;
+            optical.saturation = 0.6;
+        }
+        if (ring.topAt == 0 && position >= ring.enteredAt + TRAVEL) ring.topAt = now;
+    }
+    const bool ejecting = sim::motor(HOOK_PORT).target_voltage < 0;
+    if (ejecting && !ejectingLast) ejects.push_back(now);
+    ejectingLast = ejecting;
+}
+
+void run() {
+    sorter.setRedTeam(true);
+    sorter.setEnabled(true);
+    pros::Task task([] { sorter.run(); });
+    sorter.setIntake(127);
+    while (hooks.get_position() < feed.back().enteredAt + TRAVEL + 100) pros::delay(10);
+    sorter.setIntake(0);
+}
+
+}  // namespace
+
+// red straddles 0 deg of hue, which the fit has to average around
+bool fitLandsOnRings() {
+    std::vector<RingClassifier::Sample> samples;
+    for (int i = 0; i < 40; i++) {
+        const double noise = std::sin(i * 1.7) * 6;
+        samples.push_back({RingColor::RED, std::fmod(360 + 2 + noise, 360), 0.55 + noise / 100, 230, 0});
+        samples.push_back({RingColor::BLUE, 220 + noise, 0.65 + noise / 100, 230, 0});
+    }
+    const RingClassifier classifier(RingClassifier::fit(samples, {}));
+    const auto& fitted = classifier.getSettings();
+    std::printf("ring color fit: red %.1f+-%.1f, blue %.1f+-%.1f, min saturation %.2f, width %.2f\n",
+                fitted.red.hue, fitted.red.spread, fitted.blue.hue, fitted.blue.spread, fitted.minSaturation,
+                fitted.width);
+    return classifier.classify(358, 0.6) == RingColor::RED && classifier.classify(215, 0.6) == RingColor::BLUE &&
+           classifier.classify(120, 0.6) == RingColor::NONE && classifier.classify(215, 0.1) == RingColor::NONE;
+}
+
+int main() {
+    sim::plant_add(plant);
+    const bool finished = sim::run_task(run, 30000);
+
+    int thrown = 0;
+    int missed = 0;
+    int wrong = 0;
+    double worst = 0;
+    std::size_t next = 0;
+    for (const auto& ring : feed) {
+        if (!ring.blue) {
+            if (next < ejects.size() && ejects[next] == ring.topAt) wrong++;
+            continue;
+        }
+        while (next < ejects.size() && ejects[next] + 20 < ring.topAt) next++;
+        if (next < ejects.size() && std::abs(double(ejects[next]) - ring.topAt) <= 20) {
+            worst = std::max(worst, std::abs(double(ejects[next]) - ring.topAt));
+            thrown++;
+            next++;
+        } else {
+            missed++;
+        }
+    }
+    int blue = 0;
+    for (const auto& ring : feed) blue += ring.blue;
+    std::printf("ring sort: %d/%d blue rings thrown, %d missed, %d red thrown, %zu ejects, worst timing %.0f ms\n",
+                thrown, blue, missed, wrong, ejects.size(), worst);
+    const bool fit = fitLandsOnRings();
+    return fit && finished && missed == 0 && wrong == 0 && int(ejects.size()) <= blue && worst <= 10 ? 0 : 1;
+}
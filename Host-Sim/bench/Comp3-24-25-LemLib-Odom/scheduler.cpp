@@ -0,0 +1,190 @@
+// Drives main.cpp's chassis around open loop with odometry, the ring sort, the
+// macro engine and the screen all running, two ways: each in its own task with
+// its own delay loop like main.cpp used to start them, each task starting a
+// few ms apart, and as jobs on main.cpp's ControlScheduler. A macro step reads
+// the pose every time the engine runs it. Reports how old that pose is, which
+// with separate tasks depends on how far apart they happened to start, how
+// many context switches a second the jobs cost, and for the scheduler the job
+// runs and deadline misses it reports.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_scheduler        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_scheduler 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "controlScheduler.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "macroEngine.hpp"
+#include "pros/imu.hpp"
+#include "pros/llemu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "ringSorter.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"separate tasks", "scheduler"};
+constexpr int MODE_COUNT = 2;
+constexpr std::uint32_t RUN_MS = 5000;
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+
+// Same ports and wheels as main.cpp
+sim::DrivetrainConfig drivetrainConfig() {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+pros::Motor intakeHigh(-5);
+pros::Optical colorsort(2);
+RingSorter ringSorter(colorsort, intakeHigh, {150, 250, 0, 200, 0});
+MacroEngine macros;
+ControlScheduler scheduler;
+
+int mode = 0;
+std::uint32_t stagger[3] = {}; // ms each task starts after the last
+std::vector<double> poseAge; // ms, every time the macro step read the pose
+
+// a macro that never finishes, checking the pose each time the engine runs it
+const Macro watchPose(HOOKS, {
+    {{}, [] {
+         poseAge.push_back((pros::micros() - lemlib::getPoseTime()) / 1000.0);
+         return false;
+     }, 0},
+});
+
+void screen() {
+    const lemlib::Pose pose = lemlib::getPose();
+    pros::lcd::print(0, "X: %f", pose.x);
+    pros::lcd::print(1, "Y: %f", pose.y);
+    pros::lcd::print(2, "Theta: %f", pose.theta);
+    pros::lcd::print(3, "Rotation Sensor: %i", verticalEnc.get_position());
+}
+
+// main.cpp's initialize() before the scheduler, and with it
+void initialize() {
+    imu.reset(true);
+    static lemlib::TrackingWheel rightWheel(&rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                                            drivetrain.rpm);
+    vertical.reset();
+    rightWheel.reset();
+    horizontal.reset();
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, &rightWheel, &horizontal, nullptr, &imu), drivetrain);
+    if (mode == 0) {
+        lemlib::init();
+        pros::delay(stagger[0]);
+        pros::Task sortTask([] { ringSorter.run(); });
+        pros::delay(stagger[1]);
+        pros::Task macroTask([] { macros.run(); });
+        pros::delay(stagger[2]);
+        pros::Task screenTask([] {
+            while (true) {
+                screen();
+                pros::delay(50);
+            }
+        });
+    } else {
+        lemlib::setUpdateTask(false);
+        lemlib::init();
+        scheduler.add("odometry", Stage::SENSE, 5, [](std::uint32_t) { lemlib::update(); });
+        scheduler.add("ring sorter", Stage::COMPUTE, RingSorter::PERIOD,
+                      [](std::uint32_t now) { ringSorter.step(now); });
+        scheduler.add("macros", Stage::ACTUATE, 10, [](std::uint32_t now) { macros.update(now); });
+        scheduler.add("screen", Stage::DISPLAY, 50, [](std::uint32_t) { screen(); });
+        pros::Task schedulerTask([] { scheduler.run(); }, TASK_PRIORITY_DEFAULT + 2);
+    }
+    pros::delay(50);
+}
+
+void drive() {
+    macros.start(watchPose);
+    leftMotors.move(127);
+    rightMotors.move(60);
+    pros::delay(RUN_MS);
+    leftMotors.brake();
+    rightMotors.brake();
+}
+
+// Returns {mean pose age ms, context switches per s, scheduler runs, scheduler misses}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    std::mt19937 rng(index / MODE_COUNT);
+    for (std::uint32_t& wait : stagger) wait = rng() % 7;
+    static sim::Drivetrain robot(drivetrainConfig());
+    if (!sim::run_task(initialize, TIMEOUT_MS)) return {};
+    const std::uint64_t switches = sim::context_switches();
+    poseAge.clear();
+    if (!sim::run_task(drive, TIMEOUT_MS)) return {};
+
+    double runs = 0, misses = 0;
+    for (int job = 0; job < scheduler.getJobCount(); job++) {
+        runs += scheduler.getStats(job).runs;
+        misses += scheduler.getStats(job).misses;
+    }
+    const double age = sim::stats(poseAge).mean;
+    return {age, (sim::context_switches() - switches) * 1000.0 / RUN_MS, runs, misses};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true;
+    double meanAge[MODE_COUNT] = {};
+    double meanSwitches[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> age, switches, runs, misses;
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 4) {
+                complete = false;
+                continue;
+            }
+            age.push_back(results[i][0]);
+            switches.push_back(results[i][1]);
+            runs.push_back(results[i][2]);
+            misses.push_back(results[i][3]);
+        }
+        meanAge[m] = age.empty() ? 0 : sim::stats(age).mean;
+        meanSwitches[m] = switches.empty() ? 0 : sim::stats(switches).mean;
+        std::printf("%s, %zu runs\n", MODES[m], age.size());
+        std::printf("  pose age at macro ms:      %s\n", sim::to_string(sim::stats(age)).c_str());
+        std::printf("  context switches per s:    %s\n", sim::to_string(sim::stats(switches), 0).c_str());
+        if (m == 1) {
+            std::printf("  job runs:                  %s\n", sim::to_string(sim::stats(runs), 0).c_str());
+            std::printf("  deadline misses:           %s\n", sim::to_string(sim::stats(misses), 0).c_str());
+        }
+    }
+    std::printf("scheduler: pose %.2f ms old at the macros with separate tasks, %.2f ms on the scheduler; %.0f vs %.0f "
+                "context switches per s\n",
+                meanAge[0], meanAge[1], meanSwitches[0], meanSwitches[1]);
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+// Drives main.cpp's chassis around with odometry running, stops for a few
+// seconds, then turns on the spot, while a 50 ms screen job shows the pose two
+// ways: reprinting every pros::lcd line each time like main.cpp used to, and
+// through main.cpp's ScreenRenderer with the field map. Reports how many times
+// a second something on the screen is redrawn and what one run of the screen
+// job costs on this host, and checks the renderer ends up showing the pose it
+// was last given and flips to its second page when the screen is tapped.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_screen        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_screen 50     more runs
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "pros/imu.hpp"
+#include "pros/llemu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "screenRenderer.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"pros::lcd reprint", "ScreenRenderer"};
+constexpr int MODE_COUNT = 2;
+constexpr std::uint32_t DRIVE_MS = 2000;
+constexpr std::uint32_t STOP_MS = 4000;
+constexpr std::uint32_t TURN_MS = 2000;
+constexpr std::uint32_t SETTLE_MS = 1000;
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+
+using Clock = std::chrono::steady_clock;
+
+// Same ports and wheels as main.cpp
+sim::DrivetrainConfig drivetrainConfig() {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+ScreenRenderer screen;
+
+int mode = 0;
+int readouts[4] = {};
+Clock::duration screenTime {};
+int screenRuns = 0;
+lemlib::Pose lastPose(0, 0, 0);
+int lastRotation = 0;
+
+// main.cpp's screen job before the renderer
+void lcdScreen(std::uint32_t) {
+    const lemlib::Pose pose = lemlib::getPose();
+    pros::lcd::print(0, "X: %f", pose.x);
+    pros::lcd::print(1, "Y: %f", pose.y);
+    pros::lcd::print(2, "Theta: %f", pose.theta);
+    pros::lcd::print(3, "Rotation Sensor: %i", verticalEnc.get_position());
+}
+
+// and with it
+void rendererScreen(std::uint32_t now) {
+    lastPose = lemlib::getPose();
+    lastRotation = verticalEnc.get_position();
+    screen.setPose(lastPose);
+    screen.set(readouts[0], {lastPose.x});
+    screen.set(readouts[1], {lastPose.y});
+    screen.set(readouts[2], {lastPose.theta});
+    screen.set(readouts[3], {float(lastRotation)});
+    screen.render(now);
+}
+
+void initialize() {
+    imu.reset(true);
+    static lemlib::TrackingWheel rightWheel(&rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                                            drivetrain.rpm);
+    vertical.reset();
+    rightWheel.reset();
+    horizontal.reset();
+    lemlib::setSensors(lemlib::OdomSensors(&vertical, &rightWheel, &horizontal, nullptr, &imu), drivetrain);
+    lemlib::init();
+    if (mode == 0) {
+        pros::lcd::initialize();
+    } else {
+        screen.init();
+        readouts[0] = screen.addReadout(0, 0, 0, "X: %.2f", 0.005);
+        readouts[1] = screen.addReadout(0, 1, 0, "Y: %.2f", 0.005);
+        readouts[2] = screen.addReadout(0, 2, 0, "Theta: %.2f", 0.005);
+        readouts[3] = screen.addReadout(0, 3, 0, "Rotation Sensor: %.0f", 0.5);
+        screen.setText(screen.addText(1, 0, 0), "second page");
+    }
+    pros::Task screenTask([] {
+        std::uint32_t now = pros::millis();
+        while (true) {
+            const auto start = Clock::now();
+            if (mode == 0) lcdScreen(now);
+            else rendererScreen(now);
+            screenTime += Clock::now() - start;
+            screenRuns++;
+            pros::Task::delay_until(&now, 50);
+        }
+    });
+    pros::delay(50);
+}
+
+int leftPower = 0, rightPower = 0;
+
+void drive() {
+    leftMotors.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
+    rightMotors.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
+    leftMotors.move(leftPower);
+    rightMotors.move(rightPower);
+    pros::delay(DRIVE_MS);
+    leftMotors.brake();
+    rightMotors.brake();
+    pros::delay(STOP_MS);
+    leftMotors.move(60);
+    rightMotors.move(-60);
+    pros::delay(TURN_MS);
+    leftMotors.brake();
+    rightMotors.brake();
+    // long enough to stop and for the last redraw to go out
+    pros::delay(SETTLE_MS);
+}
+
+// every number on the screen within its epsilon, plus rounding, of the last one it was given
+bool showsPose() {
+    const char* names[] = {"X: ", "Y: ", "Theta: ", "Rotation Sensor: "};
+    const double values[] = {lastPose.x, lastPose.y, lastPose.theta, double(lastRotation)};
+    const double tolerance[] = {0.01, 0.01, 0.01, 1};
+    const std::vector<std::string> labels = sim::screen_labels();
+    // the status line is the fifth, empty
+    if (labels.size() != 5) return false;
+    for (int i = 0; i < 4; i++) {
+        const std::string name = names[i];
+        if (labels[i].compare(0, name.size(), name) != 0) return false;
+        if (std::abs(std::atof(labels[i].c_str() + name.size()) - values[i]) > tolerance[i]) return false;
+    }
+    return true;
+}
+
+void tap() {
+    sim::tap_screen();
+    pros::delay(200);
+}
+
+// Returns {redraws per s, us per screen job run, shows the pose, taps to the next page}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    std::mt19937 rng(index / MODE_COUNT);
+    leftPower = 30 + rng() % 40;
+    rightPower = 30 + rng() % 40;
+    static sim::Drivetrain robot(drivetrainConfig());
+    if (!sim::run_task(initialize, TIMEOUT_MS)) return {};
+    const std::uint32_t redraws = mode == 0 ? sim::lcd().prints : sim::screen().redraws;
+    screenTime = {};
+    screenRuns = 0;
+    if (!sim::run_task(drive, TIMEOUT_MS)) return {};
+
+    const std::uint32_t total = (mode == 0 ? sim::lcd().prints : sim::screen().redraws) - redraws;
+    const double us = std::chrono::duration<double, std::micro>(screenTime).count() / std::max(screenRuns, 1);
+    bool shown = true, paged = true;
+    if (mode == 1) {
+        shown = showsPose();
+        if (!sim::run_task(tap, TIMEOUT_MS)) return {};
+        const std::vector<std::string> labels = sim::screen_labels();
+        paged = screen.getPage() == 1 && labels.size() == 1 && labels[0] == "second page";
+    }
+    return {total * 1000.0 / (DRIVE_MS + STOP_MS + TURN_MS + SETTLE_MS), us, double(shown), double(paged)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true, correct = true;
+    double meanRedraws[MODE_COUNT] = {};
+    double meanUs[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> redraws, us;
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 4) {
+                complete = false;
+                continue;
+            }
+            redraws.push_back(results[i][0]);
+            us.push_back(results[i][1]);
+            if (results[i][2] == 0 || results[i][3] == 0) correct = false;
+        }
+        meanRedraws[m] = redraws.empty() ? 0 : sim::stats(redraws).mean;
+        meanUs[m] = us.empty() ? 0 : sim::stats(us).mean;
+        std::printf("%s, %zu runs\n", MODES[m], redraws.size());
+        std::printf("  redraws per s:         %s\n", sim::to_string(sim::stats(redraws), 1).c_str());
+        std::printf("  us per screen update:  %s\n", sim::to_string(sim::stats(us), 2).c_str());
+    }
+    std::printf("screen: %.1f redraws per s reprinting pros::lcd, %.1f with ScreenRenderer and its map; %.2f vs %.2f us "
+                "per update on this host; renderer shows the pose and pages: %s\n",
+                meanRedraws[0], meanRedraws[1], meanUs[0], meanUs[1], correct ? "yes" : "no");
+    return complete && correct ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// Logs a mix of argument types, and strings too long for one record, through
+// the binary telemetry sink to a file, runs firmware/telemetryDecode.py on it
+// and checks every line against what fmt makes of the same message on the
+// brain, in both text and CSV. Then
+// times a pose message through record() against the text telemetry path.
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lemlib/logger/logger.hpp"
+#include "pros/rtos.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+
+constexpr int BATCH = 200; // messages between letting the buffer task write, like a few loops of a 10 ms task
+constexpr int BATCHES = 25;
+const std::string FILE_PATH = SIM_BUILDDIR "/telemetry.bin";
+
+using Clock = std::chrono::steady_clock;
+
+// what telemetrySink()->info() costs, with the string written nowhere
+class TextSink : public lemlib::BaseSink {
+    public:
+        TextSink() {
+            setFormat("TELE_START{message}TELE_END");
+            setLowestLevel(lemlib::Level::INFO);
+        }
+    private:
+        void sendMessage(const lemlib::Message& message) override { buffer.pushToBuffer(message.message); }
+
+        lemlib::Buffer buffer {[](std::string_view) {}};
+};
+
+std::vector<std::string> expected; // "LEVEL message", in the order logged
+double binaryNs = 0;
+double textNs = 0;
+
+template <typename F> double time(F&& log) {
+    Clock::duration total {};
+    for (int batch = 0; batch < BATCHES; batch++) {
+        const auto start = Clock::now();
+        for (int i = 0; i < BATCH; i++) log(batch * BATCH + i);
+        total += Clock::now() - start;
+        pros::delay(20);
+    }
+    return std::chrono::duration<double, std::nano>(total).count() / (BATCH * BATCHES);
+}
+
+void run() {
+    auto sink = lemlib::telemetrySink();
+    sink->setLowestLevel(lemlib::Level::INFO);
+    sink->setFile(FILE_PATH.c_str());
+    sink->setMode(lemlib::TelemetrySink::Mode::BINARY);
+
+    const lemlib::Pose pose(12.345f, -67.89f, 123.456f);
+    sink->record<lemlib::Level::INFO, "Chassis pose: {}">(pose);
+    expected.push_back(fmt::format("INFO Chassis pose: {}", pose));
+
+    const double left = 31.4159;
+    const float right = -2.5f;
+    sink->record<lemlib::Level::DEBUG, "left: {:.2f}, right: {:>8.3f}, count {}">(left, right, 42);
+    expected.push_back(fmt::format("DEBUG left: {:.2f}, right: {:>8.3f}, count {}", left, right, 42));
+
+    const std::string world = "world";
+    sink->record<lemlib::Level::WARN, "{} {} {} {:>7}|">(true, 'x', "hello", world);
+    expected.push_back(fmt::format("WARN {} {} {} {:>7}|", true, 'x', "hello", world));
+
+    // strings too long for a record are cut short, leaving room for the numbers after them
+    const std::string longText(300, 'a');
+    const size_t room = lemlib::telemetry::MAX_RECORD - lemlib::telemetry::MESSAGE_HEADER - 1;
+    sink->record<lemlib::Level::INFO, "{} {} {}">(longText, 7, 2.5);
+    expected.push_back(fmt::format("INFO {} {} {}", longText.substr(0, room - sizeof(int) - sizeof(double)), 7, 2.5));
+    sink->record<lemlib::Level::INFO, "{}|{}|{}">(longText, longText, 9);
+    expected.push_back(fmt::format("INFO {}|{}|{}", longText.substr(0, room - 1 - sizeof(int)), "", 9));
+
+    const uint32_t sensor = 0xbeef;
+    const int64_t big = -1234567890123;
+    const uint8_t small = 200;
+    sink->record<lemlib::Level::ERROR, "level {} sensor {:x} big {} small {}">(lemlib::Level::FATAL, sensor, big,
+                                                         small);
+    expected.push_back(fmt::format("ERROR level {} sensor {:x} big {} small {}", lemlib::Level::FATAL, sensor, big,
+                                   small));
+
+    // fmt's shortest float output, both sides of where it switches to an exponent
+    const float floats[] = {0.1f, 1e6f, 1e7f, 12345678.f, 3.f, -0.f, 1e-5f};
+    const double doubles[] = {0.1, 1e15, 1e16, 3, 1e-5, 0.0001, 123456.789};
+    for (int i = 0; i < 7; i++) {
+        sink->record<lemlib::Level::INFO, "{} {}">(floats[i], doubles[i]);
+        expected.push_back(fmt::format("INFO {} {}", floats[i], doubles[i]));
+    }
+
+    binaryNs = time([&](int i) {
+        sink->record<lemlib::Level::INFO, "Chassis pose: {}">(lemlib::Pose(i * 0.01f, 24 - i * 0.02f, i * 0.1f));
+    });
+
+    TextSink text;
+    textNs = time([&](int i) {
+        text.info("Chassis pose: {}", lemlib::Pose(i * 0.01f, 24 - i * 0.02f, i * 0.1f));
+    });
+
+    // let the buffer task write the rest out before closing the file
+    pros::delay(50);
+    sink->setFile(nullptr);
+}
+
+std::vector<std::string> decode(const std::string& options) {
+    const std::string command =
+        SIM_PYTHON " " SIM_PROJDIR "/firmware/telemetryDecode.py " + options + " " + FILE_PATH;
+    std::vector<std::string> lines;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) return lines;
+    char line[1024];
+    while (std::fgets(line, sizeof(line), pipe)) {
+        std::string text(line);
+        if (!text.empty() && text.back() == '\n') text.pop_back();
+        lines.push_back(text);
+    }
+    pclose(pipe);
+    return lines;
+}
+
+}  // namespace
+
+int main() {
+    std::remove(FILE_PATH.c_str());
+    const bool finished = sim::run_task(run, 60000);
+
+    const std::vector<std::string> lines = decode("");
+    int mismatched = 0;
+    for (size_t i = 0; i < expected.size(); i++) {
+        // drop the time in front
+        const std::string got = i < lines.size() ? lines[i].substr(lines[i].find(' ') + 1) : "";
+        if (got != expected[i]) {
+            std::printf("  expected \"%s\"\n  decoded  \"%s\"\n", expected[i].c_str(), got.c_str());
+            mismatched++;
+        }
+    }
+    const size_t timed = BATCH * BATCHES;
+    const uint32_t dropped = lemlib::telemetrySink()->getDropped();
+    const bool complete = lines.size() + dropped == expected.size() + timed;
+
+    const std::vector<std::string> rows = decode("--csv --match \"Chassis pose\"");
+    const bool csv = rows.size() + dropped == 1 + timed && !rows.empty() &&
+                     rows[0].substr(rows[0].find(',')) == ",INFO,Chassis pose: {},12.345,-67.89,123.456";
+
+    std::printf("telemetry decode: %zu/%zu lines match fmt, %zu decoded, %u dropped, csv %s\n",
+                expected.size() - mismatched, expected.size(), lines.size(), dropped, csv ? "ok" : "wrong");
+    std::printf("pose message: binary record() %.0f ns, text info() %.0f ns (%.1fx)\n", binaryNs, textNs,
+                textNs / binaryNs);
+    return finished && mismatched == 0 && complete && csv ? 0 : 1;
+}
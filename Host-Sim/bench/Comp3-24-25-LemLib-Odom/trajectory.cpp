@@ -0,0 +1,252 @@
+// Follows static/red_negative.txt, the tight S-curve, on main.cpp's chassis
+// with pure pursuit, then as a trajectory tracked with RAMSETE and with LTV,
+// each time with slightly different motors, traction and weight. Reports how
+// far off the path the robot gets, how long it takes and how close to the
+// end it stops. Then times one control cycle of each on this host.
+//
+//   build/Comp3-24-25-LemLib-Odom/bench_trajectory        a quick batch
+//   build/Comp3-24-25-LemLib-Odom/bench_trajectory 20     more runs
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/feedforward.hpp"
+#include "lemlib/pathTracker.hpp"
+#include "lemlib/trajectory.hpp"
+#include "lemlib/trajectoryTracker.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+ASSET(red_negative_path);
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 4;
+constexpr const char* MODES[] = {"pure pursuit", "RAMSETE", "LTV"};
+constexpr int MODE_COUNT = 3;
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+constexpr int MOTION_TIMEOUT_MS = 10000;
+constexpr float LOOKAHEAD = 15; // in, what the autons use
+const lemlib::TrajectoryLimits LIMITS = {60, 200, 13.5};
+// what bench_characterize fits for this drivetrain
+const lemlib::DriveFeedforward FEEDFORWARD = {
+    .left = {0.21, 0.185, 0.02}, .right = {0.21, 0.185, 0.02}, .angular = {0.58, 0.0218, 0.0019}, .kP = 0.1};
+constexpr int TIMED_CYCLES = 200000;
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrainConfig(int seed) {
+    sim::DrivetrainConfig config;
+    config.left_motors = {9, 3, 8};
+    config.right_motors = {19, 12, 18};
+    config.track_width = 13.5;
+    config.wheel_diameter = lemlib::Omniwheel::NEW_275;
+    config.rpm = 450;
+    config.cartridge = pros::MotorGears::blue;
+    config.imu_port = 15;
+    config.tracking_wheels = {{1, lemlib::Omniwheel::NEW_2, -6, true}, {13, lemlib::Omniwheel::NEW_2, -1, false}};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    config.left_strength = 1 + 0.04 * spread(rng);
+    config.right_strength = 1 + 0.04 * spread(rng);
+    config.traction *= 1 + 0.08 * spread(rng);
+    config.mass *= 1 + 0.1 * spread(rng);
+    return config;
+}
+
+pros::MotorGroup leftMotors({-9, -3, -8}, pros::MotorGearset::blue);
+pros::MotorGroup rightMotors({19, 12, 18}, pros::MotorGearset::blue);
+pros::Imu imu(15);
+pros::Rotation horizontalEnc(1);
+pros::Rotation verticalEnc(-13);
+lemlib::TrackingWheel horizontal(&horizontalEnc, lemlib::Omniwheel::NEW_2, -6);
+lemlib::TrackingWheel vertical(&verticalEnc, lemlib::Omniwheel::NEW_2, -1);
+lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 13.5, lemlib::Omniwheel::NEW_275, 450, 2);
+lemlib::ControllerSettings linearController(10, 0, 3, 3, 1, 100, 3, 500, 20);
+lemlib::ControllerSettings angularController(2, 0, 12, 0, 0.5, 100, 3, 500, 0);
+lemlib::OdomSensors sensors(&vertical, nullptr, &horizontal, nullptr, &imu);
+lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors);
+
+const lemlib::PathAsset path(red_negative_path);
+lemlib::Trajectory trajectory;
+sim::Drivetrain* truth = nullptr;
+int mode = 0;
+
+// the path up to where follow() stops, its first point with a speed of 0
+std::vector<lemlib::PathPoint> pathPoints() {
+    std::vector<lemlib::PathPoint> points;
+    for (const lemlib::PathPoint& point : path) {
+        points.push_back(point);
+        if (point.speed == 0) break;
+    }
+    return points;
+}
+
+// start on the path facing along it
+sim::Pose startPose() {
+    return {path[0].x, path[0].y, std::atan2(path[1].x - path[0].x, path[1].y - path[0].y) * 180 / M_PI};
+}
+
+double distanceToSegment(const lemlib::PathPoint& a, const lemlib::PathPoint& b, double x, double y) {
+    const double dx = b.x - a.x, dy = b.y - a.y;
+    const double length = dx * dx + dy * dy;
+    const double t = length > 0 ? std::clamp(((x - a.x) * dx + (y - a.y) * dy) / length, 0.0, 1.0) : 0;
+    return std::hypot(a.x + t * dx - x, a.y + t * dy - y);
+}
+
+double crossTrack(const std::vector<lemlib::PathPoint>& points, double x, double y) {
+    double nearest = INFINITY;
+    for (std::size_t i = 0; i + 1 < points.size(); i++) {
+        nearest = std::min(nearest, distanceToSegment(points[i], points[i + 1], x, y));
+    }
+    return nearest;
+}
+
+double meanError = 0;
+double worstError = 0;
+
+void calibrate() {
+    chassis.calibrateOdom();
+    const sim::Pose start = startPose();
+    chassis.setPose(start.x, start.y, start.theta);
+}
+
+void runPath() {
+    const std::vector<lemlib::PathPoint> points = pathPoints();
+    if (mode == 0) {
+        chassis.follow(path, LOOKAHEAD, MOTION_TIMEOUT_MS);
+    } else {
+        lemlib::setDriveFeedforward(FEEDFORWARD);
+        chassis.follow(trajectory, MOTION_TIMEOUT_MS,
+                       {.type = mode == 1 ? lemlib::TrajectoryTrackerType::RAMSETE : lemlib::TrajectoryTrackerType::LTV});
+    }
+    double sum = 0;
+    int count = 0;
+    while (chassis.isInMotion()) {
+        const double error = crossTrack(points, truth->pose().x, truth->pose().y);
+        sum += error;
+        count++;
+        worstError = std::max(worstError, error);
+        pros::delay(10);
+    }
+    meanError = count > 0 ? sum / count : 0;
+}
+
+// Returns {seconds, mean cross-track error in, worst cross-track error in, end error in}
+std::vector<double> trial(int index) {
+    mode = index % MODE_COUNT;
+    trajectory = lemlib::Trajectory(path, LIMITS);
+    static sim::Drivetrain robot(drivetrainConfig(index / MODE_COUNT), startPose());
+    truth = &robot;
+    if (!sim::run_task(calibrate, TIMEOUT_MS)) return {};
+    const std::uint32_t start = sim::now_ms();
+    if (!sim::run_task(runPath, TIMEOUT_MS)) return {};
+    const lemlib::PathPoint& end = pathPoints().back();
+    return {(sim::now_ms() - start) / 1000.0, meanError, worstError,
+            std::hypot(truth->pose().x - end.x, truth->pose().y - end.y)};
+}
+
+// the robot for a cycle, 1 in to the side of the trajectory and a little off its heading
+lemlib::Pose robotAt(const lemlib::TrajectoryState& state) {
+    return {state.x + std::cos(state.theta), state.y - std::sin(state.theta), state.theta + 0.05f};
+}
+
+template <typename Cycle> double nsPerCycle(Cycle cycle) {
+    const float step = trajectory.getDuration() / TIMED_CYCLES;
+    volatile float sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TIMED_CYCLES; i++) sink = sink + cycle(i * step);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / TIMED_CYCLES;
+}
+
+// one control cycle of each, without the chassis around it
+void timeCycles() {
+    trajectory = lemlib::Trajectory(path, LIMITS);
+
+    const double purePursuit = nsPerCycle([tracker = lemlib::PathTracker(path, LOOKAHEAD)](float time) mutable {
+        const lemlib::Pose pose = robotAt(trajectory.sample(time));
+        tracker.update(pose.x, pose.y);
+        // the curvature to the lookahead point, as in follow()
+        const lemlib::PathPoint& target = tracker.getLookahead();
+        const float heading = M_PI / 2 - pose.theta;
+        const float side = std::sin(heading) * (target.x - pose.x) - std::cos(heading) * (target.y - pose.y);
+        const float a = -std::tan(heading);
+        const float c = std::tan(heading) * pose.x - pose.y;
+        const float x = std::fabs(a * target.x + target.y + c) / std::sqrt(a * a + 1);
+        const float d = std::hypot(target.x - pose.x, target.y - pose.y);
+        return (side > 0 ? 1 : -1) * 2 * x / (d * d);
+    });
+    double tracked[2];
+    for (int m = 0; m < 2; m++) {
+        const lemlib::TrajectoryTracker tracker(
+            {.type = m == 0 ? lemlib::TrajectoryTrackerType::RAMSETE : lemlib::TrajectoryTrackerType::LTV},
+            trajectory.getMaxVelocity());
+        tracked[m] = nsPerCycle([&tracker](float time) {
+            const lemlib::TrajectoryState target = trajectory.sample(time);
+            return tracker.calculate(robotAt(target), target).angularVelocity;
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const lemlib::TrajectoryTracker ltv({.type = lemlib::TrajectoryTrackerType::LTV}, trajectory.getMaxVelocity());
+    const double gainsUs =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const auto buildStart = std::chrono::steady_clock::now();
+    const lemlib::Trajectory built(path, LIMITS);
+    const double buildUs =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - buildStart).count();
+
+    std::printf("control cycle on this host, %zu point path\n", path.size());
+    std::printf("  pure pursuit ns:     %.0f\n", purePursuit);
+    std::printf("  RAMSETE ns:          %.0f\n", tracked[0]);
+    std::printf("  LTV ns:              %.0f\n", tracked[1]);
+    std::printf("  trajectory build us: %.0f, %zu states, %.2f s\n", buildUs, built.getStates().size(),
+                built.getDuration());
+    std::printf("  LTV gain table us:   %.0f\n", gainsUs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int perMode = DEFAULT_TRIALS;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) perMode = std::max(1, std::atoi(argv[1]));
+
+    const auto results = sim::run_trials(argc, argv, MODE_COUNT * perMode, trial);
+
+    bool complete = true;
+    double meanCrossTrack[MODE_COUNT] = {};
+    for (int m = 0; m < MODE_COUNT; m++) {
+        std::vector<double> time, crossTrackMean, crossTrackWorst, endError;
+        for (int i = m; i < MODE_COUNT * perMode; i += MODE_COUNT) {
+            if (results[i].size() != 4) {
+                complete = false;
+                continue;
+            }
+            time.push_back(results[i][0]);
+            crossTrackMean.push_back(results[i][1]);
+            crossTrackWorst.push_back(results[i][2]);
+            endError.push_back(results[i][3]);
+        }
+        meanCrossTrack[m] = crossTrackMean.empty() ? 0 : sim::stats(crossTrackMean).mean;
+        std::printf("%s, %zu runs of red_negative.txt\n", MODES[m], time.size());
+        std::printf("  path s:              %s\n", sim::to_string(sim::stats(time)).c_str());
+        std::printf("  mean cross-track in: %s\n", sim::to_string(sim::stats(crossTrackMean)).c_str());
+        std::printf("  worst cross-track in: %s\n", sim::to_string(sim::stats(crossTrackWorst)).c_str());
+        std::printf("  end error in:        %s\n", sim::to_string(sim::stats(endError)).c_str());
+    }
+    timeCycles();
+    std::printf("trajectory: %.2f in mean cross-track with pure pursuit, %.2f in RAMSETE, %.2f in LTV\n",
+                meanCrossTrack[0], meanCrossTrack[1], meanCrossTrack[2]);
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+// Runs the hooks for 15 s the way the autons do, with rings jamming them at
+// random spots along the way, some so firmly they need backing out twice.
+// Three ways: left running like the autons did before the supervisor, with a
+// driver who backs the intake out once they notice it has stopped, and
+// through subsystems.hpp's IntakeSupervisor.  Reports how far the hooks got,
+// how long they spent jammed, how hot the hook motor got, and for the
+// supervisor how many jams it backed out of against how many there were and
+// the time it says was lost.
+//
+//   build/EZ-Code-Odom/bench_intake_jam        a quick batch
+//   build/EZ-Code-Odom/bench_intake_jam 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "control_scheduler.hpp"
+#include "intake_supervisor.hpp"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"open loop", "driver", "intake_supervisor"};
+constexpr int MODE_COUNT = 3;
+constexpr std::uint32_t RUN_MS = 15000;
+constexpr std::uint32_t DRIVER_REACTION = 1000;  // ms stopped before the driver notices
+constexpr std::uint32_t DRIVER_REVERSE = 300;    // ms they hold R2 for
+constexpr double RING_SPACING = 700;             // hook deg between rings
+constexpr double CLEAR = 40;                     // hook deg back a jam has to be backed out to come loose
+
+constexpr int LOW_PORT = 11;
+constexpr int HOOK_PORT = 7;
+
+// same ports and settings as subsystems.hpp
+pros::Motor intakeLow(-LOW_PORT);
+pros::Motor intakeHigh(-HOOK_PORT);
+pros::Optical colorsort(16);
+RingSorter ring_sorter(colorsort, intakeHigh, {150, 250, -127, 100, 100});
+IntakeSupervisor intake_supervisor(intakeLow, intakeHigh, ring_sorter, {60, 20, 1800, 200, 127, 150, 3});
+ControlScheduler scheduler;
+
+struct Jam {
+  double at;   // hook deg
+  int sticks;  // times it jams before it comes loose
+};
+
+// Rings on the hooks, each a bit of extra load as it goes up, some of them jammed
+class Hooks {
+ public:
+  Hooks(int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> gap(1500, 4000);
+    std::uniform_real_distribution<double> chance(0, 1);
+    for (double at = gap(rng); at < 20000; at += gap(rng)) jams.push_back({at, chance(rng) < 0.7 ? 1 : 2});
+    sim::motor(LOW_PORT).load_torque = 0.2;
+    sim::plant_add([this](std::uint32_t, double dt) { step(dt); });
+  }
+
+  double jammed_time = 0;  // s
+  int jam_count = 0;       // times a ring jammed
+
+ private:
+  void step(double dt) {
+    sim::Motor& m = sim::motor(HOOK_PORT);
+    const double position = m.reversed ? -m.position : m.position;
+    const bool forward = (m.reversed ? -m.voltage : m.voltage) > 0;
+
+    if (!jammed && next < jams.size() && position >= jams[next].at) {
+      jammed = true;
+      jam_count++;
+    }
+    if (jammed && position < jams[next].at - CLEAR) {
+      jammed = false;
+      if (--jams[next].sticks == 0) next++;
+    }
+    if (jammed) jammed_time += dt;
+
+    // a ring going up is a bit heavier than the chain for a third of the way
+    const double load = std::fmod(position, RING_SPACING) < RING_SPACING / 3 ? 0.5 : 0.3;
+    m.load_torque = jammed && forward ? 5 : load;
+  }
+
+  std::vector<Jam> jams;
+  std::size_t next = 0;
+  bool jammed = false;
+};
+
+int mode = 0;
+
+void run() {
+  intakeLow.move(127);
+  ring_sorter.intake_set(106);
+  const std::uint32_t start = sim::now_ms();
+  if (mode == 0) {
+    pros::delay(RUN_MS);
+  } else if (mode == 1) {
+    std::uint32_t stopped_since = start;
+    while (sim::now_ms() - start < RUN_MS) {
+      pros::delay(10);
+      if (std::abs(intakeHigh.get_actual_velocity()) > 20) stopped_since = sim::now_ms();
+      if (sim::now_ms() - stopped_since < DRIVER_REACTION) continue;
+      intakeLow.move(-127);
+      ring_sorter.intake_set(-127);
+      pros::delay(DRIVER_REVERSE);
+      intakeLow.move(127);
+      ring_sorter.intake_set(106);
+      stopped_since = sim::now_ms();
+    }
+  } else {
+    // on the scheduler, the way main.cpp runs it
+    scheduler.add("intake", Stage::ACTUATE, IntakeSupervisor::PERIOD,
+                  [](std::uint32_t now) { intake_supervisor.update(now); });
+    pros::Task task([] { scheduler.run(); }, TASK_PRIORITY_DEFAULT + 2);
+    intake_supervisor.intake_set(127, 106);
+    pros::delay(RUN_MS);
+  }
+}
+
+// Returns {hook deg, s jammed, hook motor C, jams, jams backed out of, s the supervisor says were lost}
+std::vector<double> trial(int index) {
+  mode = index % MODE_COUNT;
+  static Hooks hooks(index / MODE_COUNT);
+  if (!sim::run_task(run, RUN_MS + 1000)) return {};
+  const IntakeSupervisor::Stats stats = intake_supervisor.stats_get();
+  return {intakeHigh.get_position(), hooks.jammed_time, intakeHigh.get_temperature(), double(hooks.jam_count),
+          double(stats.jams), stats.time_lost / 1000.0};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int per_mode = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) per_mode = std::max(1, std::atoi(argv[1]));
+
+  const auto results = sim::run_trials(argc, argv, MODE_COUNT * per_mode, trial);
+
+  bool complete = true;
+  double mean_travel[MODE_COUNT] = {};
+  for (int m = 0; m < MODE_COUNT; m++) {
+    std::vector<double> travel, jammed, temperature, jams, backed_out, lost;
+    for (int i = m; i < MODE_COUNT * per_mode; i += MODE_COUNT) {
+      if (results[i].size() != 6) {
+        complete = false;
+        continue;
+      }
+      travel.push_back(results[i][0]);
+      jammed.push_back(results[i][1]);
+      temperature.push_back(results[i][2]);
+      jams.push_back(results[i][3]);
+      backed_out.push_back(results[i][4]);
+      lost.push_back(results[i][5]);
+    }
+    mean_travel[m] = travel.empty() ? 0 : sim::stats(travel).mean;
+    std::printf("%s, %zu runs\n", MODES[m], travel.size());
+    std::printf("  hook travel deg:     %s\n", sim::to_string(sim::stats(travel), 0).c_str());
+    std::printf("  s jammed:            %s\n", sim::to_string(sim::stats(jammed)).c_str());
+    std::printf("  hook motor C:        %s\n", sim::to_string(sim::stats(temperature), 1).c_str());
+    std::printf("  jams:                %s\n", sim::to_string(sim::stats(jams), 1).c_str());
+    if (m == 2) {
+      std::printf("  jams backed out of:  %s\n", sim::to_string(sim::stats(backed_out), 1).c_str());
+      std::printf("  s lost, by stats:    %s\n", sim::to_string(sim::stats(lost)).c_str());
+    }
+  }
+  std::printf("intake jam: hooks went %.0f deg open loop, %.0f deg with a driver, %.0f deg with intake_supervisor "
+              "(%+.0f%% on the driver)\n",
+              mean_travel[0], mean_travel[1], mean_travel[2], 100 * (mean_travel[2] / mean_travel[1] - 1));
+  return complete ? 0 : 1;
+}
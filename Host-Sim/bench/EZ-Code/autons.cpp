@@ -0,0 +1,143 @@
+// Runs EZ-Code's autonomous routines many times on the simulated drivetrain,
+// each time with slightly different motors, traction and gyro, and reports how
+// long they take and how far the robot ends up from where the nominal run
+// stopped.
+//
+//   build/EZ-Code/bench_autons          a quick batch
+//   build/EZ-Code/bench_autons 5000     an overnight batch
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 16;
+constexpr std::uint32_t INIT_TIMEOUT_MS = 10000;
+constexpr std::uint32_t AUTON_TIMEOUT_MS = 120000;
+
+struct Routine {
+  const char* name;
+  void (*fn)();
+  sim::Pose start;  // on the field, where the routine tells the localizer it starts
+};
+
+const Routine ROUTINES[] = {
+    {"red_negative_auton", red_negative_auton, {}},
+    {"skills_auton", skills_auton, {-58, 0, 90}},
+};
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrain_config() {
+  sim::DrivetrainConfig config;
+  config.left_motors = {9, 3, 8};
+  config.right_motors = {19, 12, 18};
+  config.wheel_diameter = 2.75;
+  config.rpm = 450;
+  config.cartridge = pros::MotorGears::blue;
+  config.imu_port = 15;
+  config.distance_sensors = {{6, -6.5, 0, -90}, {7, 6.5, 0, 90}, {10, 0, -7, 180}};
+  for (const FieldWall& wall : high_stakes_field()) config.walls.push_back({wall.x1, wall.y1, wall.x2, wall.y2});
+  return config;
+}
+
+// Trial 0 of each routine is the nominal robot, the rest are spread around it
+sim::DrivetrainConfig perturbed(int seed) {
+  sim::DrivetrainConfig config = drivetrain_config();
+  if (seed == 0) return config;
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> spread(0, 1);
+  config.left_strength = 1 + 0.04 * spread(rng);
+  config.right_strength = 1 + 0.04 * spread(rng);
+  config.traction *= 1 + 0.08 * spread(rng);
+  config.mass *= 1 + 0.03 * spread(rng);
+  config.imu_scale = 1 + 0.003 * spread(rng);
+  config.imu_drift = 0.01 * spread(rng);
+  return config;
+}
+
+void (*routine_fn)() = nullptr;
+
+// Runs main.cpp's autonomous() with the selector pointed at the routine under test
+void run_autonomous() {
+  ez::as::auton_selector.Autons = {Auton("bench", routine_fn)};
+  ez::as::auton_selector.auton_page_current = 0;
+  autonomous();
+}
+
+// Returns {routine, completion ms, x, y, theta, finished}
+std::vector<double> trial(int index, int per_routine) {
+  const int routine = index / per_routine;
+  const int seed = index % per_routine;
+  static sim::Drivetrain drivetrain(perturbed(seed), ROUTINES[routine].start);
+
+  if (!sim::run_task(initialize, INIT_TIMEOUT_MS)) return {};
+
+  sim::competition().connected = true;
+  sim::competition().autonomous = true;
+  routine_fn = ROUTINES[routine].fn;
+  const std::uint32_t start = sim::now_ms();
+  const bool finished = sim::run_task(run_autonomous, AUTON_TIMEOUT_MS);
+
+  const sim::Pose end = drivetrain.pose();
+  return {static_cast<double>(routine), static_cast<double>(sim::now_ms() - start), end.x, end.y, end.theta,
+          finished ? 1.0 : 0.0};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int per_routine = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) per_routine = std::max(1, std::atoi(argv[1]));
+  const int routines = sizeof(ROUTINES) / sizeof(ROUTINES[0]);
+
+  const auto wall_start = std::chrono::steady_clock::now();
+  const auto results =
+      sim::run_trials(argc, argv, per_routine * routines, [&](int index) { return trial(index, per_routine); });
+  const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+  bool all_finished = true;
+  double simulated_ms = 0;
+  for (int r = 0; r < routines; r++) {
+    const auto& nominal = results[r * per_routine];
+    std::vector<double> time_s;
+    std::vector<double> position_error;
+    std::vector<double> heading_error;
+    int crashed = 0;
+    int timed_out = 0;
+    for (int i = 0; i < per_routine; i++) {
+      const auto& result = results[r * per_routine + i];
+      if (result.size() != 6) {
+        crashed++;
+        continue;
+      }
+      simulated_ms += result[1];
+      if (result[5] == 0) {
+        timed_out++;
+        continue;
+      }
+      time_s.push_back(result[1] / 1000);
+      if (nominal.size() != 6) continue;
+      position_error.push_back(std::hypot(result[2] - nominal[2], result[3] - nominal[3]));
+      heading_error.push_back(std::abs(result[4] - nominal[4]));
+    }
+    all_finished = all_finished && crashed == 0 && timed_out == 0;
+
+    std::printf("%s: %d trials, %d timed out, %d crashed\n", ROUTINES[r].name, per_routine, timed_out, crashed);
+    if (nominal.size() == 6) std::printf("  nominal end:      (%.1f, %.1f) in, %.1f deg\n", nominal[2], nominal[3], nominal[4]);
+    std::printf("  completion s:     %s\n", sim::to_string(sim::stats(time_s)).c_str());
+    std::printf("  end error in:     %s\n", sim::to_string(sim::stats(position_error)).c_str());
+    std::printf("  end error deg:    %s\n", sim::to_string(sim::stats(heading_error)).c_str());
+  }
+  std::printf("autons: %.0f simulated s in %.2f s wall (%.0fx real time)\n", simulated_ms / 1000, wall,
+              simulated_ms / 1000 / wall);
+  return all_finished ? 0 : 1;
+}
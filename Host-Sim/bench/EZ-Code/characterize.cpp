@@ -0,0 +1,184 @@
+// Runs the "Drive Characterization" auton, each time with slightly different
+// motors, traction and weight, with the terminal going to a file.  Fits the
+// file with Comp3-24-25-LemLib-Odom/firmware/characterizeFit.py, then drives a
+// velocity profile out and back with ProfiledDrive::velocity_set() on the
+// fitted constants, and again on the kv the free speed suggests with no ks or
+// ka, and reports how closely each follows the profile.
+//
+//   build/EZ-Code/bench_characterize        a quick batch
+//   build/EZ-Code/bench_characterize 20     more runs
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 4;
+constexpr std::uint32_t INIT_TIMEOUT_MS = 10000;
+constexpr std::uint32_t TIMEOUT_MS = 120000;
+constexpr double KP = 0.1;  // V per in/s, the same for both runs
+const ProfileLimits PROFILE = {50, 150, 1500};
+constexpr double PROFILE_DISTANCE = 48;
+#define FIT_SCRIPT SIM_PROJDIR "/../Comp3-24-25-LemLib-Odom/firmware/characterizeFit.py"
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrain_config(int seed) {
+  sim::DrivetrainConfig config;
+  config.left_motors = {9, 3, 8};
+  config.right_motors = {19, 12, 18};
+  config.wheel_diameter = 2.75;
+  config.rpm = 450;
+  config.cartridge = pros::MotorGears::blue;
+  config.imu_port = 15;
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> spread(0, 1);
+  config.left_strength = 1 + 0.04 * spread(rng);
+  config.right_strength = 1 + 0.04 * spread(rng);
+  config.traction *= 1 + 0.08 * spread(rng);
+  config.mass *= 1 + 0.1 * spread(rng);
+  config.rolling_resistance *= 1 + 0.2 * spread(rng);
+  return config;
+}
+
+sim::Drivetrain* truth = nullptr;
+std::string log_file;
+
+// Runs main.cpp's autonomous() on the characterization auton, with the terminal going to log_file
+void characterize() {
+  ez::as::auton_selector.Autons = {Auton("bench", drive_characterization)};
+  ez::as::auton_selector.auton_page_current = 0;
+  std::fflush(stdout);
+  const int terminal = dup(STDOUT_FILENO);
+  if (std::freopen(log_file.c_str(), "w", stdout) == nullptr) return;
+  autonomous();
+  std::fflush(stdout);
+  dup2(terminal, STDOUT_FILENO);
+  close(terminal);
+}
+
+// Returns the .feedforward line the fitter printed, and everything else it printed through fits
+std::string fit(std::string& fits) {
+  const std::string command = SIM_PYTHON " " FIT_SCRIPT " " + log_file;
+  std::string settings;
+  FILE* pipe = popen(command.c_str(), "r");
+  if (pipe == nullptr) return settings;
+  char line[512];
+  while (std::fgets(line, sizeof(line), pipe)) {
+    if (std::strncmp(line, ".feedforward", 12) == 0)
+      settings = line;
+    else
+      fits += line;
+  }
+  pclose(pipe);
+  return settings;
+}
+
+double rms_error = 0;
+
+// drives the profile out and back on velocity_set(), RMS of how far the robot is from where the profile is, in
+void follow_profile() {
+  const MotionProfile profile(PROFILE_DISTANCE, PROFILE);
+  double squares = 0;
+  int count = 0;
+  for (const double direction : {1.0, -1.0}) {
+    const sim::Pose start = truth->pose();
+    const double heading = start.theta * M_PI / 180;
+    const std::uint32_t start_time = sim::now_ms();
+    while (true) {
+      const double elapsed = (sim::now_ms() - start_time) / 1000.0;
+      if (elapsed > profile.duration_get() + 0.3) break;
+      const ProfileState planned = profile.sample(elapsed);
+      const sim::Pose pose = truth->pose();
+      const double along = (pose.x - start.x) * std::sin(heading) + (pose.y - start.y) * std::cos(heading);
+      const double error = direction * planned.position - along;
+      squares += error * error;
+      count++;
+      const double velocity = direction * planned.velocity;
+      const double acceleration = direction * planned.acceleration;
+      profiled_drive.velocity_set(velocity, velocity, acceleration, acceleration);
+      pros::delay(10);
+    }
+    chassis.drive_set(0, 0);
+    pros::delay(1000);
+  }
+  rms_error = std::sqrt(squares / count);
+}
+
+// Returns {left ks, kv, ka, angular ks, kv, ka, RMS error fitted, RMS error free speed guess}
+std::vector<double> trial(int index) {
+  static sim::Drivetrain robot(drivetrain_config(index));
+  truth = &robot;
+  if (!sim::run_task(initialize, INIT_TIMEOUT_MS)) return {};
+
+  sim::competition().connected = true;
+  sim::competition().autonomous = true;
+  log_file = SIM_BUILDDIR "/characterize_" + std::to_string(index) + ".csv";
+  if (!sim::run_task(characterize, TIMEOUT_MS)) return {};
+
+  std::string fits;
+  const std::string line = fit(fits);
+  std::remove(log_file.c_str());
+  DriveFeedforward fitted;
+  if (std::sscanf(line.c_str(), ".feedforward = {.left = {%lf, %lf, %lf}, .right = {%lf, %lf, %lf}, "
+                                ".angular = {%lf, %lf, %lf}}",
+                  &fitted.left.ks, &fitted.left.kv, &fitted.left.ka, &fitted.right.ks, &fitted.right.kv,
+                  &fitted.right.ka, &fitted.angular.ks, &fitted.angular.kv, &fitted.angular.ka) != 9) {
+    std::fprintf(stderr, "fit failed:\n%s%s", fits.c_str(), line.c_str());
+    return {};
+  }
+  fitted.kp = KP;
+
+  ProfiledDrive::Settings settings = {.wheel_diameter = 2.75, .rpm = 450, .feedforward = fitted};
+  profiled_drive.settings_set(settings);
+  if (!sim::run_task(follow_profile, TIMEOUT_MS)) return {};
+  const double fitted_error = rms_error;
+
+  // what a team would guess without characterizing: full voltage at free speed
+  const double free_speed = 450.0 / 60 * M_PI * 2.75;
+  settings.feedforward = {};
+  settings.feedforward.left.kv = settings.feedforward.right.kv = 12 / free_speed;
+  settings.feedforward.kp = KP;
+  profiled_drive.settings_set(settings);
+  if (!sim::run_task(follow_profile, TIMEOUT_MS)) return {};
+
+  return {fitted.left.ks,    fitted.left.kv,    fitted.left.ka, fitted.angular.ks,
+          fitted.angular.kv, fitted.angular.ka, fitted_error,   rms_error};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int trials = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) trials = std::max(1, std::atoi(argv[1]));
+
+  const auto results = sim::run_trials(argc, argv, trials, trial);
+
+  std::vector<double> columns[8];
+  for (const auto& result : results) {
+    if (result.size() != 8) continue;
+    for (int c = 0; c < 8; c++) columns[c].push_back(result[c]);
+  }
+  std::printf("drive_characterize, %zu robots fitted\n", columns[0].size());
+  const char* names[] = {"left ks V:", "left kv V/(in/s):", "left ka V/(in/s^2):", "angular ks V:",
+                         "angular kv V/(deg/s):", "angular ka V/(deg/s^2):"};
+  for (int c = 0; c < 6; c++) std::printf("  %-24s %s\n", names[c], sim::to_string(sim::stats(columns[c]), 4).c_str());
+  std::printf("velocity_set() following a %.0f in profile out and back\n", PROFILE_DISTANCE);
+  std::printf("  fitted RMS error in:     %s\n", sim::to_string(sim::stats(columns[6])).c_str());
+  std::printf("  free speed RMS error in: %s\n", sim::to_string(sim::stats(columns[7])).c_str());
+  const double fitted = columns[6].empty() ? 0 : sim::stats(columns[6]).mean;
+  const double guess = columns[7].empty() ? 0 : sim::stats(columns[7]).mean;
+  std::printf("characterize: %.2f in RMS off the profile with fitted feedforward, %.2f in with the free speed kv\n",
+              fitted, guess);
+  return columns[0].size() == std::size_t(trials) ? 0 : 1;
+}
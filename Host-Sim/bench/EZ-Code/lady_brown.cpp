@@ -0,0 +1,234 @@
+// Runs the lady brown on a simulated arm through a scoring cycle: lbDown up to
+// lbScore, back down, then up to lbMid to hold a ring.  Four ways: the old
+// blocking autoLadyBrownAngle() PID, EZ-Code-Odom's lbPID (P only) in a task,
+// move_absolute() like opcontrol used, and main.cpp's lb_controller, each time
+// with a slightly different arm.  Reports how long each move takes to settle,
+// how far the arm overshoots and how far it sags holding the ring.
+//
+//   build/EZ-Code/bench_lady_brown        a quick batch
+//   build/EZ-Code/bench_lady_brown 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"autoLadyBrownAngle", "lbPID", "move_absolute", "lb_controller"};
+constexpr int MODE_COUNT = 4;
+constexpr std::uint32_t TIMEOUT_MS = 30000;
+constexpr std::uint32_t HOLD_MS = 1000;   // after each move says it is done
+constexpr std::uint32_t SAG_MS = 300;     // end of the ring hold the sag is averaged over
+constexpr double BAND = 30;               // ticks from the target the arm counts as there
+
+// autons.cpp's positions
+constexpr double LB_DOWN = 0;
+constexpr double LB_MID = 480;
+constexpr double LB_SCORE = 1900;
+
+constexpr int PORT = 16;  // ladybrown in subsystems.hpp
+constexpr double GEAR_RATIO = 12;
+constexpr double REST_ANGLE = -60;  // deg above horizontal on the stop
+constexpr double TOP_STOP = 2600;   // ticks
+
+// One arm on the ladybrown motor, pushed around by gravity, with hard stops at both ends
+class Arm {
+ public:
+  Arm(int seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0, 1);
+    mass = 0.6 * (1 + 0.1 * spread(rng));
+    reach = 0.18 * (1 + 0.05 * spread(rng));
+    sim::battery_voltage();
+    sim::motor(PORT).external = true;
+    sim::plant_add([this](std::uint32_t, double dt) { step(dt); });
+  }
+
+  bool ring = false;  // carrying a ring at the end of the arm
+
+ private:
+  static constexpr double RING_MASS = 0.1;  // kg
+  static constexpr double RING_REACH = 0.3;  // m from the pivot
+
+  void step(double dt) {
+    sim::Motor& m = sim::motor(PORT);
+    const double angle = (REST_ANGLE + m.position / GEAR_RATIO) * M_PI / 180;
+    const double moment = mass * reach + (ring ? RING_MASS * RING_REACH : 0);
+    const double gravity = 9.81 * moment * std::cos(angle) / GEAR_RATIO;  // Nm at the motor shaft
+    const double friction = 0.02 * sim::stall_torque(m.gearing);
+    const double inertia = sim::rotor_inertia(m.gearing) +
+                           (mass * reach * reach + (ring ? RING_MASS * RING_REACH * RING_REACH : 0)) /
+                               (GEAR_RATIO * GEAR_RATIO);
+
+    double net = m.torque - gravity;
+    if (m.velocity != 0) {
+      net -= std::copysign(friction, m.velocity);
+    } else if (std::abs(net) <= friction) {
+      net = 0;
+    } else {
+      net -= std::copysign(friction, net);
+    }
+    double velocity = m.velocity + net / inertia * dt * 60 / (2 * M_PI);
+    if (m.velocity != 0 && std::signbit(velocity) != std::signbit(m.velocity) && std::abs(m.torque - gravity) <= friction)
+      velocity = 0;
+    m.position += (m.velocity + velocity) / 2 * 6 * dt;
+    m.velocity = velocity;
+    if (m.position < 0 || m.position > TOP_STOP) {
+      m.position = std::clamp(m.position, 0.0, TOP_STOP);
+      m.velocity = 0;
+    }
+  }
+
+  double mass;   // kg
+  double reach;  // m from the pivot to the center of mass
+};
+
+int mode = 0;
+Arm* arm = nullptr;
+
+// where the arm was every ms, and when each move was asked for
+std::vector<double> trace;
+std::vector<std::uint32_t> commands;
+
+// autons.cpp's autoLadyBrownAngle() before lb_controller
+void old_auto_lady_brown_angle(int target) {
+  const float Kp = 0.75, Ki = 0.01, Kd = 0.2;
+  const int tolerance = 50, max_output = 50;
+  int last_error = 0, integral = 0;
+  while (true) {
+    int error = target - ladybrown.get_position();
+    if (std::abs(error) <= tolerance) {
+      ladybrown.move_velocity(0);
+      break;
+    }
+    integral += error;
+    int derivative = error - last_error;
+    last_error = error;
+    int output = (Kp * error) + (Ki * integral) + (Kd * derivative);
+    ladybrown.move_velocity(std::clamp(output, -max_output, max_output));
+    pros::delay(20);
+  }
+}
+
+// EZ-Code-Odom's lbPID, lb_task and lb_wait() before lb_controller
+ez::PID lb_pid{0.45, 0, 0, 0, "ladybrown"};
+
+void lb_pid_task() {
+  while (true) {
+    ladybrown.move(lb_pid.compute(ladybrown.get_position()));
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
+
+void move(double target) {
+  commands.push_back(sim::now_ms());
+  switch (mode) {
+    case 0:
+      old_auto_lady_brown_angle(target);
+      break;
+    case 1:
+      lb_pid.target_set(target);
+      while (lb_pid.exit_condition({ladybrown}, true) == ez::RUNNING) pros::delay(ez::util::DELAY_TIME);
+      break;
+    case 2:
+      ladybrown.move_absolute(target, 127);
+      while (std::abs(ladybrown.get_position() - target) > 50) pros::delay(ez::util::DELAY_TIME);
+      break;
+    default:
+      lb_controller.move_to(target).wait(3000);
+  }
+  pros::delay(HOLD_MS);
+}
+
+void cycle() {
+  ladybrown.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
+  ladybrown.tare_position();
+  if (mode == 1) {
+    lb_pid.exit_condition_set(80, 50, 300, 150, 500, 500);
+    pros::Task task(lb_pid_task);
+  } else if (mode == 3) {
+    pros::Task task([] { lb_controller.run(); });
+  }
+  move(LB_SCORE);
+  move(LB_DOWN);
+  arm->ring = true;
+  move(LB_MID);
+  commands.push_back(sim::now_ms());
+}
+
+// ms from asking for a move until the arm is inside BAND for good, up to the next move
+double settle_time(std::size_t move, double target) {
+  const std::uint32_t start = commands[move], end = commands[move + 1];
+  std::uint32_t last_outside = start;
+  for (std::uint32_t t = start; t < end; t++) {
+    if (std::abs(trace[t] - target) > BAND) last_outside = t + 1;
+  }
+  return (last_outside - start) / 1000.0;
+}
+
+// Returns {up s, down s, mid s, overshoot ticks, ring sag ticks}
+std::vector<double> trial(int index) {
+  mode = index % MODE_COUNT;
+  static Arm robot_arm(index / MODE_COUNT);
+  arm = &robot_arm;
+  sim::plant_add([](std::uint32_t now, double) {
+    trace.resize(now + 1, 0);
+    trace[now] = sim::motor(PORT).position;
+  });
+  if (!sim::run_task(cycle, TIMEOUT_MS)) return {};
+
+  double overshoot = 0;
+  for (std::uint32_t t = commands[0]; t < commands[1]; t++) overshoot = std::max(overshoot, trace[t] - LB_SCORE);
+  for (std::uint32_t t = commands[2]; t < commands[3]; t++) overshoot = std::max(overshoot, trace[t] - LB_MID);
+  double sag = 0;
+  for (std::uint32_t t = commands[3] - SAG_MS; t < commands[3]; t++) sag += (LB_MID - trace[t]) / SAG_MS;
+  return {settle_time(0, LB_SCORE), settle_time(1, LB_DOWN), settle_time(2, LB_MID), overshoot, sag};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int per_mode = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) per_mode = std::max(1, std::atoi(argv[1]));
+
+  const auto results = sim::run_trials(argc, argv, MODE_COUNT * per_mode, trial);
+
+  bool complete = true;
+  double mean_up[MODE_COUNT] = {};
+  double mean_sag[MODE_COUNT] = {};
+  for (int m = 0; m < MODE_COUNT; m++) {
+    std::vector<double> up, down, mid, overshoot, sag;
+    for (int i = m; i < MODE_COUNT * per_mode; i += MODE_COUNT) {
+      if (results[i].size() != 5) {
+        complete = false;
+        continue;
+      }
+      up.push_back(results[i][0]);
+      down.push_back(results[i][1]);
+      mid.push_back(results[i][2]);
+      overshoot.push_back(results[i][3]);
+      sag.push_back(results[i][4]);
+    }
+    mean_up[m] = up.empty() ? 0 : sim::stats(up).mean;
+    mean_sag[m] = sag.empty() ? 0 : sim::stats(sag).mean;
+    std::printf("%s, %zu cycles\n", MODES[m], up.size());
+    std::printf("  lbDown to lbScore s:  %s\n", sim::to_string(sim::stats(up)).c_str());
+    std::printf("  lbScore to lbDown s:  %s\n", sim::to_string(sim::stats(down)).c_str());
+    std::printf("  lbDown to lbMid s:    %s\n", sim::to_string(sim::stats(mid)).c_str());
+    std::printf("  overshoot ticks:      %s\n", sim::to_string(sim::stats(overshoot), 1).c_str());
+    std::printf("  ring sag ticks:       %s\n", sim::to_string(sim::stats(sag), 1).c_str());
+  }
+  std::printf("lady brown: lbDown to lbScore %.2f s autoLadyBrownAngle, %.2f s lbPID, %.2f s move_absolute, %.2f s "
+              "lb_controller (%+.0f%% on lbPID, %+.0f%% on move_absolute); ring sag %.1f ticks lbPID, %.1f "
+              "move_absolute, %.1f lb_controller\n",
+              mean_up[0], mean_up[1], mean_up[2], mean_up[3], 100 * (mean_up[3] / mean_up[1] - 1),
+              100 * (mean_up[3] / mean_up[2] - 1), mean_sag[1], mean_sag[2], mean_sag[3]);
+  return complete ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Runs skills_auton on the simulated drivetrain with the distance sensors
+// reading the field walls, each time with slightly different motors, traction
+// and gyro, and checks the localizer's pose against the true one every 100 ms
+// next to plain dead reckoning off the same encoders and IMU.  Then times the
+// particle filter on the host.
+//
+//   build/EZ-Code/bench_localizer         a quick batch
+//   build/EZ-Code/bench_localizer 200     more runs
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 8;
+constexpr std::uint32_t INIT_TIMEOUT_MS = 10000;
+constexpr std::uint32_t AUTON_TIMEOUT_MS = 120000;
+constexpr std::uint32_t CHECK_MS = 100;
+constexpr int TIMED_STEPS = 2000;
+
+const sim::Pose SKILLS_START = {-58, 0, 90};
+
+// Same ports, wheels and sensors as main.cpp
+sim::DrivetrainConfig drivetrain_config(int seed) {
+  sim::DrivetrainConfig config;
+  config.left_motors = {9, 3, 8};
+  config.right_motors = {19, 12, 18};
+  config.wheel_diameter = 2.75;
+  config.rpm = 450;
+  config.cartridge = pros::MotorGears::blue;
+  config.imu_port = 15;
+  config.distance_sensors = {{6, -6.5, 0, -90}, {7, 6.5, 0, 90}, {10, 0, -7, 180}};
+  for (const FieldWall& wall : high_stakes_field()) config.walls.push_back({wall.x1, wall.y1, wall.x2, wall.y2});
+
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> spread(0, 1);
+  config.left_strength = 1 + 0.04 * spread(rng);
+  config.right_strength = 1 + 0.04 * spread(rng);
+  config.traction *= 1 + 0.08 * spread(rng);
+  config.mass *= 1 + 0.03 * spread(rng);
+  config.imu_scale = 1 + 0.003 * spread(rng);
+  config.imu_drift = 0.01 * spread(rng);
+  return config;
+}
+
+sim::Drivetrain* truth = nullptr;
+std::vector<double> localizer_error;
+std::vector<double> odom_error;
+
+double error(const FieldPose& estimate) {
+  const sim::Pose pose = truth->pose();
+  return std::hypot(estimate.x - pose.x, estimate.y - pose.y);
+}
+
+void check() {
+  while (true) {
+    pros::delay(CHECK_MS);
+    localizer_error.push_back(error(localizer.pose_get()));
+    odom_error.push_back(error(localizer.odom_pose_get()));
+  }
+}
+
+void run_skills() {
+  ez::as::auton_selector.Autons = {Auton("bench", skills_auton)};
+  ez::as::auton_selector.auton_page_current = 0;
+  pros::Task checker(check);
+  autonomous();
+}
+
+double mean(const std::vector<double>& values) { return values.empty() ? 0 : sim::stats(values).mean; }
+
+double max(const std::vector<double>& values) { return values.empty() ? 0 : sim::stats(values).max; }
+
+// Returns {localizer mean, localizer max, localizer end, odom mean, odom max, odom end}, in
+std::vector<double> trial(int index) {
+  static sim::Drivetrain drivetrain(drivetrain_config(index), SKILLS_START);
+  truth = &drivetrain;
+  if (!sim::run_task(initialize, INIT_TIMEOUT_MS)) return {};
+  sim::competition().connected = true;
+  sim::competition().autonomous = true;
+  if (!sim::run_task(run_skills, AUTON_TIMEOUT_MS)) return {};
+
+  return {mean(localizer_error), max(localizer_error), error(localizer.pose_get()),
+          mean(odom_error),      max(odom_error),      error(localizer.odom_pose_get())};
+}
+
+double ms_per_step = 0;
+
+// Worst case update: the robot driving and turning with a fresh reading on every sensor
+void time_steps() {
+  localizer.pose_set({-58, 0, 90});
+  std::array<float, Localizer::MAX_SENSORS> readings;
+  readings.fill(-1);
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < TIMED_STEPS; i++) {
+    readings[0] = 40 + std::sin(i * 0.01f);
+    readings[1] = 28 - std::sin(i * 0.01f);
+    readings[2] = 12 + i * 0.002f;
+    localizer.step(0.4, 90 + 10 * std::sin(i * 0.005f), readings);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  ms_per_step = std::chrono::duration<double, std::milli>(elapsed).count() / TIMED_STEPS;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int trials = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) trials = std::max(1, std::atoi(argv[1]));
+
+  const auto results = sim::run_trials(argc, argv, trials, trial);
+
+  std::vector<double> columns[6];
+  for (const auto& result : results) {
+    if (result.size() != 6) continue;
+    for (int c = 0; c < 6; c++) columns[c].push_back(result[c]);
+  }
+  const char* names[2] = {"localizer", "dead reckoning"};
+  for (int m = 0; m < 2; m++) {
+    std::printf("%s, %zu runs of skills_auton\n", names[m], columns[3 * m].size());
+    std::printf("  mean error in:     %s\n", sim::to_string(sim::stats(columns[3 * m])).c_str());
+    std::printf("  worst error in:    %s\n", sim::to_string(sim::stats(columns[3 * m + 1])).c_str());
+    std::printf("  end error in:      %s\n", sim::to_string(sim::stats(columns[3 * m + 2])).c_str());
+  }
+
+  sim::run_task(time_steps, INIT_TIMEOUT_MS);
+  std::printf("localizer: %d particles, %.3f ms per update with 3 readings, %.0f particles/ms on this host\n",
+              Localizer::PARTICLES, ms_per_step, Localizer::PARTICLES / ms_per_step);
+  return columns[0].size() == std::size_t(trials) ? 0 : 1;
+}
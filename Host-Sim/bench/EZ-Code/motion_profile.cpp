@@ -0,0 +1,106 @@
+// Runs the "Drive and Turn" example on EZ-Template's PID, then the same moves
+// on motion profiles, a trapezoid and an S-curve, each time with slightly
+// different motors and traction.  Reports how long it takes and how far from
+// the start the robot comes back to.
+//
+//   build/EZ-Code/bench_motion_profile        a quick batch
+//   build/EZ-Code/bench_motion_profile 50     more runs
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr const char* MODES[] = {"pid_drive_set", "trapezoid", "S-curve"};
+constexpr int MODE_COUNT = 3;
+constexpr std::uint32_t INIT_TIMEOUT_MS = 10000;
+constexpr std::uint32_t AUTON_TIMEOUT_MS = 30000;
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrain_config(int seed) {
+  sim::DrivetrainConfig config;
+  config.left_motors = {9, 3, 8};
+  config.right_motors = {19, 12, 18};
+  config.wheel_diameter = 2.75;
+  config.rpm = 450;
+  config.cartridge = pros::MotorGears::blue;
+  config.imu_port = 15;
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> spread(0, 1);
+  config.left_strength = 1 + 0.04 * spread(rng);
+  config.right_strength = 1 + 0.04 * spread(rng);
+  config.traction *= 1 + 0.08 * spread(rng);
+  config.mass *= 1 + 0.03 * spread(rng);
+  return config;
+}
+
+int mode = 0;
+
+// Runs main.cpp's autonomous() with the selector pointed at the routine under test
+void run_autonomous() {
+  ez::as::auton_selector.Autons = {Auton("bench", mode == 0 ? drive_and_turn : drive_and_turn_profiled)};
+  ez::as::auton_selector.auton_page_current = 0;
+  ProfiledDrive::Settings settings = {.wheel_diameter = 2.75, .rpm = 450};
+  if (mode == 1) settings.drive_jerk = settings.turn_jerk = 0;
+  profiled_drive.settings_set(settings);
+  autonomous();
+}
+
+// Returns {mode, completion s, end error in, end error deg}
+std::vector<double> trial(int index) {
+  mode = index % MODE_COUNT;
+  static sim::Drivetrain drivetrain(drivetrain_config(index / MODE_COUNT));
+  if (!sim::run_task(initialize, INIT_TIMEOUT_MS)) return {};
+
+  sim::competition().connected = true;
+  sim::competition().autonomous = true;
+  const std::uint32_t start = sim::now_ms();
+  if (!sim::run_task(run_autonomous, AUTON_TIMEOUT_MS)) return {};
+
+  // the routine comes back to where it started
+  const sim::Pose end = drivetrain.pose();
+  return {double(mode), (sim::now_ms() - start) / 1000.0, std::hypot(end.x, end.y),
+          std::abs(std::remainder(end.theta, 360))};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int per_mode = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) per_mode = std::max(1, std::atoi(argv[1]));
+
+  const auto results = sim::run_trials(argc, argv, MODE_COUNT * per_mode, trial);
+
+  bool complete = true;
+  double mean_time[MODE_COUNT] = {};
+  for (int m = 0; m < MODE_COUNT; m++) {
+    std::vector<double> time_s, position_error, heading_error;
+    for (int i = m; i < MODE_COUNT * per_mode; i += MODE_COUNT) {
+      if (results[i].size() != 4) {
+        complete = false;
+        continue;
+      }
+      time_s.push_back(results[i][1]);
+      position_error.push_back(results[i][2]);
+      heading_error.push_back(results[i][3]);
+    }
+    mean_time[m] = time_s.empty() ? 0 : sim::stats(time_s).mean;
+    std::printf("%s, %zu runs of drive_and_turn\n", MODES[m], time_s.size());
+    std::printf("  completion s:     %s\n", sim::to_string(sim::stats(time_s)).c_str());
+    std::printf("  end error in:     %s\n", sim::to_string(sim::stats(position_error)).c_str());
+    std::printf("  end error deg:    %s\n", sim::to_string(sim::stats(heading_error)).c_str());
+  }
+  std::printf("motion profile: %.2f s with pid_drive_set, %.2f s trapezoid (%+.0f%%), %.2f s S-curve (%+.0f%%)\n",
+              mean_time[0], mean_time[1], 100 * (mean_time[1] / mean_time[0] - 1), mean_time[2],
+              100 * (mean_time[2] / mean_time[0] - 1));
+  return complete ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+// Runs the "Spline Path" example on the simulated drivetrain, each time with
+// slightly different motors and traction, and checks how far the robot strays
+// from the path every 10 ms and where it ends.  Then times generating the path
+// against looking it up in the cache on the host.
+//
+//   build/EZ-Code/bench_path_cache        a quick batch
+//   build/EZ-Code/bench_path_cache 50     more runs
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/drivetrain.hpp"
+#include "sim/kernel.hpp"
+#include "sim/trials.hpp"
+
+namespace {
+
+constexpr int DEFAULT_TRIALS = 6;
+constexpr std::uint32_t INIT_TIMEOUT_MS = 10000;
+constexpr std::uint32_t AUTON_TIMEOUT_MS = 30000;
+constexpr std::uint32_t CHECK_MS = 10;
+constexpr int TIMED_GENERATIONS = 200;
+constexpr int TIMED_LOOKUPS = 100000;
+
+// The same waypoints as S_CURVE in autons.cpp
+const std::vector<Waypoint> S_CURVE = {{0, 0, 0}, {12, 24, 45}, {0, 48, 0}};
+
+// Same ports and wheels as the chassis in main.cpp
+sim::DrivetrainConfig drivetrain_config(int seed) {
+  sim::DrivetrainConfig config;
+  config.left_motors = {9, 3, 8};
+  config.right_motors = {19, 12, 18};
+  config.wheel_diameter = 2.75;
+  config.rpm = 450;
+  config.cartridge = pros::MotorGears::blue;
+  config.imu_port = 15;
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> spread(0, 1);
+  config.left_strength = 1 + 0.04 * spread(rng);
+  config.right_strength = 1 + 0.04 * spread(rng);
+  config.traction *= 1 + 0.08 * spread(rng);
+  config.mass *= 1 + 0.03 * spread(rng);
+  return config;
+}
+
+sim::Drivetrain* truth = nullptr;
+std::vector<double> cross_track;
+
+// Distance from the robot to the closest piece of the path
+double off_path(const SplinePath& path) {
+  const sim::Pose pose = truth->pose();
+  double closest = INFINITY;
+  for (std::size_t i = 0; i + 1 < path.size(); i++) {
+    const squiggles::Pose& a = path[i].vector.pose;
+    const squiggles::Pose& b = path[i + 1].vector.pose;
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double length = dx * dx + dy * dy;
+    const double t = length > 0 ? std::clamp(((pose.x - a.x) * dx + (pose.y - a.y) * dy) / length, 0.0, 1.0) : 0;
+    closest = std::min(closest, std::hypot(pose.x - a.x - t * dx, pose.y - a.y - t * dy));
+  }
+  return closest;
+}
+
+void check() {
+  const SplinePath& path = path_cache.get(S_CURVE);
+  while (true) {
+    pros::delay(CHECK_MS);
+    cross_track.push_back(off_path(path));
+  }
+}
+
+void run_spline() {
+  ez::as::auton_selector.Autons = {Auton("bench", spline_example)};
+  ez::as::auton_selector.auton_page_current = 0;
+  pros::Task checker(check);
+  autonomous();
+}
+
+// Returns {completion s, mean cross-track in, worst cross-track in, end error in, paths generated in autonomous}
+std::vector<double> trial(int index) {
+  static sim::Drivetrain drivetrain(drivetrain_config(index));
+  truth = &drivetrain;
+  cross_track.clear();
+  if (!sim::run_task(initialize, INIT_TIMEOUT_MS)) return {};
+
+  const std::size_t cached = path_cache.size();
+  sim::competition().connected = true;
+  sim::competition().autonomous = true;
+  const std::uint32_t start = sim::now_ms();
+  if (!sim::run_task(run_spline, AUTON_TIMEOUT_MS)) return {};
+
+  const sim::Pose end = drivetrain.pose();
+  const Waypoint& goal = S_CURVE.back();
+  return {(sim::now_ms() - start) / 1000.0, sim::stats(cross_track).mean, sim::stats(cross_track).max,
+          std::hypot(end.x - goal.x, end.y - goal.y), double(path_cache.size() - cached)};
+}
+
+double generate_us = 0;
+double lookup_ns = 0;
+
+void time_cache() {
+  std::size_t points = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < TIMED_GENERATIONS; i++) points += spline_path_generate(S_CURVE).size();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  generate_us = std::chrono::duration<double, std::micro>(elapsed).count() / TIMED_GENERATIONS;
+
+  path_cache.get(S_CURVE);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < TIMED_LOOKUPS; i++) points += path_cache.get(S_CURVE).size();
+  elapsed = std::chrono::steady_clock::now() - start;
+  lookup_ns = std::chrono::duration<double, std::nano>(elapsed).count() / TIMED_LOOKUPS;
+  if (points == 0) std::printf("no points\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int trials = DEFAULT_TRIALS;
+  if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0) trials = std::max(1, std::atoi(argv[1]));
+
+  const auto results = sim::run_trials(argc, argv, trials, trial);
+
+  std::vector<double> columns[5];
+  for (const auto& result : results) {
+    if (result.size() != 5) continue;
+    for (int c = 0; c < 5; c++) columns[c].push_back(result[c]);
+  }
+  const SplinePath path = spline_path_generate(S_CURVE);
+  std::printf("spline path, %zu runs of spline_example\n", columns[0].size());
+  std::printf("  completion s:          %s\n", sim::to_string(sim::stats(columns[0])).c_str());
+  std::printf("  mean cross-track in:   %s\n", sim::to_string(sim::stats(columns[1])).c_str());
+  std::printf("  worst cross-track in:  %s\n", sim::to_string(sim::stats(columns[2])).c_str());
+  std::printf("  end error in:          %s\n", sim::to_string(sim::stats(columns[3])).c_str());
+  std::printf("  generated in auton:    %s\n", sim::to_string(sim::stats(columns[4])).c_str());
+
+  sim::run_task(time_cache, INIT_TIMEOUT_MS);
+  std::printf("path cache: %zu points planned over %.2f s, %.0f us to generate, %.0f ns to look up on this host\n",
+              path.size(), path.back().time, generate_us, lookup_ns);
+  return columns[0].size() == std::size_t(trials) ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// Runs a skills-length match of the task load the team projects start (a
+// 10 ms drive loop, a 20 ms color sort poll and a 50 ms screen task) and
+// reports how much faster than real time the simulated kernel goes.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "pros/llemu.hpp"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace {
+
+constexpr std::uint32_t MATCH_MS = 60000;
+
+void drive() {
+  pros::MotorGroup left({-9, -3, -8}, pros::MotorGearset::blue);
+  pros::MotorGroup right({19, 12, 18}, pros::MotorGearset::blue);
+  left.move(127);
+  right.move(127);
+  pros::delay(1000);
+  std::printf("drive: left %.0f rpm, right %.0f rpm after 1 s at 127 (blue free speed 600)\n",
+              left.get_actual_velocity(), right.get_actual_velocity());
+  while (pros::millis() < MATCH_MS) {
+    const double t = pros::millis() / 1000.0;
+    left.move(127 * std::sin(t));
+    right.move(127 * std::cos(t));
+    pros::delay(10);
+  }
+  left.brake();
+  right.brake();
+}
+
+}  // namespace
+
+int main() {
+  pros::lcd::initialize();
+  pros::Optical colorsort(2);
+
+  pros::Task sorting([&] {
+    while (true) {
+      if (colorsort.get_rgb().blue > 220) pros::delay(200);
+      pros::delay(20);
+    }
+  });
+  pros::Task screen([] {
+    while (true) {
+      pros::lcd::print(0, "t: %u", pros::millis());
+      pros::delay(50);
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool finished = sim::run_task(drive, MATCH_MS + 1000);
+  const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::printf("kernel: %u simulated ms in %.3f s wall (%.0fx real time), %llu context switches, %u lcd prints\n",
+              sim::now_ms(), wall, sim::now_ms() / 1000.0 / wall,
+              static_cast<unsigned long long>(sim::context_switches()), sim::lcd().prints);
+  return finished ? 0 : 1;
+}
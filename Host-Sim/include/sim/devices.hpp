@@ -0,0 +1,282 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "pros/abstract_motor.hpp"
+#include "pros/misc.h"
+
+/**
+ * Simulated state behind every emulated PROS device.
+ *
+ * The pros:: classes in src/pros read and write these structs, and plants
+ * (motor models, the drivetrain simulator, test scripts) drive them from the
+ * outside.  Ports are the 1-21 smart port numbers used by PROS.
+ */
+namespace sim {
+
+constexpr int PORT_COUNT = 21;
+constexpr int ADI_PORT_COUNT = 8;
+
+/**
+ * V5 smart motor.  Position and velocity are stored at the cartridge output
+ * shaft, in degrees and rpm, and before the `reversed` flag is applied.
+ */
+struct Motor {
+  enum class Mode { voltage, velocity, position };
+
+  bool installed = false;
+  bool reversed = false;
+  pros::MotorGears gearing = pros::MotorGears::green;
+  pros::MotorUnits units = pros::MotorUnits::degrees;
+  pros::MotorBrake brake_mode = pros::MotorBrake::coast;
+  std::int32_t current_limit = 2500;  // mA
+  std::int32_t voltage_limit = 0;     // mV, 0 means no limit
+
+  // Last command
+  Mode mode = Mode::voltage;
+  double target_voltage = 0;   // mV
+  double target_velocity = 0;  // rpm
+  double target_position = 0;  // deg
+  double profile_velocity = 0; // rpm cap for position moves
+  double zero = 0;             // deg, set by tare_position / set_zero_position
+
+  // Plant state
+  double position = 0;     // deg
+  double velocity = 0;     // rpm
+  double voltage = 0;      // mV actually applied
+  double current = 0;      // mA
+  double torque = 0;       // Nm at the output shaft
+  double temperature = 25; // C
+
+  // Coupling to an external plant.  When `external` is set the motor model
+  // only computes voltage, current and torque; the owner integrates motion.
+  bool external = false;
+  double load_torque = 0;   // Nm opposing motion
+  double load_inertia = 0;  // kg m^2 added at the output shaft
+};
+
+struct Imu {
+  bool installed = false;
+  std::uint32_t calibration_end = 0;  // ms
+  double rotation = 0;                // deg, continuous, clockwise positive
+  double pitch = 0;
+  double roll = 0;
+  double yaw_rate = 0;  // deg/s
+  double accel_x = 0;   // g
+  double accel_y = 0;
+  double accel_z = 1;
+
+  // Offsets applied by tare_* and set_*
+  double rotation_offset = 0;
+  double heading_offset = 0;
+  double pitch_offset = 0;
+  double roll_offset = 0;
+  double yaw_offset = 0;
+  std::uint32_t data_rate = 10;  // ms
+
+  // What the brain last received, latched every data_rate ms.  The getters
+  // read these, so code sees readings up to data_rate ms old like on the robot
+  std::uint32_t data_phase = 0;  // ms into each data_rate period it sends at, the port by default
+  double sampled_rotation = 0;
+  double sampled_yaw_rate = 0;
+};
+
+struct Rotation {
+  bool installed = false;
+  bool reversed = false;
+  double angle = 0;     // deg, continuous, as seen by the shaft
+  double velocity = 0;  // deg/s
+  double offset = 0;    // deg, set by reset_position / set_position
+  std::uint32_t data_rate = 10;  // ms
+
+  // latched every data_rate ms, see Imu
+  std::uint32_t data_phase = 0;
+  double sampled_angle = 0;
+  double sampled_velocity = 0;
+};
+
+/**
+ * V5 distance sensor.  `distance` is whatever is in front of it right now, set
+ * by the drivetrain or a test; what the brain reads is latched every data_rate
+ * ms with the sensor's noise added.
+ */
+struct Distance {
+  bool installed = false;
+  double distance = 9999;        // mm to the nearest object, 9999 when there is nothing in range
+  double object_size = 400;      // 0-400, walls look big
+  double object_velocity = 0;    // m/s, towards the sensor negative
+  std::uint32_t data_rate = 33;  // ms, the sensor sends about 30 times a second
+
+  // latched every data_rate ms, see Imu
+  std::uint32_t data_phase = 0;
+  std::uint32_t noise_state = 1;  // per sensor random sequence, so runs repeat
+  std::int32_t sampled_distance = 9999;
+  std::int32_t sampled_confidence = 0;
+};
+
+/**
+ * V5 GPS sensor.  x, y and heading are where the robot really is, set by the
+ * drivetrain or a test.  Every data_rate ms the sensor takes a reading with
+ * its noise added, and the brain gets it `latency` ms later, so code always
+ * sees where the robot was a moment ago.
+ */
+struct Gps {
+  struct Reading {
+    std::uint32_t arrives;  // ms
+    double x;
+    double y;
+    double heading;
+  };
+
+  bool installed = false;
+  double x = 0;        // m from the center of the field, +x towards the blue alliance stake
+  double y = 0;
+  double heading = 0;  // deg clockwise from north (+y)
+  bool visible = true; // false when it can't see the field strip, then readings stop coming
+  double offset_x = 0; // m, set_offset, where the sensor is on the robot
+  double offset_y = 0;
+  double position_noise = 0.01;  // m, standard deviation
+  double heading_noise = 0.3;    // deg
+  std::uint32_t latency = 40;    // ms from a reading being taken to the brain having it
+  std::uint32_t data_rate = 20;  // ms
+
+  std::uint32_t data_phase = 0;
+  std::uint32_t noise_state = 1;
+  std::deque<Reading> in_flight;
+  double sampled_x = 0;
+  double sampled_y = 0;
+  double sampled_heading = 0;
+};
+
+struct Optical {
+  bool installed = false;
+  double hue = 0;          // 0-359.99
+  double saturation = 0;   // 0-1
+  double brightness = 0;   // 0-1
+  std::int32_t proximity = 0;  // 0-255
+  double red = 0;          // processed rgb, 0-255 range as read by the teams
+  double green = 0;
+  double blue = 0;
+  std::int32_t led_pwm = 0;
+  double integration_time = 100;  // ms
+  bool gesture = false;
+};
+
+struct Adi {
+  std::array<std::int32_t, ADI_PORT_COUNT> config{};
+  std::array<std::int32_t, ADI_PORT_COUNT> value{};
+};
+
+struct Controller {
+  bool connected = true;
+  std::array<std::int32_t, 4> analog{};   // indexed by controller_analog_e_t
+  std::array<bool, 12> digital{};         // indexed by button - E_CONTROLLER_DIGITAL_L1
+  std::array<bool, 12> digital_seen{};    // for get_digital_new_press
+  std::array<char, 3 * 20> text{};
+};
+
+struct Lcd {
+  bool initialized = false;
+  std::array<std::string, 8> lines;
+  std::uint8_t buttons = 0;  // LCD_BTN_LEFT | LCD_BTN_CENTER | LCD_BTN_RIGHT
+  std::uint32_t prints = 0;  // how many times a line was redrawn
+};
+
+/**
+ * The screen as drawn with LVGL, see src/pros/lvgl.cpp.
+ */
+struct Screen {
+  std::uint32_t objects = 0;  // LVGL objects made
+  std::uint32_t redraws = 0;  // times an object changed in a way that makes LVGL redraw it
+};
+
+struct Competition {
+  bool connected = false;
+  bool autonomous = false;
+  bool disabled = false;
+};
+
+/**
+ * Device accessors.  Constructing the matching pros:: object marks the port as
+ * installed; tests may also poke the state before any object exists.
+ */
+Motor& motor(int port);
+Imu& imu(int port);
+Rotation& rotation(int port);
+Distance& distance(int port);
+Gps& gps(int port);
+Optical& optical(int port);
+Adi& adi();
+Controller& controller(pros::controller_id_e_t id = pros::E_CONTROLLER_MASTER);
+Competition& competition();
+Lcd& lcd();
+Screen& screen();
+
+/**
+ * Text of every LVGL label that can be seen, top to bottom, then left to right.
+ */
+std::vector<std::string> screen_labels();
+
+/**
+ * Taps the screen on the top object that takes clicks.
+ */
+void tap_screen();
+
+/**
+ * What the brain sees plugged into a smart port.
+ */
+pros::DeviceType& plugged_type(int port);
+
+/**
+ * Battery voltage used by the motor models, mV.
+ */
+double& battery_voltage();
+
+/**
+ * Free speed of a cartridge at the output shaft, rpm.
+ */
+double free_speed(pros::MotorGears gearing);
+
+/**
+ * Stall torque of a cartridge at the output shaft, Nm.
+ */
+double stall_torque(pros::MotorGears gearing);
+
+/**
+ * Rotor inertia of a cartridge reflected to the output shaft, kg m^2.
+ */
+double rotor_inertia(pros::MotorGears gearing);
+
+/**
+ * Converts output shaft degrees to the motor's configured encoder units.
+ */
+double to_units(const Motor& motor, double degrees);
+
+/**
+ * Converts the motor's configured encoder units to output shaft degrees.
+ */
+double from_units(const Motor& motor, double value);
+
+/**
+ * Computes the voltage the motor firmware applies for the current command and
+ * the resulting torque and current.  Does not integrate motion.
+ */
+void motor_drive(Motor& motor, double dt);
+
+/**
+ * Steps every installed motor that is not owned by an external plant.
+ * Registered with the kernel automatically.
+ */
+void motors_step(double dt);
+
+/**
+ * Latches IMU, rotation, distance and GPS sensor readings that are due at this time, see
+ * Imu::data_rate.  Registered with the kernel automatically.
+ */
+void sensors_sample(std::uint32_t now_ms);
+
+}  // namespace sim
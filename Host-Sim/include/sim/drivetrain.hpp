@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "pros/abstract_motor.hpp"
+
+/**
+ * Skid-steer drivetrain plant.
+ *
+ * Takes the torque the simulated drive motors produce, pushes the robot around
+ * the field with it and writes the result back into the motor encoders, the
+ * IMU and any tracking wheels, so odometry and PID code see what they would on
+ * the real robot.  Wheels keep traction until the force on them passes what
+ * friction allows, then spin out; the body skids sideways once it turns
+ * faster than the side grip can hold.
+ */
+namespace sim {
+
+/**
+ * Field position.  Inches, and degrees clockwise from facing +y, the same as
+ * lemlib::Pose and the IMU heading.
+ */
+struct Pose {
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+};
+
+/**
+ * Vertical wheels count up driving forward and horizontal ones sliding left,
+ * the way lemlib odometry reads them.  The sensor's reversed flag is taken as
+ * mounted to match, so it doesn't change the reading.
+ */
+struct TrackingWheel {
+  int port = 0;            // rotation sensor port
+  double diameter = 2;     // in
+  double offset = 0;       // in, right of center for vertical wheels, forward of center for horizontal ones
+  bool horizontal = false;
+};
+
+/**
+ * A distance sensor on the robot.  The real beam is a narrow cone; a single
+ * ray is close enough against flat walls.
+ */
+struct DistanceSensor {
+  int port = 0;
+  double x = 0;      // in, right of center
+  double y = 0;      // in, forward of center
+  double angle = 0;  // deg clockwise from straight ahead
+};
+
+/**
+ * A straight piece of field wall or field element the distance sensors can
+ * see, in the same frame as the pose.
+ */
+struct Wall {
+  double x1 = 0;
+  double y1 = 0;
+  double x2 = 0;
+  double y2 = 0;
+};
+
+/**
+ * The first block mirrors the lemlib::Drivetrain and ez::Drive constructor
+ * parameters so a project can copy its own numbers in.  The rest is the
+ * physical robot; the defaults are a 15" skills-weight bot.
+ */
+struct DrivetrainConfig {
+  std::vector<int> left_motors;   // ports; the motors' own reversed flags set which way is forward
+  std::vector<int> right_motors;
+  double track_width = 13.5;      // in
+  double wheel_diameter = 2.75;   // in
+  double rpm = 450;               // wheel rpm at cartridge free speed
+  pros::MotorGears cartridge = pros::MotorGears::blue;  // what is physically in the motors
+  double horizontal_drift = 2;    // lemlib: 2 for all omnis, 8 with center traction wheels
+  int imu_port = 0;
+  std::vector<TrackingWheel> tracking_wheels;
+  std::vector<DistanceSensor> distance_sensors;
+  std::vector<Wall> walls;        // only used by the distance sensors, so the start pose has to be in their frame
+  int gps_port = 0;               // reports the pose as field position, so the start pose has to be one too
+
+  double mass = 6.8;                // kg
+  double inertia = 0.16;            // kg m^2 about the center of rotation
+  double traction = 1.0;            // wheel to tile friction coefficient, forward/back
+  double rolling_resistance = 0.03; // fraction of the robot's weight
+
+  // Per-run variation, used to spread trials
+  double left_strength = 1;  // motor torque scale
+  double right_strength = 1;
+  double imu_scale = 1;      // gyro scale error
+  double imu_drift = 0;      // deg/s
+};
+
+class Drivetrain {
+ public:
+  /**
+   * Takes over integrating the listed motors and registers the plant with
+   * the kernel.  The drivetrain must outlive the simulation, so make it a
+   * global or a static.
+   */
+  explicit Drivetrain(DrivetrainConfig config, Pose start = {});
+
+  Drivetrain(const Drivetrain&) = delete;
+  Drivetrain& operator=(const Drivetrain&) = delete;
+
+  const DrivetrainConfig& config() const;
+
+  /**
+   * Changes the physical parameters, including the per-run variation.  Wheel
+   * geometry and ports should not change once the sim is running.
+   */
+  void config_set(const DrivetrainConfig& config);
+
+  /**
+   * True position of the robot, which odometry is trying to estimate.
+   */
+  Pose pose() const;
+
+  /**
+   * Teleports the robot and stops it.  Sensors keep their readings, as if the
+   * robot were picked up and put down.
+   */
+  void pose_set(Pose pose);
+
+  /**
+   * Forward speed, in/s.
+   */
+  double velocity() const;
+
+  /**
+   * Turn rate, deg/s clockwise.
+   */
+  double angular_velocity() const;
+
+  /**
+   * Whether each side's wheels are spinning faster or slower than the ground
+   * under them.
+   */
+  bool left_slipping() const;
+  bool right_slipping() const;
+
+  /**
+   * Total distance driven, in, and the number of simulated milliseconds any
+   * wheel spent slipping.
+   */
+  double distance() const;
+  std::uint32_t slip_ms() const;
+
+ private:
+  struct Side {
+    double surface_speed = 0;  // m/s at the tread
+    bool slipping = false;
+  };
+
+  void step(double dt);
+  double drive_force(const std::vector<int>& ports, double strength, double& reflected_mass) const;
+  void side_step(Side& side, double force, double reflected_mass, double ground_speed, double& traction, double dt);
+  void sensors_step(double dt, double forward_accel, double lateral_accel);
+
+  DrivetrainConfig config_;
+  Pose pose_;
+  double velocity_ = 0;   // m/s forward
+  double lateral_ = 0;    // m/s to the right
+  double angular_ = 0;    // rad/s clockwise
+  Side left_;
+  Side right_;
+  double distance_ = 0;   // m
+  std::uint32_t slip_ms_ = 0;
+};
+
+}  // namespace sim
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+/**
+ * Host-side replacement for the PROS scheduler.
+ *
+ * Every pros::Task runs on its own host thread, but only one of them is ever
+ * allowed to execute at a time. A task keeps running until it blocks
+ * (pros::delay, a held pros::Mutex, notify_take, join), at which point the
+ * kernel hands control to the next ready task. When every task is blocked the
+ * simulated clock advances by one millisecond and all registered plants are
+ * stepped. Nothing depends on wall-clock time, so a run is fully deterministic
+ * and goes as fast as the host can execute the user code.
+ */
+namespace sim {
+
+/**
+ * Called once per simulated millisecond, after every task that was ready at
+ * the current time has blocked.
+ *
+ * \param now_ms
+ *        the time that is about to be entered, in milliseconds
+ * \param dt
+ *        the step size, in seconds
+ */
+using plant_fn_t = std::function<void(std::uint32_t now_ms, double dt)>;
+
+/**
+ * Returns the simulated time in milliseconds since the kernel started.
+ */
+std::uint32_t now_ms();
+
+/**
+ * Returns the simulated time in microseconds since the kernel started.
+ */
+std::uint64_t now_us();
+
+/**
+ * Registers a physics step.  Plants are stepped in registration order.
+ *
+ * \param plant
+ *        the function to call every simulated millisecond
+ */
+void plant_add(plant_fn_t plant);
+
+/**
+ * Registers a sensor sampler.  Samplers run after every plant has been
+ * stepped, so they latch what the plants just produced, the way a smart
+ * device sends the brain a reading every data rate period.
+ *
+ * \param sampler
+ *        the function to call every simulated millisecond
+ */
+void sampler_add(plant_fn_t sampler);
+
+/**
+ * Runs every task for the given amount of simulated time.  Must be called
+ * from the host thread (not from inside a pros::Task).
+ *
+ * \param ms
+ *        simulated milliseconds to run for
+ */
+void run_for(std::uint32_t ms);
+
+/**
+ * Runs every task until the condition is true or the timeout expires.  The
+ * condition is checked each simulated millisecond.
+ *
+ * \param done
+ *        condition to stop on
+ * \param timeout_ms
+ *        the maximum amount of simulated time to run for
+ *
+ * \return true if the condition was met, false if it timed out
+ */
+bool run_until(const std::function<bool()>& done, std::uint32_t timeout_ms);
+
+/**
+ * Starts a user function (initialize, autonomous, opcontrol...) in its own
+ * task and runs the kernel until it returns or the timeout expires.
+ *
+ * \param fn
+ *        the competition function to run
+ * \param timeout_ms
+ *        the maximum amount of simulated time to run for
+ *
+ * \return true if the function returned before the timeout
+ */
+bool run_task(void (*fn)(), std::uint32_t timeout_ms);
+
+/**
+ * Returns how many context switches the kernel has performed.
+ */
+std::uint64_t context_switches();
+
+}  // namespace sim
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Batch runner for Monte Carlo style runs of a routine.
+ *
+ * Every trial runs in a fresh copy of the current program, so each one starts
+ * from a clean kernel and clean device state no matter what the last one
+ * left running (competition code usually leaves tasks going forever).  The
+ * copies run in parallel across the host's cores.
+ */
+namespace sim {
+
+/**
+ * Runs one trial and returns its measurements.  The index is passed in so the
+ * trial can pick its own random seed and variation.
+ */
+using trial_fn_t = std::function<std::vector<double>(int trial)>;
+
+/**
+ * Runs `count` trials and collects their results in order.
+ *
+ * Call this from main() before starting any simulation: in a trial copy of the
+ * program it runs just that one trial and exits instead of returning.  Trial
+ * copies are started with the same arguments plus the trial flag at the end.
+ *
+ * \param argc, argv
+ *        main's arguments, used to recognise a trial copy
+ * \param count
+ *        how many trials to run
+ * \param trial
+ *        the trial to run
+ * \param jobs
+ *        how many trials to run at once, 0 uses every core
+ *
+ * \return one entry per trial, empty if that trial crashed
+ */
+std::vector<std::vector<double>> run_trials(int argc, char** argv, int count, const trial_fn_t& trial, int jobs = 0);
+
+struct Stats {
+  int count = 0;
+  double mean = 0;
+  double stddev = 0;
+  double min = 0;
+  double p50 = 0;
+  double p95 = 0;
+  double max = 0;
+};
+
+/**
+ * Summarises a set of measurements.
+ */
+Stats stats(std::vector<double> values);
+
+/**
+ * Formats stats as "mean 1.23 sd 0.45 min ... p50 ... p95 ... max ..." with
+ * the given number of decimals.
+ */
+std::string to_string(const Stats& stats, int precision = 2);
+
+}  // namespace sim
@@ -0,0 +1,185 @@
+#include "EZ-Template/PID.hpp"
+
+using namespace ez;
+
+PID::PID() {
+  variables_reset();
+  constants_set(0, 0, 0, 0);
+}
+
+PID::PID(double p, double i, double d, double start_i, std::string name) {
+  variables_reset();
+  constants_set(p, i, d, start_i);
+  name_set(name);
+}
+
+void PID::constants_set(double p, double i, double d, double p_start_i) { constants = {p, i, d, p_start_i}; }
+
+PID::Constants PID::constants_get() { return constants; }
+
+void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error,
+                             int p_velocity_exit_time, int p_mA_timeout) {
+  exit = {p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout};
+}
+
+void PID::target_set(double input) { target = input; }
+
+double PID::target_get() { return target; }
+
+void PID::variables_reset() {
+  output = 0;
+  target = 0;
+  error = 0;
+  prev_error = 0;
+  integral = 0;
+  time = 0;
+  prev_time = 0;
+}
+
+void PID::timers_reset() {
+  i = 0;
+  j = 0;
+  k = 0;
+  l = 0;
+  m = 0;
+  is_mA = false;
+}
+
+void PID::name_set(std::string p_name) {
+  name = p_name;
+  name_active = !name.empty();
+}
+
+std::string PID::name_get() { return name; }
+
+void PID::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
+
+bool PID::i_reset_get() { return reset_i_sgn; }
+
+double PID::compute(double current) {
+  error = target - current;
+  return compute_error(error, current);
+}
+
+double PID::compute_error(double err, double current) {
+  error = err;
+  cur = current;
+  return raw_compute();
+}
+
+double PID::raw_compute() {
+  // Derivative on measurement, so a new target does not kick the output
+  derivative = cur - prev_current;
+
+  if (constants.ki != 0) {
+    if (std::fabs(error) < constants.start_i) integral += error;
+    if (util::sgn(error) != util::sgn(prev_error) && reset_i_sgn) integral = 0;
+  }
+
+  output = (error * constants.kp) + (integral * constants.ki) - (derivative * constants.kd);
+
+  prev_current = cur;
+  prev_error = error;
+  return output;
+}
+
+void PID::velocity_sensor_secondary_set(double secondary_sensor) { second_sensor = secondary_sensor; }
+
+double PID::velocity_sensor_secondary_get() { return second_sensor; }
+
+void PID::velocity_sensor_secondary_toggle_set(bool toggle) { use_second_sensor = toggle; }
+
+bool PID::velocity_sensor_secondary_toggle_get() { return use_second_sensor; }
+
+void PID::velocity_sensor_main_exit_set(double zero) { velocity_zero_main = zero; }
+
+double PID::velocity_sensor_main_exit_get() { return velocity_zero_main; }
+
+void PID::velocity_sensor_secondary_exit_set(double zero) { velocity_zero_secondary = zero; }
+
+double PID::velocity_sensor_secondary_exit_get() { return velocity_zero_secondary; }
+
+void PID::exit_condition_print(ez::exit_output exit_type) {
+  std::cout << " ";
+  if (name_active) std::cout << name << " ";
+  std::cout << "PID " << exit_to_string(exit_type) << " Exit.\n";
+}
+
+ez::exit_output PID::exit_condition(bool print) {
+  if (!(exit.small_error || exit.small_exit_time || exit.big_error || exit.big_exit_time || exit.velocity_exit_time ||
+        exit.mA_timeout)) {
+    if (print) exit_condition_print(ERROR_NO_CONSTANTS);
+    return ERROR_NO_CONSTANTS;
+  }
+
+  // Settled inside the small error for long enough
+  if (exit.small_error != 0) {
+    if (std::fabs(error) < exit.small_error) {
+      j += util::DELAY_TIME;
+      i = 0;  // the big timer does not run while the small one does
+      if (j > exit.small_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(SMALL_EXIT);
+        return SMALL_EXIT;
+      }
+    } else {
+      j = 0;
+    }
+  }
+
+  // Close to the target but not getting any closer
+  if (exit.big_error != 0 && exit.big_exit_time != 0) {
+    if (std::fabs(error) < exit.big_error) {
+      i += util::DELAY_TIME;
+      if (i > exit.big_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(BIG_EXIT);
+        return BIG_EXIT;
+      }
+    } else {
+      i = 0;
+    }
+  }
+
+  // Not moving at all
+  if (exit.velocity_exit_time != 0) {
+    const bool main_stopped = std::fabs(derivative) <= velocity_zero_main;
+    const bool secondary_stopped = !use_second_sensor || std::fabs(second_sensor) <= velocity_zero_secondary;
+    if (main_stopped && secondary_stopped) {
+      k += util::DELAY_TIME;
+      if (k > exit.velocity_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(VELOCITY_EXIT);
+        return VELOCITY_EXIT;
+      }
+    } else {
+      k = 0;
+    }
+  }
+
+  return RUNNING;
+}
+
+ez::exit_output PID::exit_condition(pros::Motor sensor, bool print) {
+  return exit_condition(std::vector<pros::Motor>{sensor}, print);
+}
+
+ez::exit_output PID::exit_condition(std::vector<pros::Motor> sensor, bool print) {
+  // Pushing against something: every motor is at its current limit
+  if (exit.mA_timeout != 0) {
+    bool over = !sensor.empty();
+    for (auto& motor : sensor) over = over && motor.is_over_current();
+    is_mA = over;
+    if (is_mA) {
+      l += util::DELAY_TIME;
+      if (l > exit.mA_timeout) {
+        timers_reset();
+        if (print) exit_condition_print(mA_EXIT);
+        return mA_EXIT;
+      }
+    } else {
+      l = 0;
+    }
+  }
+  return exit_condition(print);
+}
@@ -0,0 +1,13 @@
+#include "EZ-Template/auton.hpp"
+
+using namespace ez;
+
+Auton::Auton() {
+  Name = "";
+  auton_call = nullptr;
+}
+
+Auton::Auton(std::string name, std::function<void()> callback) {
+  Name = name;
+  auton_call = callback;
+}
@@ -0,0 +1,33 @@
+#include "EZ-Template/auton_selector.hpp"
+
+#include "EZ-Template/util.hpp"
+
+using namespace ez;
+
+AutonSelector::AutonSelector() {
+  auton_count = 0;
+  auton_page_current = 0;
+  Autons = {};
+}
+
+AutonSelector::AutonSelector(std::vector<Auton> autons) {
+  auton_count = autons.size();
+  auton_page_current = 0;
+  Autons = autons;
+}
+
+void AutonSelector::selected_auton_print() {
+  if (auton_count == 0) return;
+  for (int i = 0; i < 8; i++) pros::lcd::clear_line(i);
+  ez::screen_print("Page " + std::to_string(auton_page_current + 1) + "\n" + Autons[auton_page_current].Name);
+}
+
+void AutonSelector::selected_auton_call() {
+  if (auton_count != 0 && Autons[auton_page_current].auton_call) Autons[auton_page_current].auton_call();
+}
+
+void AutonSelector::autons_add(std::vector<Auton> autons) {
+  auton_count += autons.size();
+  auton_page_current = 0;
+  Autons.insert(Autons.end(), autons.begin(), autons.end());
+}
@@ -0,0 +1,299 @@
+#include "EZ-Template/drive/drive.hpp"
+
+#include "EZ-Template/sdcard.hpp"
+
+using namespace ez;
+
+namespace {
+
+pros::Motor drive_motor(int port) {
+  pros::Motor motor(port);
+  // Tick math below assumes encoder counts, whatever the cartridge
+  motor.set_encoder_units(pros::MotorUnits::counts);
+  return motor;
+}
+
+}  // namespace
+
+// Integrated encoders
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter,
+             double ticks, double ratio)
+    : imu(imu_port),
+      left_tracker(-1, -1, false),  // placeholder
+      right_tracker(-1, -1, false),
+      left_rotation(-1),
+      right_rotation(-1),
+      ez_auto([this] { this->ez_auto_task(); }) {
+  is_tracker = DRIVE_INTEGRATED;
+  for (auto i : left_motor_ports) left_motors.push_back(drive_motor(i));
+  for (auto i : right_motor_ports) right_motors.push_back(drive_motor(i));
+
+  WHEEL_DIAMETER = wheel_diameter;
+  RATIO = ratio;
+  CARTRIDGE = ticks;
+  TICK_PER_INCH = drive_tick_per_inch();
+
+  drive_defaults_set();
+}
+
+// ADI encoders on the brain
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter,
+             double ticks, double ratio, std::vector<int> left_tracker_ports, std::vector<int> right_tracker_ports)
+    : imu(imu_port),
+      left_tracker(abs(left_tracker_ports[0]), abs(left_tracker_ports[1]), util::reversed_active(left_tracker_ports[0])),
+      right_tracker(abs(right_tracker_ports[0]), abs(right_tracker_ports[1]), util::reversed_active(right_tracker_ports[0])),
+      left_rotation(-1),
+      right_rotation(-1),
+      ez_auto([this] { this->ez_auto_task(); }) {
+  is_tracker = DRIVE_ADI_ENCODER;
+  for (auto i : left_motor_ports) left_motors.push_back(drive_motor(i));
+  for (auto i : right_motor_ports) right_motors.push_back(drive_motor(i));
+
+  WHEEL_DIAMETER = wheel_diameter;
+  RATIO = ratio;
+  CARTRIDGE = ticks;
+  TICK_PER_INCH = drive_tick_per_inch();
+
+  drive_defaults_set();
+}
+
+// ADI encoders on a 3 wire expander
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter,
+             double ticks, double ratio, std::vector<int> left_tracker_ports, std::vector<int> right_tracker_ports,
+             int expander_smart_port)
+    : imu(imu_port),
+      left_tracker(pros::adi::ext_adi_port_tuple_t(expander_smart_port, abs(left_tracker_ports[0]), abs(left_tracker_ports[1])),
+                   util::reversed_active(left_tracker_ports[0])),
+      right_tracker(pros::adi::ext_adi_port_tuple_t(expander_smart_port, abs(right_tracker_ports[0]), abs(right_tracker_ports[1])),
+                    util::reversed_active(right_tracker_ports[0])),
+      left_rotation(-1),
+      right_rotation(-1),
+      ez_auto([this] { this->ez_auto_task(); }) {
+  is_tracker = DRIVE_ADI_ENCODER;
+  for (auto i : left_motor_ports) left_motors.push_back(drive_motor(i));
+  for (auto i : right_motor_ports) right_motors.push_back(drive_motor(i));
+
+  WHEEL_DIAMETER = wheel_diameter;
+  RATIO = ratio;
+  CARTRIDGE = ticks;
+  TICK_PER_INCH = drive_tick_per_inch();
+
+  drive_defaults_set();
+}
+
+// Rotation sensors
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter,
+             double ratio, int left_rotation_port, int right_rotation_port)
+    : imu(imu_port),
+      left_tracker(-1, -1, false),  // placeholder
+      right_tracker(-1, -1, false),
+      left_rotation(left_rotation_port),
+      right_rotation(right_rotation_port),
+      ez_auto([this] { this->ez_auto_task(); }) {
+  is_tracker = DRIVE_ROTATION;
+  for (auto i : left_motor_ports) left_motors.push_back(drive_motor(i));
+  for (auto i : right_motor_ports) right_motors.push_back(drive_motor(i));
+
+  WHEEL_DIAMETER = wheel_diameter;
+  RATIO = ratio;
+  CARTRIDGE = 36000;  // centidegrees per turn
+  TICK_PER_INCH = drive_tick_per_inch();
+
+  drive_defaults_set();
+}
+
+void Drive::drive_defaults_set() {
+  // PID constants
+  pid_heading_constants_set(11, 0, 20);
+  pid_drive_constants_set(20, 0, 100);
+  pid_turn_constants_set(3, 0.05, 20, 15);
+  pid_swing_constants_set(6, 0, 65);
+  pid_turn_min_set(30);
+  pid_swing_min_set(30);
+
+  // Exit conditions
+  pid_turn_exit_condition_set(80, 3, 250, 7, 500, 500);
+  pid_swing_exit_condition_set(80, 3, 250, 7, 500, 500);
+  pid_drive_exit_condition_set(80, 1, 250, 3, 500, 500);
+
+  // Motion chaining
+  pid_turn_chain_constant_set(3.0);
+  pid_swing_chain_constant_set(5.0);
+  pid_drive_chain_constant_set(3.0);
+
+  // Slew
+  slew_drive_constants_set(7 * okapi::inch, 80);
+  slew_swing_constants_set(7 * okapi::inch, 80);
+  slew_turn_constants_set(3 * okapi::degree, 70);
+
+  // Joysticks
+  opcontrol_curve_buttons_toggle(false);
+  opcontrol_curve_buttons_left_set(pros::E_CONTROLLER_DIGITAL_LEFT, pros::E_CONTROLLER_DIGITAL_RIGHT);
+  opcontrol_curve_buttons_right_set(pros::E_CONTROLLER_DIGITAL_Y, pros::E_CONTROLLER_DIGITAL_A);
+  opcontrol_curve_default_set(0, 0);
+  opcontrol_joystick_threshold_set(5);
+
+  pid_drive_toggle(true);
+  pid_print_toggle(true);
+  pid_speed_max_set(127);
+  drive_mode_set(DISABLE);
+  current_swing = LEFT_SWING;
+  is_tank = false;
+}
+
+double Drive::drive_tick_per_inch() {
+  CIRCUMFERENCE = WHEEL_DIAMETER * M_PI;
+  if (is_tracker == DRIVE_ADI_ENCODER || is_tracker == DRIVE_ROTATION)
+    TICK_PER_REV = CARTRIDGE * RATIO;
+  else
+    TICK_PER_REV = (50.0 * (3600.0 / CARTRIDGE)) * RATIO;  // counts per wheel turn for any cartridge
+  TICK_PER_INCH = TICK_PER_REV / CIRCUMFERENCE;
+  return TICK_PER_INCH;
+}
+
+void Drive::drive_ratio_set(double ratio) { RATIO = ratio; }
+
+double Drive::drive_ratio_get() { return RATIO; }
+
+void Drive::drive_rpm_set(double rpm) { CARTRIDGE = rpm; }
+
+double Drive::drive_rpm_get() { return CARTRIDGE; }
+
+void Drive::initialize() {
+  opcontrol_curve_sd_initialize();
+  drive_imu_calibrate();
+  drive_sensor_reset();
+}
+
+void Drive::drive_mode_set(e_mode p_mode) { mode = p_mode; }
+
+e_mode Drive::drive_mode_get() { return mode; }
+
+void Drive::private_drive_set(int left, int right) {
+  for (auto& motor : left_motors)
+    if (!pto_check(motor)) motor.move_voltage(left * (12000.0 / 127.0));
+  for (auto& motor : right_motors)
+    if (!pto_check(motor)) motor.move_voltage(right * (12000.0 / 127.0));
+}
+
+void Drive::drive_set(int left, int right) {
+  drive_mode_set(DISABLE);
+  private_drive_set(left, right);
+}
+
+std::vector<int> Drive::drive_get() {
+  return {static_cast<int>(left_motors.front().get_voltage() * 127.0 / 12000.0),
+          static_cast<int>(right_motors.front().get_voltage() * 127.0 / 12000.0)};
+}
+
+void Drive::drive_brake_set(pros::motor_brake_mode_e_t brake_type) {
+  CURRENT_BRAKE = brake_type;
+  for (auto& motor : left_motors) motor.set_brake_mode(brake_type);
+  for (auto& motor : right_motors) motor.set_brake_mode(brake_type);
+}
+
+pros::motor_brake_mode_e_t Drive::drive_brake_get() { return CURRENT_BRAKE; }
+
+void Drive::drive_current_limit_set(int mA) {
+  CURRENT_MA = util::clamp(mA, 2500, 0);
+  for (auto& motor : left_motors) motor.set_current_limit(CURRENT_MA);
+  for (auto& motor : right_motors) motor.set_current_limit(CURRENT_MA);
+}
+
+int Drive::drive_current_limit_get() { return CURRENT_MA; }
+
+void Drive::pid_drive_toggle(bool toggle) { drive_toggle = toggle; }
+
+bool Drive::pid_drive_toggle_get() { return drive_toggle; }
+
+void Drive::pid_print_toggle(bool toggle) { print_toggle = toggle; }
+
+bool Drive::pid_print_toggle_get() { return print_toggle; }
+
+/////
+// Telemetry
+/////
+
+int Drive::drive_sensor_right_raw() {
+  if (is_tracker == DRIVE_ADI_ENCODER) return right_tracker.get_value();
+  if (is_tracker == DRIVE_ROTATION) return right_rotation.get_position();
+  return right_motors.front().get_position();
+}
+
+double Drive::drive_sensor_right() { return drive_sensor_right_raw() / drive_tick_per_inch(); }
+
+int Drive::drive_velocity_right() { return right_motors.front().get_actual_velocity(); }
+
+double Drive::drive_mA_right() { return right_motors.front().get_current_draw(); }
+
+bool Drive::drive_current_right_over() { return right_motors.front().is_over_current(); }
+
+int Drive::drive_sensor_left_raw() {
+  if (is_tracker == DRIVE_ADI_ENCODER) return left_tracker.get_value();
+  if (is_tracker == DRIVE_ROTATION) return left_rotation.get_position();
+  return left_motors.front().get_position();
+}
+
+double Drive::drive_sensor_left() { return drive_sensor_left_raw() / drive_tick_per_inch(); }
+
+int Drive::drive_velocity_left() { return left_motors.front().get_actual_velocity(); }
+
+double Drive::drive_mA_left() { return left_motors.front().get_current_draw(); }
+
+bool Drive::drive_current_left_over() { return left_motors.front().is_over_current(); }
+
+void Drive::drive_sensor_reset() {
+  for (auto& motor : left_motors) motor.tare_position();
+  for (auto& motor : right_motors) motor.tare_position();
+  if (is_tracker == DRIVE_ADI_ENCODER) {
+    left_tracker.reset();
+    right_tracker.reset();
+  } else if (is_tracker == DRIVE_ROTATION) {
+    left_rotation.reset_position();
+    right_rotation.reset_position();
+  }
+}
+
+void Drive::drive_imu_reset(double new_heading) { imu.set_rotation(new_heading); }
+
+double Drive::drive_imu_get() { return imu.get_rotation() * IMU_SCALER; }
+
+double Drive::drive_imu_accel_get() { return imu.get_accel().x + imu.get_accel().y; }
+
+void Drive::drive_imu_scaler_set(double scaler) { IMU_SCALER = scaler; }
+
+double Drive::drive_imu_scaler_get() { return IMU_SCALER; }
+
+void Drive::drive_imu_display_loading(int iter) {
+  // A bar across the screen while the IMU calibrates
+  const int filled = std::min(iter, 2000) * 20 / 2000;
+  ez::screen_print("Calibrating IMU\n[" + std::string(filled, '#') + std::string(20 - filled, ' ') + "]", 0);
+}
+
+bool Drive::drive_imu_calibrate(bool run_loading_animation) {
+  imu.reset();
+  int iter = 0;
+  while (true) {
+    iter += util::DELAY_TIME;
+    if (run_loading_animation) drive_imu_display_loading(iter);
+    if (iter >= 2000) {
+      if (!imu.is_calibrating()) break;
+      if (iter >= 3000) {
+        printf("No IMU plugged in, (took %d ms to realize that)\n", iter);
+        return false;
+      }
+    }
+    pros::delay(util::DELAY_TIME);
+  }
+  master.rumble(".");
+  printf("IMU is done calibrating (took %d ms)\n", iter);
+  return true;
+}
+
+void Drive::opcontrol_joystick_practicemode_toggle(bool toggle) { practice_mode_is_on = toggle; }
+
+bool Drive::opcontrol_joystick_practicemode_toggle_get() { return practice_mode_is_on; }
+
+void Drive::opcontrol_drive_reverse_set(bool toggle) { is_reversed = toggle; }
+
+bool Drive::opcontrol_drive_reverse_get() { return is_reversed; }
@@ -0,0 +1,159 @@
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+namespace {
+
+bool interference(exit_output exit) { return exit == mA_EXIT || exit == VELOCITY_EXIT; }
+
+}  // namespace
+
+void Drive::pid_wait() {
+  interfered = false;
+
+  if (mode == DRIVE) {
+    exit_output left_exit = RUNNING;
+    exit_output right_exit = RUNNING;
+    while (left_exit == RUNNING || right_exit == RUNNING) {
+      leftPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+      rightPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+      left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+      right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) std::cout << "  Left: " << exit_to_string(left_exit) << " Exit.   Right: " << exit_to_string(right_exit) << " Exit.\n";
+    interfered = interference(left_exit) || interference(right_exit);
+  } else if (mode == TURN) {
+    exit_output turn_exit = RUNNING;
+    while (turn_exit == RUNNING) {
+      turnPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+      turn_exit = turnPID.exit_condition({left_motors[0], right_motors[0]});
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) std::cout << "  Turn: " << exit_to_string(turn_exit) << " Exit.\n";
+    interfered = interference(turn_exit);
+  } else if (mode == SWING) {
+    exit_output swing_exit = RUNNING;
+    pros::Motor& sensor = current_swing == LEFT_SWING ? left_motors[0] : right_motors[0];
+    while (swing_exit == RUNNING) {
+      swingPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+      swing_exit = swingPID.exit_condition(sensor);
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) std::cout << "  Swing: " << exit_to_string(swing_exit) << " Exit.\n";
+    interfered = interference(swing_exit);
+  }
+}
+
+void Drive::wait_until_drive(double target) {
+  const double l_tar = l_start + target;
+  const double r_tar = r_start + target;
+  const int l_sgn = util::sgn(l_tar - drive_sensor_left());
+  const int r_sgn = util::sgn(r_tar - drive_sensor_right());
+  exit_output left_exit = RUNNING;
+  exit_output right_exit = RUNNING;
+
+  while (true) {
+    const double l_error = l_tar - drive_sensor_left();
+    const double r_error = r_tar - drive_sensor_right();
+
+    // Once either side passes the point, stop waiting
+    if (util::sgn(l_error) != l_sgn || util::sgn(r_error) != r_sgn) {
+      if (print_toggle) std::cout << "  Drive Wait Until Exit Success, Triggered at: L,R(" << drive_sensor_left() - l_start << ", " << drive_sensor_right() - r_start << ")  Target: L,R(" << target << ", " << target << ")\n";
+      return;
+    }
+
+    // Exit conditions keep a blocked robot from waiting here forever
+    if (left_exit != RUNNING && right_exit != RUNNING) {
+      if (print_toggle) std::cout << "  Left: " << exit_to_string(left_exit) << " Wait Until Exit Failed.   Right: " << exit_to_string(right_exit) << " Wait Until Exit Failed.\n";
+      interfered = interference(left_exit) || interference(right_exit);
+      return;
+    }
+    leftPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+    rightPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+    left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+    right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+void Drive::wait_until_turn_swing(double target) {
+  const int g_sgn = util::sgn(target - drive_imu_get());
+  exit_output exit = RUNNING;
+  PID& pid = mode == TURN ? turnPID : swingPID;
+
+  while (true) {
+    const double g_error = target - drive_imu_get();
+
+    if (util::sgn(g_error) != g_sgn) {
+      if (print_toggle) std::cout << "  Turn/Swing Wait Until Exit Success, Triggered at: " << drive_imu_get() << "  Target: " << target << "\n";
+      return;
+    }
+
+    if (exit != RUNNING) {
+      if (print_toggle) std::cout << "  " << exit_to_string(exit) << " Wait Until Exit Failed.\n";
+      interfered = interference(exit);
+      return;
+    }
+    pid.velocity_sensor_secondary_set(drive_imu_accel_get());
+    if (mode == TURN)
+      exit = pid.exit_condition({left_motors[0], right_motors[0]});
+    else
+      exit = pid.exit_condition(current_swing == LEFT_SWING ? left_motors[0] : right_motors[0]);
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+void Drive::pid_wait_until(double target) {
+  interfered = false;
+  if (mode == DRIVE)
+    wait_until_drive(target);
+  else if (mode == TURN || mode == SWING)
+    wait_until_turn_swing(target);
+  else
+    printf("Not in a valid drive mode!\n");
+}
+
+void Drive::pid_wait_until(okapi::QLength target) {
+  if (mode != DRIVE) {
+    printf("QLength not supported for turn or swing!\n");
+    return;
+  }
+  pid_wait_until(target.convert(okapi::inch));
+}
+
+void Drive::pid_wait_until(okapi::QAngle target) {
+  if (mode == DRIVE) {
+    printf("QAngle not supported for drive!\n");
+    return;
+  }
+  pid_wait_until(target.convert(okapi::degree));
+}
+
+void Drive::pid_wait_quick() {
+  if (mode == DISABLE) return;
+  pid_wait_until(chain_target_start);
+}
+
+// Pushes the target past where the motion should end and returns as soon as
+// the robot crosses the real one, so the next motion starts while still moving
+void Drive::pid_wait_quick_chain() {
+  if (mode == DRIVE) {
+    used_motion_chain_scale = motion_chain_backward ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+    const double extra = motion_chain_backward ? -used_motion_chain_scale : used_motion_chain_scale;
+    leftPID.target_set(leftPID.target_get() + extra);
+    rightPID.target_set(rightPID.target_get() + extra);
+    pid_wait_until(chain_target_start);
+  } else if (mode == TURN || mode == SWING) {
+    const bool forward = chain_target_start > chain_sensor_start;
+    if (mode == TURN)
+      used_motion_chain_scale = turn_motion_chain_scale;
+    else
+      used_motion_chain_scale = forward == (current_swing == LEFT_SWING) ? swing_forward_motion_chain_scale : swing_backward_motion_chain_scale;
+    PID& pid = mode == TURN ? turnPID : swingPID;
+    pid.target_set(pid.target_get() + (forward ? used_motion_chain_scale : -used_motion_chain_scale));
+    pid_wait_until(chain_target_start);
+  } else {
+    printf("Not in a valid drive mode!\n");
+  }
+}
@@ -0,0 +1,94 @@
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+void Drive::ez_auto_task() {
+  while (true) {
+    if (drive_mode_get() == SWING)
+      swing_pid_task();
+    else if (drive_mode_get() == TURN)
+      turn_pid_task();
+    else if (drive_mode_get() == DRIVE)
+      drive_pid_task();
+
+    // Leaving autonomous hands the drive back to the driver
+    if (pros::competition::is_autonomous()) {
+      util::AUTON_RAN = true;
+    } else if (util::AUTON_RAN && drive_mode_get() != DISABLE) {
+      drive_mode_set(DISABLE);
+    }
+
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+void Drive::drive_pid_task() {
+  leftPID.compute(drive_sensor_left());
+  rightPID.compute(drive_sensor_right());
+  headingPID.compute(drive_imu_get());
+
+  slew_left.iterate(drive_sensor_left());
+  slew_right.iterate(drive_sensor_right());
+
+  // Slew returns max_speed once it is done or disabled
+  const double l_drive_out = util::clamp(leftPID.output, slew_left.output(), -slew_left.output());
+  const double r_drive_out = util::clamp(rightPID.output, slew_right.output(), -slew_right.output());
+
+  const double gyro_out = heading_on ? headingPID.output : 0;
+  double l_out = l_drive_out + gyro_out;
+  double r_out = r_drive_out - gyro_out;
+
+  // Scale both sides together so heading correction never saturates one side
+  const double max_slew_out = fmin(slew_left.output(), slew_right.output());
+  if (fabs(l_out) > max_slew_out || fabs(r_out) > max_slew_out) {
+    if (fabs(l_out) > fabs(r_out)) {
+      r_out = r_out * (max_slew_out / fabs(l_out));
+      l_out = util::clamp(l_out, max_slew_out, -max_slew_out);
+    } else {
+      l_out = l_out * (max_slew_out / fabs(r_out));
+      r_out = util::clamp(r_out, max_slew_out, -max_slew_out);
+    }
+  }
+
+  if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::turn_pid_task() {
+  turnPID.compute(drive_imu_get());
+  slew_turn.iterate(drive_imu_get());
+
+  double gyro_out = util::clamp(turnPID.output, slew_turn.output(), -slew_turn.output());
+
+  // Inside start_i the output can get too small to move the robot, hold it at the minimum
+  const PID::Constants consts = turnPID.constants_get();
+  if (consts.ki != 0 && fabs(turnPID.target_get()) > consts.start_i && fabs(turnPID.error) < consts.start_i) {
+    if (pid_turn_min_get() != 0) gyro_out = util::clamp(gyro_out, pid_turn_min_get(), -pid_turn_min_get());
+  }
+
+  if (drive_toggle) private_drive_set(gyro_out, -gyro_out);
+}
+
+void Drive::swing_pid_task() {
+  swingPID.compute(drive_imu_get());
+  if (slew_swing_using_angle)
+    slew_swing.iterate(drive_imu_get());
+  else
+    slew_swing.iterate(current_swing == LEFT_SWING ? drive_sensor_left() : drive_sensor_right());
+
+  double swing_out = util::clamp(swingPID.output, slew_swing.output(), -slew_swing.output());
+
+  const PID::Constants consts = swingPID.constants_get();
+  if (consts.ki != 0 && fabs(swingPID.target_get()) > consts.start_i && fabs(swingPID.error) < consts.start_i) {
+    if (pid_swing_min_get() != 0) swing_out = util::clamp(swing_out, pid_swing_min_get(), -pid_swing_min_get());
+  }
+
+  // The other side follows at the same fraction of its own speed
+  const double opposite_out = max_speed == 0 ? 0 : swing_out * swing_opposite_speed / max_speed;
+
+  if (drive_toggle) {
+    if (current_swing == LEFT_SWING)
+      private_drive_set(swing_out, opposite_out);
+    else
+      private_drive_set(-opposite_out, -swing_out);
+  }
+}
@@ -0,0 +1,132 @@
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+void Drive::pid_tuner_brain_init() {
+  constants = {
+      {"Drive Forward PID Constants", &forward_drivePID.constants},
+      {"Drive Backward PID Constants", &backward_drivePID.constants},
+      {"Heading PID Constants", &headingPID.constants},
+      {"Turn PID Constants", &turnPID.constants},
+      {"Swing Forward PID Constants", &forward_swingPID.constants},
+      {"Swing Backward PID Constants", &backward_swingPID.constants},
+  };
+  column = 0;
+  row = 0;
+}
+
+void Drive::pid_tuner_enable() {
+  if (constants.empty()) pid_tuner_brain_init();
+  pid_tuner_on = true;
+  pid_tuner_print();
+}
+
+void Drive::pid_tuner_disable() {
+  pid_tuner_on = false;
+}
+
+void Drive::pid_tuner_toggle() {
+  if (pid_tuner_on)
+    pid_tuner_disable();
+  else
+    pid_tuner_enable();
+}
+
+bool Drive::pid_tuner_enabled() { return pid_tuner_on; }
+
+void Drive::pid_tuner_print_brain_set(bool input) { pid_tuner_lcd_b = input; }
+
+void Drive::pid_tuner_print_terminal_set(bool input) { pid_tuner_terminal_b = input; }
+
+bool Drive::pid_tuner_print_terminal_enabled() { return pid_tuner_terminal_b; }
+
+bool Drive::pid_tuner_print_brain_enabled() { return pid_tuner_lcd_b; }
+
+void Drive::pid_tuner_increment_p_set(double p) { p_increment = fabs(p); }
+
+void Drive::pid_tuner_increment_i_set(double i) { i_increment = fabs(i); }
+
+void Drive::pid_tuner_increment_d_set(double d) { d_increment = fabs(d); }
+
+void Drive::pid_tuner_increment_start_i_set(double start_i) { start_i_increment = fabs(start_i); }
+
+double Drive::pid_tuner_increment_p_get() { return p_increment; }
+
+double Drive::pid_tuner_increment_i_get() { return i_increment; }
+
+double Drive::pid_tuner_increment_d_get() { return d_increment; }
+
+double Drive::pid_tuner_increment_start_i_get() { return start_i_increment; }
+
+void Drive::pid_tuner_print() {
+  if (!pid_tuner_on) return;
+
+  const PID::Constants& consts = *constants[column].consts;
+  const std::string names[] = {"kp: ", "ki: ", "kd: ", "start i: "};
+  const double values[] = {consts.kp, consts.ki, consts.kd, consts.start_i};
+
+  complete_pid_tuner_output = constants[column].name + "\n";
+  for (int i = 0; i < 4; i++) {
+    char value[32];
+    snprintf(value, sizeof(value), "%.3f", values[i]);
+    complete_pid_tuner_output += names[i] + value;
+    complete_pid_tuner_output += i == row ? arrow : "\n";
+  }
+
+  pid_tuner_print_brain();
+  pid_tuner_print_terminal();
+}
+
+void Drive::pid_tuner_print_brain() {
+  if (pid_tuner_lcd_b) ez::screen_print(complete_pid_tuner_output);
+}
+
+void Drive::pid_tuner_print_terminal() {
+  if (pid_tuner_terminal_b) std::cout << complete_pid_tuner_output << "\n";
+}
+
+void Drive::pid_tuner_value_modify(float p, float i, float d, float start) {
+  PID::Constants& consts = *constants[column].consts;
+  switch (row) {
+    case 0:
+      consts.kp = fmax(consts.kp + p, 0);
+      break;
+    case 1:
+      consts.ki = fmax(consts.ki + i, 0);
+      break;
+    case 2:
+      consts.kd = fmax(consts.kd + d, 0);
+      break;
+    case 3:
+      consts.start_i = fmax(consts.start_i + start, 0);
+      break;
+  }
+}
+
+void Drive::pid_tuner_value_increase() { pid_tuner_value_modify(p_increment, i_increment, d_increment, start_i_increment); }
+
+void Drive::pid_tuner_value_decrease() { pid_tuner_value_modify(-p_increment, -i_increment, -d_increment, -start_i_increment); }
+
+// Left/right picks the constants, up/down the term, A/Y changes it
+void Drive::pid_tuner_iterate() {
+  if (!pid_tuner_on) return;
+
+  const int count = constants.size();
+  bool changed = true;
+  if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT))
+    column = (column + 1) % count;
+  else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT))
+    column = (column + count - 1) % count;
+  else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN))
+    row = (row + 1) % 4;
+  else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_UP))
+    row = (row + 3) % 4;
+  else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A))
+    pid_tuner_value_increase();
+  else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_Y))
+    pid_tuner_value_decrease();
+  else
+    changed = false;
+
+  if (changed) pid_tuner_print();
+}
@@ -0,0 +1,29 @@
+#include "EZ-Template/piston.hpp"
+
+using namespace ez;
+
+Piston::Piston(int input_port, bool default_state) : piston(input_port, default_state) { reversed = default_state; }
+
+Piston::Piston(int input_port, int expander_smart_port, bool default_state)
+    : piston(pros::adi::ext_adi_port_pair_t(expander_smart_port, input_port), default_state) {
+  reversed = default_state;
+}
+
+void Piston::set(bool input) {
+  piston.set_value(reversed ? !input : input);
+  current = input;
+}
+
+bool Piston::get() { return current; }
+
+void Piston::button_toggle(int toggle) {
+  if (toggle && !last_press) set(!get());
+  last_press = toggle;
+}
+
+void Piston::buttons(int active, int deactive) {
+  if (active && !get())
+    set(true);
+  else if (deactive && get())
+    set(false);
+}
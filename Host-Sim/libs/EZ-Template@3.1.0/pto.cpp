@@ -0,0 +1,35 @@
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+bool Drive::pto_check(pros::Motor check_if_pto) {
+  const int port = check_if_pto.get_port();
+  for (auto i : pto_active)
+    if (i == port) return true;
+  return false;
+}
+
+void Drive::pto_add(std::vector<pros::Motor> pto_list) {
+  for (auto& motor : pto_list) {
+    // The first motor on each side is the drive sensor and has to stay on the drive
+    if (motor.get_port() == left_motors[0].get_port() || motor.get_port() == right_motors[0].get_port()) {
+      printf("You cannot PTO your first motor!\n");
+      return;
+    }
+    if (!pto_check(motor)) pto_active.push_back(motor.get_port());
+  }
+}
+
+void Drive::pto_remove(std::vector<pros::Motor> pto_list) {
+  for (auto& motor : pto_list) {
+    auto position = std::find(pto_active.begin(), pto_active.end(), motor.get_port());
+    if (position != pto_active.end()) pto_active.erase(position);
+  }
+}
+
+void Drive::pto_toggle(std::vector<pros::Motor> pto_list, bool toggle) {
+  if (toggle)
+    pto_add(pto_list);
+  else
+    pto_remove(pto_list);
+}
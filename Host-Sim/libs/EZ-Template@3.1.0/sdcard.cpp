@@ -0,0 +1,54 @@
+#include "EZ-Template/sdcard.hpp"
+
+#include "EZ-Template/util.hpp"
+
+// The sim has no SD card, so the selected page always starts at 0 and is
+// never saved
+namespace ez::as {
+
+AutonSelector auton_selector{};
+bool turn_off = false;
+pros::adi::DigitalIn* limit_switch_left = nullptr;
+pros::adi::DigitalIn* limit_switch_right = nullptr;
+
+void auto_sd_update() {}
+
+void auton_selector_initialize() { auton_selector.auton_page_current = 0; }
+
+void page_up() {
+  if (auton_selector.auton_count == 0) return;
+  auton_selector.auton_page_current = (auton_selector.auton_page_current + 1) % auton_selector.auton_count;
+  auton_selector.selected_auton_print();
+}
+
+void page_down() {
+  if (auton_selector.auton_count == 0) return;
+  auton_selector.auton_page_current =
+      (auton_selector.auton_page_current + auton_selector.auton_count - 1) % auton_selector.auton_count;
+  auton_selector.selected_auton_print();
+}
+
+void initialize() {
+  pros::lcd::initialize();
+  auton_selector_initialize();
+  pros::lcd::register_btn0_cb(page_down);
+  pros::lcd::register_btn2_cb(page_up);
+  auton_selector_running = true;
+  auton_selector.selected_auton_print();
+}
+
+void shutdown() {
+  pros::lcd::shutdown();
+  auton_selector_running = false;
+}
+
+bool enabled() { return auton_selector_running; }
+
+void limit_switch_lcd_initialize(pros::adi::DigitalIn* right_limit, pros::adi::DigitalIn* left_limit) {
+  limit_switch_right = right_limit;
+  limit_switch_left = left_limit;
+}
+
+void limitSwitchTask() {}
+
+}  // namespace ez::as
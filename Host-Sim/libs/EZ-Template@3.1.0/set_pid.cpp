@@ -0,0 +1,370 @@
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+/////
+// Constants
+/////
+
+void Drive::pid_heading_constants_set(double p, double i, double d, double p_start_i) {
+  headingPID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_heading_constants_get() { return headingPID.constants_get(); }
+
+void Drive::pid_drive_constants_set(double p, double i, double d, double p_start_i) {
+  pid_drive_constants_forward_set(p, i, d, p_start_i);
+  pid_drive_constants_backward_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_drive_constants_get() { return forward_drivePID.constants_get(); }
+
+void Drive::pid_drive_constants_forward_set(double p, double i, double d, double p_start_i) {
+  forward_drivePID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_drive_constants_forward_get() { return forward_drivePID.constants_get(); }
+
+void Drive::pid_drive_constants_backward_set(double p, double i, double d, double p_start_i) {
+  backward_drivePID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_drive_constants_backward_get() { return backward_drivePID.constants_get(); }
+
+void Drive::pid_turn_constants_set(double p, double i, double d, double p_start_i) {
+  turnPID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_turn_constants_get() { return turnPID.constants_get(); }
+
+void Drive::pid_swing_constants_set(double p, double i, double d, double p_start_i) {
+  pid_swing_constants_forward_set(p, i, d, p_start_i);
+  pid_swing_constants_backward_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_swing_constants_get() { return forward_swingPID.constants_get(); }
+
+void Drive::pid_swing_constants_forward_set(double p, double i, double d, double p_start_i) {
+  forward_swingPID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_swing_constants_forward_get() { return forward_swingPID.constants_get(); }
+
+void Drive::pid_swing_constants_backward_set(double p, double i, double d, double p_start_i) {
+  backward_swingPID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_swing_constants_backward_get() { return backward_swingPID.constants_get(); }
+
+void Drive::pid_turn_min_set(int min) { turn_min = abs(min); }
+
+int Drive::pid_turn_min_get() { return turn_min; }
+
+void Drive::pid_swing_min_set(int min) { swing_min = abs(min); }
+
+int Drive::pid_swing_min_get() { return swing_min; }
+
+void Drive::pid_speed_max_set(int speed) {
+  max_speed = abs(util::clamp(speed, 127, -127));
+  slew_left.speed_max_set(max_speed);
+  slew_right.speed_max_set(max_speed);
+  slew_turn.speed_max_set(max_speed);
+  slew_swing.speed_max_set(max_speed);
+}
+
+int Drive::pid_speed_max_get() { return max_speed; }
+
+/////
+// Exit conditions
+/////
+
+void Drive::pid_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time,
+                                         double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  leftPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time,
+                             p_mA_timeout);
+  rightPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time,
+                              p_mA_timeout);
+  leftPID.velocity_sensor_secondary_toggle_set(use_imu);
+  rightPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time,
+                                        double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  turnPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time,
+                             p_mA_timeout);
+  turnPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time,
+                                         double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  swingPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time,
+                              p_mA_timeout);
+  swingPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error,
+                                         okapi::QTime p_big_exit_time, okapi::QLength p_big_error,
+                                         okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_drive_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch),
+                               p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::inch),
+                               p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond),
+                               use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error,
+                                        okapi::QTime p_big_exit_time, okapi::QAngle p_big_error,
+                                        okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_turn_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree),
+                              p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree),
+                              p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond),
+                              use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error,
+                                         okapi::QTime p_big_exit_time, okapi::QAngle p_big_error,
+                                         okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_swing_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree),
+                               p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree),
+                               p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond),
+                               use_imu);
+}
+
+/////
+// Motion chaining
+/////
+
+void Drive::pid_drive_chain_constant_set(double input) {
+  pid_drive_chain_forward_constant_set(input);
+  pid_drive_chain_backward_constant_set(input);
+}
+
+void Drive::pid_drive_chain_constant_set(okapi::QLength input) { pid_drive_chain_constant_set(input.convert(okapi::inch)); }
+
+void Drive::pid_drive_chain_forward_constant_set(double input) { drive_forward_motion_chain_scale = fabs(input); }
+
+void Drive::pid_drive_chain_forward_constant_set(okapi::QLength input) {
+  pid_drive_chain_forward_constant_set(input.convert(okapi::inch));
+}
+
+double Drive::pid_drive_chain_forward_constant_get() { return drive_forward_motion_chain_scale; }
+
+void Drive::pid_drive_chain_backward_constant_set(double input) { drive_backward_motion_chain_scale = fabs(input); }
+
+void Drive::pid_drive_chain_backward_constant_set(okapi::QLength input) {
+  pid_drive_chain_backward_constant_set(input.convert(okapi::inch));
+}
+
+double Drive::pid_drive_chain_backward_constant_get() { return drive_backward_motion_chain_scale; }
+
+void Drive::pid_turn_chain_constant_set(double input) { turn_motion_chain_scale = fabs(input); }
+
+void Drive::pid_turn_chain_constant_set(okapi::QAngle input) { pid_turn_chain_constant_set(input.convert(okapi::degree)); }
+
+double Drive::pid_turn_chain_constant_get() { return turn_motion_chain_scale; }
+
+void Drive::pid_swing_chain_constant_set(double input) {
+  pid_swing_chain_forward_constant_set(input);
+  pid_swing_chain_backward_constant_set(input);
+}
+
+void Drive::pid_swing_chain_constant_set(okapi::QAngle input) { pid_swing_chain_constant_set(input.convert(okapi::degree)); }
+
+void Drive::pid_swing_chain_forward_constant_set(double input) { swing_forward_motion_chain_scale = fabs(input); }
+
+void Drive::pid_swing_chain_forward_constant_set(okapi::QAngle input) {
+  pid_swing_chain_forward_constant_set(input.convert(okapi::degree));
+}
+
+double Drive::pid_swing_chain_forward_constant_get() { return swing_forward_motion_chain_scale; }
+
+void Drive::pid_swing_chain_backward_constant_set(double input) { swing_backward_motion_chain_scale = fabs(input); }
+
+void Drive::pid_swing_chain_backward_constant_set(okapi::QAngle input) {
+  pid_swing_chain_backward_constant_set(input.convert(okapi::degree));
+}
+
+double Drive::pid_swing_chain_backward_constant_get() { return swing_backward_motion_chain_scale; }
+
+/////
+// Slew
+/////
+
+void Drive::slew_drive_constants_set(okapi::QLength distance, int min_speed) {
+  slew_drive_constants_forward_set(distance, min_speed);
+  slew_drive_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_drive_constants_forward_set(okapi::QLength distance, int min_speed) {
+  slew_forward.constants_set(distance.convert(okapi::inch), min_speed);
+}
+
+void Drive::slew_drive_constants_backward_set(okapi::QLength distance, int min_speed) {
+  slew_backward.constants_set(distance.convert(okapi::inch), min_speed);
+}
+
+void Drive::slew_turn_constants_set(okapi::QAngle distance, int min_speed) {
+  slew_turn.constants_set(distance.convert(okapi::degree), min_speed);
+}
+
+void Drive::slew_swing_constants_set(okapi::QLength distance, int min_speed) {
+  slew_swing_constants_forward_set(distance, min_speed);
+  slew_swing_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_swing_constants_forward_set(okapi::QLength distance, int min_speed) {
+  slew_swing_forward.constants_set(distance.convert(okapi::inch), min_speed);
+  slew_swing_fwd_using_angle = false;
+}
+
+void Drive::slew_swing_constants_backward_set(okapi::QLength distance, int min_speed) {
+  slew_swing_backward.constants_set(distance.convert(okapi::inch), min_speed);
+  slew_swing_rev_using_angle = false;
+}
+
+void Drive::slew_swing_constants_set(okapi::QAngle distance, int min_speed) {
+  slew_swing_constants_forward_set(distance, min_speed);
+  slew_swing_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_swing_constants_forward_set(okapi::QAngle distance, int min_speed) {
+  slew_swing_forward.constants_set(distance.convert(okapi::degree), min_speed);
+  slew_swing_fwd_using_angle = true;
+}
+
+void Drive::slew_swing_constants_backward_set(okapi::QAngle distance, int min_speed) {
+  slew_swing_backward.constants_set(distance.convert(okapi::degree), min_speed);
+  slew_swing_rev_using_angle = true;
+}
+
+/////
+// Motions
+/////
+
+void Drive::pid_targets_reset() {
+  headingPID.target_set(0);
+  leftPID.target_set(0);
+  rightPID.target_set(0);
+  forward_drivePID.target_set(0);
+  backward_drivePID.target_set(0);
+  turnPID.target_set(0);
+  swingPID.target_set(0);
+}
+
+void Drive::drive_angle_set(double angle) {
+  headingPID.target_set(angle);
+  imu.set_rotation(angle);
+}
+
+void Drive::drive_angle_set(okapi::QAngle p_angle) { drive_angle_set(p_angle.convert(okapi::degree)); }
+
+void Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading) {
+  TICK_PER_INCH = drive_tick_per_inch();
+  if (print_toggle) printf("Drive Started... Target Value: %f in", target);
+
+  pid_speed_max_set(speed);
+  heading_on = toggle_heading;
+
+  l_start = drive_sensor_left();
+  r_start = drive_sensor_right();
+  const double l_target = l_start + target;
+  const double r_target = r_start + target;
+  const bool is_backwards = l_target < l_start && r_target < r_start;
+  if (print_toggle) printf(is_backwards ? "   (backwards)\n" : "\n");
+
+  chain_target_start = target;
+  chain_sensor_start = (l_start + r_start) / 2;
+  used_motion_chain_scale = 0;
+  motion_chain_backward = is_backwards;
+
+  const PID::Constants pid_consts = is_backwards ? backward_drivePID.constants_get() : forward_drivePID.constants_get();
+  const slew::Constants slew_consts = is_backwards ? slew_backward.constants_get() : slew_forward.constants_get();
+
+  leftPID.constants_set(pid_consts.kp, pid_consts.ki, pid_consts.kd, pid_consts.start_i);
+  rightPID.constants_set(pid_consts.kp, pid_consts.ki, pid_consts.kd, pid_consts.start_i);
+  leftPID.target_set(l_target);
+  rightPID.target_set(r_target);
+
+  slew_left.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+  slew_right.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+  slew_left.initialize(slew_on, max_speed, l_target, l_start);
+  slew_right.initialize(slew_on, max_speed, r_target, r_start);
+
+  drive_mode_set(DRIVE);
+}
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
+  pid_drive_set(p_target.convert(okapi::inch), speed, slew_on, toggle_heading);
+}
+
+void Drive::pid_turn_set(double target, int speed, bool slew_on) {
+  if (print_toggle) printf("Turn Started... Target Value: %f\n", target);
+
+  chain_sensor_start = drive_imu_get();
+  chain_target_start = target;
+  used_motion_chain_scale = 0;
+
+  turnPID.target_set(target);
+  headingPID.target_set(target);  // the next drive holds this heading
+  pid_speed_max_set(speed);
+  slew_turn.initialize(slew_on, max_speed, target, chain_sensor_start);
+
+  drive_mode_set(TURN);
+}
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on) {
+  pid_turn_set(p_target.convert(okapi::degree), speed, slew_on);
+}
+
+// Relative to the last target rather than the IMU, so error does not pile up
+// over a routine
+void Drive::pid_turn_relative_set(double target, int speed, bool slew_on) {
+  pid_turn_set(headingPID.target_get() + target, speed, slew_on);
+}
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on) {
+  pid_turn_relative_set(p_target.convert(okapi::degree), speed, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+  if (print_toggle) printf("Swing Started... Target Value: %f\n", target);
+
+  current_swing = type;
+  chain_sensor_start = drive_imu_get();
+  chain_target_start = target;
+  used_motion_chain_scale = 0;
+  swing_opposite_speed = opposite_speed;
+
+  // Whether the swinging side drives forward or backward
+  const int side = type == LEFT_SWING ? 1 : -1;
+  const bool backward = util::sgn((target - chain_sensor_start) * side) == -1;
+  const PID::Constants pid_consts = backward ? backward_swingPID.constants_get() : forward_swingPID.constants_get();
+  const slew::Constants slew_consts = backward ? slew_swing_backward.constants_get() : slew_swing_forward.constants_get();
+  slew_swing_using_angle = backward ? slew_swing_rev_using_angle : slew_swing_fwd_using_angle;
+
+  swingPID.constants_set(pid_consts.kp, pid_consts.ki, pid_consts.kd, pid_consts.start_i);
+  swingPID.target_set(target);
+  headingPID.target_set(target);
+  pid_speed_max_set(speed);
+
+  slew_swing.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
+  if (slew_swing_using_angle) {
+    slew_swing.initialize(slew_on, max_speed, target, chain_sensor_start);
+  } else {
+    const double current = type == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+    slew_swing.initialize(slew_on, max_speed, current + (backward ? -1 : 1) * slew_consts.distance_to_travel, current);
+  }
+
+  drive_mode_set(SWING);
+}
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+  pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+  pid_swing_set(type, headingPID.target_get() + target, speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+  pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on);
+}
@@ -0,0 +1,52 @@
+#include "EZ-Template/slew.hpp"
+
+using namespace ez;
+
+slew::slew() { constants_set(0, 0); }
+
+slew::slew(double distance, int minimum_speed) { constants_set(distance, minimum_speed); }
+
+void slew::constants_set(double distance, int minimum_speed) {
+  constants.distance_to_travel = distance;
+  constants.min_speed = minimum_speed;
+}
+
+slew::Constants slew::constants_get() { return constants; }
+
+// Ramps linearly from min_speed at the start of the motion to max_speed once
+// distance_to_travel has been covered
+void slew::initialize(bool enabled, double maximum_speed, double target, double current) {
+  is_enabled = enabled && constants.distance_to_travel > 0;
+  max_speed = maximum_speed;
+  sign = util::sgn(target - current);
+  x_intercept = current + constants.distance_to_travel * sign;
+  y_intercept = max_speed;
+  slope = (max_speed - constants.min_speed) / (constants.distance_to_travel > 0 ? constants.distance_to_travel : 1);
+  last_output = is_enabled ? constants.min_speed : max_speed;
+}
+
+double slew::iterate(double current) {
+  if (!is_enabled) {
+    last_output = max_speed;
+    return last_output;
+  }
+  error = x_intercept - current;
+  if (util::sgn(error) != sign) {
+    is_enabled = false;
+    last_output = max_speed;
+    return last_output;
+  }
+  last_output = std::fmin(max_speed, y_intercept - slope * std::fabs(error));
+  return last_output;
+}
+
+bool slew::enabled() { return is_enabled; }
+
+double slew::output() { return last_output; }
+
+void slew::speed_max_set(double speed) {
+  max_speed = speed;
+  y_intercept = speed;
+}
+
+double slew::speed_max_get() { return max_speed; }
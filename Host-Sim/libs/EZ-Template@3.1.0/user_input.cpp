@@ -0,0 +1,194 @@
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+namespace {
+
+constexpr double CURVE_STEP = 0.1;
+constexpr int HOLD_DELAY = 500;   // ms before a held button starts repeating
+constexpr int HOLD_REPEAT = 100;  // ms between repeats
+
+}  // namespace
+
+/////
+// Curves
+/////
+
+// The curve file lives on the SD card, which the host does not have
+void Drive::opcontrol_curve_sd_initialize() {}
+
+void Drive::save_l_curve_sd() {}
+
+void Drive::save_r_curve_sd() {}
+
+void Drive::opcontrol_curve_default_set(double left, double right) {
+  left_curve_scale = left;
+  right_curve_scale = right;
+}
+
+std::vector<double> Drive::opcontrol_curve_default_get() { return {left_curve_scale, right_curve_scale}; }
+
+void Drive::opcontrol_drive_activebrake_set(double kp) { active_brake_kp = kp; }
+
+double Drive::opcontrol_drive_activebrake_get() { return active_brake_kp; }
+
+void Drive::opcontrol_curve_buttons_toggle(bool toggle) { disable_controller = toggle; }
+
+bool Drive::opcontrol_curve_buttons_toggle_get() { return disable_controller; }
+
+void Drive::opcontrol_curve_buttons_left_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {
+  l_decrease_.button = decrease;
+  l_increase_.button = increase;
+}
+
+std::vector<pros::controller_digital_e_t> Drive::opcontrol_curve_buttons_left_get() {
+  return {l_decrease_.button, l_increase_.button};
+}
+
+void Drive::opcontrol_curve_buttons_right_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {
+  r_decrease_.button = decrease;
+  r_increase_.button = increase;
+}
+
+std::vector<pros::controller_digital_e_t> Drive::opcontrol_curve_buttons_right_get() {
+  return {r_decrease_.button, r_increase_.button};
+}
+
+void Drive::l_increase() { left_curve_scale += CURVE_STEP; }
+
+void Drive::l_decrease() { left_curve_scale = fmax(left_curve_scale - CURVE_STEP, 0); }
+
+void Drive::r_increase() { right_curve_scale += CURVE_STEP; }
+
+void Drive::r_decrease() { right_curve_scale = fmax(right_curve_scale - CURVE_STEP, 0); }
+
+// A tap changes the curve once, holding repeats it
+void Drive::button_press(button_* input_name, int button, std::function<void()> change_curve, std::function<void()> save) {
+  if (button && !input_name->lock) {
+    change_curve();
+    input_name->lock = true;
+    input_name->release_reset = true;
+  } else if (button && input_name->lock) {
+    input_name->hold_timer += util::DELAY_TIME;
+    if (input_name->hold_timer > HOLD_DELAY) {
+      input_name->increase_timer += util::DELAY_TIME;
+      if (input_name->increase_timer > HOLD_REPEAT) {
+        change_curve();
+        input_name->increase_timer = 0;
+      }
+    }
+  } else if (!button) {
+    input_name->lock = false;
+    input_name->hold_timer = 0;
+    input_name->increase_timer = 0;
+    if (input_name->release_reset) {
+      input_name->release_timer += util::DELAY_TIME;
+      if (input_name->release_timer > HOLD_DELAY) {
+        save();
+        input_name->release_timer = 0;
+        input_name->release_reset = false;
+      }
+    }
+  }
+}
+
+void Drive::opcontrol_curve_buttons_iterate() {
+  if (!disable_controller) return;
+
+  button_press(&l_increase_, master.get_digital(l_increase_.button), ([this] { this->l_increase(); }),
+               ([this] { this->save_l_curve_sd(); }));
+  button_press(&l_decrease_, master.get_digital(l_decrease_.button), ([this] { this->l_decrease(); }),
+               ([this] { this->save_l_curve_sd(); }));
+  if (!is_tank) {
+    button_press(&r_increase_, master.get_digital(r_increase_.button), ([this] { this->r_increase(); }),
+                 ([this] { this->save_r_curve_sd(); }));
+    button_press(&r_decrease_, master.get_digital(r_decrease_.button), ([this] { this->r_decrease(); }),
+                 ([this] { this->save_r_curve_sd(); }));
+  }
+}
+
+double Drive::opcontrol_curve_left(double x) {
+  if (left_curve_scale == 0) return x;
+  return (powf(2.718, -(left_curve_scale / 10)) + powf(2.718, (fabs(x) - 127) / 10) * (1 - powf(2.718, -(left_curve_scale / 10)))) * x;
+}
+
+double Drive::opcontrol_curve_right(double x) {
+  if (right_curve_scale == 0) return x;
+  return (powf(2.718, -(right_curve_scale / 10)) + powf(2.718, (fabs(x) - 127) / 10) * (1 - powf(2.718, -(right_curve_scale / 10)))) * x;
+}
+
+/////
+// Joysticks
+/////
+
+void Drive::opcontrol_joystick_threshold_set(int threshold) { JOYSTICK_THRESHOLD = abs(threshold); }
+
+int Drive::opcontrol_joystick_threshold_get() { return JOYSTICK_THRESHOLD; }
+
+int Drive::clipped_joystick(int joystick) { return abs(joystick) > JOYSTICK_THRESHOLD ? joystick : 0; }
+
+// Encoders are zeroed once after autonomous so active brake holds from where driving starts
+void Drive::opcontrol_drive_sensors_reset() {
+  if (util::AUTON_RAN) {
+    drive_sensor_reset();
+    util::AUTON_RAN = false;
+  }
+}
+
+void Drive::opcontrol_joystick_threshold_iterate(int l_stick, int r_stick) {
+  // Practice mode cuts the drive whenever a stick is pinned, to train smoother driving
+  if (practice_mode_is_on && (abs(l_stick) == 127 || abs(r_stick) == 127)) {
+    l_stick = 0;
+    r_stick = 0;
+  }
+
+  if (abs(l_stick) > JOYSTICK_THRESHOLD || abs(r_stick) > JOYSTICK_THRESHOLD) {
+    if (is_reversed)
+      private_drive_set(-r_stick, -l_stick);
+    else
+      private_drive_set(l_stick, r_stick);
+    if (active_brake_kp != 0) drive_sensor_reset();
+  } else {
+    private_drive_set((0 - drive_sensor_left()) * active_brake_kp, (0 - drive_sensor_right()) * active_brake_kp);
+  }
+}
+
+void Drive::opcontrol_tank() {
+  is_tank = true;
+  drive_mode_set(DISABLE);
+  opcontrol_drive_sensors_reset();
+
+  if (!pid_tuner_enabled()) opcontrol_curve_buttons_iterate();
+
+  const int l_stick = opcontrol_curve_left(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+  const int r_stick = opcontrol_curve_left(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y));
+  opcontrol_joystick_threshold_iterate(l_stick, r_stick);
+}
+
+void Drive::opcontrol_arcade_standard(e_type stick_type) {
+  is_tank = false;
+  drive_mode_set(DISABLE);
+  opcontrol_drive_sensors_reset();
+
+  if (!pid_tuner_enabled()) opcontrol_curve_buttons_iterate();
+
+  const pros::controller_analog_e_t turn_stick =
+      stick_type == SPLIT ? pros::E_CONTROLLER_ANALOG_RIGHT_X : pros::E_CONTROLLER_ANALOG_LEFT_X;
+  const int fwd_stick = opcontrol_curve_left(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+  const int turn = opcontrol_curve_right(master.get_analog(turn_stick));
+  opcontrol_joystick_threshold_iterate(fwd_stick + turn, fwd_stick - turn);
+}
+
+void Drive::opcontrol_arcade_flipped(e_type stick_type) {
+  is_tank = false;
+  drive_mode_set(DISABLE);
+  opcontrol_drive_sensors_reset();
+
+  if (!pid_tuner_enabled()) opcontrol_curve_buttons_iterate();
+
+  const pros::controller_analog_e_t fwd_axis =
+      stick_type == SPLIT ? pros::E_CONTROLLER_ANALOG_RIGHT_Y : pros::E_CONTROLLER_ANALOG_LEFT_Y;
+  const int fwd_stick = opcontrol_curve_right(master.get_analog(fwd_axis));
+  const int turn = opcontrol_curve_left(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X));
+  opcontrol_joystick_threshold_iterate(fwd_stick + turn, fwd_stick - turn);
+}
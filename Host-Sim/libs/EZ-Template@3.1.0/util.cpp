@@ -0,0 +1,49 @@
+#include "EZ-Template/util.hpp"
+
+#include "EZ-Template/api.hpp"
+
+pros::Controller master(pros::E_CONTROLLER_MASTER);
+
+namespace ez {
+
+void ez_template_print() { std::cout << "EZ-Template 3.1.0 (host build)\n"; }
+
+void screen_print(std::string text, int line) {
+  // One LLEMU line per '\n', like the brain screen
+  std::stringstream lines(text);
+  std::string current;
+  while (std::getline(lines, current)) pros::lcd::set_text(line++, current);
+}
+
+std::string exit_to_string(exit_output input) {
+  switch (input) {
+    case RUNNING: return "Running";
+    case SMALL_EXIT: return "Small";
+    case BIG_EXIT: return "Big";
+    case VELOCITY_EXIT: return "Velocity";
+    case mA_EXIT: return "mA";
+    case ERROR_NO_CONSTANTS: return "Error: Exit condition constants not set!";
+  }
+  return "Error: Out of bounds!";
+}
+
+namespace util {
+
+bool AUTON_RAN = true;
+
+int sgn(double input) {
+  if (input > 0) return 1;
+  if (input < 0) return -1;
+  return 0;
+}
+
+bool reversed_active(double input) { return input < 0; }
+
+double clamp(double input, double max, double min) {
+  if (input > max) return max;
+  if (input < min) return min;
+  return input;
+}
+
+}  // namespace util
+}  // namespace ez
@@ -0,0 +1,20 @@
+#pragma once
+
+// The odometry functions LemLib.a defines, the ones Chassis calls. The project's
+// lemlib/chassis/odom.hpp declares its own rebuilt ones in an inline namespace,
+// so these are what lemlib::getPose() and so on name on the robot whenever that
+// header isn't included, here too
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+void setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain);
+Pose getPose(bool radians = false);
+void setPose(Pose pose, bool radians = false);
+Pose getSpeed(bool radians = false);
+Pose getLocalSpeed(bool radians = false);
+Pose estimatePose(float time, bool radians = false);
+void update();
+void init();
+} // namespace lemlib
@@ -0,0 +1,267 @@
+// The sensor and drivetrain settings, and enough of Chassis to run motions on
+// the host: calibrating, the pose, the motion "queue", moveToPoint() and
+// turnToHeading(). The rest of Chassis isn't built for the host
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "pros/misc.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "archiveOdom.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+
+lemlib::OdomSensors::OdomSensors(TrackingWheel* vertical1, TrackingWheel* vertical2, TrackingWheel* horizontal1,
+                                 TrackingWheel* horizontal2, pros::Imu* imu)
+    : vertical1(vertical1),
+      vertical2(vertical2),
+      horizontal1(horizontal1),
+      horizontal2(horizontal2),
+      imu(imu) {}
+
+lemlib::Drivetrain::Drivetrain(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                               float wheelDiameter, float rpm, float horizontalDrift)
+    : leftMotors(leftMotors),
+      rightMotors(rightMotors),
+      trackWidth(trackWidth),
+      wheelDiameter(wheelDiameter),
+      rpm(rpm),
+      horizontalDrift(horizontalDrift) {}
+
+lemlib::Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings, ControllerSettings angularSettings,
+                         OdomSensors sensors, DriveCurve* throttleCurve, DriveCurve* steerCurve)
+    : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD, linearSettings.windupRange, true),
+      angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true),
+      lateralSettings(linearSettings),
+      angularSettings(angularSettings),
+      drivetrain(drivetrain),
+      sensors(sensors),
+      throttleCurve(throttleCurve),
+      steerCurve(steerCurve),
+      lateralLargeExit(lateralSettings.largeError, lateralSettings.largeErrorTimeout),
+      lateralSmallExit(lateralSettings.smallError, lateralSettings.smallErrorTimeout),
+      angularLargeExit(angularSettings.largeError, angularSettings.largeErrorTimeout),
+      angularSmallExit(angularSettings.smallError, angularSettings.smallErrorTimeout) {}
+
+void lemlib::Chassis::calibrate(bool calibrateImu) {
+    if (calibrateImu && sensors.imu != nullptr) {
+        sensors.imu->reset();
+        do pros::delay(10);
+        while (sensors.imu->is_calibrating());
+    }
+    // the drive sides stand in for missing vertical tracking wheels
+    if (sensors.vertical1 == nullptr) {
+        sensors.vertical1 = new TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                              -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    }
+    if (sensors.vertical2 == nullptr) {
+        sensors.vertical2 = new TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                              drivetrain.trackWidth / 2, drivetrain.rpm);
+    }
+    for (TrackingWheel* wheel : {sensors.vertical1, sensors.vertical2, sensors.horizontal1, sensors.horizontal2}) {
+        if (wheel != nullptr) wheel->reset();
+    }
+    setSensors(sensors, drivetrain);
+    init();
+}
+
+void lemlib::Chassis::setPose(float x, float y, float theta, bool radians) {
+    lemlib::setPose(Pose(x, y, theta), radians);
+}
+
+void lemlib::Chassis::setPose(Pose pose, bool radians) { lemlib::setPose(pose, radians); }
+
+lemlib::Pose lemlib::Chassis::getPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::getPose(true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+void lemlib::Chassis::waitUntil(float dist) {
+    // give the motion time to start
+    do pros::delay(10);
+    while (distTraveled <= dist && distTraveled != -1);
+}
+
+void lemlib::Chassis::waitUntilDone() {
+    do pros::delay(10);
+    while (distTraveled != -1);
+}
+
+void lemlib::Chassis::requestMotionStart() {
+    if (isInMotion()) motionQueued = true;
+    else motionRunning = true;
+    // wait until this motion is at the front of the "queue"
+    mutex.take(TIMEOUT_MAX);
+}
+
+void lemlib::Chassis::endMotion() {
+    // move the "queue" forward 1, and let the queued motion run
+    motionRunning = motionQueued;
+    motionQueued = false;
+    mutex.give();
+}
+
+void lemlib::Chassis::cancelMotion() {
+    motionRunning = false;
+    pros::delay(10); // give the motion time to stop
+}
+
+void lemlib::Chassis::cancelAllMotions() {
+    motionRunning = false;
+    motionQueued = false;
+    pros::delay(10);
+}
+
+bool lemlib::Chassis::isInMotion() const { return motionRunning; }
+
+void lemlib::Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+    drivetrain.leftMotors->set_brake_mode_all(mode);
+    drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+void lemlib::Chassis::turnToHeading(float theta, int timeout, TurnToHeadingParams params, bool async) {
+    params.minSpeed = std::abs(params.minSpeed);
+    requestMotionStart();
+    if (!motionRunning) return;
+    if (async) {
+        pros::Task task([this, theta, timeout, params] { turnToHeading(theta, timeout, params, false); });
+        endMotion();
+        pros::delay(10);
+        return;
+    }
+
+    float prevMotorPower = 0;
+    const float startTheta = getPose().theta;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+    Timer timer(timeout);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && motionRunning) {
+        if (compState != pros::competition::get_status()) break;
+        Pose pose = getPose();
+        pose.theta = std::fmod(pose.theta, 360);
+        distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+
+        const float deltaTheta = angleError(theta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+        // motion chaining
+        if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(*prevDeltaTheta)) break;
+        prevDeltaTheta = deltaTheta;
+
+        float motorPower = angularPID.update(deltaTheta);
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta);
+
+        motorPower = std::clamp<float>(motorPower, -params.maxSpeed, params.maxSpeed);
+        if (std::fabs(deltaTheta) > 20) motorPower = slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+
+        drivetrain.leftMotors->move(motorPower);
+        drivetrain.rightMotors->move(-motorPower);
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    endMotion();
+}
+
+void lemlib::Chassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    requestMotionStart();
+    if (!motionRunning) return;
+    if (async) {
+        pros::Task task([this, x, y, timeout, params] { moveToPoint(x, y, timeout, params, false); });
+        endMotion();
+        pros::delay(10);
+        return;
+    }
+
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+
+    Pose lastPose = getPose();
+    distTraveled = 0;
+    Timer timer(timeout);
+    bool close = false;
+    float prevLateralOut = 0;
+    const int compState = pros::competition::get_status();
+    std::optional<bool> prevSide = std::nullopt;
+
+    // the target in standard position, facing along the line from the start
+    Pose target(x, y);
+    target.theta = getPose(true, true).angle(target);
+
+    while (!timer.isDone() && ((!lateralSmallExit.getExit() && !lateralLargeExit.getExit()) || !close) &&
+           motionRunning) {
+        if (compState != pros::competition::get_status()) break;
+        const Pose pose = getPose(true, true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // settle once close, the angle to the point swings around near it
+        const float distTarget = pose.distance(target);
+        if (distTarget < 7.5 && !close) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+        }
+
+        // motion chaining, exit once past the line through the target square to the path
+        const bool side = (pose.y - target.y) * -std::sin(target.theta) <=
+                          (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        if (prevSide == std::nullopt) prevSide = side;
+        if (side != *prevSide && params.minSpeed != 0) break;
+        prevSide = side;
+
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = close ? 0 : angleError(adjustedRobotTheta, pose.angle(target));
+        const float lateralError = distTarget * std::cos(angleError(pose.theta, pose.angle(target)));
+
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+
+        float lateralOut = lateralPID.update(lateralError);
+        float angularOut = angularPID.update(radToDeg(angularError));
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+        if (!close) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+        // don't drive the wrong way before settling
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+        if (params.forwards && lateralOut < std::fabs(params.minSpeed) && lateralOut > 0)
+            lateralOut = std::fabs(params.minSpeed);
+        if (!params.forwards && -lateralOut < std::fabs(params.minSpeed) && lateralOut < 0)
+            lateralOut = -std::fabs(params.minSpeed);
+        prevLateralOut = lateralOut;
+
+        // keep the ratio between the sides if either is saturated
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+        drivetrain.leftMotors->move(leftPower);
+        drivetrain.rightMotors->move(rightPower);
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    endMotion();
+}
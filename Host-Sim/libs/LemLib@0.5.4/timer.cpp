@@ -0,0 +1,51 @@
+#include "pros/rtos.hpp"
+#include "lemlib/timer.hpp"
+
+lemlib::Timer::Timer(uint32_t time)
+    : period(time) {
+    lastTime = pros::millis();
+}
+
+uint32_t lemlib::Timer::getTimeSet() { return period; }
+
+uint32_t lemlib::Timer::getTimeLeft() {
+    const uint32_t passed = getTimePassed();
+    return passed < period ? period - passed : 0;
+}
+
+uint32_t lemlib::Timer::getTimePassed() {
+    // only count the time since the last check if the timer is running
+    const uint32_t time = pros::millis();
+    if (!paused) timeWaited += time - lastTime;
+    lastTime = time;
+    return timeWaited;
+}
+
+bool lemlib::Timer::isDone() { return getTimePassed() >= period; }
+
+bool lemlib::Timer::isPaused() { return paused; }
+
+void lemlib::Timer::set(uint32_t time) {
+    period = time;
+    reset();
+}
+
+void lemlib::Timer::reset() {
+    timeWaited = 0;
+    lastTime = pros::millis();
+}
+
+void lemlib::Timer::pause() {
+    if (!paused) getTimePassed();
+    paused = true;
+}
+
+void lemlib::Timer::resume() {
+    if (paused) lastTime = pros::millis();
+    paused = false;
+}
+
+void lemlib::Timer::waitUntilDone() {
+    do pros::delay(5);
+    while (!isDone());
+}
@@ -0,0 +1,45 @@
+#include <cmath>
+
+#include "lemlib/util.hpp"
+
+float lemlib::slew(float target, float current, float maxChange) {
+    float change = target - current;
+    if (maxChange == 0) return target;
+    if (change > maxChange) change = maxChange;
+    else if (change < -maxChange) change = -maxChange;
+    return current + change;
+}
+
+float lemlib::angleError(float target, float position, bool radians, AngularDirection direction) {
+    const float full = radians ? 2 * M_PI : 360;
+    // bound to [0, full)
+    target = std::fmod(std::fmod(target, full) + full, full);
+    position = std::fmod(std::fmod(position, full) + full, full);
+    const float error = target - position;
+    switch (direction) {
+        case AngularDirection::CW_CLOCKWISE: return error < 0 ? error + full : error;
+        case AngularDirection::CCW_COUNTERCLOCKWISE: return error > 0 ? error - full : error;
+        default: return std::remainder(error, full);
+    }
+}
+
+float lemlib::avg(std::vector<float> values) {
+    if (values.empty()) return 0;
+    float sum = 0;
+    for (float value : values) sum += value;
+    return sum / values.size();
+}
+
+float lemlib::ema(float current, float previous, float smooth) { return (current * smooth) + (previous * (1 - smooth)); }
+
+float lemlib::getCurvature(Pose pose, Pose other) {
+    // calculate whether the pose is on the left or right side of the circle
+    const float side = lemlib::sgn(std::sin(pose.theta) * (other.x - pose.x) - std::cos(pose.theta) * (other.y - pose.y));
+    // calculate center point and radius
+    const float a = -std::tan(pose.theta);
+    const float c = std::tan(pose.theta) * pose.x - pose.y;
+    const float x = std::fabs(a * other.x + other.y + c) / std::sqrt((a * a) + 1);
+    const float d = std::hypot(other.x - pose.x, other.y - pose.y);
+    // return curvature
+    return side * ((2 * x) / (d * d));
+}
@@ -0,0 +1,35 @@
+#include "okapi/api/util/logging.hpp"
+
+namespace okapi {
+
+int DefaultLoggerInitializer::count = 0;
+
+std::shared_ptr<Logger> defaultLogger;
+
+Logger::Logger() noexcept : Logger(nullptr, nullptr, LogLevel::off) {}
+
+Logger::Logger(std::unique_ptr<AbstractTimer> itimer, std::string_view ifileName, const LogLevel& ilevel) noexcept
+    : Logger(std::move(itimer), nullptr, ilevel) {
+  // The brain's serial streams map onto the host's
+  if (ifileName == "/ser/sout")
+    logfile = stdout;
+  else if (ifileName == "/ser/serr")
+    logfile = stderr;
+  else
+    logfile = fopen(std::string(ifileName).c_str(), "w");
+}
+
+Logger::Logger(std::unique_ptr<AbstractTimer> itimer, FILE* ifile, const LogLevel& ilevel) noexcept
+    : timer(std::move(itimer)), logLevel(ilevel), logfile(ifile) {}
+
+Logger::~Logger() {
+  if (logfile != stdout && logfile != stderr) close();
+}
+
+std::shared_ptr<Logger> Logger::getDefaultLogger() { return defaultLogger; }
+
+void Logger::setDefaultLogger(std::shared_ptr<Logger> ilogger) { defaultLogger = std::move(ilogger); }
+
+bool Logger::isSerialStream(std::string_view filename) { return filename == "/ser/sout" || filename == "/ser/serr"; }
+
+}  // namespace okapi
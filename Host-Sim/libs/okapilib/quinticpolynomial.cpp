@@ -0,0 +1,36 @@
+#include "math/quinticpolynomial.hpp"
+
+// squiggles ships inside okapi's archive on the brain, this is the one piece
+// of it team code builds on
+
+namespace squiggles {
+
+// a0-a2 come straight from the start, a3-a5 solve the goal's position,
+// speed and acceleration at time t
+QuinticPolynomial::QuinticPolynomial(double s_p, double s_v, double s_a, double g_p, double g_v, double g_a, double t)
+    : a0(s_p), a1(s_v), a2(s_a / 2) {
+  const double t2 = t * t;
+  const double t3 = t2 * t;
+  const double position = g_p - a0 - a1 * t - a2 * t2;
+  const double velocity = g_v - a1 - 2 * a2 * t;
+  const double acceleration = g_a - 2 * a2;
+  a3 = (20 * position - 8 * velocity * t + acceleration * t2) / (2 * t3);
+  a4 = (-30 * position + 14 * velocity * t - 2 * acceleration * t2) / (2 * t3 * t);
+  a5 = (12 * position - 6 * velocity * t + acceleration * t2) / (2 * t3 * t2);
+}
+
+double QuinticPolynomial::calc_point(double t) {
+  return a0 + t * (a1 + t * (a2 + t * (a3 + t * (a4 + t * a5))));
+}
+
+double QuinticPolynomial::calc_first_derivative(double t) {
+  return a1 + t * (2 * a2 + t * (3 * a3 + t * (4 * a4 + t * 5 * a5)));
+}
+
+double QuinticPolynomial::calc_second_derivative(double t) {
+  return 2 * a2 + t * (6 * a3 + t * (12 * a4 + t * 20 * a5));
+}
+
+double QuinticPolynomial::calc_third_derivative(double t) { return 6 * a3 + t * (24 * a4 + t * 60 * a5); }
+
+}  // namespace squiggles
@@ -0,0 +1,61 @@
+#include "okapi/impl/util/timer.hpp"
+
+#include "api.h"
+
+namespace okapi {
+
+AbstractTimer::AbstractTimer(QTime ifirstCalled)
+    : firstCalled(ifirstCalled), lastCalled(ifirstCalled), mark(ifirstCalled), hardMark(0_ms), repeatMark(ifirstCalled) {}
+
+AbstractTimer::~AbstractTimer() = default;
+
+QTime AbstractTimer::getDt() {
+  const QTime now = millis();
+  const QTime dt = now - lastCalled;
+  lastCalled = now;
+  return dt;
+}
+
+QTime AbstractTimer::readDt() const { return millis() - lastCalled; }
+
+QTime AbstractTimer::getStartingTime() const { return firstCalled; }
+
+QTime AbstractTimer::getDtFromStart() const { return millis() - firstCalled; }
+
+void AbstractTimer::placeMark() { mark = millis(); }
+
+QTime AbstractTimer::clearMark() {
+  const QTime old = mark;
+  mark = 0_ms;
+  return old;
+}
+
+void AbstractTimer::placeHardMark() {
+  if (hardMark == 0_ms) hardMark = millis();
+}
+
+QTime AbstractTimer::clearHardMark() {
+  const QTime old = hardMark;
+  hardMark = 0_ms;
+  return old;
+}
+
+QTime AbstractTimer::getDtFromMark() const { return mark == 0_ms ? 0_ms : millis() - mark; }
+
+QTime AbstractTimer::getDtFromHardMark() const { return hardMark == 0_ms ? 0_ms : millis() - hardMark; }
+
+bool AbstractTimer::repeat(QTime time) {
+  if (millis() - repeatMark >= time) {
+    repeatMark = millis();
+    return true;
+  }
+  return false;
+}
+
+bool AbstractTimer::repeat(QFrequency frequency) { return repeat(QTime(1 / frequency.convert(Hz))); }
+
+Timer::Timer() : AbstractTimer(millis()) {}
+
+QTime Timer::millis() const { return pros::millis() * millisecond; }
+
+}  // namespace okapi
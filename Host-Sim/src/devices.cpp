@@ -0,0 +1,242 @@
+#include "sim/devices.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/kernel.hpp"
+
+namespace sim {
+namespace {
+
+constexpr double STALL_CURRENT = 4200;    // mA the windings would draw at 12 V, before limiting
+constexpr double RATED_CURRENT = 2500;    // mA at which the rated stall torque is produced
+constexpr double MAX_VOLTAGE = 12000;     // mV
+constexpr double ROTOR_TIME_CONSTANT = 0.04;  // s, unloaded spin up of a bare motor
+constexpr double FRICTION = 0.02;         // fraction of stall torque lost to the gearbox
+constexpr double VELOCITY_KP = 2.0;       // firmware velocity loop, fraction of full voltage per free speed of error
+constexpr double POSITION_KP = 3.0;       // firmware position loop, rpm per degree of error
+
+struct Devices {
+  std::array<Motor, PORT_COUNT> motors;
+  std::array<Imu, PORT_COUNT> imus;
+  std::array<Rotation, PORT_COUNT> rotations;
+  std::array<Distance, PORT_COUNT> distances;
+  std::array<Gps, PORT_COUNT> gpses;
+  std::array<Optical, PORT_COUNT> opticals;
+  Adi adi;
+  std::array<Controller, 2> controllers;
+  Competition competition;
+  Lcd lcd;
+  Screen screen;
+  std::array<pros::DeviceType, PORT_COUNT> plugged{};
+  double battery = 12800;
+
+  Devices() {
+    // each sensor sends on its own phase, so they don't all line up with a task
+    // that happens to run on a multiple of the data rate
+    for (int i = 0; i < PORT_COUNT; i++) {
+      imus[i].data_phase = i;
+      rotations[i].data_phase = i;
+      distances[i].data_phase = i;
+      distances[i].noise_state = 0x9e3779b9u * (i + 1);
+      gpses[i].data_phase = i;
+      gpses[i].noise_state = 0x85ebca6bu * (i + 1);
+    }
+    plant_add([](std::uint32_t, double dt) { motors_step(dt); });
+    sampler_add([](std::uint32_t now, double) { sensors_sample(now); });
+  }
+};
+
+Devices& devices() {
+  static Devices d;
+  return d;
+}
+
+int index(int port) { return std::clamp(std::abs(port), 1, PORT_COUNT) - 1; }
+
+constexpr double DISTANCE_RANGE = 2000;  // mm, further than this reads as nothing
+
+// Roughly normal, from a sensor's own xorshift sequence
+double noise(std::uint32_t& state) {
+  double sum = 0;
+  for (int i = 0; i < 4; i++) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    sum += state / 4294967296.0;
+  }
+  return (sum - 2) * std::sqrt(3.0);
+}
+
+// What the sensor sends: within 15 mm under 200 mm and 5% past that, the spec
+// sheet's accuracy taken as two standard deviations
+void distance_sample(Distance& sensor) {
+  const double error = noise(sensor.noise_state);
+  if (sensor.distance >= DISTANCE_RANGE) {
+    sensor.sampled_distance = 9999;
+    sensor.sampled_confidence = 0;
+    return;
+  }
+  const double sd = sensor.distance < 200 ? 7.5 : sensor.distance * 0.025;
+  sensor.sampled_distance = std::max(0L, std::lround(sensor.distance + sd * error));
+  sensor.sampled_confidence = sensor.distance < 200 ? 63 : std::lround(63 * std::min(1.0, sensor.object_size / 400));
+}
+
+// Takes a reading when one is due and hands over the ones that have arrived
+void gps_sample(Gps& sensor, std::uint32_t now) {
+  if (sensor.visible && (now + sensor.data_phase) % sensor.data_rate == 0) {
+    const double heading = sensor.heading + sensor.heading_noise * noise(sensor.noise_state);
+    sensor.in_flight.push_back({now + sensor.latency, sensor.x + sensor.position_noise * noise(sensor.noise_state),
+                                sensor.y + sensor.position_noise * noise(sensor.noise_state),
+                                std::fmod(std::fmod(heading, 360) + 360, 360)});
+  }
+  while (!sensor.in_flight.empty() && sensor.in_flight.front().arrives <= now) {
+    sensor.sampled_x = sensor.in_flight.front().x;
+    sensor.sampled_y = sensor.in_flight.front().y;
+    sensor.sampled_heading = sensor.in_flight.front().heading;
+    sensor.in_flight.pop_front();
+  }
+}
+
+double rpm_to_rad(double rpm) { return rpm * 2 * M_PI / 60; }
+
+double ticks_per_rev(pros::MotorGears gearing) {
+  switch (gearing) {
+    case pros::MotorGears::red: return 1800;
+    case pros::MotorGears::blue: return 300;
+    default: return 900;
+  }
+}
+
+}  // namespace
+
+Motor& motor(int port) { return devices().motors[index(port)]; }
+Imu& imu(int port) { return devices().imus[index(port)]; }
+Rotation& rotation(int port) { return devices().rotations[index(port)]; }
+Distance& distance(int port) { return devices().distances[index(port)]; }
+Gps& gps(int port) { return devices().gpses[index(port)]; }
+Optical& optical(int port) { return devices().opticals[index(port)]; }
+Adi& adi() { return devices().adi; }
+Controller& controller(pros::controller_id_e_t id) { return devices().controllers[id == pros::E_CONTROLLER_PARTNER]; }
+Competition& competition() { return devices().competition; }
+Lcd& lcd() { return devices().lcd; }
+Screen& screen() { return devices().screen; }
+pros::DeviceType& plugged_type(int port) { return devices().plugged[index(port)]; }
+double& battery_voltage() { return devices().battery; }
+
+double free_speed(pros::MotorGears gearing) {
+  switch (gearing) {
+    case pros::MotorGears::red: return 100;
+    case pros::MotorGears::blue: return 600;
+    default: return 200;
+  }
+}
+
+double stall_torque(pros::MotorGears gearing) {
+  switch (gearing) {
+    case pros::MotorGears::red: return 2.1;
+    case pros::MotorGears::blue: return 0.35;
+    default: return 1.05;
+  }
+}
+
+double rotor_inertia(pros::MotorGears gearing) {
+  return ROTOR_TIME_CONSTANT * stall_torque(gearing) / rpm_to_rad(free_speed(gearing));
+}
+
+double to_units(const Motor& motor, double degrees) {
+  switch (motor.units) {
+    case pros::MotorUnits::rotations: return degrees / 360;
+    case pros::MotorUnits::counts: return degrees * ticks_per_rev(motor.gearing) / 360;
+    default: return degrees;
+  }
+}
+
+double from_units(const Motor& motor, double value) {
+  switch (motor.units) {
+    case pros::MotorUnits::rotations: return value * 360;
+    case pros::MotorUnits::counts: return value * 360 / ticks_per_rev(motor.gearing);
+    default: return value;
+  }
+}
+
+void motor_drive(Motor& m, double) {
+  const double sign = m.reversed ? -1 : 1;
+  const double free = free_speed(m.gearing);
+  const double user_velocity = sign * m.velocity;
+  const double user_position = sign * m.position;
+  const double max_voltage = std::min(MAX_VOLTAGE, battery_voltage());
+
+  double command = 0;
+  bool open_circuit = false;
+  switch (m.mode) {
+    case Motor::Mode::voltage:
+      command = m.target_voltage;
+      open_circuit = command == 0 && m.brake_mode == pros::MotorBrake::coast;
+      break;
+    case Motor::Mode::position: {
+      double limit = m.profile_velocity > 0 ? m.profile_velocity : free;
+      double target = std::clamp(POSITION_KP * (m.target_position - user_position), -limit, limit);
+      command = MAX_VOLTAGE * (target + VELOCITY_KP * (target - user_velocity)) / free;
+      break;
+    }
+    case Motor::Mode::velocity:
+      command = MAX_VOLTAGE * (m.target_velocity + VELOCITY_KP * (m.target_velocity - user_velocity)) / free;
+      break;
+  }
+  if (m.voltage_limit > 0) command = std::clamp(command, -double(m.voltage_limit), double(m.voltage_limit));
+  command = std::clamp(command, -max_voltage, max_voltage);
+
+  m.voltage = sign * command;
+  const double limit = std::min<double>(m.current_limit, RATED_CURRENT);
+  m.current = open_circuit ? 0 : std::clamp(STALL_CURRENT * (m.voltage / MAX_VOLTAGE - m.velocity / free), -limit, limit);
+  m.torque = stall_torque(m.gearing) * m.current / RATED_CURRENT;
+}
+
+void sensors_sample(std::uint32_t now) {
+  auto& d = devices();
+  for (int i = 0; i < PORT_COUNT; i++) {
+    Imu& imu = d.imus[i];
+    if (imu.installed && (now + imu.data_phase) % imu.data_rate == 0) {
+      imu.sampled_rotation = imu.rotation;
+      imu.sampled_yaw_rate = imu.yaw_rate;
+    }
+    Rotation& rotation = d.rotations[i];
+    if (rotation.installed && (now + rotation.data_phase) % rotation.data_rate == 0) {
+      rotation.sampled_angle = rotation.angle;
+      rotation.sampled_velocity = rotation.velocity;
+    }
+    Distance& distance = d.distances[i];
+    if (distance.installed && (now + distance.data_phase) % distance.data_rate == 0) distance_sample(distance);
+    if (d.gpses[i].installed) gps_sample(d.gpses[i], now);
+  }
+}
+
+void motors_step(double dt) {
+  for (auto& m : devices().motors) {
+    if (!m.installed) continue;
+    motor_drive(m, dt);
+    const double amps = m.current / 1000;
+    m.temperature += dt * (0.05 * amps * amps - 0.01 * (m.temperature - 25));
+    if (m.external) continue;
+
+    const double stall = stall_torque(m.gearing);
+    const double resist = FRICTION * stall + m.load_torque;
+    double net = m.torque;
+    if (m.velocity != 0) {
+      net -= std::copysign(resist, m.velocity);
+    } else if (std::abs(net) <= resist) {
+      continue;  // static friction holds the shaft
+    } else {
+      net -= std::copysign(resist, net);
+    }
+    const double accel = net / (rotor_inertia(m.gearing) + m.load_inertia);  // rad/s^2
+    double velocity = m.velocity + accel * dt * 60 / (2 * M_PI);
+    // Friction can stop the shaft but never reverse it
+    if (m.velocity != 0 && std::signbit(velocity) != std::signbit(m.velocity) && std::abs(m.torque) <= resist) velocity = 0;
+    m.position += (m.velocity + velocity) / 2 * 6 * dt;
+    m.velocity = velocity;
+  }
+}
+
+}  // namespace sim
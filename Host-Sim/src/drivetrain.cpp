@@ -0,0 +1,229 @@
+#include "sim/drivetrain.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace sim {
+namespace {
+
+constexpr double GRAVITY = 9.81;          // m/s^2
+constexpr double METERS_PER_INCH = 0.0254;
+constexpr double KINETIC_FRICTION = 0.8;  // sliding grip as a fraction of static grip
+constexpr double LATERAL_GRIP_PER_DRIFT = 0.15;  // side friction coefficient per unit of lemlib horizontalDrift
+
+double degrees(double radians) { return radians * 180 / M_PI; }
+
+double radians(double degrees) { return degrees * M_PI / 180; }
+
+// Coulomb friction on something moving at `speed` with `applied` force on
+// it.  Opposes motion up to `limit`; if that is enough to stop it this step it
+// stops it exactly instead of pushing it backwards.  Works the same for
+// torques and angular speeds.
+double friction(double speed, double applied, double mass, double limit, double dt) {
+  return std::clamp(-(speed * mass / dt + applied), -limit, limit);
+}
+
+double direction(const Motor& motor) { return motor.reversed ? -1 : 1; }
+
+double cross(double ax, double ay, double bx, double by) { return ax * by - ay * bx; }
+
+// How far along the ray from (x, y) going (dx, dy) it meets the wall, infinity
+// if it misses
+double ray_hit(double x, double y, double dx, double dy, const Wall& wall) {
+  const double ex = wall.x2 - wall.x1;
+  const double ey = wall.y2 - wall.y1;
+  const double denominator = cross(dx, dy, ex, ey);
+  if (std::abs(denominator) < 1e-12) return INFINITY;
+  const double wx = wall.x1 - x;
+  const double wy = wall.y1 - y;
+  const double along = cross(wx, wy, ex, ey) / denominator;
+  const double across = cross(wx, wy, dx, dy) / denominator;
+  return along >= 0 && across >= 0 && across <= 1 ? along : INFINITY;
+}
+
+}  // namespace
+
+Drivetrain::Drivetrain(DrivetrainConfig config, Pose start) : config_(std::move(config)), pose_(start) {
+  // Touching the devices first makes sure the motor plant is stepped before
+  // this one, so the torques read below are for the current step
+  battery_voltage();
+  for (const auto* ports : {&config_.left_motors, &config_.right_motors}) {
+    for (int port : *ports) {
+      motor(port).external = true;
+      motor(port).gearing = config_.cartridge;
+    }
+  }
+  if (config_.gps_port > 0) {
+    gps(config_.gps_port).installed = true;
+    plugged_type(config_.gps_port) = pros::DeviceType::gps;
+  }
+  plant_add([this](std::uint32_t, double dt) { step(dt); });
+}
+
+const DrivetrainConfig& Drivetrain::config() const { return config_; }
+
+void Drivetrain::config_set(const DrivetrainConfig& config) { config_ = config; }
+
+Pose Drivetrain::pose() const { return pose_; }
+
+void Drivetrain::pose_set(Pose pose) {
+  pose_ = pose;
+  velocity_ = lateral_ = angular_ = 0;
+  left_ = right_ = Side{};
+}
+
+double Drivetrain::velocity() const { return velocity_ / METERS_PER_INCH; }
+
+double Drivetrain::angular_velocity() const { return degrees(angular_); }
+
+bool Drivetrain::left_slipping() const { return left_.slipping; }
+
+bool Drivetrain::right_slipping() const { return right_.slipping; }
+
+double Drivetrain::distance() const { return distance_ / METERS_PER_INCH; }
+
+std::uint32_t Drivetrain::slip_ms() const { return slip_ms_; }
+
+// Force the side's motors put on the ground through the wheels, N, and the
+// rotor inertia of those motors as felt at the tread, kg
+double Drivetrain::drive_force(const std::vector<int>& ports, double strength, double& reflected_mass) const {
+  const double radius = config_.wheel_diameter * METERS_PER_INCH / 2;
+  double force = 0;
+  reflected_mass = 0;
+  for (int port : ports) {
+    const Motor& m = motor(port);
+    const double ratio = free_speed(m.gearing) / config_.rpm;  // motor turns per wheel turn
+    force += direction(m) * m.torque * strength * ratio / radius;
+    reflected_mass += rotor_inertia(m.gearing) * std::pow(ratio / radius, 2);
+  }
+  return force;
+}
+
+void Drivetrain::side_step(Side& side, double force, double reflected_mass, double ground_speed, double& traction,
+                           double dt) {
+  const double grip = config_.traction * config_.mass * GRAVITY / 2;
+  // With the wheel stuck to the tile, part of the motor force goes into
+  // spinning up the rotors along with the robot
+  const double stuck = force * (config_.mass / 2) / (config_.mass / 2 + reflected_mass);
+
+  if (!side.slipping && std::abs(stuck) > grip) side.slipping = true;
+  if (!side.slipping || reflected_mass <= 0) {
+    side.slipping = false;
+    traction = stuck;
+    return;
+  }
+
+  const double slide = side.surface_speed - ground_speed;
+  const double sign = slide != 0 ? std::copysign(1.0, slide) : std::copysign(1.0, force);
+  traction = sign * KINETIC_FRICTION * grip;
+  side.surface_speed += (force - traction) / reflected_mass * dt;
+
+  // Catching back up with the ground re-grips the wheel
+  const double after = side.surface_speed - ground_speed;
+  if ((after == 0 || std::signbit(after) != std::signbit(slide)) && std::abs(stuck) <= grip) side.slipping = false;
+}
+
+void Drivetrain::step(double dt) {
+  const double half_track = config_.track_width * METERS_PER_INCH / 2;
+  const double weight = config_.mass * GRAVITY;
+  const double lateral_grip = LATERAL_GRIP_PER_DRIFT * config_.horizontal_drift;
+
+  double left_mass = 0;
+  double right_mass = 0;
+  const double left_force = drive_force(config_.left_motors, config_.left_strength, left_mass);
+  const double right_force = drive_force(config_.right_motors, config_.right_strength, right_mass);
+
+  // Clockwise turning moves the left side forward
+  double left_traction = 0;
+  double right_traction = 0;
+  side_step(left_, left_force, left_mass, velocity_ + angular_ * half_track, left_traction, dt);
+  side_step(right_, right_force, right_mass, velocity_ - angular_ * half_track, right_traction, dt);
+
+  // Forward: drive force against rolling resistance
+  const double push = left_traction + right_traction;
+  const double roll = friction(velocity_, push, config_.mass, config_.rolling_resistance * weight, dt);
+  const double forward_accel = (push + roll) / config_.mass + lateral_ * angular_;
+
+  // Sideways: the wheels hold the robot on its arc until the side grip gives out
+  const double hold = std::clamp(velocity_ * angular_ - lateral_ / dt, -lateral_grip * GRAVITY, lateral_grip * GRAVITY);
+  const double lateral_accel = hold - velocity_ * angular_;
+
+  // Turning: skid steer scrubs the wheels sideways
+  const double moment = (left_traction - right_traction) * half_track;
+  const double scrub = friction(angular_, moment, config_.inertia, lateral_grip * weight * half_track / 4, dt);
+  const double angular_accel = (moment + scrub) / config_.inertia;
+
+  velocity_ += forward_accel * dt;
+  lateral_ += lateral_accel * dt;
+  const double previous_angular = angular_;
+  angular_ += angular_accel * dt;
+
+  const double theta = radians(pose_.theta) + (previous_angular + angular_) / 2 * dt / 2;
+  pose_.x += (velocity_ * std::sin(theta) + lateral_ * std::cos(theta)) * dt / METERS_PER_INCH;
+  pose_.y += (velocity_ * std::cos(theta) - lateral_ * std::sin(theta)) * dt / METERS_PER_INCH;
+  pose_.theta += degrees((previous_angular + angular_) / 2 * dt);
+  distance_ += std::abs(velocity_) * dt;
+
+  if (!left_.slipping) left_.surface_speed = velocity_ + angular_ * half_track;
+  if (!right_.slipping) right_.surface_speed = velocity_ - angular_ * half_track;
+  if (left_.slipping || right_.slipping) slip_ms_++;
+
+  sensors_step(dt, forward_accel, lateral_accel);
+}
+
+void Drivetrain::sensors_step(double dt, double forward_accel, double lateral_accel) {
+  const double radius = config_.wheel_diameter * METERS_PER_INCH / 2;
+  const auto spin = [&](const std::vector<int>& ports, double surface_speed) {
+    for (int port : ports) {
+      Motor& m = motor(port);
+      const double rpm = direction(m) * surface_speed / radius * free_speed(m.gearing) / config_.rpm * 60 / (2 * M_PI);
+      m.position += (m.velocity + rpm) / 2 * 6 * dt;
+      m.velocity = rpm;
+    }
+  };
+  spin(config_.left_motors, left_.surface_speed);
+  spin(config_.right_motors, right_.surface_speed);
+
+  if (config_.imu_port > 0) {
+    Imu& imu = sim::imu(config_.imu_port);
+    imu.yaw_rate = degrees(angular_) * config_.imu_scale + config_.imu_drift;
+    imu.rotation += imu.yaw_rate * dt;
+    imu.accel_x = lateral_accel / GRAVITY;
+    imu.accel_y = forward_accel / GRAVITY;
+  }
+
+  for (const auto& wheel : config_.tracking_wheels) {
+    Rotation& sensor = rotation(wheel.port);
+    const double offset = wheel.offset * METERS_PER_INCH;
+    const double speed = wheel.horizontal ? -(lateral_ + angular_ * offset) : velocity_ - angular_ * offset;
+    sensor.velocity = (sensor.reversed ? -1 : 1) * degrees(speed / (wheel.diameter * METERS_PER_INCH / 2));
+    sensor.angle += sensor.velocity * dt;
+  }
+
+  const double theta = radians(pose_.theta);
+  const double s = std::sin(theta);
+  const double c = std::cos(theta);
+  for (const auto& mount : config_.distance_sensors) {
+    const double x = pose_.x + mount.x * c + mount.y * s;
+    const double y = pose_.y - mount.x * s + mount.y * c;
+    const double beam = theta + radians(mount.angle);
+    const double dx = std::sin(beam);
+    const double dy = std::cos(beam);
+    double nearest = INFINITY;
+    for (const Wall& wall : config_.walls) nearest = std::min(nearest, ray_hit(x, y, dx, dy, wall));
+    sim::distance(mount.port).distance = std::isinf(nearest) ? 9999 : nearest * METERS_PER_INCH * 1000;
+  }
+
+  // the sensor corrects for where it is mounted itself, so it reports the center of the robot
+  if (config_.gps_port > 0) {
+    Gps& sensor = gps(config_.gps_port);
+    sensor.x = pose_.x * METERS_PER_INCH;
+    sensor.y = pose_.y * METERS_PER_INCH;
+    sensor.heading = std::fmod(std::fmod(pose_.theta, 360) + 360, 360);
+  }
+}
+
+}  // namespace sim
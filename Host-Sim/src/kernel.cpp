@@ -0,0 +1,210 @@
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "kernel_internal.hpp"
+
+namespace sim {
+namespace detail {
+namespace {
+
+struct Kernel {
+  std::mutex lock;
+  std::condition_variable host_cv;
+  std::vector<std::unique_ptr<Task>> tasks;
+  std::vector<plant_fn_t> plants;
+  std::vector<plant_fn_t> samplers;
+  Task* running = nullptr;  // nullptr means the host thread owns the clock
+  std::uint32_t now = 0;
+  std::uint64_t switches = 0;
+};
+
+// Leaked on purpose: task threads may still be parked on the kernel when
+// static destructors run at exit.
+Kernel& kernel() {
+  static Kernel* k = new Kernel();
+  return *k;
+}
+
+thread_local Task* current = nullptr;
+
+bool runnable(const Kernel& k, Task& task) {
+  switch (task.state) {
+    case TaskState::ready:
+    case TaskState::running:
+      return true;
+    case TaskState::blocked:
+      if (task.until && task.until()) return true;
+      return !task.wake_forever && k.now >= task.wake_ms;
+    default:
+      return false;
+  }
+}
+
+// Picks the highest priority runnable task (least recently run on ties) and
+// hands it control.  If nothing can run, control goes back to the host.
+// Caller must hold the kernel lock.
+void dispatch(Kernel& k) {
+  Task* next = nullptr;
+  for (auto& task : k.tasks) {
+    if (!runnable(k, *task)) continue;
+    if (next == nullptr || task->priority > next->priority ||
+        (task->priority == next->priority && task->last_run < next->last_run))
+      next = task.get();
+  }
+
+  k.running = next;
+  if (next == nullptr) {
+    k.host_cv.notify_all();
+    return;
+  }
+  next->state = TaskState::running;
+  next->last_run = ++k.switches;
+  next->cv.notify_all();
+}
+
+// Hands control away from the calling task and waits until it gets it back.
+void yield(Kernel& k, std::unique_lock<std::mutex>& guard) {
+  Task* self = current;
+  dispatch(k);
+  self->cv.wait(guard, [&] { return k.running == self; });
+}
+
+void task_entry(Task* task) {
+  Kernel& k = kernel();
+  {
+    std::unique_lock<std::mutex> guard(k.lock);
+    task->cv.wait(guard, [&] { return k.running == task; });
+  }
+  current = task;
+  task->function(task->parameters);
+
+  std::unique_lock<std::mutex> guard(k.lock);
+  task->state = TaskState::deleted;
+  dispatch(k);
+}
+
+// Runs tasks until every one of them is blocked at the current time.
+void settle(Kernel& k) {
+  std::unique_lock<std::mutex> guard(k.lock);
+  dispatch(k);
+  k.host_cv.wait(guard, [&] { return k.running == nullptr; });
+}
+
+void step(Kernel& k) {
+  // No task is running here, so plants may touch device state freely
+  for (auto& plant : k.plants) plant(k.now + 1, 0.001);
+  for (auto& sampler : k.samplers) sampler(k.now + 1, 0.001);
+  std::lock_guard<std::mutex> guard(k.lock);
+  k.now++;
+}
+
+}  // namespace
+
+Task* task_current() { return current; }
+
+Task* task_spawn(pros::task_fn_t function, void* parameters, std::uint32_t priority, const char* name) {
+  Kernel& k = kernel();
+  auto task = std::make_unique<Task>();
+  task->function = function;
+  task->parameters = parameters;
+  task->priority = priority;
+  task->name = name != nullptr ? name : "";
+  Task* raw = task.get();
+  {
+    std::lock_guard<std::mutex> guard(k.lock);
+    k.tasks.push_back(std::move(task));
+  }
+  std::thread(task_entry, raw).detach();
+  return raw;
+}
+
+bool block(std::uint32_t timeout_ms, std::function<bool()> until) {
+  Kernel& k = kernel();
+  Task* self = current;
+  std::unique_lock<std::mutex> guard(k.lock);
+  self->state = TaskState::blocked;
+  self->wake_forever = timeout_ms == TIMEOUT_MAX;
+  self->wake_ms = self->wake_forever ? 0 : k.now + timeout_ms;
+  self->until = std::move(until);
+  yield(k, guard);
+  bool met = self->until && self->until();
+  self->until = nullptr;
+  return met;
+}
+
+void sleep_until(std::uint32_t wake_ms) {
+  Kernel& k = kernel();
+  Task* self = current;
+  std::unique_lock<std::mutex> guard(k.lock);
+  self->state = TaskState::blocked;
+  self->wake_forever = false;
+  self->wake_ms = wake_ms;
+  self->until = nullptr;
+  yield(k, guard);
+}
+
+void task_state_set(Task* task, TaskState state) {
+  Kernel& k = kernel();
+  std::unique_lock<std::mutex> guard(k.lock);
+  task->state = state;
+  if (task != current) return;
+  if (state == TaskState::deleted || state == TaskState::suspended) {
+    yield(k, guard);
+    // A deleted task never gets control back; park the thread for good
+    if (state == TaskState::deleted) task->cv.wait(guard, [] { return false; });
+  }
+}
+
+std::uint32_t task_count() {
+  Kernel& k = kernel();
+  std::lock_guard<std::mutex> guard(k.lock);
+  std::uint32_t count = 0;
+  for (auto& task : k.tasks)
+    if (task->state != TaskState::deleted) count++;
+  return count;
+}
+
+Task* task_find(const char* name) {
+  Kernel& k = kernel();
+  std::lock_guard<std::mutex> guard(k.lock);
+  for (auto& task : k.tasks)
+    if (task->state != TaskState::deleted && task->name == name) return task.get();
+  return nullptr;
+}
+
+}  // namespace detail
+
+std::uint32_t now_ms() { return detail::kernel().now; }
+
+std::uint64_t now_us() { return static_cast<std::uint64_t>(detail::kernel().now) * 1000; }
+
+void plant_add(plant_fn_t plant) { detail::kernel().plants.push_back(std::move(plant)); }
+
+void sampler_add(plant_fn_t sampler) { detail::kernel().samplers.push_back(std::move(sampler)); }
+
+void run_for(std::uint32_t ms) {
+  run_until([] { return false; }, ms);
+}
+
+bool run_until(const std::function<bool()>& done, std::uint32_t timeout_ms) {
+  auto& k = detail::kernel();
+  const std::uint32_t end = k.now + timeout_ms;
+  while (true) {
+    detail::settle(k);
+    if (done()) return true;
+    if (k.now >= end) return false;
+    detail::step(k);
+  }
+}
+
+bool run_task(void (*fn)(), std::uint32_t timeout_ms) {
+  auto* task = detail::task_spawn([](void* fn) { reinterpret_cast<void (*)()>(fn)(); },
+                                  reinterpret_cast<void*>(fn), TASK_PRIORITY_DEFAULT, "User Task");
+  return run_until([task] { return task->state == detail::TaskState::deleted; }, timeout_ms);
+}
+
+std::uint64_t context_switches() { return detail::kernel().switches; }
+
+}  // namespace sim
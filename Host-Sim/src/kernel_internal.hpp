@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "pros/rtos.h"
+#include "sim/kernel.hpp"
+
+namespace sim::detail {
+
+enum class TaskState { ready, running, blocked, suspended, deleted };
+
+struct Task {
+  std::string name;
+  pros::task_fn_t function = nullptr;
+  void* parameters = nullptr;
+  std::uint32_t priority = TASK_PRIORITY_DEFAULT;
+  TaskState state = TaskState::ready;
+
+  // Blocking bookkeeping.  A blocked task becomes ready when `until` returns
+  // true or when the clock reaches `wake_ms`, whichever happens first.
+  std::uint32_t wake_ms = 0;
+  bool wake_forever = false;
+  std::function<bool()> until;
+
+  // Round robin between tasks of equal priority
+  std::uint64_t last_run = 0;
+
+  std::uint32_t notify_value = 0;
+  std::condition_variable cv;
+};
+
+/**
+ * Returns the task the calling thread belongs to, or nullptr on the host thread.
+ */
+Task* task_current();
+
+/**
+ * Creates a task.  It starts running the next time the kernel dispatches.
+ */
+Task* task_spawn(pros::task_fn_t function, void* parameters, std::uint32_t priority, const char* name);
+
+/**
+ * Blocks the calling task until the condition holds or the timeout expires.
+ * Must only be called from inside a task.
+ *
+ * \param timeout_ms
+ *        how long to wait, TIMEOUT_MAX waits forever
+ * \param until
+ *        condition to wake on, may be empty for a plain delay
+ *
+ * \return true if the condition holds on return
+ */
+bool block(std::uint32_t timeout_ms, std::function<bool()> until);
+
+/**
+ * Blocks the calling task until the given absolute time.
+ */
+void sleep_until(std::uint32_t wake_ms);
+
+/**
+ * Changes the state of a task from another task, rescheduling if the caller
+ * suspended or deleted itself.
+ */
+void task_state_set(Task* task, TaskState state);
+
+/**
+ * Number of tasks that have not been deleted.
+ */
+std::uint32_t task_count();
+
+/**
+ * Finds a task by name, nullptr if there is none.
+ */
+Task* task_find(const char* name);
+
+}  // namespace sim::detail
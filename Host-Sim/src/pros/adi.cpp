@@ -0,0 +1,118 @@
+#include "pros/adi.hpp"
+
+#include <array>
+
+#include "pros/error.h"
+#include "sim/devices.hpp"
+
+namespace pros::adi {
+namespace {
+
+// Accepts 1-8, 'a'-'h' and 'A'-'H' like the real ADI API
+std::uint8_t adi_index(std::uint8_t port) {
+  if (port >= 'a' && port <= 'h') return port - 'a';
+  if (port >= 'A' && port <= 'H') return port - 'A';
+  return (port >= 1 && port <= sim::ADI_PORT_COUNT) ? port - 1 : 0;
+}
+
+std::array<bool, sim::ADI_PORT_COUNT> press_seen{};
+
+bool adi_valid(std::uint8_t port) {
+  return (port >= 'a' && port <= 'h') || (port >= 'A' && port <= 'H') || (port >= 1 && port <= sim::ADI_PORT_COUNT);
+}
+
+}  // namespace
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type)
+    : _smart_port(INTERNAL_ADI_PORT), _adi_port(adi_index(adi_port) + 1) {
+  if (type != E_ADI_TYPE_UNDEFINED) set_config(type);
+}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+    : _smart_port(port_pair.first), _adi_port(adi_index(port_pair.second) + 1) {
+  // Expanders share the simulated internal ADI state
+  if (type != E_ADI_TYPE_UNDEFINED) set_config(type);
+}
+
+std::int32_t Port::get_config() const { return sim::adi().config[_adi_port - 1]; }
+
+std::int32_t Port::get_value() const { return sim::adi().value[_adi_port - 1]; }
+
+std::int32_t Port::set_config(adi_port_config_e_t type) const {
+  sim::adi().config[_adi_port - 1] = type;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Port::set_value(std::int32_t value) const {
+  sim::adi().value[_adi_port - 1] = value;
+  return PROS_SUCCESS;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, PROS_ERR_BYTE}; }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state) : Port(adi_port, E_ADI_DIGITAL_OUT) {
+  set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state) : Port(port_pair, E_ADI_DIGITAL_OUT) {
+  set_value(init_state);
+}
+
+DigitalIn::DigitalIn(std::uint8_t adi_port) : Port(adi_port, E_ADI_DIGITAL_IN) {}
+
+DigitalIn::DigitalIn(ext_adi_port_pair_t port_pair) : Port(port_pair, E_ADI_DIGITAL_IN) {}
+
+std::int32_t DigitalIn::get_new_press() const {
+  bool& seen = press_seen[_adi_port - 1];
+  if (!get_value()) {
+    seen = false;
+    return false;
+  }
+  const bool fresh = !seen;
+  seen = true;
+  return fresh;
+}
+
+// The count lives on the top port, like the brain reports it
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool reversed)
+    : Port(adi_port_top, E_ADI_TYPE_UNDEFINED), _port_pair(adi_port_top, adi_port_bottom) {
+  // EZ-Template builds placeholder encoders on port -1, leave the real ports alone
+  if (!adi_valid(adi_port_top) || !adi_valid(adi_port_bottom)) return;
+  set_config(E_ADI_LEGACY_ENCODER);
+  sim::adi().config[adi_index(adi_port_bottom)] = E_ADI_LEGACY_ENCODER;
+}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool reversed)
+    : Encoder(std::get<1>(port_tuple), std::get<2>(port_tuple), reversed) {}
+
+std::int32_t Encoder::reset() const {
+  if (!adi_valid(_port_pair.first)) return PROS_ERR;
+  return set_value(0);
+}
+
+std::int32_t Encoder::get_value() const {
+  if (!adi_valid(_port_pair.first)) return PROS_ERR;
+  return Port::get_value();
+}
+
+ext_adi_port_tuple_t Encoder::get_port() const { return {_smart_port, _port_pair.first, _port_pair.second}; }
+
+std::ostream& operator<<(std::ostream& os, pros::adi::Encoder& encoder) {
+  os << "Encoder [smart_port: " << int(encoder._smart_port) << ", adi_port: " << int(encoder._adi_port)
+     << ", value: " << encoder.get_value() << "]";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, pros::adi::DigitalOut& digital_out) {
+  os << "DigitalOut [smart_port: " << int(digital_out._smart_port) << ", adi_port: " << int(digital_out._adi_port)
+     << ", value: " << digital_out.get_value() << "]";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, pros::adi::DigitalIn& digital_in) {
+  os << "DigitalIn [smart_port: " << int(digital_in._smart_port) << ", adi_port: " << int(digital_in._adi_port)
+     << ", value: " << digital_in.get_value() << "]";
+  return os;
+}
+
+}  // namespace pros::adi
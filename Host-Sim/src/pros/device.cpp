@@ -0,0 +1,32 @@
+#include "pros/device.hpp"
+
+#include "sim/devices.hpp"
+
+namespace pros {
+inline namespace v5 {
+
+Device::Device(const std::uint8_t port) : _port(port) {}
+
+std::uint8_t Device::get_port(void) const { return _port; }
+
+bool Device::is_installed() { return get_plugged_type() == _deviceType && _deviceType != DeviceType::none; }
+
+pros::DeviceType Device::get_plugged_type() const { return get_plugged_type(_port); }
+
+pros::DeviceType Device::get_plugged_type(std::uint8_t port) {
+  if (port < 1 || port > sim::PORT_COUNT) return DeviceType::undefined;
+  return sim::plugged_type(port);
+}
+
+std::vector<Device> Device::get_all_devices(pros::DeviceType device_type) {
+  std::vector<Device> devices;
+  for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++) {
+    auto type = sim::plugged_type(port);
+    if (type == DeviceType::none) continue;
+    if (device_type == DeviceType::undefined || type == device_type) devices.emplace_back(port);
+  }
+  return devices;
+}
+
+}  // namespace v5
+}  // namespace pros
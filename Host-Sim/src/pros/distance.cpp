@@ -0,0 +1,34 @@
+#include "pros/distance.hpp"
+
+#include "sim/devices.hpp"
+
+namespace pros {
+inline namespace v5 {
+
+Distance::Distance(const std::uint8_t port) : Device(port, DeviceType::distance) {
+  sim::distance(port).installed = true;
+  sim::plugged_type(port) = DeviceType::distance;
+}
+
+std::int32_t Distance::get() { return sim::distance(_port).sampled_distance; }
+
+std::int32_t Distance::get_distance() { return get(); }
+
+std::int32_t Distance::get_confidence() { return sim::distance(_port).sampled_confidence; }
+
+std::int32_t Distance::get_object_size() {
+  const auto& distance = sim::distance(_port);
+  return distance.sampled_confidence > 0 ? std::int32_t(distance.object_size) : -1;
+}
+
+double Distance::get_object_velocity() { return sim::distance(_port).object_velocity; }
+
+std::ostream& operator<<(std::ostream& os, pros::Distance& distance) {
+  os << "Distance [port: " << int(distance.get_port()) << ", distance: " << distance.get()
+     << ", confidence: " << distance.get_confidence() << ", object size: " << distance.get_object_size()
+     << ", object velocity: " << distance.get_object_velocity() << "]";
+  return os;
+}
+
+}  // namespace v5
+}  // namespace pros
@@ -0,0 +1,126 @@
+#include "pros/gps.hpp"
+
+#include <cerrno>
+#include <cmath>
+
+#include "pros/error.h"
+#include "sim/devices.hpp"
+
+// The constructors live in the header and don't mark the port, so a GPS counts
+// as plugged in once a plant (sim::Drivetrain's gps_port) or a test says so.
+
+namespace pros {
+namespace c {
+
+int32_t gps_initialize_full(uint8_t port, double xInitial, double yInitial, double headingInitial, double xOffset,
+                            double yOffset) {
+  gps_set_position(port, xInitial, yInitial, headingInitial);
+  return gps_set_offset(port, xOffset, yOffset);
+}
+
+int32_t gps_set_offset(uint8_t port, double xOffset, double yOffset) {
+  auto& gps = sim::gps(port);
+  gps.offset_x = xOffset;
+  gps.offset_y = yOffset;
+  return PROS_SUCCESS;
+}
+
+// Only a hint for when the sensor can't see the field strip, which the sim
+// doesn't model beyond readings stopping
+int32_t gps_set_position(uint8_t port, double xInitial, double yInitial, double headingInitial) {
+  return PROS_SUCCESS;
+}
+
+}  // namespace c
+
+inline namespace v5 {
+
+std::int32_t Gps::initialize_full(double xInitial, double yInitial, double headingInitial, double xOffset,
+                                  double yOffset) const {
+  return c::gps_initialize_full(_port, xInitial, yInitial, headingInitial, xOffset, yOffset);
+}
+
+std::int32_t Gps::set_offset(double xOffset, double yOffset) const { return c::gps_set_offset(_port, xOffset, yOffset); }
+
+std::vector<Gps> Gps::get_all_devices() {
+  std::vector<Gps> gpses;
+  for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++)
+    if (sim::plugged_type(port) == DeviceType::gps) gpses.emplace_back(port);
+  return gpses;
+}
+
+pros::gps_position_s_t Gps::get_offset() const {
+  const auto& gps = sim::gps(_port);
+  return {gps.offset_x, gps.offset_y};
+}
+
+std::int32_t Gps::set_position(double xInitial, double yInitial, double headingInitial) const {
+  return c::gps_set_position(_port, xInitial, yInitial, headingInitial);
+}
+
+std::int32_t Gps::set_data_rate(std::uint32_t rate) const {
+  sim::gps(_port).data_rate = std::max<std::uint32_t>(5, rate - rate % 5);
+  return PROS_SUCCESS;
+}
+
+double Gps::get_error() const { return sim::gps(_port).position_noise; }
+
+pros::gps_status_s_t Gps::get_position_and_orientation() const {
+  return {get_position_x(), get_position_y(), get_pitch(), get_roll(), get_yaw()};
+}
+
+pros::gps_position_s_t Gps::get_position() const { return {get_position_x(), get_position_y()}; }
+
+double Gps::get_position_x() const { return sim::gps(_port).sampled_x; }
+
+double Gps::get_position_y() const { return sim::gps(_port).sampled_y; }
+
+pros::gps_orientation_s_t Gps::get_orientation() const { return {get_pitch(), get_roll(), get_yaw()}; }
+
+double Gps::get_pitch() const { return 0; }
+
+double Gps::get_roll() const { return 0; }
+
+double Gps::get_yaw() const {
+  const double heading = get_heading();
+  return heading > 180 ? heading - 360 : heading;
+}
+
+double Gps::get_heading() const { return sim::gps(_port).sampled_heading; }
+
+double Gps::get_heading_raw() const { return get_heading(); }
+
+pros::gps_gyro_s_t Gps::get_gyro_rate() const { return {0, 0, 0}; }
+
+double Gps::get_gyro_rate_x() const { return 0; }
+
+double Gps::get_gyro_rate_y() const { return 0; }
+
+double Gps::get_gyro_rate_z() const { return 0; }
+
+pros::gps_accel_s_t Gps::get_accel() const { return {0, 0, 0}; }
+
+double Gps::get_accel_x() const { return 0; }
+
+double Gps::get_accel_y() const { return 0; }
+
+double Gps::get_accel_z() const { return 0; }
+
+std::ostream& operator<<(std::ostream& os, const pros::Gps& gps) {
+  os << "Gps [port: " << int(gps._port) << ", x: " << gps.get_position_x() << ", y: " << gps.get_position_y()
+     << ", heading: " << gps.get_heading() << ", error: " << gps.get_error() << "]";
+  return os;
+}
+
+Gps Gps::get_gps() {
+  static int calls = 0;
+  const std::vector<Gps> gpses = get_all_devices();
+  if (gpses.empty()) {
+    errno = ENODEV;
+    return Gps(PROS_ERR_BYTE);
+  }
+  return gpses[calls++ % gpses.size()];
+}
+
+}  // namespace v5
+}  // namespace pros
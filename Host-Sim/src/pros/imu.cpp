@@ -0,0 +1,157 @@
+#include "pros/imu.hpp"
+
+#include <cmath>
+
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace pros {
+inline namespace v5 {
+namespace {
+
+constexpr std::uint32_t CALIBRATION_TIME = 2000;  // ms, roughly what a real IMU takes
+
+double wrap_360(double angle) {
+  angle = std::fmod(angle, 360);
+  return angle < 0 ? angle + 360 : angle;
+}
+
+double wrap_180(double angle) { return wrap_360(angle + 180) - 180; }
+
+}  // namespace
+
+std::int32_t Imu::reset(bool blocking) const {
+  auto& imu = sim::imu(_port);
+  imu.installed = true;
+  sim::plugged_type(_port) = DeviceType::imu;
+  imu.calibration_end = sim::now_ms() + CALIBRATION_TIME;
+  if (blocking) pros::delay(CALIBRATION_TIME);
+  return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const {
+  // Same rounding as the firmware: multiples of 5 ms, at least 5 ms
+  sim::imu(_port).data_rate = std::max<std::uint32_t>(5, rate - rate % 5);
+  return PROS_SUCCESS;
+}
+
+std::vector<Imu> Imu::get_all_devices() {
+  std::vector<Imu> imus;
+  for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++)
+    if (sim::plugged_type(port) == DeviceType::imu) imus.emplace_back(port);
+  return imus;
+}
+
+double Imu::get_rotation() const {
+  const auto& imu = sim::imu(_port);
+  return imu.sampled_rotation + imu.rotation_offset;
+}
+
+double Imu::get_heading() const {
+  const auto& imu = sim::imu(_port);
+  return wrap_360(imu.sampled_rotation + imu.heading_offset);
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+  const auto euler = get_euler();
+  const double cy = std::cos(euler.yaw * M_PI / 360), sy = std::sin(euler.yaw * M_PI / 360);
+  const double cp = std::cos(euler.pitch * M_PI / 360), sp = std::sin(euler.pitch * M_PI / 360);
+  const double cr = std::cos(euler.roll * M_PI / 360), sr = std::sin(euler.roll * M_PI / 360);
+  return {sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy, cr * cp * sy - sr * sp * cy,
+          cr * cp * cy + sr * sp * sy};
+}
+
+pros::euler_s_t Imu::get_euler() const { return {get_pitch(), get_roll(), get_yaw()}; }
+
+double Imu::get_pitch() const {
+  const auto& imu = sim::imu(_port);
+  return wrap_180(imu.pitch + imu.pitch_offset);
+}
+
+double Imu::get_roll() const {
+  const auto& imu = sim::imu(_port);
+  return wrap_180(imu.roll + imu.roll_offset);
+}
+
+double Imu::get_yaw() const {
+  const auto& imu = sim::imu(_port);
+  return wrap_180(imu.sampled_rotation + imu.yaw_offset);
+}
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const { return {0, 0, sim::imu(_port).sampled_yaw_rate}; }
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return set_pitch(0); }
+
+std::int32_t Imu::tare_yaw() const { return set_yaw(0); }
+
+std::int32_t Imu::tare_roll() const { return set_roll(0); }
+
+std::int32_t Imu::tare() const {
+  tare_euler();
+  tare_heading();
+  return tare_rotation();
+}
+
+std::int32_t Imu::tare_euler() const { return set_euler({0, 0, 0}); }
+
+std::int32_t Imu::set_heading(const double target) const {
+  auto& imu = sim::imu(_port);
+  imu.heading_offset = target - imu.sampled_rotation;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+  auto& imu = sim::imu(_port);
+  imu.rotation_offset = target - imu.sampled_rotation;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_yaw(const double target) const {
+  auto& imu = sim::imu(_port);
+  imu.yaw_offset = target - imu.sampled_rotation;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_pitch(const double target) const {
+  auto& imu = sim::imu(_port);
+  imu.pitch_offset = target - imu.pitch;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_roll(const double target) const {
+  auto& imu = sim::imu(_port);
+  imu.roll_offset = target - imu.roll;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+  set_pitch(target.pitch);
+  set_roll(target.roll);
+  return set_yaw(target.yaw);
+}
+
+pros::imu_accel_s_t Imu::get_accel() const {
+  const auto& imu = sim::imu(_port);
+  return {imu.accel_x, imu.accel_y, imu.accel_z};
+}
+
+pros::ImuStatus Imu::get_status() const { return is_calibrating() ? ImuStatus::calibrating : ImuStatus::ready; }
+
+bool Imu::is_calibrating() const { return sim::now_ms() < sim::imu(_port).calibration_end; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+
+std::ostream& operator<<(std::ostream& os, const pros::Imu& imu) {
+  os << "Imu [port: " << int(imu._port) << ", rotation: " << imu.get_rotation() << ", heading: " << imu.get_heading()
+     << "]";
+  return os;
+}
+
+}  // namespace v5
+}  // namespace pros
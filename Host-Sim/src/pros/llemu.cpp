@@ -0,0 +1,95 @@
+// pros/llemu.h carries a weak lcd_print stub, so only the liblvgl declarations
+// are pulled in here
+#include "liblvgl/llemu.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+
+#include "sim/devices.hpp"
+
+namespace pros {
+namespace c {
+
+bool lcd_is_initialized(void) { return sim::lcd().initialized; }
+
+bool lcd_initialize(void) {
+  sim::lcd().initialized = true;
+  return true;
+}
+
+bool lcd_shutdown(void) {
+  sim::lcd().initialized = false;
+  return true;
+}
+
+bool lcd_set_text(int16_t line, const char* text) {
+  auto& lcd = sim::lcd();
+  if (!lcd.initialized) {
+    errno = ENXIO;
+    return false;
+  }
+  if (line < 0 || line >= static_cast<int16_t>(lcd.lines.size())) {
+    errno = EINVAL;
+    return false;
+  }
+  lcd.lines[line] = text;
+  lcd.prints++;
+  return true;
+}
+
+bool lcd_print(int16_t line, const char* fmt, ...) {
+  char buffer[64];
+  va_list args;
+  va_start(args, fmt);
+  std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+  va_end(args);
+  return lcd_set_text(line, buffer);
+}
+
+bool lcd_clear(void) {
+  for (auto& line : sim::lcd().lines) line.clear();
+  return true;
+}
+
+bool lcd_clear_line(int16_t line) { return lcd_set_text(line, ""); }
+
+bool lcd_register_btn0_cb(lcd_btn_cb_fn_t) { return true; }
+
+bool lcd_register_btn1_cb(lcd_btn_cb_fn_t) { return true; }
+
+bool lcd_register_btn2_cb(lcd_btn_cb_fn_t) { return true; }
+
+uint8_t lcd_read_buttons(void) { return sim::lcd().buttons; }
+
+void lcd_set_text_align(text_align_e_t) {}
+
+}  // namespace c
+
+namespace lcd {
+
+bool is_initialized(void) { return pros::c::lcd_is_initialized(); }
+
+bool initialize(void) { return pros::c::lcd_initialize(); }
+
+bool shutdown(void) { return pros::c::lcd_shutdown(); }
+
+bool set_text(std::int16_t line, std::string text) { return pros::c::lcd_set_text(line, text.c_str()); }
+
+bool clear(void) { return pros::c::lcd_clear(); }
+
+bool clear_line(std::int16_t line) { return pros::c::lcd_clear_line(line); }
+
+void register_btn0_cb(lcd_btn_cb_fn_t cb) { pros::c::lcd_register_btn0_cb(cb); }
+
+void register_btn1_cb(lcd_btn_cb_fn_t cb) { pros::c::lcd_register_btn1_cb(cb); }
+
+void register_btn2_cb(lcd_btn_cb_fn_t cb) { pros::c::lcd_register_btn2_cb(cb); }
+
+void set_text_align(Text_Align alignment) {
+  pros::c::lcd_set_text_align(static_cast<pros::text_align_e_t>(alignment));
+}
+
+std::uint8_t read_buttons(void) { return pros::c::lcd_read_buttons(); }
+
+}  // namespace lcd
+}  // namespace pros
@@ -0,0 +1,178 @@
+// The bits of liblvgl team code draws with. Objects only keep what a bench
+// can check (where they are, their text or points, whether they're hidden) and
+// every change that would make LVGL redraw an object is counted, see
+// sim::Screen. Styles are accepted and dropped.
+#include "liblvgl/lvgl.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sim/devices.hpp"
+
+namespace {
+
+struct Object {
+  std::unique_ptr<lv_obj_t> obj = std::make_unique<lv_obj_t>();
+  lv_obj_t* parent = nullptr;
+  int x = 0;
+  int y = 0;
+  bool hidden = false;
+  bool label = false;
+  std::string text;
+  std::vector<lv_point_t> points;
+  lv_event_cb_t clicked = nullptr;
+  void* user_data = nullptr;
+};
+
+std::vector<Object>& objects() {
+  static std::vector<Object> all;
+  return all;
+}
+
+Object* find(const lv_obj_t* obj) {
+  for (Object& object : objects()) {
+    if (object.obj.get() == obj) return &object;
+  }
+  return nullptr;
+}
+
+lv_obj_t* make(lv_obj_t* parent, bool label = false) {
+  Object object;
+  object.parent = parent;
+  object.label = label;
+  objects().push_back(std::move(object));
+  sim::screen().objects++;
+  return objects().back().obj.get();
+}
+
+void redrawn(const lv_obj_t* obj) {
+  Object* object = find(obj);
+  if (object != nullptr) sim::screen().redraws++;
+}
+
+bool visible(const Object& object) {
+  for (const Object* at = &object; at != nullptr; at = at->parent ? find(at->parent) : nullptr) {
+    if (at->hidden) return false;
+  }
+  return true;
+}
+
+// position on the screen, adding up the parents'
+std::pair<int, int> position(const Object& object) {
+  int x = 0, y = 0;
+  for (const Object* at = &object; at != nullptr; at = at->parent ? find(at->parent) : nullptr) {
+    x += at->x;
+    y += at->y;
+  }
+  return {x, y};
+}
+
+}  // namespace
+
+// the active screen is the first object, made on first use
+lv_disp_t* lv_disp_get_default(void) { return nullptr; }
+
+lv_obj_t* lv_disp_get_scr_act(lv_disp_t*) {
+  if (objects().empty()) make(nullptr);
+  return objects().front().obj.get();
+}
+
+lv_obj_t* lv_obj_create(lv_obj_t* parent) { return make(parent); }
+lv_obj_t* lv_label_create(lv_obj_t* parent) { return make(parent, true); }
+lv_obj_t* lv_line_create(lv_obj_t* parent) { return make(parent); }
+
+void lv_obj_set_pos(lv_obj_t* obj, lv_coord_t x, lv_coord_t y) {
+  Object* object = find(obj);
+  if (object == nullptr || (object->x == x && object->y == y)) return;
+  object->x = x;
+  object->y = y;
+  redrawn(obj);
+}
+
+void lv_obj_set_size(lv_obj_t*, lv_coord_t, lv_coord_t) {}
+
+void lv_obj_add_flag(lv_obj_t* obj, lv_obj_flag_t f) {
+  Object* object = find(obj);
+  if (object == nullptr || !(f & LV_OBJ_FLAG_HIDDEN) || object->hidden) return;
+  object->hidden = true;
+  redrawn(obj);
+}
+
+void lv_obj_clear_flag(lv_obj_t* obj, lv_obj_flag_t f) {
+  Object* object = find(obj);
+  if (object == nullptr || !(f & LV_OBJ_FLAG_HIDDEN) || !object->hidden) return;
+  object->hidden = false;
+  redrawn(obj);
+}
+
+struct _lv_event_dsc_t* lv_obj_add_event_cb(struct _lv_obj_t* obj, lv_event_cb_t event_cb, lv_event_code_t filter,
+                                            void* user_data) {
+  Object* object = find(obj);
+  if (object != nullptr && filter == LV_EVENT_CLICKED) {
+    object->clicked = event_cb;
+    object->user_data = user_data;
+  }
+  return nullptr;
+}
+
+void* lv_event_get_user_data(lv_event_t* e) { return e->user_data; }
+
+// LVGL redraws a label whenever its text is set, even to the same text
+void lv_label_set_text(lv_obj_t* obj, const char* text) {
+  Object* object = find(obj);
+  if (object == nullptr) return;
+  object->text = text == nullptr ? "" : text;
+  redrawn(obj);
+}
+
+void lv_line_set_points(lv_obj_t* obj, const lv_point_t points[], uint16_t point_num) {
+  Object* object = find(obj);
+  if (object == nullptr) return;
+  object->points.assign(points, points + point_num);
+  redrawn(obj);
+}
+
+void lv_obj_set_style_pad_top(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_pad_bottom(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_pad_left(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_pad_right(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_border_width(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_radius(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_bg_color(struct _lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+void lv_obj_set_style_text_color(struct _lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+void lv_obj_set_style_line_width(struct _lv_obj_t*, lv_coord_t, lv_style_selector_t) {}
+void lv_obj_set_style_line_color(struct _lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+
+namespace sim {
+
+std::vector<std::string> screen_labels() {
+  std::vector<std::tuple<int, int, std::string>> shown;
+  for (const Object& object : objects()) {
+    if (!object.label || !visible(object)) continue;
+    const auto [x, y] = position(object);
+    shown.emplace_back(y, x, object.text);
+  }
+  std::sort(shown.begin(), shown.end());
+  std::vector<std::string> labels;
+  for (const auto& [y, x, text] : shown) labels.push_back(text);
+  return labels;
+}
+
+void tap_screen() {
+  // the last object made that takes clicks and can be seen is on top
+  for (auto object = objects().rbegin(); object != objects().rend(); object++) {
+    if (object->clicked == nullptr || !visible(*object)) continue;
+    lv_event_t event {};
+    event.target = object->obj.get();
+    event.current_target = object->obj.get();
+    event.code = LV_EVENT_CLICKED;
+    event.user_data = object->user_data;
+    object->clicked(&event);
+    return;
+  }
+}
+
+}  // namespace sim
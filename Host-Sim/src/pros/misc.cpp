@@ -0,0 +1,167 @@
+#include "pros/misc.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include "pros/error.h"
+#include "sim/devices.hpp"
+
+namespace {
+
+int button_index(pros::controller_digital_e_t button) { return button - pros::E_CONTROLLER_DIGITAL_L1; }
+
+}  // namespace
+
+namespace pros::c {
+
+uint8_t competition_get_status(void) {
+  const auto& comp = sim::competition();
+  return (comp.disabled ? COMPETITION_DISABLED : 0) | (comp.autonomous ? COMPETITION_AUTONOMOUS : 0) |
+         (comp.connected ? COMPETITION_CONNECTED : 0);
+}
+
+uint8_t competition_is_disabled(void) { return sim::competition().disabled; }
+
+uint8_t competition_is_connected(void) { return sim::competition().connected; }
+
+uint8_t competition_is_autonomous(void) { return sim::competition().autonomous; }
+
+uint8_t competition_is_field(void) { return 0; }
+
+uint8_t competition_is_switch(void) { return sim::competition().connected; }
+
+int32_t controller_is_connected(controller_id_e_t id) { return sim::controller(id).connected; }
+
+int32_t controller_get_analog(controller_id_e_t id, controller_analog_e_t channel) {
+  return sim::controller(id).analog[channel];
+}
+
+int32_t controller_get_battery_capacity(controller_id_e_t id) { return 100; }
+
+int32_t controller_get_battery_level(controller_id_e_t id) { return 100; }
+
+int32_t controller_get_digital(controller_id_e_t id, controller_digital_e_t button) {
+  return sim::controller(id).digital[button_index(button)];
+}
+
+int32_t controller_get_digital_new_press(controller_id_e_t id, controller_digital_e_t button) {
+  auto& controller = sim::controller(id);
+  const int i = button_index(button);
+  if (!controller.digital[i]) {
+    controller.digital_seen[i] = false;
+    return false;
+  }
+  const bool fresh = !controller.digital_seen[i];
+  controller.digital_seen[i] = true;
+  return fresh;
+}
+
+int32_t controller_set_text(controller_id_e_t id, uint8_t line, uint8_t col, const char* str) {
+  auto& text = sim::controller(id).text;
+  if (line > 2 || col > 18) return PROS_ERR;
+  std::memcpy(&text[line * 20 + col], str, strnlen(str, 19 - col));
+  return PROS_SUCCESS;
+}
+
+int32_t controller_print(controller_id_e_t id, uint8_t line, uint8_t col, const char* fmt, ...) {
+  char buffer[20];
+  va_list args;
+  va_start(args, fmt);
+  std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+  va_end(args);
+  return controller_set_text(id, line, col, buffer);
+}
+
+int32_t controller_clear_line(controller_id_e_t id, uint8_t line) {
+  if (line > 2) return PROS_ERR;
+  std::memset(&sim::controller(id).text[line * 20], 0, 20);
+  return PROS_SUCCESS;
+}
+
+int32_t controller_clear(controller_id_e_t id) {
+  sim::controller(id).text.fill(0);
+  return PROS_SUCCESS;
+}
+
+int32_t controller_rumble(controller_id_e_t id, const char* rumble_pattern) { return PROS_SUCCESS; }
+
+int32_t battery_get_voltage(void) { return sim::battery_voltage(); }
+
+int32_t battery_get_current(void) { return 0; }
+
+double battery_get_temperature(void) { return 25; }
+
+double battery_get_capacity(void) { return 100; }
+
+int32_t usd_is_installed(void) { return 0; }
+
+int32_t usd_list_files(const char* path, char* buffer, int32_t len) {
+  errno = ENODEV;
+  return PROS_ERR;
+}
+
+}  // namespace pros::c
+
+namespace pros {
+inline namespace v5 {
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected(void) { return pros::c::controller_is_connected(_id); }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) {
+  return pros::c::controller_get_analog(_id, channel);
+}
+
+std::int32_t Controller::get_battery_capacity(void) { return pros::c::controller_get_battery_capacity(_id); }
+
+std::int32_t Controller::get_battery_level(void) { return pros::c::controller_get_battery_level(_id); }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) {
+  return pros::c::controller_get_digital(_id, button);
+}
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+  return pros::c::controller_get_digital_new_press(_id, button);
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) {
+  return pros::c::controller_set_text(_id, line, col, str);
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) {
+  return set_text(line, col, str.c_str());
+}
+
+std::int32_t Controller::clear_line(std::uint8_t line) { return pros::c::controller_clear_line(_id, line); }
+
+std::int32_t Controller::rumble(const char* rumble_pattern) { return pros::c::controller_rumble(_id, rumble_pattern); }
+
+std::int32_t Controller::clear(void) { return pros::c::controller_clear(_id); }
+
+}  // namespace v5
+
+namespace battery {
+double get_capacity(void) { return pros::c::battery_get_capacity(); }
+int32_t get_current(void) { return pros::c::battery_get_current(); }
+double get_temperature(void) { return pros::c::battery_get_temperature(); }
+int32_t get_voltage(void) { return pros::c::battery_get_voltage(); }
+}  // namespace battery
+
+namespace competition {
+std::uint8_t get_status(void) { return pros::c::competition_get_status(); }
+std::uint8_t is_autonomous(void) { return pros::c::competition_is_autonomous(); }
+std::uint8_t is_connected(void) { return pros::c::competition_is_connected(); }
+std::uint8_t is_disabled(void) { return pros::c::competition_is_disabled(); }
+std::uint8_t is_field_control(void) { return pros::c::competition_is_field(); }
+std::uint8_t is_competition_switch(void) { return pros::c::competition_is_switch(); }
+}  // namespace competition
+
+namespace usd {
+std::int32_t is_installed(void) { return pros::c::usd_is_installed(); }
+std::int32_t list_files(const char* path, char* buffer, std::int32_t len) {
+  return pros::c::usd_list_files(path, buffer, len);
+}
+}  // namespace usd
+}  // namespace pros
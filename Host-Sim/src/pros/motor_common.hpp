@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+#include "pros/error.h"
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+/**
+ * Per-port motor operations shared by pros::Motor and pros::MotorGroup.  The
+ * port may be negative, which reverses the motor just like in PROS.
+ */
+namespace sim::motor_ops {
+
+inline double sign(const Motor& m) { return m.reversed ? -1 : 1; }
+
+// Position as the user sees it, output degrees including the zero offset
+inline double user_position(const Motor& m) { return sign(m) * m.position; }
+
+inline Motor& install(std::int8_t port, pros::MotorGears gearset, pros::MotorUnits units) {
+  Motor& m = motor(port);
+  m.installed = true;
+  m.reversed = port < 0;
+  if (gearset != pros::MotorGears::invalid) m.gearing = gearset;
+  if (units != pros::MotorUnits::invalid) m.units = units;
+  plugged_type(port) = pros::DeviceType::motor;
+  return m;
+}
+
+inline std::int32_t move_voltage(std::int8_t port, double millivolts) {
+  Motor& m = motor(port);
+  // V5 motors hold their position when told to stop in hold mode
+  if (millivolts == 0 && m.brake_mode == pros::MotorBrake::hold) {
+    m.mode = Motor::Mode::position;
+    m.target_position = user_position(m);
+    m.profile_velocity = 0;
+    return PROS_SUCCESS;
+  }
+  m.mode = Motor::Mode::voltage;
+  m.target_voltage = std::fmax(-12000, std::fmin(12000, millivolts));
+  return PROS_SUCCESS;
+}
+
+inline std::int32_t move(std::int8_t port, std::int32_t voltage) {
+  return move_voltage(port, std::fmax(-127, std::fmin(127, voltage)) * 12000.0 / 127);
+}
+
+inline std::int32_t move_velocity(std::int8_t port, std::int32_t velocity) {
+  Motor& m = motor(port);
+  if (velocity == 0) return move_voltage(port, 0);
+  m.mode = Motor::Mode::velocity;
+  m.target_velocity = velocity;
+  return PROS_SUCCESS;
+}
+
+inline std::int32_t move_absolute(std::int8_t port, double position, std::int32_t velocity) {
+  Motor& m = motor(port);
+  m.mode = Motor::Mode::position;
+  m.target_position = from_units(m, position) + m.zero;
+  m.profile_velocity = std::abs(velocity);
+  return PROS_SUCCESS;
+}
+
+inline std::int32_t move_relative(std::int8_t port, double position, std::int32_t velocity) {
+  Motor& m = motor(port);
+  m.mode = Motor::Mode::position;
+  m.target_position = user_position(m) + from_units(m, position);
+  m.profile_velocity = std::abs(velocity);
+  return PROS_SUCCESS;
+}
+
+inline std::int32_t brake(std::int8_t port) { return move_voltage(port, 0); }
+
+inline std::int32_t modify_profiled_velocity(std::int8_t port, std::int32_t velocity) {
+  motor(port).profile_velocity = std::abs(velocity);
+  return PROS_SUCCESS;
+}
+
+inline double get_target_position(std::int8_t port) {
+  const Motor& m = motor(port);
+  return to_units(m, m.target_position - m.zero);
+}
+
+inline std::int32_t get_target_velocity(std::int8_t port) { return motor(port).target_velocity; }
+
+inline double get_actual_velocity(std::int8_t port) {
+  const Motor& m = motor(port);
+  return sign(m) * m.velocity;
+}
+
+inline std::int32_t get_current_draw(std::int8_t port) { return std::abs(motor(port).current); }
+
+inline std::int32_t get_direction(std::int8_t port) { return get_actual_velocity(port) < 0 ? -1 : 1; }
+
+inline double get_efficiency(std::int8_t port) {
+  const Motor& m = motor(port);
+  const double in = std::abs(m.voltage * m.current);
+  if (in == 0) return 0;
+  const double out = std::abs(m.torque * m.velocity * 2 * M_PI / 60) * 1e6;
+  return std::fmin(100, 100 * out / in);
+}
+
+inline std::uint32_t get_faults(std::int8_t port) {
+  const Motor& m = motor(port);
+  std::uint32_t faults = 0;
+  if (m.temperature >= 55) faults |= pros::E_MOTOR_FAULT_MOTOR_OVER_TEMP;
+  if (std::abs(m.current) >= m.current_limit) faults |= pros::E_MOTOR_FAULT_OVER_CURRENT;
+  return faults;
+}
+
+inline std::uint32_t get_flags(std::int8_t port) {
+  const Motor& m = motor(port);
+  return m.velocity == 0 ? pros::E_MOTOR_FLAGS_ZERO_VELOCITY : pros::E_MOTOR_FLAGS_NONE;
+}
+
+inline double get_position(std::int8_t port) {
+  const Motor& m = motor(port);
+  return to_units(m, user_position(m) - m.zero);
+}
+
+inline double get_power(std::int8_t port) {
+  const Motor& m = motor(port);
+  return std::abs(m.voltage * m.current) / 1e6;
+}
+
+inline std::int32_t get_raw_position(std::int8_t port, std::uint32_t* const timestamp) {
+  Motor& m = motor(port);
+  if (timestamp != nullptr) *timestamp = now_ms();
+  const auto units = m.units;
+  m.units = pros::MotorUnits::counts;
+  const double counts = to_units(m, user_position(m));
+  m.units = units;
+  return std::lround(counts);
+}
+
+inline double get_temperature(std::int8_t port) { return motor(port).temperature; }
+
+inline double get_torque(std::int8_t port) {
+  const Motor& m = motor(port);
+  return sign(m) * m.torque;
+}
+
+inline std::int32_t get_voltage(std::int8_t port) {
+  const Motor& m = motor(port);
+  return std::lround(sign(m) * m.voltage);
+}
+
+inline std::int32_t is_over_current(std::int8_t port) {
+  return (get_faults(port) & pros::E_MOTOR_FAULT_OVER_CURRENT) != 0;
+}
+
+inline std::int32_t is_over_temp(std::int8_t port) {
+  return (get_faults(port) & pros::E_MOTOR_FAULT_MOTOR_OVER_TEMP) != 0;
+}
+
+inline std::int32_t set_zero_position(std::int8_t port, double position) {
+  Motor& m = motor(port);
+  m.zero = user_position(m) - from_units(m, position);
+  return PROS_SUCCESS;
+}
+
+inline std::int32_t set_reversed(std::int8_t port, bool reverse) {
+  Motor& m = motor(port);
+  m.reversed = reverse;
+  return PROS_SUCCESS;
+}
+
+}  // namespace sim::motor_ops
@@ -0,0 +1,378 @@
+#include "pros/motor_group.hpp"
+
+#include <algorithm>
+
+#include "motor_common.hpp"
+
+namespace ops = sim::motor_ops;
+
+namespace pros {
+inline namespace v5 {
+namespace {
+
+// Runs a command on every motor, returning PROS_ERR if the group is empty
+template <typename F>
+std::int32_t each(const std::vector<std::int8_t>& ports, F&& command) {
+  if (ports.empty()) {
+    errno = EDOM;
+    return PROS_ERR;
+  }
+  for (auto port : ports) command(port);
+  return PROS_SUCCESS;
+}
+
+template <typename T, typename F>
+std::vector<T> all(const std::vector<std::int8_t>& ports, F&& getter) {
+  std::vector<T> out;
+  out.reserve(ports.size());
+  for (auto port : ports) out.push_back(getter(port));
+  return out;
+}
+
+template <typename T, typename F>
+T at(const std::vector<std::int8_t>& ports, std::uint8_t index, T error, F&& getter) {
+  if (index >= ports.size()) {
+    errno = EDOM;
+    return error;
+  }
+  return getter(ports[index]);
+}
+
+}  // namespace
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : _ports(ports) {
+  for (auto port : _ports) ops::install(port, gearset, encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group) : _ports(motor_group.get_port_all()) {}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+  return each(_ports, [&](auto port) { ops::move(port, voltage); });
+}
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+  return each(_ports, [&](auto port) { ops::move_absolute(port, position, velocity); });
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+  return each(_ports, [&](auto port) { ops::move_relative(port, position, velocity); });
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+  return each(_ports, [&](auto port) { ops::move_velocity(port, velocity); });
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+  return each(_ports, [&](auto port) { ops::move_voltage(port, voltage); });
+}
+
+std::int32_t MotorGroup::brake(void) const {
+  return each(_ports, [&](auto port) { ops::brake(port); });
+}
+
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+  return each(_ports, [&](auto port) { ops::modify_profiled_velocity(port, velocity); });
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+  return at(_ports, index, double(PROS_ERR_F), ops::get_target_position);
+}
+
+std::vector<double> MotorGroup::get_target_position_all(void) const {
+  return all<double>(_ports, ops::get_target_position);
+}
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, ops::get_target_velocity);
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const {
+  return all<std::int32_t>(_ports, ops::get_target_velocity);
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+  return at(_ports, index, double(PROS_ERR_F), ops::get_actual_velocity);
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const {
+  return all<double>(_ports, ops::get_actual_velocity);
+}
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, ops::get_current_draw);
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const {
+  return all<std::int32_t>(_ports, ops::get_current_draw);
+}
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, ops::get_direction);
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const {
+  return all<std::int32_t>(_ports, ops::get_direction);
+}
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+  return at(_ports, index, double(PROS_ERR_F), ops::get_efficiency);
+}
+
+std::vector<double> MotorGroup::get_efficiency_all(void) const { return all<double>(_ports, ops::get_efficiency); }
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+  return at(_ports, index, std::uint32_t(PROS_ERR), ops::get_faults);
+}
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const {
+  return all<std::uint32_t>(_ports, ops::get_faults);
+}
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+  return at(_ports, index, std::uint32_t(PROS_ERR), ops::get_flags);
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const { return all<std::uint32_t>(_ports, ops::get_flags); }
+
+double MotorGroup::get_position(const std::uint8_t index) const {
+  return at(_ports, index, double(PROS_ERR_F), ops::get_position);
+}
+
+std::vector<double> MotorGroup::get_position_all(void) const { return all<double>(_ports, ops::get_position); }
+
+double MotorGroup::get_power(const std::uint8_t index) const { return at(_ports, index, double(PROS_ERR_F), ops::get_power); }
+
+std::vector<double> MotorGroup::get_power_all(void) const { return all<double>(_ports, ops::get_power); }
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) { return ops::get_raw_position(port, timestamp); });
+}
+
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+  return all<std::int32_t>(_ports, [&](auto port) { return ops::get_raw_position(port, timestamp); });
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+  return at(_ports, index, double(PROS_ERR_F), ops::get_temperature);
+}
+
+std::vector<double> MotorGroup::get_temperature_all(void) const { return all<double>(_ports, ops::get_temperature); }
+
+double MotorGroup::get_torque(const std::uint8_t index) const { return at(_ports, index, double(PROS_ERR_F), ops::get_torque); }
+
+std::vector<double> MotorGroup::get_torque_all(void) const { return all<double>(_ports, ops::get_torque); }
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, ops::get_voltage);
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const {
+  return all<std::int32_t>(_ports, ops::get_voltage);
+}
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, ops::is_over_current);
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const {
+  return all<std::int32_t>(_ports, ops::is_over_current);
+}
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, ops::is_over_temp);
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const {
+  return all<std::int32_t>(_ports, ops::is_over_temp);
+}
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+  return at(_ports, index, MotorBrake::invalid, [](auto port) { return sim::motor(port).brake_mode; });
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+  return all<MotorBrake>(_ports, [](auto port) { return sim::motor(port).brake_mode; });
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [](auto port) { return sim::motor(port).current_limit; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const {
+  return all<std::int32_t>(_ports, [](auto port) { return sim::motor(port).current_limit; });
+}
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+  return at(_ports, index, MotorUnits::invalid, [](auto port) { return sim::motor(port).units; });
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+  return all<MotorUnits>(_ports, [](auto port) { return sim::motor(port).units; });
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+  return at(_ports, index, MotorGears::invalid, [](auto port) { return sim::motor(port).gearing; });
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+  return all<MotorGears>(_ports, [](auto port) { return sim::motor(port).gearing; });
+}
+
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const { return _ports; }
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [](auto port) { return sim::motor(port).voltage_limit; });
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const {
+  return all<std::int32_t>(_ports, [](auto port) { return sim::motor(port).voltage_limit; });
+}
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [](auto port) { return std::int32_t(sim::motor(port).reversed); });
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const {
+  return all<std::int32_t>(_ports, [](auto port) { return std::int32_t(sim::motor(port).reversed); });
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) {
+    sim::motor(port).brake_mode = mode;
+    return PROS_SUCCESS;
+  });
+}
+
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+  return set_brake_mode(static_cast<MotorBrake>(mode), index);
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+  return each(_ports, [&](auto port) { sim::motor(port).brake_mode = mode; });
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+  return set_brake_mode_all(static_cast<MotorBrake>(mode));
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) {
+    sim::motor(port).current_limit = limit;
+    return PROS_SUCCESS;
+  });
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+  return each(_ports, [&](auto port) { sim::motor(port).current_limit = limit; });
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) {
+    sim::motor(port).units = units;
+    return PROS_SUCCESS;
+  });
+}
+
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+  return set_encoder_units(static_cast<MotorUnits>(units), index);
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+  return each(_ports, [&](auto port) { sim::motor(port).units = units; });
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+  return set_encoder_units_all(static_cast<MotorUnits>(units));
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+  for (std::size_t i = 0; i < std::min(gearsets.size(), _ports.size()); i++)
+    sim::motor(_ports[i]).gearing = static_cast<MotorGears>(gearsets[i]);
+  return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+  return set_gearing(static_cast<MotorGears>(gearset), index);
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+  for (std::size_t i = 0; i < std::min(gearsets.size(), _ports.size()); i++) sim::motor(_ports[i]).gearing = gearsets[i];
+  return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) {
+    sim::motor(port).gearing = gearset;
+    return PROS_SUCCESS;
+  });
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+  return each(_ports, [&](auto port) { sim::motor(port).gearing = gearset; });
+}
+
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+  return set_gearing_all(static_cast<MotorGears>(gearset));
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+  if (index >= _ports.size()) {
+    errno = EDOM;
+    return PROS_ERR;
+  }
+  _ports[index] = reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]);
+  return ops::set_reversed(_ports[index], reverse);
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+  for (std::uint8_t i = 0; i < _ports.size(); i++) set_reversed(reverse, i);
+  return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) {
+    sim::motor(port).voltage_limit = limit;
+    return PROS_SUCCESS;
+  });
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+  return each(_ports, [&](auto port) { sim::motor(port).voltage_limit = limit; });
+}
+
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR, [&](auto port) { return ops::set_zero_position(port, position); });
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+  return each(_ports, [&](auto port) { ops::set_zero_position(port, position); });
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const { return set_zero_position(0, index); }
+
+std::int32_t MotorGroup::tare_position_all(void) const { return set_zero_position_all(0); }
+
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+  return at(_ports, index, std::int8_t(PROS_ERR_BYTE), [](auto port) { return port; });
+}
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+  auto ports = other.get_port_all();
+  _ports.insert(_ports.end(), ports.begin(), ports.end());
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+  _ports.erase(std::remove(_ports.begin(), _ports.end(), port), _ports.end());
+}
+
+}  // namespace v5
+}  // namespace pros
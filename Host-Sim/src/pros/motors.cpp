@@ -0,0 +1,213 @@
+#include "pros/motors.hpp"
+
+#include "motor_common.hpp"
+
+namespace ops = sim::motor_ops;
+
+namespace pros {
+inline namespace v5 {
+
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor), _port(port) {
+  ops::install(port, gearset, encoder_units);
+}
+
+std::int32_t Motor::move(std::int32_t voltage) const { return ops::move(_port, voltage); }
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const {
+  return ops::move_absolute(_port, position, velocity);
+}
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+  return ops::move_relative(_port, position, velocity);
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const { return ops::move_velocity(_port, velocity); }
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const { return ops::move_voltage(_port, voltage); }
+
+std::int32_t Motor::brake(void) const { return ops::brake(_port); }
+
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const {
+  return ops::modify_profiled_velocity(_port, velocity);
+}
+
+double Motor::get_target_position(const std::uint8_t) const { return ops::get_target_position(_port); }
+
+std::int32_t Motor::get_target_velocity(const std::uint8_t) const { return ops::get_target_velocity(_port); }
+
+double Motor::get_actual_velocity(const std::uint8_t) const { return ops::get_actual_velocity(_port); }
+
+std::int32_t Motor::get_current_draw(const std::uint8_t) const { return ops::get_current_draw(_port); }
+
+std::int32_t Motor::get_direction(const std::uint8_t) const { return ops::get_direction(_port); }
+
+double Motor::get_efficiency(const std::uint8_t) const { return ops::get_efficiency(_port); }
+
+std::uint32_t Motor::get_faults(const std::uint8_t) const { return ops::get_faults(_port); }
+
+std::uint32_t Motor::get_flags(const std::uint8_t) const { return ops::get_flags(_port); }
+
+double Motor::get_position(const std::uint8_t) const { return ops::get_position(_port); }
+
+double Motor::get_power(const std::uint8_t) const { return ops::get_power(_port); }
+
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t) const {
+  return ops::get_raw_position(_port, timestamp);
+}
+
+double Motor::get_temperature(const std::uint8_t) const { return ops::get_temperature(_port); }
+
+double Motor::get_torque(const std::uint8_t) const { return ops::get_torque(_port); }
+
+std::int32_t Motor::get_voltage(const std::uint8_t) const { return ops::get_voltage(_port); }
+
+std::int32_t Motor::is_over_current(const std::uint8_t) const { return ops::is_over_current(_port); }
+
+std::int32_t Motor::is_over_temp(const std::uint8_t) const { return ops::is_over_temp(_port); }
+
+MotorBrake Motor::get_brake_mode(const std::uint8_t) const { return sim::motor(_port).brake_mode; }
+
+std::int32_t Motor::get_current_limit(const std::uint8_t) const { return sim::motor(_port).current_limit; }
+
+MotorUnits Motor::get_encoder_units(const std::uint8_t) const { return sim::motor(_port).units; }
+
+MotorGears Motor::get_gearing(const std::uint8_t) const { return sim::motor(_port).gearing; }
+
+std::int32_t Motor::get_voltage_limit(const std::uint8_t) const { return sim::motor(_port).voltage_limit; }
+
+std::int32_t Motor::is_reversed(const std::uint8_t) const { return sim::motor(_port).reversed; }
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t) const {
+  sim::motor(_port).brake_mode = mode;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+  return set_brake_mode(static_cast<MotorBrake>(mode), index);
+}
+
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t) const {
+  sim::motor(_port).current_limit = limit;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t) const {
+  sim::motor(_port).units = units;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+  return set_encoder_units(static_cast<MotorUnits>(units), index);
+}
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t) const {
+  sim::motor(_port).gearing = gearset;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+  return set_gearing(static_cast<MotorGears>(gearset), index);
+}
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t) {
+  _port = reverse ? -std::abs(_port) : std::abs(_port);
+  return ops::set_reversed(_port, reverse);
+}
+
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t) const {
+  sim::motor(_port).voltage_limit = limit;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t) const {
+  return ops::set_zero_position(_port, position);
+}
+
+std::int32_t Motor::tare_position(const std::uint8_t) const { return ops::set_zero_position(_port, 0); }
+
+std::int8_t Motor::size(void) const { return 1; }
+
+std::vector<Motor> Motor::get_all_devices() {
+  std::vector<Motor> motors;
+  for (int port = 1; port <= sim::PORT_COUNT; port++)
+    if (sim::plugged_type(port) == DeviceType::motor) motors.emplace_back(sim::motor(port).reversed ? -port : port);
+  return motors;
+}
+
+std::int8_t Motor::get_port(const std::uint8_t) const { return _port; }
+
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position()}; }
+
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity()}; }
+
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity()}; }
+
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw()}; }
+
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction()}; }
+
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency()}; }
+
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults()}; }
+
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags()}; }
+
+std::vector<double> Motor::get_position_all(void) const { return {get_position()}; }
+
+std::vector<double> Motor::get_power_all(void) const { return {get_power()}; }
+
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const {
+  return {get_raw_position(timestamp)};
+}
+
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature()}; }
+
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque()}; }
+
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage()}; }
+
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current()}; }
+
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp()}; }
+
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode()}; }
+
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit()}; }
+
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units()}; }
+
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing()}; }
+
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {_port}; }
+
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit()}; }
+
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed()}; }
+
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit); }
+
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units); }
+
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+  return set_encoder_units(units);
+}
+
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse); }
+
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit); }
+
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position); }
+
+std::int32_t Motor::tare_position_all(void) const { return tare_position(); }
+
+}  // namespace v5
+}  // namespace pros
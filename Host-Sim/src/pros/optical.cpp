@@ -0,0 +1,81 @@
+#include "pros/optical.hpp"
+
+#include <cmath>
+
+#include "sim/devices.hpp"
+#include "sim/kernel.hpp"
+
+namespace pros {
+inline namespace v5 {
+
+Optical::Optical(const std::uint8_t port) : Device(port, DeviceType::optical) {
+  sim::optical(port).installed = true;
+  sim::plugged_type(port) = DeviceType::optical;
+}
+
+std::vector<Optical> Optical::get_all_devices() {
+  std::vector<Optical> opticals;
+  for (std::uint8_t port = 1; port <= sim::PORT_COUNT; port++)
+    if (sim::plugged_type(port) == DeviceType::optical) opticals.emplace_back(port);
+  return opticals;
+}
+
+double Optical::get_hue() { return sim::optical(_port).hue; }
+
+double Optical::get_saturation() { return sim::optical(_port).saturation; }
+
+double Optical::get_brightness() { return sim::optical(_port).brightness; }
+
+std::int32_t Optical::get_proximity() { return sim::optical(_port).proximity; }
+
+std::int32_t Optical::set_led_pwm(uint8_t value) {
+  sim::optical(_port).led_pwm = value;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Optical::get_led_pwm() { return sim::optical(_port).led_pwm; }
+
+pros::c::optical_rgb_s_t Optical::get_rgb() {
+  const auto& optical = sim::optical(_port);
+  return {optical.red, optical.green, optical.blue, optical.brightness};
+}
+
+pros::c::optical_raw_s_t Optical::get_raw() {
+  // The raw channels are unscaled photodiode counts; scale the processed values up
+  const auto& optical = sim::optical(_port);
+  const auto counts = [](double value) { return static_cast<std::uint32_t>(std::lround(value * 16)); };
+  return {counts(optical.red + optical.green + optical.blue), counts(optical.red), counts(optical.green),
+          counts(optical.blue)};
+}
+
+pros::c::optical_direction_e_t Optical::get_gesture() { return pros::c::NO_GESTURE; }
+
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return {0, 0, 0, 0, 0, 0, 0, sim::now_ms()}; }
+
+std::int32_t Optical::enable_gesture() {
+  sim::optical(_port).gesture = true;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Optical::disable_gesture() {
+  sim::optical(_port).gesture = false;
+  return PROS_SUCCESS;
+}
+
+#ifdef SIM_OPTICAL_INTEGRATION_TIME
+double Optical::get_integration_time() { return sim::optical(_port).integration_time; }
+
+std::int32_t Optical::set_integration_time(double time) {
+  sim::optical(_port).integration_time = std::fmax(3, std::fmin(712, time));
+  return PROS_SUCCESS;
+}
+#endif
+
+std::ostream& operator<<(std::ostream& os, pros::Optical& optical) {
+  os << "Optical [port: " << int(optical.get_port()) << ", hue: " << optical.get_hue()
+     << ", saturation: " << optical.get_saturation() << ", proximity: " << optical.get_proximity() << "]";
+  return os;
+}
+
+}  // namespace v5
+}  // namespace pros
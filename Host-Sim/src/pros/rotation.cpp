@@ -0,0 +1,90 @@
+#include "pros/rotation.hpp"
+
+#include <cmath>
+
+#include "pros/error.h"
+#include "sim/devices.hpp"
+
+namespace pros {
+inline namespace v5 {
+namespace {
+
+// Angle as the user sees it, degrees, before the position offset
+double user_angle(const sim::Rotation& rotation) {
+  return rotation.reversed ? -rotation.sampled_angle : rotation.sampled_angle;
+}
+
+}  // namespace
+
+Rotation::Rotation(const std::int8_t port) : Device(std::abs(port), DeviceType::rotation) {
+  auto& rotation = sim::rotation(port);
+  rotation.installed = true;
+  rotation.reversed = port < 0;
+  sim::plugged_type(port) = DeviceType::rotation;
+}
+
+std::int32_t Rotation::reset() {
+  // Position snaps back to the absolute angle of the magnet
+  auto& rotation = sim::rotation(_port);
+  const double angle = user_angle(rotation);
+  rotation.offset = angle - (std::fmod(angle, 360) + (std::fmod(angle, 360) < 0 ? 360 : 0));
+  return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const {
+  sim::rotation(_port).data_rate = std::max<std::uint32_t>(5, rate - rate % 5);
+  return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::set_position(std::uint32_t position) const {
+  auto& rotation = sim::rotation(_port);
+  rotation.offset = user_angle(rotation) - static_cast<std::int32_t>(position) / 100.0;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reset_position(void) const { return set_position(0); }
+
+std::vector<Rotation> Rotation::get_all_devices() {
+  std::vector<Rotation> rotations;
+  for (int port = 1; port <= sim::PORT_COUNT; port++)
+    if (sim::plugged_type(port) == DeviceType::rotation)
+      rotations.emplace_back(sim::rotation(port).reversed ? -port : port);
+  return rotations;
+}
+
+std::int32_t Rotation::get_position() const {
+  const auto& rotation = sim::rotation(_port);
+  return std::lround((user_angle(rotation) - rotation.offset) * 100);
+}
+
+std::int32_t Rotation::get_velocity() const {
+  const auto& rotation = sim::rotation(_port);
+  return std::lround((rotation.reversed ? -rotation.sampled_velocity : rotation.sampled_velocity) * 100);
+}
+
+std::int32_t Rotation::get_angle() const {
+  const std::int32_t angle = std::lround(user_angle(sim::rotation(_port)) * 100) % 36000;
+  return angle < 0 ? angle + 36000 : angle;
+}
+
+std::int32_t Rotation::set_reversed(bool value) const {
+  sim::rotation(_port).reversed = value;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reverse() const {
+  auto& rotation = sim::rotation(_port);
+  rotation.reversed = !rotation.reversed;
+  return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::get_reversed() const { return sim::rotation(_port).reversed; }
+
+std::ostream& operator<<(std::ostream& os, const pros::Rotation& rotation) {
+  os << "Rotation [port: " << int(rotation._port) << ", position: " << rotation.get_position()
+     << ", velocity: " << rotation.get_velocity() << "]";
+  return os;
+}
+
+}  // namespace v5
+}  // namespace pros
@@ -0,0 +1,223 @@
+#include "pros/rtos.hpp"
+
+#include "../kernel_internal.hpp"
+
+using SimTask = sim::detail::Task;
+using sim::detail::TaskState;
+
+namespace {
+
+struct SimMutex {
+  bool locked = false;
+};
+
+SimTask* resolve(pros::task_t task) {
+  return task == CURRENT_TASK ? sim::detail::task_current() : static_cast<SimTask*>(task);
+}
+
+}  // namespace
+
+namespace pros::c {
+
+uint32_t millis(void) { return sim::now_ms(); }
+
+uint64_t micros(void) { return sim::now_us(); }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth,
+                   const char* const name) {
+  (void)stack_depth;
+  return sim::detail::task_spawn(function, parameters, prio, name);
+}
+
+void task_delete(task_t task) { sim::detail::task_state_set(resolve(task), TaskState::deleted); }
+
+void task_delay(const uint32_t milliseconds) {
+  // The host thread has no task to block, so it drives the clock instead
+  if (sim::detail::task_current() == nullptr) {
+    sim::run_for(milliseconds);
+    return;
+  }
+  sim::detail::sleep_until(sim::now_ms() + milliseconds);
+}
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+  *prev_time += delta;
+  if (sim::detail::task_current() == nullptr) {
+    if (*prev_time > sim::now_ms()) sim::run_for(*prev_time - sim::now_ms());
+    return;
+  }
+  sim::detail::sleep_until(*prev_time);
+}
+
+uint32_t task_get_priority(task_t task) { return resolve(task)->priority; }
+
+void task_set_priority(task_t task, uint32_t prio) { resolve(task)->priority = prio; }
+
+task_state_e_t task_get_state(task_t task) {
+  SimTask* t = resolve(task);
+  if (t == nullptr) return E_TASK_STATE_INVALID;
+  switch (t->state) {
+    case TaskState::running: return E_TASK_STATE_RUNNING;
+    case TaskState::ready: return E_TASK_STATE_READY;
+    case TaskState::blocked: return E_TASK_STATE_BLOCKED;
+    case TaskState::suspended: return E_TASK_STATE_SUSPENDED;
+    case TaskState::deleted: return E_TASK_STATE_DELETED;
+  }
+  return E_TASK_STATE_INVALID;
+}
+
+void task_suspend(task_t task) { sim::detail::task_state_set(resolve(task), TaskState::suspended); }
+
+void task_resume(task_t task) {
+  SimTask* t = resolve(task);
+  if (t->state == TaskState::suspended) sim::detail::task_state_set(t, TaskState::ready);
+}
+
+uint32_t task_get_count(void) { return sim::detail::task_count(); }
+
+char* task_get_name(task_t task) { return resolve(task)->name.data(); }
+
+task_t task_get_by_name(const char* name) { return sim::detail::task_find(name); }
+
+task_t task_get_current() { return sim::detail::task_current(); }
+
+uint32_t task_notify(task_t task) { return task_notify_ext(task, 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+void task_join(task_t task) {
+  SimTask* t = resolve(task);
+  sim::detail::block(TIMEOUT_MAX, [t] { return t->state == TaskState::deleted; });
+}
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+  SimTask* t = resolve(task);
+  if (prev_value != nullptr) *prev_value = t->notify_value;
+  switch (action) {
+    case E_NOTIFY_ACTION_NONE: break;
+    case E_NOTIFY_ACTION_BITS: t->notify_value |= value; break;
+    case E_NOTIFY_ACTION_INCR: t->notify_value++; break;
+    case E_NOTIFY_ACTION_OWRITE: t->notify_value = value; break;
+    case E_NOTIFY_ACTION_NO_OWRITE:
+      if (t->notify_value != 0) return 0;
+      t->notify_value = value;
+      break;
+  }
+  return 1;
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+  SimTask* self = sim::detail::task_current();
+  if (self->notify_value == 0 && timeout != 0)
+    sim::detail::block(timeout, [self] { return self->notify_value != 0; });
+  uint32_t value = self->notify_value;
+  if (value != 0) self->notify_value = clear_on_exit ? 0 : value - 1;
+  return value;
+}
+
+bool task_notify_clear(task_t task) {
+  SimTask* t = resolve(task);
+  bool was_pending = t->notify_value != 0;
+  t->notify_value = 0;
+  return was_pending;
+}
+
+mutex_t mutex_create(void) { return new SimMutex(); }
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) {
+  auto* m = static_cast<SimMutex*>(mutex);
+  if (m->locked) {
+    // Nothing can release the mutex while the host thread holds the clock
+    if (sim::detail::task_current() == nullptr || timeout == 0) return false;
+    if (!sim::detail::block(timeout, [m] { return !m->locked; })) return false;
+  }
+  m->locked = true;
+  return true;
+}
+
+bool mutex_give(mutex_t mutex) {
+  auto* m = static_cast<SimMutex*>(mutex);
+  bool was_locked = m->locked;
+  m->locked = false;
+  return was_locked;
+}
+
+void mutex_delete(mutex_t mutex) { delete static_cast<SimMutex*>(mutex); }
+
+}  // namespace pros::c
+
+namespace pros {
+inline namespace rtos {
+
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(pros::c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task Task::current() { return Task(pros::c::task_get_current()); }
+
+Task& Task::operator=(task_t in) {
+  task = in;
+  return *this;
+}
+
+void Task::remove() { pros::c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return pros::c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { pros::c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return pros::c::task_get_state(task); }
+
+void Task::suspend() { pros::c::task_suspend(task); }
+
+void Task::resume() { pros::c::task_resume(task); }
+
+const char* Task::get_name() { return pros::c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return pros::c::task_notify(task); }
+
+void Task::join() { pros::c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+  return pros::c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+  return pros::c::task_notify_take(clear_on_exit, timeout);
+}
+
+bool Task::notify_clear() { return pros::c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { pros::c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+  pros::c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count() { return pros::c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point{duration{pros::c::millis()}}; }
+
+Mutex::Mutex() : mutex(pros::c::mutex_create(), pros::c::mutex_delete) {}
+
+bool Mutex::take() { return pros::c::mutex_take(mutex.get(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return pros::c::mutex_take(mutex.get(), timeout); }
+
+bool Mutex::give() { return pros::c::mutex_give(mutex.get()); }
+
+void Mutex::lock() {
+  while (!take(TIMEOUT_MAX))
+    ;
+}
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+}  // namespace rtos
+}  // namespace pros
@@ -0,0 +1,113 @@
+#include "sim/trials.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace sim {
+namespace {
+
+constexpr const char* TRIAL_FLAG = "--sim-trial";
+constexpr const char* RESULT_TAG = "sim-trial-result";
+
+std::string quoted(const std::string& arg) {
+  std::string out = "'";
+  for (char c : arg) out += c == '\'' ? std::string("'\\''") : std::string(1, c);
+  return out + "'";
+}
+
+std::string self_path() {
+  char path[4096];
+  const ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+  if (length <= 0) return "";
+  return std::string(path, length);
+}
+
+// The trial's own output is passed through; only the tagged line is parsed
+std::vector<double> collect(FILE* child) {
+  std::vector<double> result;
+  char line[4096];
+  while (std::fgets(line, sizeof(line), child) != nullptr) {
+    if (std::strncmp(line, RESULT_TAG, std::strlen(RESULT_TAG)) != 0) continue;
+    std::istringstream values(line + std::strlen(RESULT_TAG));
+    double value;
+    while (values >> value) result.push_back(value);
+  }
+  return result;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+  const double index = fraction * (sorted.size() - 1);
+  const std::size_t low = static_cast<std::size_t>(index);
+  const std::size_t high = std::min(low + 1, sorted.size() - 1);
+  return sorted[low] + (sorted[high] - sorted[low]) * (index - low);
+}
+
+}  // namespace
+
+std::vector<std::vector<double>> run_trials(int argc, char** argv, int count, const trial_fn_t& trial, int jobs) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (std::strcmp(argv[i], TRIAL_FLAG) != 0) continue;
+    const std::vector<double> result = trial(std::atoi(argv[i + 1]));
+    std::printf("\n%s", RESULT_TAG);
+    for (double value : result) std::printf(" %.17g", value);
+    std::printf("\n");
+    std::fflush(stdout);
+    // Task threads are still parked in the kernel, skip static destructors
+    std::_Exit(0);
+  }
+
+  if (jobs <= 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+  // Trial copies get the same arguments, so they agree on what each index means
+  std::string command_base = quoted(self_path());
+  for (int i = 1; i < argc; i++) command_base += " " + quoted(argv[i]);
+  std::vector<std::vector<double>> results(count);
+  for (int first = 0; first < count; first += jobs) {
+    const int last = std::min(count, first + jobs);
+    std::vector<FILE*> children;
+    for (int i = first; i < last; i++) {
+      const std::string command = command_base + " " + TRIAL_FLAG + " " + std::to_string(i) + " 2>/dev/null";
+      children.push_back(popen(command.c_str(), "r"));
+    }
+    for (int i = first; i < last; i++) {
+      FILE* child = children[i - first];
+      if (child == nullptr) continue;
+      results[i] = collect(child);
+      pclose(child);
+    }
+  }
+  return results;
+}
+
+Stats stats(std::vector<double> values) {
+  Stats s;
+  s.count = values.size();
+  if (values.empty()) return s;
+  std::sort(values.begin(), values.end());
+  double sum = 0;
+  for (double value : values) sum += value;
+  s.mean = sum / values.size();
+  double square = 0;
+  for (double value : values) square += (value - s.mean) * (value - s.mean);
+  s.stddev = values.size() > 1 ? std::sqrt(square / (values.size() - 1)) : 0;
+  s.min = values.front();
+  s.p50 = percentile(values, 0.5);
+  s.p95 = percentile(values, 0.95);
+  s.max = values.back();
+  return s;
+}
+
+std::string to_string(const Stats& s, int precision) {
+  char buffer[256];
+  std::snprintf(buffer, sizeof(buffer), "mean %.*f sd %.*f min %.*f p50 %.*f p95 %.*f max %.*f", precision, s.mean,
+                precision, s.stddev, precision, s.min, precision, s.p50, precision, s.p95, precision, s.max);
+  return buffer;
+}
+
+}  // namespace sim